@@ -57,6 +57,8 @@ class LinearStateConstraint : public StateConstraint {
   VectorFunctionLinearApproximation getLinearApproximation(scalar_t t, const vector_t& x,
                                                            const PreComputation& /* preComputation */) const final;
 
+  bool isJacobianConstant() const final { return true; }
+
  public:
   vector_t h_; /**< State only constraint */
   matrix_t F_; /**< State only constraint derivative wrt. state */
@@ -66,6 +66,12 @@ class StateConstraint {
     }
   }
 
+  /**
+   * Whether the derivatives (dfdx) of the linear approximation are independent of the time and state. The constraint collection then
+   * caches them and only queries getValue(). The derivatives of such a term must not change after it is added to a collection.
+   */
+  virtual bool isJacobianConstant() const { return false; }
+
   /** Get the constraint quadratic approximation */
   virtual VectorFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                          const PreComputation& preComp) const {
@@ -66,6 +66,13 @@ class StateInputConstraint {
     }
   }
 
+  /**
+   * Whether the derivatives (dfdx, dfdu) of the linear approximation are independent of the time, state and input. The constraint
+   * collection then caches them and only queries getValue(). The derivatives of such a term must not change after it is added to a
+   * collection.
+   */
+  virtual bool isJacobianConstant() const { return false; }
+
   /** Get the constraint quadratic approximation */
   virtual VectorFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                          const PreComputation& preComp) const {
@@ -42,6 +42,10 @@ namespace ocs2 {
  * This class collects a variable number of constraint functions and provides methods to get the
  * concatenated constraint vectors and approximations. Each constraint can be accessed through its
  * string name and can be activated or deactivated.
+ *
+ * The derivatives of the terms that declare them constant (StateInputConstraint::isJacobianConstant()) are stacked once per set of active
+ * terms and reused in the following linear approximations. Since this cache is mutable, a collection should not be evaluated
+ * concurrently from several threads.
  */
 class StateInputConstraintCollection : public Collection<StateInputConstraint> {
  public:
@@ -69,6 +73,21 @@ class StateInputConstraintCollection : public Collection<StateInputConstraint> {
  protected:
   /** Copy constructor */
   StateInputConstraintCollection(const StateInputConstraintCollection& other);
+
+ private:
+  /** Stacked constant Jacobians of a set of active terms. The rows of the other terms are zero. */
+  struct ConstantJacobianCache {
+    size_t termsRevision = 0;
+    size_array_t termsSize;  // the number of constraints of each term, zero if inactive
+    matrix_t dfdx;
+    matrix_t dfdu;
+  };
+
+  /** Updates the cache if the terms, their activity, their sizes or the dimensions have changed. */
+  void updateConstantJacobianCache(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp,
+                                   const size_array_t& termsSize) const;
+
+  mutable ConstantJacobianCache constantJacobianCache_;
 };
 
 }  // namespace ocs2
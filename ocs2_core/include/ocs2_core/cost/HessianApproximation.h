@@ -0,0 +1,119 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+namespace hessian_approximation {
+
+/** Strategy to obtain the Hessian of a cost term */
+enum class Strategy {
+  EXACT,        // second derivatives in every evaluation
+  REUSE,        // Hessian of the last exact evaluation of the node, only the gradient is refreshed
+  DAMPED_BFGS,  // Hessian of the last exact evaluation of the node, updated with Powell-damped BFGS steps from the gradient changes
+};
+
+/** Get string name of the strategy */
+std::string toString(Strategy strategy);
+
+/** Get the strategy from its string name */
+Strategy fromString(const std::string& name);
+
+struct Settings {
+  Strategy strategy = Strategy::EXACT;
+
+  // The Hessian of a node is evaluated exactly at least every refreshPeriod evaluations of the node
+  size_t refreshPeriod = 5;
+
+  // Number of nodes with an approximation. Nodes with a larger index are always evaluated exactly.
+  size_t maxNumNodes = 1000;
+};
+
+/**
+ * Load the Hessian approximation settings from file
+ *
+ * @param [in] filename: File name which contains the configuration data.
+ * @param [in] fieldName: Field name which contains the configuration data.
+ * @param [in] verbose: Flag to determine whether to print out the loaded settings or not.
+ * @return The settings
+ */
+Settings loadSettings(const std::string& filename, const std::string& fieldName = "hessian_approximation", bool verbose = true);
+
+}  // namespace hessian_approximation
+
+/**
+ * Approximates the Hessian of a state-input cost term at the nodes of a discretized trajectory from its gradients, such that the
+ * second derivatives only need to be evaluated every few iterations.
+ *
+ * The nodes are identified by their index in the time discretization. A node therefore keeps its approximation when the MPC horizon
+ * shifts, and the next exact evaluation or BFGS step corrects for the shift. The clones of a cost term share one instance. Different
+ * nodes can be approximated concurrently, but a node must not be evaluated by two threads at the same time. The multiple-shooting
+ * solvers guarantee this by evaluating every node once per iteration.
+ */
+class HessianApproximation {
+ public:
+  explicit HessianApproximation(hessian_approximation::Settings settings);
+
+  const hessian_approximation::Settings& settings() const { return settings_; }
+
+  /**
+   * Completes the gradient-only approximation of a node with the approximated Hessian.
+   *
+   * @param [in] node: The index of the node.
+   * @param [in] state: The state of the node.
+   * @param [in] input: The input of the node.
+   * @param [in, out] cost: The cost value and gradients at the node on input. The Hessian blocks are set if true is returned.
+   * @return False if the Hessian of the node has to be evaluated exactly, see setExactApproximation().
+   */
+  bool approximate(size_t node, const vector_t& state, const vector_t& input, ScalarFunctionQuadraticApproximation& cost);
+
+  /** Stores the exact quadratic approximation of a node, which restarts the approximation of its Hessian. */
+  void setExactApproximation(size_t node, const vector_t& state, const vector_t& input, const ScalarFunctionQuadraticApproximation& cost);
+
+  /** Forgets all nodes. */
+  void clear();
+
+ private:
+  struct Node {
+    size_t numApproximations = 0;  // since the last exact evaluation
+    vector_t stateInput;
+    vector_t gradient;
+    matrix_t hessian;  // [dfdxx, dfdux'; dfdux, dfduu]
+  };
+
+  hessian_approximation::Settings settings_;
+  std::vector<Node> nodes_;
+};
+
+}  // namespace ocs2
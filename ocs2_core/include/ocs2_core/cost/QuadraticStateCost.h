@@ -53,6 +53,13 @@ class QuadraticStateCost : public StateCost {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation&) const final;
 
+  /** Get cost term value and gradient */
+  ScalarFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state,
+                                                           const TargetTrajectories& targetTrajectories, const PreComputation&) const final;
+
+  /** The Hessian is Q */
+  bool isHessianConstant() const final { return true; }
+
  protected:
   QuadraticStateCost(const QuadraticStateCost& rhs) = default;
 
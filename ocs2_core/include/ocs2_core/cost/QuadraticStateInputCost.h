@@ -58,6 +58,14 @@ class QuadraticStateInputCost : public StateInputCost {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation&) const final;
 
+  /** Get cost term value and gradients */
+  ScalarFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                           const TargetTrajectories& targetTrajectories,
+                                                           const PreComputation&) const final;
+
+  /** The Hessians are Q, R and P */
+  bool isHessianConstant() const final { return true; }
+
  protected:
   QuadraticStateInputCost(const QuadraticStateInputCost& rhs) = default;
 
@@ -56,6 +56,27 @@ class StateCost {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const = 0;
 
+  /**
+   * Get cost term value and gradient. By default, they are extracted from the quadratic approximation. Terms with a constant Hessian
+   * should override it to avoid computing and copying the Hessian.
+   */
+  virtual ScalarFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state,
+                                                                   const TargetTrajectories& targetTrajectories,
+                                                                   const PreComputation& preComp) const {
+    auto quadraticApproximation = getQuadraticApproximation(time, state, targetTrajectories, preComp);
+    ScalarFunctionLinearApproximation linearApproximation;
+    linearApproximation.f = quadraticApproximation.f;
+    linearApproximation.dfdx = std::move(quadraticApproximation.dfdx);
+    return linearApproximation;
+  }
+
+  /**
+   * Whether the second order derivative (dfdxx) of the quadratic approximation is independent of the time, state and target
+   * trajectories. The cost collection then sums these Hessians once and only queries getLinearApproximation().
+   * The Hessian of such a term must not change after it is added to a collection.
+   */
+  virtual bool isHessianConstant() const { return false; }
+
  protected:
   StateCost(const StateCost& rhs) = default;
 };
@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/PreComputation.h>
 #include <ocs2_core/Types.h>
+#include <ocs2_core/cost/HessianApproximation.h>
 #include <ocs2_core/reference/TargetTrajectories.h>
 
 namespace ocs2 {
@@ -56,6 +57,40 @@ class StateInputCost {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const = 0;
 
+  /**
+   * Get cost term value and gradients. By default, they are extracted from the quadratic approximation. Terms with a constant Hessian
+   * should override it to avoid computing and copying the Hessian.
+   */
+  virtual ScalarFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                   const TargetTrajectories& targetTrajectories,
+                                                                   const PreComputation& preComp) const {
+    auto quadraticApproximation = getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+    ScalarFunctionLinearApproximation linearApproximation;
+    linearApproximation.f = quadraticApproximation.f;
+    linearApproximation.dfdx = std::move(quadraticApproximation.dfdx);
+    linearApproximation.dfdu = std::move(quadraticApproximation.dfdu);
+    return linearApproximation;
+  }
+
+  /**
+   * Whether the second order derivatives (dfdxx, dfdux, dfduu) of the quadratic approximation are independent of the time, state,
+   * input and target trajectories. The cost collection then sums these Hessians once and only queries getLinearApproximation().
+   * The Hessian of such a term must not change after it is added to a collection.
+   */
+  virtual bool isHessianConstant() const { return false; }
+
+  /**
+   * Sets how the Hessian of the term is obtained, see hessian_approximation::Strategy. Terms that do not support an approximation
+   * ignore it and always return the exact Hessian.
+   */
+  virtual void setHessianApproximation(const hessian_approximation::Settings& settings) {}
+
+  /**
+   * Selects the node of the time discretization that the next quadratic approximations belong to. The Hessian approximation of a term
+   * is kept per node index, see HessianApproximation. The multiple-shooting solvers select the node before evaluating it.
+   */
+  virtual void setHessianApproximationNode(size_t node) {}
+
  protected:
   StateInputCost(const StateInputCost& rhs) = default;
 };
@@ -43,6 +43,10 @@ namespace ocs2 {
  * This class collects a variable number of cost terms and provides methods to get the
  * summed cost values and quadratic approximations. Each cost term can be accessed through its
  * string name and can be activated or deactivated.
+ *
+ * The Hessians of the terms that declare them constant (StateInputCost::isHessianConstant()) are summed once per set of active
+ * terms and reused in the following quadratic approximations. Since this cache is mutable, a collection should not be evaluated
+ * concurrently from several threads. The solvers evaluate a separate clone of the optimal control problem per worker.
  */
 class StateInputCostCollection : public Collection<StateInputCost> {
  public:
@@ -59,9 +63,31 @@ class StateInputCostCollection : public Collection<StateInputCost> {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const;
 
+  /** Sets the Hessian approximation of all terms, see StateInputCost::setHessianApproximation(). */
+  void setHessianApproximation(const hessian_approximation::Settings& settings);
+
+  /** Selects the node of the Hessian approximation of all terms, see StateInputCost::setHessianApproximationNode(). */
+  void setHessianApproximationNode(size_t node);
+
  protected:
   /** Copy constructor */
   StateInputCostCollection(const StateInputCostCollection& other);
+
+ private:
+  /** Sum of the constant Hessians of a set of active terms */
+  struct ConstantHessianCache {
+    size_t termsRevision = 0;
+    std::vector<bool> isSummed;  // for each term, whether its Hessian is included in the sum
+    matrix_t dfdxx;
+    matrix_t dfdux;
+    matrix_t dfduu;
+  };
+
+  /** Sums the constant Hessians of the terms that are active at the given time. */
+  void updateConstantHessianCache(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                                  const PreComputation& preComp) const;
+
+  mutable ConstantHessianCache constantHessianCache_;
 };
 
 }  // namespace ocs2
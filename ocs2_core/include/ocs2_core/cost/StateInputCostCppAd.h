@@ -29,11 +29,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <limits>
 #include <memory>
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/automatic_differentiation/CppAdInterface.h>
 #include <ocs2_core/automatic_differentiation/Types.h>
+#include <ocs2_core/cost/HessianApproximation.h>
 #include <ocs2_core/cost/StateInputCost.h>
 
 namespace ocs2 {
@@ -56,6 +58,16 @@ class StateInputCostCppAd : public StateInputCost {
   void initialize(size_t stateDim, size_t inputDim, size_t parameterDim, const std::string& modelName,
                   const std::string& modelFolder = "/tmp/ocs2", bool recompileLibraries = true, bool verbose = true);
 
+  /**
+   * Sets how the Hessian is obtained. With a strategy other than hessian_approximation::Strategy::EXACT, the second derivatives of a
+   * node are only evaluated every settings.refreshPeriod evaluations and approximated from the gradients in between. The clones of
+   * this term share the approximation, and each clone evaluates the node selected by setHessianApproximationNode(). Without a selected
+   * node, the Hessian is evaluated exactly.
+   */
+  void setHessianApproximation(const hessian_approximation::Settings& settings) override;
+
+  void setHessianApproximationNode(size_t node) override { hessianApproximationNode_ = node; }
+
   /** Get the parameter vector */
   virtual vector_t getParameters(scalar_t time, const TargetTrajectories& targetTrajectories,
                                  const PreComputation& /* preComputation */) const {
@@ -68,6 +80,9 @@ class StateInputCostCppAd : public StateInputCost {
   ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation& preComputation) const override;
+  ScalarFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                           const TargetTrajectories& targetTrajectories,
+                                                           const PreComputation& preComputation) const override;
 
  protected:
   StateInputCostCppAd(const StateInputCostCppAd& rhs);
@@ -78,6 +93,8 @@ class StateInputCostCppAd : public StateInputCost {
 
  private:
   std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr_;
+  std::shared_ptr<HessianApproximation> hessianApproximationPtr_;
+  size_t hessianApproximationNode_ = std::numeric_limits<size_t>::max();
 };
 
 }  // namespace ocs2
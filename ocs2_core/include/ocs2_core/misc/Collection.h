@@ -104,6 +104,9 @@ class Collection {
   //! Contains all terms in the order they were added
   std::vector<std::unique_ptr<T>> terms_;
 
+  //! Incremented whenever a term is added or removed. Derived collections use it to invalidate data cached on the terms.
+  size_t termsRevision_ = 0;
+
  private:
   //! Lookup from cost term name to index in the cost term vector
   std::unordered_map<std::string, size_t> termNameMap_;
@@ -116,6 +119,7 @@ template <typename T>
 void Collection<T>::clear() {
   terms_.clear();
   termNameMap_.clear();
+  ++termsRevision_;
 }
 
 /******************************************************************************************************/
@@ -127,6 +131,7 @@ void Collection<T>::add(std::string name, std::unique_ptr<T> term) {
   auto info = termNameMap_.emplace(std::move(name), nextIndex);
   if (info.second) {
     terms_.push_back(std::move(term));
+    ++termsRevision_;
   } else {
     throw std::runtime_error(std::string("[Collection::add] Term with name \"") + info.first->first + "\" already exists");
   }
@@ -160,6 +165,7 @@ std::unique_ptr<T> Collection<T>::extract(const std::string& name) {
   auto term = (std::move(terms_[termInd]));
   // remove the term
   terms_.erase(terms_.begin() + termInd);
+  ++termsRevision_;
 
   return term;
 }
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/constraint/StateConstraintCollection.h>
 
+#include <numeric>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -87,16 +89,36 @@ vector_array_t StateConstraintCollection::getValue(scalar_t time, const vector_t
 /******************************************************************************************************/
 VectorFunctionLinearApproximation StateConstraintCollection::getLinearApproximation(scalar_t time, const vector_t& state,
                                                                                     const PreComputation& preComp) const {
-  VectorFunctionLinearApproximation linearApproximation(getNumConstraints(time), state.rows());
+  const auto termsSize = getTermsSize(time);
+  const size_t numConstraints = std::accumulate(termsSize.begin(), termsSize.end(), size_t(0));
+
+  bool hasConstantJacobian = false;
+  for (size_t t = 0; t < this->terms_.size(); ++t) {
+    hasConstantJacobian = hasConstantJacobian || (termsSize[t] > 0 && this->terms_[t]->isJacobianConstant());
+  }
+
+  VectorFunctionLinearApproximation linearApproximation;
+  if (hasConstantJacobian) {
+    // Initialize with the cached Jacobians, such that the terms with constant Jacobian only fill in their values.
+    updateConstantJacobianCache(time, state, preComp, termsSize);
+    linearApproximation.f.resize(numConstraints);
+    linearApproximation.dfdx = constantJacobianCache_.dfdx;
+  } else {
+    linearApproximation = VectorFunctionLinearApproximation(numConstraints, state.rows());
+  }
 
   // append linearApproximation of each constraintTerm
   size_t i = 0;
-  for (const auto& constraintTerm : this->terms_) {
-    if (constraintTerm->isActive(time)) {
-      const auto constraintTermApproximation = constraintTerm->getLinearApproximation(time, state, preComp);
-      const size_t nc = constraintTermApproximation.f.rows();
-      linearApproximation.f.segment(i, nc) = constraintTermApproximation.f;
-      linearApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
+  for (size_t t = 0; t < this->terms_.size(); ++t) {
+    const size_t nc = termsSize[t];
+    if (nc > 0) {
+      if (hasConstantJacobian && this->terms_[t]->isJacobianConstant()) {
+        linearApproximation.f.segment(i, nc) = this->terms_[t]->getValue(time, state, preComp);
+      } else {
+        const auto constraintTermApproximation = this->terms_[t]->getLinearApproximation(time, state, preComp);
+        linearApproximation.f.segment(i, nc) = constraintTermApproximation.f;
+        linearApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
+      }
       i += nc;
     }
   }
@@ -132,4 +154,33 @@ VectorFunctionQuadraticApproximation StateConstraintCollection::getQuadraticAppr
   return quadraticApproximation;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateConstraintCollection::updateConstantJacobianCache(scalar_t time, const vector_t& state, const PreComputation& preComp,
+                                                            const size_array_t& termsSize) const {
+  auto& cache = constantJacobianCache_;
+  const bool isValid = cache.termsRevision == termsRevision_ && cache.termsSize == termsSize && cache.dfdx.cols() == state.rows();
+  if (isValid) {
+    return;
+  }
+
+  const size_t numConstraints = std::accumulate(termsSize.begin(), termsSize.end(), size_t(0));
+  cache.termsRevision = termsRevision_;
+  cache.termsSize = termsSize;
+  cache.dfdx.setZero(numConstraints, state.rows());
+
+  size_t i = 0;
+  for (size_t t = 0; t < this->terms_.size(); ++t) {
+    const size_t nc = termsSize[t];
+    if (nc > 0) {
+      if (this->terms_[t]->isJacobianConstant()) {
+        const auto constraintTermApproximation = this->terms_[t]->getLinearApproximation(time, state, preComp);
+        cache.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
+      }
+      i += nc;
+    }
+  }
+}
+
 }  // namespace ocs2
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/constraint/StateInputConstraintCollection.h>
 
+#include <numeric>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -90,17 +92,38 @@ vector_array_t StateInputConstraintCollection::getValue(scalar_t time, const vec
 VectorFunctionLinearApproximation StateInputConstraintCollection::getLinearApproximation(scalar_t time, const vector_t& state,
                                                                                          const vector_t& input,
                                                                                          const PreComputation& preComp) const {
-  VectorFunctionLinearApproximation linearApproximation(getNumConstraints(time), state.rows(), input.rows());
+  const auto termsSize = getTermsSize(time);
+  const size_t numConstraints = std::accumulate(termsSize.begin(), termsSize.end(), size_t(0));
+
+  bool hasConstantJacobian = false;
+  for (size_t t = 0; t < this->terms_.size(); ++t) {
+    hasConstantJacobian = hasConstantJacobian || (termsSize[t] > 0 && this->terms_[t]->isJacobianConstant());
+  }
+
+  VectorFunctionLinearApproximation linearApproximation;
+  if (hasConstantJacobian) {
+    // Initialize with the cached Jacobians, such that the terms with constant Jacobian only fill in their values.
+    updateConstantJacobianCache(time, state, input, preComp, termsSize);
+    linearApproximation.f.resize(numConstraints);
+    linearApproximation.dfdx = constantJacobianCache_.dfdx;
+    linearApproximation.dfdu = constantJacobianCache_.dfdu;
+  } else {
+    linearApproximation = VectorFunctionLinearApproximation(numConstraints, state.rows(), input.rows());
+  }
 
   // append linearApproximation of each constraintTerm
   size_t i = 0;
-  for (const auto& constraintTerm : this->terms_) {
-    if (constraintTerm->isActive(time)) {
-      const auto constraintTermApproximation = constraintTerm->getLinearApproximation(time, state, input, preComp);
-      const size_t nc = constraintTermApproximation.f.rows();
-      linearApproximation.f.segment(i, nc) = constraintTermApproximation.f;
-      linearApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
-      linearApproximation.dfdu.middleRows(i, nc) = constraintTermApproximation.dfdu;
+  for (size_t t = 0; t < this->terms_.size(); ++t) {
+    const size_t nc = termsSize[t];
+    if (nc > 0) {
+      if (hasConstantJacobian && this->terms_[t]->isJacobianConstant()) {
+        linearApproximation.f.segment(i, nc) = this->terms_[t]->getValue(time, state, input, preComp);
+      } else {
+        const auto constraintTermApproximation = this->terms_[t]->getLinearApproximation(time, state, input, preComp);
+        linearApproximation.f.segment(i, nc) = constraintTermApproximation.f;
+        linearApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
+        linearApproximation.dfdu.middleRows(i, nc) = constraintTermApproximation.dfdu;
+      }
       i += nc;
     }
   }
@@ -143,4 +166,36 @@ VectorFunctionQuadraticApproximation StateInputConstraintCollection::getQuadrati
   return quadraticApproximation;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputConstraintCollection::updateConstantJacobianCache(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                 const PreComputation& preComp, const size_array_t& termsSize) const {
+  auto& cache = constantJacobianCache_;
+  const bool isValid = cache.termsRevision == termsRevision_ && cache.termsSize == termsSize && cache.dfdx.cols() == state.rows() &&
+                       cache.dfdu.cols() == input.rows();
+  if (isValid) {
+    return;
+  }
+
+  const size_t numConstraints = std::accumulate(termsSize.begin(), termsSize.end(), size_t(0));
+  cache.termsRevision = termsRevision_;
+  cache.termsSize = termsSize;
+  cache.dfdx.setZero(numConstraints, state.rows());
+  cache.dfdu.setZero(numConstraints, input.rows());
+
+  size_t i = 0;
+  for (size_t t = 0; t < this->terms_.size(); ++t) {
+    const size_t nc = termsSize[t];
+    if (nc > 0) {
+      if (this->terms_[t]->isJacobianConstant()) {
+        const auto constraintTermApproximation = this->terms_[t]->getLinearApproximation(time, state, input, preComp);
+        cache.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
+        cache.dfdu.middleRows(i, nc) = constraintTermApproximation.dfdu;
+      }
+      i += nc;
+    }
+  }
+}
+
 }  // namespace ocs2
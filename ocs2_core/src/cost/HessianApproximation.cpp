@@ -0,0 +1,182 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/cost/HessianApproximation.h"
+
+#include <iostream>
+#include <unordered_map>
+
+#include <boost/property_tree/info_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include "ocs2_core/NumericTraits.h"
+#include "ocs2_core/misc/LoadData.h"
+
+namespace ocs2 {
+
+namespace {
+/**
+ * Powell-damped BFGS update of the Hessian approximation B for the step s and the gradient change y. The damping keeps B positive
+ * definite along s when the curvature y' * s is small or negative. The update is skipped if B has no positive curvature along s.
+ */
+void dampedBfgsUpdate(const vector_t& s, const vector_t& y, matrix_t& B) {
+  const vector_t Bs = B * s;
+  const scalar_t sBs = s.dot(Bs);
+  if (sBs <= numeric_traits::limitEpsilon<scalar_t>()) {
+    return;
+  }
+  const scalar_t sy = s.dot(y);
+  const scalar_t theta = (sy >= 0.2 * sBs) ? 1.0 : 0.8 * sBs / (sBs - sy);
+  const vector_t r = theta * y + (1.0 - theta) * Bs;
+  B.noalias() -= (Bs / sBs) * Bs.transpose();
+  B.noalias() += (r / s.dot(r)) * r.transpose();
+}
+}  // namespace
+
+namespace hessian_approximation {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string toString(Strategy strategy) {
+  static const std::unordered_map<Strategy, std::string> strategyMap = {
+      {Strategy::EXACT, "EXACT"}, {Strategy::REUSE, "REUSE"}, {Strategy::DAMPED_BFGS, "DAMPED_BFGS"}};
+
+  return strategyMap.at(strategy);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Strategy fromString(const std::string& name) {
+  static const std::unordered_map<std::string, Strategy> strategyMap = {
+      {"EXACT", Strategy::EXACT}, {"REUSE", Strategy::REUSE}, {"DAMPED_BFGS", Strategy::DAMPED_BFGS}};
+
+  return strategyMap.at(name);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Settings loadSettings(const std::string& filename, const std::string& fieldName, bool verbose) {
+  boost::property_tree::ptree pt;
+  boost::property_tree::read_info(filename, pt);
+
+  Settings settings;
+
+  if (verbose) {
+    std::cerr << "\n #### Hessian Approximation Settings:";
+    std::cerr << "\n #### =============================================================================\n";
+  }
+
+  auto strategyName = toString(settings.strategy);
+  loadData::loadPtreeValue(pt, strategyName, fieldName + ".strategy", verbose);
+  settings.strategy = fromString(strategyName);
+  loadData::loadPtreeValue(pt, settings.refreshPeriod, fieldName + ".refreshPeriod", verbose);
+  loadData::loadPtreeValue(pt, settings.maxNumNodes, fieldName + ".maxNumNodes", verbose);
+
+  if (verbose) {
+    std::cerr << " #### =============================================================================" << std::endl;
+  }
+
+  return settings;
+}
+
+}  // namespace hessian_approximation
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+HessianApproximation::HessianApproximation(hessian_approximation::Settings settings)
+    : settings_(std::move(settings)), nodes_(settings_.strategy == hessian_approximation::Strategy::EXACT ? 0 : settings_.maxNumNodes) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool HessianApproximation::approximate(size_t node, const vector_t& state, const vector_t& input,
+                                       ScalarFunctionQuadraticApproximation& cost) {
+  if (node >= nodes_.size()) {
+    return false;
+  }
+
+  const size_t stateDim = state.size();
+  const size_t inputDim = input.size();
+  Node& nodeData = nodes_[node];
+  if (nodeData.numApproximations + 1 >= settings_.refreshPeriod || nodeData.stateInput.size() != stateDim + inputDim) {
+    return false;
+  }
+
+  vector_t stateInput(stateDim + inputDim);
+  stateInput << state, input;
+  vector_t gradient(stateDim + inputDim);
+  gradient << cost.dfdx, cost.dfdu;
+  if (settings_.strategy == hessian_approximation::Strategy::DAMPED_BFGS) {
+    dampedBfgsUpdate(stateInput - nodeData.stateInput, gradient - nodeData.gradient, nodeData.hessian);
+  }
+  nodeData.stateInput = std::move(stateInput);
+  nodeData.gradient = std::move(gradient);
+  ++nodeData.numApproximations;
+
+  cost.dfdxx = nodeData.hessian.topLeftCorner(stateDim, stateDim);
+  cost.dfdux = nodeData.hessian.bottomLeftCorner(inputDim, stateDim);
+  cost.dfduu = nodeData.hessian.bottomRightCorner(inputDim, inputDim);
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void HessianApproximation::setExactApproximation(size_t node, const vector_t& state, const vector_t& input,
+                                                 const ScalarFunctionQuadraticApproximation& cost) {
+  if (node >= nodes_.size()) {
+    return;
+  }
+
+  const size_t stateDim = state.size();
+  const size_t inputDim = input.size();
+  Node& nodeData = nodes_[node];
+  nodeData.numApproximations = 0;
+  nodeData.stateInput.resize(stateDim + inputDim);
+  nodeData.stateInput << state, input;
+  nodeData.gradient.resize(stateDim + inputDim);
+  nodeData.gradient << cost.dfdx, cost.dfdu;
+  nodeData.hessian.resize(stateDim + inputDim, stateDim + inputDim);
+  nodeData.hessian << cost.dfdxx, cost.dfdux.transpose(), cost.dfdux, cost.dfduu;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void HessianApproximation::clear() {
+  for (auto& nodeData : nodes_) {
+    nodeData = Node();
+  }
+}
+
+}  // namespace ocs2
@@ -67,6 +67,20 @@ ScalarFunctionQuadraticApproximation QuadraticStateCost::getQuadraticApproximati
   return Phi;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionLinearApproximation QuadraticStateCost::getLinearApproximation(scalar_t time, const vector_t& state,
+                                                                             const TargetTrajectories& targetTrajectories,
+                                                                             const PreComputation&) const {
+  const vector_t xDeviation = getStateDeviation(time, state, targetTrajectories);
+
+  ScalarFunctionLinearApproximation Phi;
+  Phi.dfdx.noalias() = Q_ * xDeviation;
+  Phi.f = 0.5 * xDeviation.dot(Phi.dfdx);
+  return Phi;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
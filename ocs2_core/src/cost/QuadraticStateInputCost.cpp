@@ -96,6 +96,31 @@ ScalarFunctionQuadraticApproximation QuadraticStateInputCost::getQuadraticApprox
   return L;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionLinearApproximation QuadraticStateInputCost::getLinearApproximation(scalar_t time, const vector_t& state,
+                                                                                  const vector_t& input,
+                                                                                  const TargetTrajectories& targetTrajectories,
+                                                                                  const PreComputation&) const {
+  vector_t stateDeviation, inputDeviation;
+  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories);
+
+  ScalarFunctionLinearApproximation L;
+  L.dfdx.noalias() = Q_ * stateDeviation;
+  L.dfdu.noalias() = R_ * inputDeviation;
+  L.f = 0.5 * stateDeviation.dot(L.dfdx) + 0.5 * inputDeviation.dot(L.dfdu);
+
+  if (P_.size() > 0) {
+    const vector_t pDeviation = P_ * stateDeviation;
+    L.f += inputDeviation.dot(pDeviation);
+    L.dfdu += pDeviation;
+    L.dfdx.noalias() += P_.transpose() * inputDeviation;
+  }
+
+  return L;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
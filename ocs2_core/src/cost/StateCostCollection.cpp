@@ -66,24 +66,60 @@ scalar_t StateCostCollection::getValue(scalar_t time, const vector_t& state, con
 ScalarFunctionQuadraticApproximation StateCostCollection::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                     const TargetTrajectories& targetTrajectories,
                                                                                     const PreComputation& preComp) const {
-  const auto firstActive =
-      std::find_if(terms_.begin(), terms_.end(), [time](const std::unique_ptr<StateCost>& costTerm) { return costTerm->isActive(time); });
+  // Count the active terms and the ones among them with a constant Hessian, and check them against the cached sum.
+  const auto& cache = constantHessianCache_;
+  size_t numActiveTerms = 0;
+  size_t numConstantHessians = 0;
+  bool isCacheValid = cache.termsRevision == termsRevision_ && cache.isSummed.size() == terms_.size();
+  for (size_t i = 0; i < terms_.size(); ++i) {
+    const bool isActive = terms_[i]->isActive(time);
+    const bool isConstantHessian = isActive && terms_[i]->isHessianConstant();
+    numActiveTerms += isActive ? 1 : 0;
+    numConstantHessians += isConstantHessian ? 1 : 0;
+    isCacheValid = isCacheValid && cache.isSummed[i] == isConstantHessian;
+  }
 
   // No active terms (or terms is empty).
-  if (firstActive == terms_.end()) {
+  if (numActiveTerms == 0) {
     return ScalarFunctionQuadraticApproximation::Zero(state.rows());
   }
 
-  // Initialize with first active term, accumulate potentially other active terms.
-  auto cost = (*firstActive)->getQuadraticApproximation(time, state, targetTrajectories, preComp);
-  std::for_each(std::next(firstActive), terms_.end(), [&](const std::unique_ptr<StateCost>& costTerm) {
-    if (costTerm->isActive(time)) {
-      const auto costTermApproximation = costTerm->getQuadraticApproximation(time, state, targetTrajectories, preComp);
-      cost.f += costTermApproximation.f;
-      cost.dfdx += costTermApproximation.dfdx;
-      cost.dfdxx += costTermApproximation.dfdxx;
+  ScalarFunctionQuadraticApproximation cost;
+  if (numConstantHessians > 0 && numActiveTerms > 1) {
+    // Initialize with the cached Hessians, such that the terms with constant Hessian only add their gradients.
+    if (!isCacheValid || cache.dfdxx.rows() != state.rows()) {
+      updateConstantHessianCache(time, state, targetTrajectories, preComp);
+    }
+    cost.dfdxx = cache.dfdxx;
+    cost.dfdx.setZero(state.rows());
+    cost.f = 0.0;
+    for (size_t i = 0; i < terms_.size(); ++i) {
+      if (cache.isSummed[i]) {
+        const auto costTermApproximation = terms_[i]->getLinearApproximation(time, state, targetTrajectories, preComp);
+        cost.f += costTermApproximation.f;
+        cost.dfdx += costTermApproximation.dfdx;
+      } else if (terms_[i]->isActive(time)) {
+        const auto costTermApproximation = terms_[i]->getQuadraticApproximation(time, state, targetTrajectories, preComp);
+        cost.f += costTermApproximation.f;
+        cost.dfdx += costTermApproximation.dfdx;
+        cost.dfdxx += costTermApproximation.dfdxx;
+      }
     }
-  });
+
+  } else {
+    // Initialize with first active term, accumulate potentially other active terms.
+    const auto firstActive =
+        std::find_if(terms_.begin(), terms_.end(), [time](const std::unique_ptr<StateCost>& costTerm) { return costTerm->isActive(time); });
+    cost = (*firstActive)->getQuadraticApproximation(time, state, targetTrajectories, preComp);
+    std::for_each(std::next(firstActive), terms_.end(), [&](const std::unique_ptr<StateCost>& costTerm) {
+      if (costTerm->isActive(time)) {
+        const auto costTermApproximation = costTerm->getQuadraticApproximation(time, state, targetTrajectories, preComp);
+        cost.f += costTermApproximation.f;
+        cost.dfdx += costTermApproximation.dfdx;
+        cost.dfdxx += costTermApproximation.dfdxx;
+      }
+    });
+  }
 
   // Make sure that input derivatives are empty
   cost.dfdu = vector_t();
@@ -93,4 +129,21 @@ ScalarFunctionQuadraticApproximation StateCostCollection::getQuadraticApproximat
   return cost;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateCostCollection::updateConstantHessianCache(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                                     const PreComputation& preComp) const {
+  auto& cache = constantHessianCache_;
+  cache.termsRevision = termsRevision_;
+  cache.isSummed.resize(terms_.size());
+  cache.dfdxx.setZero(state.rows(), state.rows());
+  for (size_t i = 0; i < terms_.size(); ++i) {
+    cache.isSummed[i] = terms_[i]->isActive(time) && terms_[i]->isHessianConstant();
+    if (cache.isSummed[i]) {
+      cache.dfdxx += terms_[i]->getQuadraticApproximation(time, state, targetTrajectories, preComp).dfdxx;
+    }
+  }
+}
+
 }  // namespace ocs2
@@ -67,23 +67,101 @@ ScalarFunctionQuadraticApproximation StateInputCostCollection::getQuadraticAppro
                                                                                          const vector_t& input,
                                                                                          const TargetTrajectories& targetTrajectories,
                                                                                          const PreComputation& preComp) const {
-  const auto firstActive = std::find_if(terms_.begin(), terms_.end(),
-                                        [time](const std::unique_ptr<StateInputCost>& costTerm) { return costTerm->isActive(time); });
+  // Count the active terms and the ones among them with a constant Hessian, and check them against the cached sum.
+  const auto& cache = constantHessianCache_;
+  size_t numActiveTerms = 0;
+  size_t numConstantHessians = 0;
+  bool isCacheValid = cache.termsRevision == termsRevision_ && cache.isSummed.size() == terms_.size();
+  for (size_t i = 0; i < terms_.size(); ++i) {
+    const bool isActive = terms_[i]->isActive(time);
+    const bool isConstantHessian = isActive && terms_[i]->isHessianConstant();
+    numActiveTerms += isActive ? 1 : 0;
+    numConstantHessians += isConstantHessian ? 1 : 0;
+    isCacheValid = isCacheValid && cache.isSummed[i] == isConstantHessian;
+  }
 
   // No active terms (or terms is empty).
-  if (firstActive == terms_.end()) {
+  if (numActiveTerms == 0) {
     return ScalarFunctionQuadraticApproximation::Zero(state.rows(), input.rows());
   }
 
-  // Initialize with first active term, accumulate potentially other active terms.
-  auto cost = (*firstActive)->getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
-  std::for_each(std::next(firstActive), terms_.end(), [&](const std::unique_ptr<StateInputCost>& costTerm) {
-    if (costTerm->isActive(time)) {
-      cost += costTerm->getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+  ScalarFunctionQuadraticApproximation cost;
+  if (numConstantHessians > 0 && numActiveTerms > 1) {
+    // Initialize with the cached Hessians, such that the terms with constant Hessian only add their gradients.
+    if (!isCacheValid || cache.dfdxx.rows() != state.rows() || cache.dfduu.rows() != input.rows()) {
+      updateConstantHessianCache(time, state, input, targetTrajectories, preComp);
+    }
+    cost.dfdxx = cache.dfdxx;
+    cost.dfdux = cache.dfdux;
+    cost.dfduu = cache.dfduu;
+    cost.dfdx.setZero(state.rows());
+    cost.dfdu.setZero(input.rows());
+    cost.f = 0.0;
+    for (size_t i = 0; i < terms_.size(); ++i) {
+      if (cache.isSummed[i]) {
+        const auto costTermApproximation = terms_[i]->getLinearApproximation(time, state, input, targetTrajectories, preComp);
+        cost.f += costTermApproximation.f;
+        cost.dfdx += costTermApproximation.dfdx;
+        cost.dfdu += costTermApproximation.dfdu;
+      } else if (terms_[i]->isActive(time)) {
+        cost += terms_[i]->getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+      }
     }
-  });
+
+  } else {
+    // Initialize with first active term, accumulate potentially other active terms.
+    const auto firstActive = std::find_if(terms_.begin(), terms_.end(),
+                                          [time](const std::unique_ptr<StateInputCost>& costTerm) { return costTerm->isActive(time); });
+    cost = (*firstActive)->getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+    std::for_each(std::next(firstActive), terms_.end(), [&](const std::unique_ptr<StateInputCost>& costTerm) {
+      if (costTerm->isActive(time)) {
+        cost += costTerm->getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+      }
+    });
+  }
 
   return cost;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputCostCollection::setHessianApproximation(const hessian_approximation::Settings& settings) {
+  for (auto& costTerm : terms_) {
+    costTerm->setHessianApproximation(settings);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputCostCollection::setHessianApproximationNode(size_t node) {
+  for (auto& costTerm : terms_) {
+    costTerm->setHessianApproximationNode(node);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputCostCollection::updateConstantHessianCache(scalar_t time, const vector_t& state, const vector_t& input,
+                                                          const TargetTrajectories& targetTrajectories,
+                                                          const PreComputation& preComp) const {
+  auto& cache = constantHessianCache_;
+  cache.termsRevision = termsRevision_;
+  cache.isSummed.resize(terms_.size());
+  cache.dfdxx.setZero(state.rows(), state.rows());
+  cache.dfdux.setZero(input.rows(), state.rows());
+  cache.dfduu.setZero(input.rows(), input.rows());
+  for (size_t i = 0; i < terms_.size(); ++i) {
+    cache.isSummed[i] = terms_[i]->isActive(time) && terms_[i]->isHessianConstant();
+    if (cache.isSummed[i]) {
+      const auto costTermApproximation = terms_[i]->getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+      cache.dfdxx += costTermApproximation.dfdxx;
+      cache.dfdux += costTermApproximation.dfdux;
+      cache.dfduu += costTermApproximation.dfduu;
+    }
+  }
+}
+
 }  // namespace ocs2
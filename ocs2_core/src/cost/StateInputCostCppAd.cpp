@@ -57,7 +57,21 @@ void StateInputCostCppAd::initialize(size_t stateDim, size_t inputDim, size_t pa
 /******************************************************************************************************/
 /******************************************************************************************************/
 StateInputCostCppAd::StateInputCostCppAd(const StateInputCostCppAd& rhs)
-    : StateInputCost(rhs), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)) {}
+    : StateInputCost(rhs),
+      adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)),
+      hessianApproximationPtr_(rhs.hessianApproximationPtr_),
+      hessianApproximationNode_(rhs.hessianApproximationNode_) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputCostCppAd::setHessianApproximation(const hessian_approximation::Settings& settings) {
+  if (settings.strategy == hessian_approximation::Strategy::EXACT) {
+    hessianApproximationPtr_.reset();
+  } else {
+    hessianApproximationPtr_ = std::make_shared<HessianApproximation>(settings);
+  }
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -90,11 +104,42 @@ ScalarFunctionQuadraticApproximation StateInputCostCppAd::getQuadraticApproximat
   cost.dfdx = J.middleCols(1, stateDim).transpose();
   cost.dfdu = J.rightCols(inputDim).transpose();
 
+  if (hessianApproximationPtr_ != nullptr && hessianApproximationPtr_->approximate(hessianApproximationNode_, state, input, cost)) {
+    return cost;
+  }
+
   const matrix_t H = adInterfacePtr_->getHessian(0, tapedTimeStateInput, params);
   cost.dfdxx = H.block(1, 1, stateDim, stateDim);
   cost.dfdux = H.block(1 + stateDim, 1, inputDim, stateDim);
   cost.dfduu = H.bottomRightCorner(inputDim, inputDim);
 
+  if (hessianApproximationPtr_ != nullptr) {
+    hessianApproximationPtr_->setExactApproximation(hessianApproximationNode_, state, input, cost);
+  }
+
+  return cost;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionLinearApproximation StateInputCostCppAd::getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                              const TargetTrajectories& targetTrajectories,
+                                                                              const PreComputation& preComputation) const {
+  ScalarFunctionLinearApproximation cost;
+
+  const size_t stateDim = state.rows();
+  const size_t inputDim = input.rows();
+  const vector_t params = getParameters(time, targetTrajectories, preComputation);
+  vector_t tapedTimeStateInput(1 + stateDim + inputDim);
+  tapedTimeStateInput << time, state, input;
+
+  cost.f = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params)(0);
+
+  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeStateInput, params);
+  cost.dfdx = J.middleCols(1, stateDim).transpose();
+  cost.dfdu = J.rightCols(inputDim).transpose();
+
   return cost;
 }
 
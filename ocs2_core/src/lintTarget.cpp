@@ -23,6 +23,7 @@
 #include <ocs2_core/control/StateBasedLinearController.h>
 
 // Cost
+#include <ocs2_core/cost/HessianApproximation.h>
 #include <ocs2_core/cost/QuadraticStateCost.h>
 #include <ocs2_core/cost/QuadraticStateInputCost.h>
 #include <ocs2_core/cost/StateCost.h>
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/constraint/LinearStateInputConstraint.h>
 #include <ocs2_core/constraint/StateConstraintCollection.h>
 #include <ocs2_core/constraint/StateInputConstraintCollection.h>
 #include "testConstraints.h"
@@ -181,6 +182,52 @@ TEST(TestConstraintCollection, getLinearApproximation) {
   EXPECT_EQ(linearApproximation.dfdu.row(3).sum(), 2);
 }
 
+TEST(TestConstraintCollection, getLinearApproximationWithConstantJacobian) {
+  using collection_t = ocs2::StateInputConstraintCollection;
+  collection_t constraintCollection;
+
+  // evaluation point
+  const double t = 0.0;
+  const ocs2::vector_t x = ocs2::vector_t::Random(3);
+  const ocs2::vector_t u = ocs2::vector_t::Random(2);
+
+  // Linear term with constant Jacobians between two dummy terms
+  const ocs2::vector_t e = ocs2::vector_t::Random(3);
+  const ocs2::matrix_t C = ocs2::matrix_t::Random(3, 3);
+  const ocs2::matrix_t D = ocs2::matrix_t::Random(3, 2);
+  constraintCollection.add("Constraint1", std::make_unique<TestDummyConstraint>());
+  constraintCollection.add("Linear", std::make_unique<ocs2::LinearStateInputConstraint>(e, C, D));
+  constraintCollection.add("Constraint2", std::make_unique<TestDummyConstraint>());
+
+  const auto checkLinearApproximation = [&](size_t rowOffset) {
+    const auto linearApproximation = constraintCollection.getLinearApproximation(t, x, u, ocs2::PreComputation());
+    ASSERT_EQ(linearApproximation.f.size(), constraintCollection.getNumConstraints(t));
+    EXPECT_TRUE(linearApproximation.f.segment(rowOffset, 3).isApprox(C * x + D * u + e));
+    EXPECT_TRUE(linearApproximation.dfdx.middleRows(rowOffset, 3).isApprox(C));
+    EXPECT_TRUE(linearApproximation.dfdu.middleRows(rowOffset, 3).isApprox(D));
+    // The last dummy term
+    const size_t last = linearApproximation.f.size() - 2;
+    EXPECT_EQ(linearApproximation.f(last + 1), 2.0);
+    EXPECT_EQ(linearApproximation.dfdx.row(last).sum(), 0);
+    EXPECT_EQ(linearApproximation.dfdx.row(last + 1).sum(), 3);
+    EXPECT_EQ(linearApproximation.dfdu.row(last + 1).sum(), 2);
+  };
+
+  // Evaluate twice to use the cached Jacobians
+  checkLinearApproximation(2);
+  checkLinearApproximation(2);
+
+  // Changing the active terms moves the rows of the linear term
+  constraintCollection.get<TestDummyConstraint>("Constraint1").setActivity(false);
+  checkLinearApproximation(0);
+  constraintCollection.get<TestDummyConstraint>("Constraint1").setActivity(true);
+  checkLinearApproximation(2);
+
+  // Adding a term in front invalidates the cache
+  constraintCollection.erase("Constraint1");
+  checkLinearApproximation(0);
+}
+
 TEST(TestConstraintCollection, getQuadraticApproximation) {
   using collection_t = ocs2::StateInputConstraintCollection;
   collection_t constraintCollection;
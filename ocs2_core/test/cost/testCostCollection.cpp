@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/cost/QuadraticStateCost.h>
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
 #include <ocs2_core/cost/StateCostCollection.h>
 #include <ocs2_core/cost/StateInputCostCollection.h>
 
@@ -154,6 +156,50 @@ TEST_F(StateInputCost_TestFixture, canClone) {
   EXPECT_NEAR(cost, expectedCost, 1e-6);
 }
 
+TEST_F(StateInputCost_TestFixture, constantHessian) {
+  const ocs2::matrix_t Q = 2.0 * ocs2::matrix_t::Identity(STATE_DIM, STATE_DIM);
+  const ocs2::matrix_t R = 3.0 * ocs2::matrix_t::Identity(INPUT_DIM, INPUT_DIM);
+  const ocs2::matrix_t P = ocs2::matrix_t::Ones(INPUT_DIM, STATE_DIM);
+  targetTrajectories = ocs2::TargetTrajectories({0.0}, {ocs2::vector_t::Random(STATE_DIM)}, {ocs2::vector_t::Random(INPUT_DIM)});
+
+  auto quadraticCost = std::make_unique<ocs2::QuadraticStateInputCost>(Q, R, P);
+  ASSERT_TRUE(quadraticCost->isHessianConstant());
+  const auto quadraticCostApproximation = quadraticCost->getQuadraticApproximation(t, x, u, targetTrajectories, {});
+  const auto quadraticCostLinearApproximation = quadraticCost->getLinearApproximation(t, x, u, targetTrajectories, {});
+  EXPECT_NEAR(quadraticCostLinearApproximation.f, quadraticCostApproximation.f, 1e-12);
+  EXPECT_TRUE(quadraticCostLinearApproximation.dfdx.isApprox(quadraticCostApproximation.dfdx));
+  EXPECT_TRUE(quadraticCostLinearApproximation.dfdu.isApprox(quadraticCostApproximation.dfdu));
+  costCollection.add("Quadratic cost", std::move(quadraticCost));
+
+  const auto checkApproximation = [&](const ocs2::ScalarFunctionQuadraticApproximation& expected) {
+    const auto cost = costCollection.getQuadraticApproximation(t, x, u, targetTrajectories, {});
+    EXPECT_NEAR(cost.f, expected.f, 1e-9);
+    EXPECT_TRUE(cost.dfdx.isApprox(expected.dfdx));
+    EXPECT_TRUE(cost.dfdu.isApprox(expected.dfdu));
+    EXPECT_TRUE(cost.dfdxx.isApprox(expected.dfdxx));
+    EXPECT_TRUE(cost.dfdux.isApprox(expected.dfdux));
+    EXPECT_TRUE(cost.dfduu.isApprox(expected.dfduu));
+  };
+
+  // Evaluate twice to use the cached Hessians
+  auto expected = expectedCostApproximation;
+  expected += quadraticCostApproximation;
+  checkApproximation(expected);
+  checkApproximation(expected);
+
+  // Cost terms without constant Hessians are still fully evaluated
+  auto& cost1 = costCollection.get<SimpleQuadraticCost>("Simple quadratic cost");
+  cost1.active_ = false;
+  expected = costCollection.get("Another simple quadratic cost").getQuadraticApproximation(t, x, u, targetTrajectories, {});
+  expected += quadraticCostApproximation;
+  checkApproximation(expected);
+
+  // Adding a term with constant Hessian invalidates the cache
+  costCollection.add("Another quadratic cost", std::make_unique<ocs2::QuadraticStateInputCost>(Q, R));
+  expected += costCollection.get("Another quadratic cost").getQuadraticApproximation(t, x, u, targetTrajectories, {});
+  checkApproximation(expected);
+}
+
 class SimpleQuadraticFinalCost final : public ocs2::StateCost {
  public:
   SimpleQuadraticFinalCost(ocs2::matrix_t Q) : Q_(std::move(Q)) {}
@@ -220,3 +266,23 @@ TEST_F(StateCost_TestFixture, testStateCostApproximation) {
   EXPECT_TRUE(cost.dfdx.isApprox(expectedCostApproximation.dfdx));
   EXPECT_TRUE(cost.dfdxx.isApprox(expectedCostApproximation.dfdxx));
 }
+
+TEST_F(StateCost_TestFixture, constantHessian) {
+  const ocs2::matrix_t Q = 2.0 * ocs2::matrix_t::Identity(STATE_DIM, STATE_DIM);
+  targetTrajectories = ocs2::TargetTrajectories({0.0}, {ocs2::vector_t::Random(STATE_DIM)}, {ocs2::vector_t::Zero(INPUT_DIM)});
+  auto quadraticCost = std::make_unique<ocs2::QuadraticStateCost>(Q);
+  ASSERT_TRUE(quadraticCost->isHessianConstant());
+  auto expected = quadraticCost->getQuadraticApproximation(t, x, targetTrajectories, {});
+  expected.f += expectedCost;
+  expected.dfdx += expectedCostApproximation.dfdx;
+  expected.dfdxx += expectedCostApproximation.dfdxx;
+  costCollection.add("Quadratic cost", std::move(quadraticCost));
+
+  for (int i = 0; i < 2; ++i) {
+    const auto cost = costCollection.getQuadraticApproximation(t, x, targetTrajectories, {});
+    EXPECT_NEAR(cost.f, expected.f, 1e-9);
+    EXPECT_TRUE(cost.dfdx.isApprox(expected.dfdx));
+    EXPECT_TRUE(cost.dfdxx.isApprox(expected.dfdxx));
+    EXPECT_EQ(cost.dfdu.size(), 0);
+  }
+}
@@ -159,3 +159,110 @@ TEST(TestGNStateInputCostCppAd, getValue) {
   ASSERT_DOUBLE_EQ(approx.dfdux(0, 1), 0.0);
   ASSERT_DOUBLE_EQ(approx.dfduu(0, 0), (t * t + 1.0));
 }
+
+class TestQuarticStateInputCost : public ocs2::StateInputCostCppAd {
+ public:
+  TestQuarticStateInputCost() { initialize(2, 1, 0, "TestQuarticStateInputCost", "/tmp/ocs2", true, false); }
+  ~TestQuarticStateInputCost() override = default;
+  TestQuarticStateInputCost* clone() const override { return new TestQuarticStateInputCost(*this); }
+
+  // cost = 0.25 * (x(0)^4 + x(1)^4 + u(0)^4) + 0.5 * (x(0) + u(0))^2
+  ocs2::ad_scalar_t costFunction(ocs2::ad_scalar_t time, const ocs2::ad_vector_t& state, const ocs2::ad_vector_t& input,
+                                 const ocs2::ad_vector_t& parameters) const override {
+    const ocs2::ad_scalar_t quartic = state.array().square().square().sum() + input.array().square().square().sum();
+    const ocs2::ad_scalar_t mixed = state(0) + input(0);
+    return ocs2::ad_scalar_t(0.25) * quartic + ocs2::ad_scalar_t(0.5) * mixed * mixed;
+  }
+
+ private:
+  TestQuarticStateInputCost(const TestQuarticStateInputCost& other) = default;
+};
+
+TEST(TestStateInputCostCppAd, hessianReuse) {
+  TestQuarticStateInputCost cost;
+  ocs2::hessian_approximation::Settings settings;
+  settings.strategy = ocs2::hessian_approximation::Strategy::REUSE;
+  settings.refreshPeriod = 4;
+  cost.setHessianApproximation(settings);
+  TestQuarticStateInputCost exactCost;
+  const ocs2::TargetTrajectories desiredTrajectory;
+
+  const ocs2::scalar_t t = 0.1;
+  const ocs2::vector_t x0 = (ocs2::vector_t(2) << 0.1, 0.2).finished();
+  const ocs2::vector_t x1 = (ocs2::vector_t(2) << 0.5, -0.4).finished();
+  const ocs2::vector_t u = (ocs2::vector_t(1) << 0.3).finished();
+  const auto exact = exactCost.getQuadraticApproximation(t, x1, u, desiredTrajectory, ocs2::PreComputation());
+
+  // Without a selected node the Hessian is exact
+  const auto noNode = cost.getQuadraticApproximation(t, x1, u, desiredTrajectory, ocs2::PreComputation());
+  EXPECT_TRUE(noNode.dfdxx.isApprox(exact.dfdxx));
+
+  cost.setHessianApproximationNode(0);
+  const auto first = cost.getQuadraticApproximation(t, x0, u, desiredTrajectory, ocs2::PreComputation());
+  EXPECT_TRUE(first.dfdxx.isApprox(exactCost.getQuadraticApproximation(t, x0, u, desiredTrajectory, ocs2::PreComputation()).dfdxx));
+
+  // The second evaluation of the node refreshes the value and gradient only
+  const auto second = cost.getQuadraticApproximation(t, x1, u, desiredTrajectory, ocs2::PreComputation());
+  EXPECT_DOUBLE_EQ(second.f, exact.f);
+  EXPECT_TRUE(second.dfdx.isApprox(exact.dfdx));
+  EXPECT_TRUE(second.dfdu.isApprox(exact.dfdu));
+  EXPECT_TRUE(second.dfdxx.isApprox(first.dfdxx));
+  EXPECT_TRUE(second.dfdux.isApprox(first.dfdux));
+  EXPECT_TRUE(second.dfduu.isApprox(first.dfduu));
+  EXPECT_FALSE(second.dfdxx.isApprox(exact.dfdxx));
+
+  // Another node is evaluated exactly
+  cost.setHessianApproximationNode(1);
+  const auto otherNode = cost.getQuadraticApproximation(t + 0.1, x1, u, desiredTrajectory, ocs2::PreComputation());
+  EXPECT_TRUE(otherNode.dfdxx.isApprox(exact.dfdxx));
+
+  // A clone shares the nodes, and a node keeps its Hessian when the time of the node shifts as in MPC
+  std::unique_ptr<TestQuarticStateInputCost> clonedCost(cost.clone());
+  clonedCost->setHessianApproximationNode(0);
+  const auto shiftedNode = clonedCost->getQuadraticApproximation(t + 0.05, x1, u, desiredTrajectory, ocs2::PreComputation());
+  EXPECT_TRUE(shiftedNode.dfdxx.isApprox(first.dfdxx));
+
+  // The fourth evaluation of the node still reuses the Hessian, the fifth one refreshes it
+  cost.setHessianApproximationNode(0);
+  const auto fourth = cost.getQuadraticApproximation(t, x1, u, desiredTrajectory, ocs2::PreComputation());
+  EXPECT_TRUE(fourth.dfdxx.isApprox(first.dfdxx));
+  const auto fifth = cost.getQuadraticApproximation(t, x1, u, desiredTrajectory, ocs2::PreComputation());
+  EXPECT_TRUE(fifth.dfdxx.isApprox(exact.dfdxx));
+  EXPECT_TRUE(fifth.dfduu.isApprox(exact.dfduu));
+
+  // Nodes beyond maxNumNodes are always evaluated exactly
+  cost.setHessianApproximationNode(settings.maxNumNodes);
+  cost.getQuadraticApproximation(t, x0, u, desiredTrajectory, ocs2::PreComputation());
+  const auto beyond = cost.getQuadraticApproximation(t, x1, u, desiredTrajectory, ocs2::PreComputation());
+  EXPECT_TRUE(beyond.dfdxx.isApprox(exact.dfdxx));
+}
+
+TEST(TestStateInputCostCppAd, hessianDampedBfgs) {
+  TestQuarticStateInputCost cost;
+  ocs2::hessian_approximation::Settings settings;
+  settings.strategy = ocs2::hessian_approximation::Strategy::DAMPED_BFGS;
+  settings.refreshPeriod = 10;
+  cost.setHessianApproximation(settings);
+  cost.setHessianApproximationNode(0);
+  const ocs2::TargetTrajectories desiredTrajectory;
+
+  const ocs2::scalar_t t = 0.1;
+  const ocs2::vector_t x0 = (ocs2::vector_t(2) << 0.1, 0.2).finished();
+  const ocs2::vector_t u0 = (ocs2::vector_t(1) << 0.3).finished();
+  const ocs2::vector_t x1 = (ocs2::vector_t(2) << 0.4, 0.5).finished();
+  const ocs2::vector_t u1 = (ocs2::vector_t(1) << 0.6).finished();
+
+  const auto first = cost.getQuadraticApproximation(t, x0, u0, desiredTrajectory, ocs2::PreComputation());
+  const auto second = cost.getQuadraticApproximation(t, x1, u1, desiredTrajectory, ocs2::PreComputation());
+
+  // The curvature increases along the step, so the update is undamped and satisfies the secant condition B * s = y
+  ocs2::matrix_t B(3, 3);
+  B << second.dfdxx, second.dfdux.transpose(), second.dfdux, second.dfduu;
+  ocs2::vector_t s(3);
+  s << x1 - x0, u1 - u0;
+  ocs2::vector_t y(3);
+  y << second.dfdx - first.dfdx, second.dfdu - first.dfdu;
+  EXPECT_TRUE(B.isApprox(B.transpose()));
+  EXPECT_TRUE((B * s).isApprox(y));
+  EXPECT_GT(Eigen::SelfAdjointEigenSolver<ocs2::matrix_t>(B).eigenvalues().minCoeff(), 0.0);
+}
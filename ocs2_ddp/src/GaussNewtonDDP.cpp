@@ -1069,7 +1069,7 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
         !initialSolutionExists, *std::prev(performanceIndexHistory_.end(), 2), performanceIndexHistory_.back());
     initialSolutionExists = true;
 
-    if (isConverged || (totalNumIterations_ - initIteration) == ddpSettings_.maxNumIterations_) {
+    if (isConverged || (totalNumIterations_ - initIteration) == ddpSettings_.maxNumIterations_ || isTerminationRequested()) {
       break;
 
     } else {
@@ -1100,6 +1100,9 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
     } else if (totalNumIterations_ - initIteration == ddpSettings_.maxNumIterations_) {
       std::cerr << "The algorithm has terminated as: \n";
       std::cerr << "    * The maximum number of iterations (i.e., " << ddpSettings_.maxNumIterations_ << ") has reached." << std::endl;
+    } else if (isTerminationRequested()) {
+      std::cerr << "The algorithm has terminated as: \n";
+      std::cerr << "    * The termination was requested." << std::endl;
     } else {
       std::cerr << "The algorithm has terminated for an unknown reason!" << std::endl;
     }
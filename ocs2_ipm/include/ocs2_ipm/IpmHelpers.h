@@ -51,6 +51,19 @@ namespace ipm {
 void condenseIneqConstraints(scalar_t barrierParam, const vector_t& slack, const vector_t& dual,
                              const VectorFunctionLinearApproximation& ineqConstraints, ScalarFunctionQuadraticApproximation& lagrangian);
 
+/**
+ * Updates the linear terms of a Lagrangian condensed by condenseIneqConstraints() when the target of the perturbed complementary
+ * slackness is shifted from slack .* dual = barrierParam to slack .* dual = barrierParam + targetShift. The quadratic terms do not
+ * depend on this target, therefore the QP keeps the same Hessian and its factorization can be reused.
+ *
+ * @param[in] targetShift : The element-wise shift of the complementary slackness target.
+ * @param[in] slack : The slack variable associated with the inequality constraints.
+ * @param[in] ineqConstraints : Linear approximation of the inequality constraints.
+ * @param[in, out] lagrangian : Quadratic approximation of the condensed Lagrangian.
+ */
+void shiftComplementarityTarget(const vector_t& targetShift, const vector_t& slack, const VectorFunctionLinearApproximation& ineqConstraints,
+                                ScalarFunctionQuadraticApproximation& lagrangian);
+
 /**
  * Computes the SSE of the residual in the perturbed complementary slackness.
  *
@@ -99,6 +112,39 @@ vector_t retrieveSlackDirection(const VectorFunctionLinearApproximation& stateIn
  */
 vector_t retrieveDualDirection(scalar_t barrierParam, const vector_t& slack, const vector_t& dual, const vector_t& slackDirection);
 
+/**
+ * Retrieves the Newton directions of the dual variable for an element-wise target of the perturbed complementary slackness, i.e.,
+ * slack .* dual = complementarityTarget. This is used by the corrector step of the Mehrotra predictor-corrector method.
+ *
+ * @param[in] complementarityTarget : The target of the perturbed complementary slackness.
+ * @param[in] slack : The slack variable associated with the inequality constraints.
+ * @param[in] dual : The dual variable associated with the inequality constraints.
+ * @param[in] slackDirection : The Newton direction of the slack variable.
+ * @return Newton directions of the dual variable.
+ */
+vector_t retrieveDualDirection(const vector_t& complementarityTarget, const vector_t& slack, const vector_t& dual,
+                               const vector_t& slackDirection);
+
+/**
+ * Computes the sum of the complementarity products after taking the given steps, i.e., (slack + a_p * ds)' * (dual + a_d * ddual).
+ * This is used to measure the progress of the affine-scaling (predictor) step of the Mehrotra predictor-corrector method.
+ *
+ * @param[in] slack : The slack variable associated with the inequality constraints.
+ * @param[in] dual : The dual variable associated with the inequality constraints.
+ * @param[in] slackDirection : The Newton direction of the slack variable.
+ * @param[in] dualDirection : The Newton direction of the dual variable.
+ * @param[in] primalStepSize : The step size of the slack variable.
+ * @param[in] dualStepSize : The step size of the dual variable.
+ * @return The sum of the complementarity products.
+ */
+inline scalar_t complementarityAfterStep(const vector_t& slack, const vector_t& dual, const vector_t& slackDirection,
+                                         const vector_t& dualDirection, scalar_t primalStepSize, scalar_t dualStepSize) {
+  if (slack.size() == 0) {
+    return 0.0;
+  }
+  return (slack + primalStepSize * slackDirection).dot(dual + dualStepSize * dualDirection);
+}
+
 /**
  * Computes the step size via fraction-to-boundary-rule, which is introduced in the IPOPT's implementaion paper,
  * "On the implementation of an interior-point filter line-search algorithm for large-scale nonlinear programming"
@@ -34,9 +34,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
+#include <ocs2_oc/multiple_shooting/IncrementalLinearization.h>
 #include <ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h>
 #include <ocs2_oc/multiple_shooting/Transcription.h>
 #include <ocs2_oc/oc_data/TimeDiscretization.h>
+#include <ocs2_oc/oc_problem/LqSubproblemRecorder.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/oc_solver/SolverBase.h>
 #include <ocs2_oc/search_strategy/FilterLinesearch.h>
@@ -73,6 +75,9 @@ class IpmSolver : public SolverBase {
 
   size_t getNumIterations() const override { return totalNumIterations_; }
 
+  /** Returns the number of nodes that kept the LQ approximation of an earlier iteration, see incrementalLinearizationRefreshPeriod. */
+  size_t getNumSkippedLinearizations() const { return totalNumSkippedLinearizations_; }
+
   const OptimalControlProblem& getOptimalControlProblem() const override { return ocpDefinitions_.front(); }
 
   const PerformanceIndex& getPerformanceIndeces() const override { return getIterationsLog().back(); };
@@ -134,7 +139,7 @@ class IpmSolver : public SolverBase {
                                             const vector_array_t& u, const vector_array_t& lmd, const vector_array_t& nu,
                                             scalar_t barrierParam, const vector_array_t& slackStateIneq,
                                             const vector_array_t& slackStateInputIneq, const vector_array_t& dualStateIneq,
-                                            const vector_array_t& dualStateInputIneq, std::vector<Metrics>& metrics);
+                                            const vector_array_t& dualStateInputIneq);
 
   /** Computes only the performance metrics at the current {t, x(t), u(t)} */
   PerformanceIndex computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
@@ -154,11 +159,22 @@ class IpmSolver : public SolverBase {
     scalar_t armijoDescentMetric;  // inner product of the cost gradient and decision variable step
     scalar_t maxPrimalStepSize;
     scalar_t maxDualStepSize;
+    scalar_t centeredBarrierParam;  // sigma * mu_avg of the predictor-corrector method, equal to barrierParam otherwise
   };
   OcpSubproblemSolution getOCPSolution(const vector_t& delta_x0, scalar_t barrierParam, const vector_array_t& slackStateIneq,
                                        const vector_array_t& dualStateIneq, const vector_array_t& slackStateInputIneq,
                                        const vector_array_t& dualStateInputIneq);
 
+  /**
+   * Solves the QP subproblem with the Mehrotra predictor-corrector method. The affine-scaling (predictor) QP is factorized by HPIPM
+   * and the corrector QP, which only differs in the linear terms, is solved with the same factorization.
+   * Returns the element-wise targets of the complementary slackness of the corrector step and the centered barrier parameter.
+   */
+  scalar_t solvePredictorCorrector(const vector_t& delta_x0, scalar_t barrierParam, const vector_array_t& slackStateIneq,
+                                   const vector_array_t& dualStateIneq, const vector_array_t& slackStateInputIneq,
+                                   const vector_array_t& dualStateInputIneq, vector_array_t& deltaXSol, vector_array_t& deltaUSol,
+                                   vector_array_t& stateIneqTarget, vector_array_t& stateInputIneqTarget);
+
   /** Extract the value function based on the last solved QP */
   void extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x, const vector_array_t& lmd,
                             const vector_array_t& deltaXSol);
@@ -173,6 +189,12 @@ class IpmSolver : public SolverBase {
                                vector_array_t& u, scalar_t barrierParam, vector_array_t& slackStateIneq,
                                vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics);
 
+  /** Same as takePrimalStep(), but the backtracking step sizes are evaluated concurrently if the full step is rejected */
+  ipm::StepInfo takeSpeculativePrimalStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
+                                          const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
+                                          vector_array_t& u, scalar_t barrierParam, vector_array_t& slackStateIneq,
+                                          vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics);
+
   /** Updates the Lagrange multipliers */
   void takeDualStep(const OcpSubproblemSolution& subproblemSolution, const ipm::StepInfo& stepInfo, vector_array_t& lmd, vector_array_t& nu,
                     vector_array_t& dualStateIneq, vector_array_t& dualStateInputIneq) const;
@@ -195,6 +217,9 @@ class IpmSolver : public SolverBase {
   // Solver interface
   HpipmInterface hpipmInterface_;
 
+  // Records the QP subproblems passed to HPIPM, nullptr if the recording is disabled
+  std::unique_ptr<LqSubproblemRecorder> lqRecorderPtr_;
+
   // Threading
   ThreadPool threadPool_;
 
@@ -219,6 +244,9 @@ class IpmSolver : public SolverBase {
   // Constraint terms size
   std::vector<multiple_shooting::ConstraintsSize> constraintsSize_;
 
+  // Linearization points and transcriptions of the nodes for the incremental linearization
+  multiple_shooting::IncrementalLinearization incrementalLinearization_;
+
   // Lagrange multipliers
   std::vector<multiple_shooting::ProjectionMultiplierCoefficients> projectionMultiplierCoefficients_;
 
@@ -230,6 +258,8 @@ class IpmSolver : public SolverBase {
 
   // Benchmarking
   size_t totalNumIterations_{0};
+  size_t totalNumLinearizations_{0};
+  size_t totalNumSkippedLinearizations_{0};
   benchmark::RepeatedTimer initializationTimer_;
   benchmark::RepeatedTimer linearQuadraticApproximationTimer_;
   benchmark::RepeatedTimer solveQpTimer_;
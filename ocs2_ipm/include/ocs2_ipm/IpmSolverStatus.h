@@ -39,7 +39,7 @@ namespace ocs2 {
 namespace ipm {
 
 /** Different types of convergence */
-enum class Convergence { FALSE, ITERATIONS, STEPSIZE, METRICS, PRIMAL };
+enum class Convergence { FALSE, ITERATIONS, STEPSIZE, METRICS, PRIMAL, TERMINATED };
 
 /** Struct to contain the result and logging data of the stepsize computation */
 struct StepInfo {
@@ -68,6 +68,8 @@ inline std::string toString(const Convergence& convergence) {
       return "Cost decrease and constraint satisfaction below tolerance";
     case Convergence::PRIMAL:
       return "Primal update below tolerance";
+    case Convergence::TERMINATED:
+      return "Termination requested";
     case Convergence::FALSE:
     default:
       return "Not Converged";
@@ -67,6 +67,19 @@ void condenseIneqConstraints(scalar_t barrierParam, const vector_t& slack, const
   }
 }
 
+void shiftComplementarityTarget(const vector_t& targetShift, const vector_t& slack, const VectorFunctionLinearApproximation& ineqConstraint,
+                                ScalarFunctionQuadraticApproximation& lagrangian) {
+  if (ineqConstraint.f.size() == 0) {
+    return;
+  }
+
+  const vector_t condensingLinearCoeff = targetShift.cwiseQuotient(slack);
+  lagrangian.dfdx.noalias() -= ineqConstraint.dfdx.transpose() * condensingLinearCoeff;
+  if (ineqConstraint.dfdu.cols() > 0) {
+    lagrangian.dfdu.noalias() -= ineqConstraint.dfdu.transpose() * condensingLinearCoeff;
+  }
+}
+
 vector_t retrieveSlackDirection(const VectorFunctionLinearApproximation& stateInputIneqConstraints, const vector_t& dx, const vector_t& du,
                                 scalar_t barrierParam, const vector_t& slackStateInputIneq) {
   assert(barrierParam > 0.0);
@@ -100,6 +113,14 @@ vector_t retrieveDualDirection(scalar_t barrierParam, const vector_t& slack, con
   return dualDirection;
 }
 
+vector_t retrieveDualDirection(const vector_t& complementarityTarget, const vector_t& slack, const vector_t& dual,
+                               const vector_t& slackDirection) {
+  vector_t dualDirection = dual.cwiseProduct(slack + slackDirection);
+  dualDirection -= complementarityTarget;
+  dualDirection.array() /= -slack.array();
+  return dualDirection;
+}
+
 scalar_t fractionToBoundaryStepSize(const vector_t& v, const vector_t& dv, scalar_t marginRate) {
   assert(marginRate > 0.0);
   assert(marginRate <= 1.0);
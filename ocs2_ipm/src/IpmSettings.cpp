@@ -54,24 +54,32 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.deltaTol, fieldName + ".deltaTol", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_decay, fieldName + ".alpha_decay", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_min, fieldName + ".alpha_min", verbose);
+  loadData::loadPtreeValue(pt, settings.speculativeLinesearch, fieldName + ".speculativeLinesearch", verbose);
   loadData::loadPtreeValue(pt, settings.gamma_c, fieldName + ".gamma_c", verbose);
   loadData::loadPtreeValue(pt, settings.g_max, fieldName + ".g_max", verbose);
   loadData::loadPtreeValue(pt, settings.g_min, fieldName + ".g_min", verbose);
   loadData::loadPtreeValue(pt, settings.armijoFactor, fieldName + ".armijoFactor", verbose);
   loadData::loadPtreeValue(pt, settings.costTol, fieldName + ".costTol", verbose);
   loadData::loadPtreeValue(pt, settings.dt, fieldName + ".dt", verbose);
+  loadData::loadPtreeValue(pt, settings.dtGrowthFactor, fieldName + ".dtGrowthFactor", verbose);
+  loadData::loadPtreeValue(pt, settings.dtMax, fieldName + ".dtMax", verbose);
   loadData::loadPtreeValue(pt, settings.useFeedbackPolicy, fieldName + ".useFeedbackPolicy", verbose);
   loadData::loadPtreeValue(pt, settings.createValueFunction, fieldName + ".createValueFunction", verbose);
   loadData::loadPtreeValue(pt, settings.computeLagrangeMultipliers, fieldName + ".computeLagrangeMultipliers", verbose);
   auto integratorName = sensitivity_integrator::toString(settings.integratorType);
   loadData::loadPtreeValue(pt, integratorName, fieldName + ".integratorType", verbose);
   settings.integratorType = sensitivity_integrator::fromString(integratorName);
+  loadData::loadPtreeValue(pt, settings.incrementalLinearizationTol, fieldName + ".incrementalLinearizationTol", verbose);
+  loadData::loadPtreeValue(pt, settings.incrementalLinearizationRefreshPeriod, fieldName + ".incrementalLinearizationRefreshPeriod",
+                           verbose);
   loadData::loadPtreeValue(pt, settings.initialBarrierParameter, fieldName + ".initialBarrierParameter", verbose);
   loadData::loadPtreeValue(pt, settings.targetBarrierParameter, fieldName + ".targetBarrierParameter", verbose);
   loadData::loadPtreeValue(pt, settings.barrierReductionCostTol, fieldName + ".barrierReductionCostTol ", verbose);
   loadData::loadPtreeValue(pt, settings.barrierReductionConstraintTol, fieldName + ".barrierReductionConstraintTol", verbose);
   loadData::loadPtreeValue(pt, settings.barrierLinearDecreaseFactor, fieldName + ".barrierLinearDecreaseFactor", verbose);
   loadData::loadPtreeValue(pt, settings.barrierSuperlinearDecreasePower, fieldName + ".barrierSuperlinearDecreasePower", verbose);
+  loadData::loadPtreeValue(pt, settings.usePredictorCorrector, fieldName + ".usePredictorCorrector", verbose);
+  loadData::loadPtreeValue(pt, settings.centeringParameterPower, fieldName + ".centeringParameterPower", verbose);
   loadData::loadPtreeValue(pt, settings.fractionToBoundaryMargin, fieldName + ".fractionToBoundaryMargin", verbose);
   loadData::loadPtreeValue(pt, settings.usePrimalStepSizeForDual, fieldName + ".usePrimalStepSizeForDual", verbose);
   loadData::loadPtreeValue(pt, settings.initialSlackLowerBound, fieldName + ".initialSlackLowerBound", verbose);
@@ -81,9 +89,14 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.printSolverStatus, fieldName + ".printSolverStatus", verbose);
   loadData::loadPtreeValue(pt, settings.printSolverStatistics, fieldName + ".printSolverStatistics", verbose);
   loadData::loadPtreeValue(pt, settings.printLinesearch, fieldName + ".printLinesearch", verbose);
+  loadData::loadPtreeValue(pt, settings.lqRecordingFile, fieldName + ".lqRecordingFile", verbose);
+  loadData::loadPtreeValue(pt, settings.lqRecordingPeriod, fieldName + ".lqRecordingPeriod", verbose);
   loadData::loadPtreeValue(pt, settings.nThreads, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority, fieldName + ".threadPriority", verbose);
 
+  if (settings.dtGrowthFactor < 1.0) {
+    throw std::invalid_argument("[MultipleShootingIpmSettings] dtGrowthFactor must be at least 1.0!");
+  }
   if (settings.initialSlackLowerBound <= 0.0) {
     throw std::runtime_error("[MultipleShootingIpmSettings] initialSlackLowerBound must be positive!");
   }
@@ -96,6 +109,9 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   if (settings.initialDualMarginRate < 0.0) {
     throw std::runtime_error("[MultipleShootingIpmSettings] initialDualMarginRate must be non-negative!");
   }
+  if (settings.centeringParameterPower <= 0.0) {
+    throw std::runtime_error("[MultipleShootingIpmSettings] centeringParameterPower must be positive!");
+  }
   if (settings.fractionToBoundaryMargin <= 0.0 || settings.fractionToBoundaryMargin > 1.0) {
     throw std::runtime_error("[MultipleShootingIpmSettings] fractionToBoundaryMargin must be positive and no more than 1.0!");
   }
@@ -105,6 +121,8 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
     std::cerr << " #### =============================================================================" << std::endl;
   }
 
+  settings.hessianApproximation = hessian_approximation::loadSettings(filename, fieldName + ".hessianApproximation", verbose);
+
   return settings;
 }
 }  // namespace ipm
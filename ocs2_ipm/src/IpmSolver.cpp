@@ -40,6 +40,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_oc/multiple_shooting/MetricsComputation.h>
 #include <ocs2_oc/multiple_shooting/PerformanceIndexComputation.h>
 #include <ocs2_oc/oc_problem/OcpSize.h>
+#include <ocs2_oc/search_strategy/SpeculativeLinesearch.h>
 #include <ocs2_oc/trajectory_adjustment/TrajectorySpreadingHelperFunctions.h>
 
 #include "ocs2_ipm/IpmHelpers.h"
@@ -58,6 +59,7 @@ ipm::Settings rectifySettings(const OptimalControlProblem& ocp, ipm::Settings&&
   if (ocp.inequalityConstraintPtr->empty() && ocp.stateInequalityConstraintPtr->empty() && ocp.preJumpInequalityConstraintPtr->empty() &&
       ocp.finalInequalityConstraintPtr->empty()) {
     settings.targetBarrierParameter = settings.initialBarrierParameter;
+    settings.usePredictorCorrector = false;
   }
   return settings;
 }
@@ -66,7 +68,8 @@ ipm::Settings rectifySettings(const OptimalControlProblem& ocp, ipm::Settings&&
 IpmSolver::IpmSolver(ipm::Settings settings, const OptimalControlProblem& optimalControlProblem, const Initializer& initializer)
     : settings_(rectifySettings(optimalControlProblem, std::move(settings))),
       hpipmInterface_(OcpSize(), settings_.hpipmSettings),
-      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority) {
+      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority),
+      incrementalLinearization_(settings_.incrementalLinearizationTol, settings_.incrementalLinearizationRefreshPeriod) {
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
 
@@ -75,13 +78,24 @@ IpmSolver::IpmSolver(ipm::Settings settings, const OptimalControlProblem& optima
   sensitivityDiscretizer_ = selectDynamicsSensitivityDiscretization(settings_.integratorType);
 
   // Clone objects to have one for each worker
-  for (int w = 0; w < settings_.nThreads; w++) {
-    ocpDefinitions_.push_back(optimalControlProblem);
+  ocpDefinitions_.push_back(optimalControlProblem);
+  if (settings_.hessianApproximation.strategy != hessian_approximation::Strategy::EXACT) {
+    // Set before cloning, such that all clones share the approximation of the nodes
+    ocpDefinitions_.front().costPtr->setHessianApproximation(settings_.hessianApproximation);
+    ocpDefinitions_.front().softConstraintPtr->setHessianApproximation(settings_.hessianApproximation);
+  }
+  for (int w = 1; w < settings_.nThreads; w++) {
+    ocpDefinitions_.push_back(ocpDefinitions_.front());
   }
 
   // Operating points
   initializerPtr_.reset(initializer.clone());
 
+  // QP subproblem recording
+  if (!settings_.lqRecordingFile.empty()) {
+    lqRecorderPtr_.reset(new LqSubproblemRecorder(settings_.lqRecordingFile, settings_.lqRecordingPeriod));
+  }
+
   // Linesearch
   filterLinesearch_.g_max = settings_.g_max;
   filterLinesearch_.g_min = settings_.g_min;
@@ -104,9 +118,12 @@ void IpmSolver::reset() {
   dualIneqTrajectory_.clear();
   valueFunction_.clear();
   performanceIndeces_.clear();
+  incrementalLinearization_.reset();
 
   // reset timers
   totalNumIterations_ = 0;
+  totalNumLinearizations_ = 0;
+  totalNumSkippedLinearizations_ = 0;
   initializationTimer_.reset();
   linearQuadraticApproximationTimer_.reset();
   solveQpTimer_.reset();
@@ -134,6 +151,11 @@ std::string IpmSolver::getBenchmarkingInformation() const {
                << initializationTotal / benchmarkTotal * inPercent << "%)\n";
     infoStream << "\tLQ Approximation   :\t" << linearQuadraticApproximationTimer_.getAverageInMilliseconds() << " [ms] \t\t("
                << linearQuadraticApproximationTotal / benchmarkTotal * inPercent << "%)\n";
+    if (settings_.incrementalLinearizationRefreshPeriod > 1) {
+      infoStream << "\tSkipped nodes      :\t" << totalNumSkippedLinearizations_ << " of " << totalNumLinearizations_ << " \t\t("
+                 << static_cast<scalar_t>(totalNumSkippedLinearizations_) / std::max(totalNumLinearizations_, size_t(1)) * inPercent
+                 << "%)\n";
+    }
     infoStream << "\tSolve QP           :\t" << solveQpTimer_.getAverageInMilliseconds() << " [ms] \t\t("
                << solveQpTotal / benchmarkTotal * inPercent << "%)\n";
     infoStream << "\tLinesearch         :\t" << linesearchTimer_.getAverageInMilliseconds() << " [ms] \t\t("
@@ -209,7 +231,8 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
 
   // Determine time discretization, taking into account event times.
   const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
-  const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
+  const auto timeDiscretization =
+      gradedTimeDiscretizationWithEvents(initTime, finalTime, settings_.dt, settings_.dtGrowthFactor, settings_.dtMax, eventTimes);
 
   // Initialize references
   for (auto& ocpDefinition : ocpDefinitions_) {
@@ -247,7 +270,7 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   }
   initializationTimer_.endTimer();
 
-  // Bookkeeping
+  // Bookkeeping. The metrics are those of the last accepted step, i.e., of the current x and u.
   performanceIndeces_.clear();
   std::vector<Metrics> metrics;
 
@@ -261,7 +284,7 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     // Make QP approximation
     linearQuadraticApproximationTimer_.startTimer();
     const auto baselinePerformance = setupQuadraticSubproblem(timeDiscretization, initState, x, u, lmd, nu, barrierParam, slackStateIneq,
-                                                              slackStateInputIneq, dualStateIneq, dualStateInputIneq, metrics);
+                                                              slackStateInputIneq, dualStateIneq, dualStateInputIneq);
     linearQuadraticApproximationTimer_.endTimer();
 
     // Solve QP
@@ -287,7 +310,11 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     convergence = checkConvergence(iter, barrierParam, baselinePerformance, stepInfo);
 
     // Update the barrier parameter
-    barrierParam = updateBarrierParameter(barrierParam, baselinePerformance, stepInfo);
+    if (settings_.usePredictorCorrector) {
+      barrierParam = std::min(barrierParam, deltaSolution.centeredBarrierParam);
+    } else {
+      barrierParam = updateBarrierParameter(barrierParam, baselinePerformance, stepInfo);
+    }
 
     // Next iteration
     ++iter;
@@ -295,12 +322,18 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   }
 
   computeControllerTimer_.startTimer();
+  problemMetrics_ = ProblemMetrics();
+  if (isSolutionMetricsRequired()) {
+    if (metrics.empty()) {  // No step was accepted
+      computePerformance(timeDiscretization, initState, x, u, barrierParam, slackStateIneq, slackStateInputIneq, metrics);
+    }
+    problemMetrics_ = multiple_shooting::toProblemMetrics(timeDiscretization, std::move(metrics));
+  }
   primalSolution_ = toPrimalSolution(timeDiscretization, std::move(x), std::move(u));
   costateTrajectory_ = std::move(lmd);
   projectionMultiplierTrajectory_ = std::move(nu);
   slackIneqTrajectory_ = ipm::toDualSolution(timeDiscretization, constraintsSize_, slackStateIneq, slackStateInputIneq);
   dualIneqTrajectory_ = ipm::toDualSolution(timeDiscretization, constraintsSize_, dualStateIneq, dualStateInputIneq);
-  problemMetrics_ = multiple_shooting::toProblemMetrics(timeDiscretization, std::move(metrics));
   computeControllerTimer_.endTimer();
 
   if (settings_.printSolverStatus || settings_.printLinesearch) {
@@ -475,22 +508,36 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
   OcpSubproblemSolution solution;
   auto& deltaXSol = solution.deltaXSol;
   auto& deltaUSol = solution.deltaUSol;
-  hpipm_status status;
   hpipmInterface_.resize(extractSizesFromProblem(dynamics_, lagrangian_, nullptr));
-  status = hpipmInterface_.solve(delta_x0, dynamics_, lagrangian_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
+  if (lqRecorderPtr_ != nullptr) {
+    // The condensed QP at the current barrier parameter, i.e., before the predictor-corrector shifts its linear terms
+    lqRecorderPtr_->record(delta_x0, dynamics_, lagrangian_, nullptr);
+  }
 
-  if (status != hpipm_status::SUCCESS) {
-    throw std::runtime_error("[IpmSolver] Failed to solve QP");
+  // Element-wise targets of the perturbed complementary slackness. Only used by the predictor-corrector method.
+  vector_array_t stateIneqTarget, stateInputIneqTarget;
+  if (settings_.usePredictorCorrector) {
+    solution.centeredBarrierParam =
+        solvePredictorCorrector(delta_x0, barrierParam, slackStateIneq, dualStateIneq, slackStateInputIneq, dualStateInputIneq, deltaXSol,
+                                deltaUSol, stateIneqTarget, stateInputIneqTarget);
+  } else {
+    const auto status =
+        hpipmInterface_.solve(delta_x0, dynamics_, lagrangian_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
+    if (status != hpipm_status::SUCCESS) {
+      throw std::runtime_error("[IpmSolver] Failed to solve QP");
+    }
+
+    // Extract value function
+    if (settings_.createValueFunction) {
+      valueFunction_ = hpipmInterface_.getRiccatiCostToGo(dynamics_[0], lagrangian_[0]);
+    }
+    solution.centeredBarrierParam = barrierParam;
   }
+  const bool useComplementarityTarget = !stateIneqTarget.empty();
 
   // to determine if the solution is a descent direction for the cost: compute gradient(cost)' * [dx; du]
   solution.armijoDescentMetric = armijoDescentMetric(lagrangian_, deltaXSol, deltaUSol);
 
-  // Extract value function
-  if (settings_.createValueFunction) {
-    valueFunction_ = hpipmInterface_.getRiccatiCostToGo(dynamics_[0], lagrangian_[0]);
-  }
-
   // Problem horizon
   const int N = static_cast<int>(deltaXSol.size()) - 1;
 
@@ -518,11 +565,18 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
     int i = timeIndex++;
     while (i < N) {
       deltaSlackStateIneq[i] = ipm::retrieveSlackDirection(stateIneqConstraints_[i], deltaXSol[i], barrierParam, slackStateIneq[i]);
-      deltaDualStateIneq[i] = ipm::retrieveDualDirection(barrierParam, slackStateIneq[i], dualStateIneq[i], deltaSlackStateIneq[i]);
       deltaSlackStateInputIneq[i] =
           ipm::retrieveSlackDirection(stateInputIneqConstraints_[i], deltaXSol[i], deltaUSol[i], barrierParam, slackStateInputIneq[i]);
-      deltaDualStateInputIneq[i] =
-          ipm::retrieveDualDirection(barrierParam, slackStateInputIneq[i], dualStateInputIneq[i], deltaSlackStateInputIneq[i]);
+      if (useComplementarityTarget) {
+        deltaDualStateIneq[i] =
+            ipm::retrieveDualDirection(stateIneqTarget[i], slackStateIneq[i], dualStateIneq[i], deltaSlackStateIneq[i]);
+        deltaDualStateInputIneq[i] =
+            ipm::retrieveDualDirection(stateInputIneqTarget[i], slackStateInputIneq[i], dualStateInputIneq[i], deltaSlackStateInputIneq[i]);
+      } else {
+        deltaDualStateIneq[i] = ipm::retrieveDualDirection(barrierParam, slackStateIneq[i], dualStateIneq[i], deltaSlackStateIneq[i]);
+        deltaDualStateInputIneq[i] =
+            ipm::retrieveDualDirection(barrierParam, slackStateInputIneq[i], dualStateInputIneq[i], deltaSlackStateInputIneq[i]);
+      }
       primalStepSizes[workerId] = std::min(
           {primalStepSizes[workerId],
            ipm::fractionToBoundaryStepSize(slackStateIneq[i], deltaSlackStateIneq[i], settings_.fractionToBoundaryMargin),
@@ -556,7 +610,10 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
 
     if (i == N) {  // Only one worker will execute this
       deltaSlackStateIneq[i] = ipm::retrieveSlackDirection(stateIneqConstraints_[i], deltaXSol[i], barrierParam, slackStateIneq[i]);
-      deltaDualStateIneq[i] = ipm::retrieveDualDirection(barrierParam, slackStateIneq[i], dualStateIneq[i], deltaSlackStateIneq[i]);
+      deltaDualStateIneq[i] =
+          useComplementarityTarget
+              ? ipm::retrieveDualDirection(stateIneqTarget[i], slackStateIneq[i], dualStateIneq[i], deltaSlackStateIneq[i])
+              : ipm::retrieveDualDirection(barrierParam, slackStateIneq[i], dualStateIneq[i], deltaSlackStateIneq[i]);
       primalStepSizes[workerId] =
           std::min(primalStepSizes[workerId],
                    ipm::fractionToBoundaryStepSize(slackStateIneq[i], deltaSlackStateIneq[i], settings_.fractionToBoundaryMargin));
@@ -577,6 +634,138 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
   return solution;
 }
 
+scalar_t IpmSolver::solvePredictorCorrector(const vector_t& delta_x0, scalar_t barrierParam, const vector_array_t& slackStateIneq,
+                                            const vector_array_t& dualStateIneq, const vector_array_t& slackStateInputIneq,
+                                            const vector_array_t& dualStateInputIneq, vector_array_t& deltaXSol, vector_array_t& deltaUSol,
+                                            vector_array_t& stateIneqTarget, vector_array_t& stateInputIneqTarget) {
+  /*
+   * Mehrotra predictor-corrector method based on:
+   * "On the implementation of a primal-dual interior point method"
+   * https://doi.org/10.1137/0802028
+   */
+  // Problem horizon
+  const int N = static_cast<int>(dynamics_.size());
+
+  // Shifts the complementary slackness targets of the condensed Lagrangian. This only changes the linear terms of the QP.
+  auto shiftComplementarityTargets = [&](const vector_array_t& stateIneqShift, const vector_array_t& stateInputIneqShift) {
+    std::atomic_int timeIndex{0};
+    auto parallelTask = [&](int workerId) {
+      int i = timeIndex++;
+      while (i <= N) {
+        ipm::shiftComplementarityTarget(stateIneqShift[i], slackStateIneq[i], stateIneqConstraints_[i], lagrangian_[i]);
+        if (i < N) {
+          ipm::shiftComplementarityTarget(stateInputIneqShift[i], slackStateInputIneq[i], stateInputIneqConstraints_[i], lagrangian_[i]);
+        }
+        i = timeIndex++;
+      }
+    };
+    runParallel(std::move(parallelTask));
+  };
+
+  auto constantTrajectory = [](const vector_array_t& trajectory, scalar_t value) {
+    vector_array_t result;
+    result.reserve(trajectory.size());
+    for (const auto& v : trajectory) {
+      result.push_back(vector_t::Constant(v.size(), value));
+    }
+    return result;
+  };
+
+  // Predictor: affine-scaling step with a zero complementary slackness target
+  shiftComplementarityTargets(constantTrajectory(slackStateIneq, -barrierParam), constantTrajectory(slackStateInputIneq, -barrierParam));
+  auto status = hpipmInterface_.solve(delta_x0, dynamics_, lagrangian_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
+  if (status != hpipm_status::SUCCESS) {
+    throw std::runtime_error("[IpmSolver] Failed to solve the predictor QP");
+  }
+
+  vector_array_t deltaSlackStateIneq(N + 1), deltaDualStateIneq(N + 1);
+  vector_array_t deltaSlackStateInputIneq(N), deltaDualStateInputIneq(N);
+  std::atomic_int timeIndex{0};
+  auto parallelTask = [&](int workerId) {
+    int i = timeIndex++;
+    while (i <= N) {
+      deltaSlackStateIneq[i] = ipm::retrieveSlackDirection(stateIneqConstraints_[i], deltaXSol[i], barrierParam, slackStateIneq[i]);
+      deltaDualStateIneq[i] = ipm::retrieveDualDirection(vector_t::Zero(slackStateIneq[i].size()), slackStateIneq[i], dualStateIneq[i],
+                                                         deltaSlackStateIneq[i]);
+      if (i < N) {
+        deltaSlackStateInputIneq[i] =
+            ipm::retrieveSlackDirection(stateInputIneqConstraints_[i], deltaXSol[i], deltaUSol[i], barrierParam, slackStateInputIneq[i]);
+        deltaDualStateInputIneq[i] = ipm::retrieveDualDirection(vector_t::Zero(slackStateInputIneq[i].size()), slackStateInputIneq[i],
+                                                                dualStateInputIneq[i], deltaSlackStateInputIneq[i]);
+      }
+      i = timeIndex++;
+    }
+  };
+  runParallel(std::move(parallelTask));
+
+  // Centering parameter from the complementarity reduction of the affine-scaling step
+  size_t numIneqConstraints = 0;
+  scalar_t complementarity = 0.0;
+  scalar_t primalStepSize = 1.0;
+  scalar_t dualStepSize = 1.0;
+  for (int i = 0; i <= N; ++i) {
+    numIneqConstraints += slackStateIneq[i].size();
+    complementarity += slackStateIneq[i].dot(dualStateIneq[i]);
+    primalStepSize = std::min(primalStepSize, ipm::fractionToBoundaryStepSize(slackStateIneq[i], deltaSlackStateIneq[i], 1.0));
+    dualStepSize = std::min(dualStepSize, ipm::fractionToBoundaryStepSize(dualStateIneq[i], deltaDualStateIneq[i], 1.0));
+    if (i < N) {
+      numIneqConstraints += slackStateInputIneq[i].size();
+      complementarity += slackStateInputIneq[i].dot(dualStateInputIneq[i]);
+      primalStepSize = std::min(primalStepSize, ipm::fractionToBoundaryStepSize(slackStateInputIneq[i], deltaSlackStateInputIneq[i], 1.0));
+      dualStepSize = std::min(dualStepSize, ipm::fractionToBoundaryStepSize(dualStateInputIneq[i], deltaDualStateInputIneq[i], 1.0));
+    }
+  }
+  scalar_t affineComplementarity = 0.0;
+  for (int i = 0; i <= N; ++i) {
+    affineComplementarity += ipm::complementarityAfterStep(slackStateIneq[i], dualStateIneq[i], deltaSlackStateIneq[i],
+                                                           deltaDualStateIneq[i], primalStepSize, dualStepSize);
+    if (i < N) {
+      affineComplementarity += ipm::complementarityAfterStep(slackStateInputIneq[i], dualStateInputIneq[i], deltaSlackStateInputIneq[i],
+                                                             deltaDualStateInputIneq[i], primalStepSize, dualStepSize);
+    }
+  }
+  const scalar_t centeredBarrierParam = [&]() {
+    if (numIneqConstraints == 0 || complementarity <= 0.0) {
+      return barrierParam;
+    }
+    const scalar_t centeringParam = std::min(1.0, std::pow(affineComplementarity / complementarity, settings_.centeringParameterPower));
+    return std::max(centeringParam * complementarity / static_cast<scalar_t>(numIneqConstraints), settings_.targetBarrierParameter);
+  }();
+
+  // Corrector: centered target with the second-order correction of the affine-scaling step
+  stateIneqTarget = constantTrajectory(slackStateIneq, centeredBarrierParam);
+  stateInputIneqTarget = constantTrajectory(slackStateInputIneq, centeredBarrierParam);
+  for (int i = 0; i <= N; ++i) {
+    stateIneqTarget[i] -= deltaSlackStateIneq[i].cwiseProduct(deltaDualStateIneq[i]);
+    if (i < N) {
+      stateInputIneqTarget[i] -= deltaSlackStateInputIneq[i].cwiseProduct(deltaDualStateInputIneq[i]);
+    }
+  }
+  shiftComplementarityTargets(stateIneqTarget, stateInputIneqTarget);
+  status = hpipmInterface_.resolve(delta_x0, dynamics_, lagrangian_, deltaXSol, deltaUSol);
+  if (status != hpipm_status::SUCCESS) {
+    throw std::runtime_error("[IpmSolver] Failed to solve the corrector QP");
+  }
+
+  // Extract value function
+  if (settings_.createValueFunction) {
+    valueFunction_ = hpipmInterface_.getRiccatiCostToGo(dynamics_[0], lagrangian_[0]);
+  }
+
+  // Restore the Lagrangian condensed with the barrier parameter
+  vector_array_t stateIneqShift = constantTrajectory(slackStateIneq, barrierParam);
+  vector_array_t stateInputIneqShift = constantTrajectory(slackStateInputIneq, barrierParam);
+  for (int i = 0; i <= N; ++i) {
+    stateIneqShift[i] -= stateIneqTarget[i];
+    if (i < N) {
+      stateInputIneqShift[i] -= stateInputIneqTarget[i];
+    }
+  }
+  shiftComplementarityTargets(stateIneqShift, stateInputIneqShift);
+
+  return centeredBarrierParam;
+}
+
 void IpmSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x, const vector_array_t& lmd,
                                      const vector_array_t& deltaXSol) {
   if (settings_.createValueFunction) {
@@ -607,7 +796,7 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
                                                      const vector_array_t& x, const vector_array_t& u, const vector_array_t& lmd,
                                                      const vector_array_t& nu, scalar_t barrierParam, const vector_array_t& slackStateIneq,
                                                      const vector_array_t& slackStateInputIneq, const vector_array_t& dualStateIneq,
-                                                     const vector_array_t& dualStateInputIneq, std::vector<Metrics>& metrics) {
+                                                     const vector_array_t& dualStateInputIneq) {
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
 
@@ -620,8 +809,17 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
   constraintsProjection_.resize(N);
   projectionMultiplierCoefficients_.resize(N);
   constraintsSize_.resize(N + 1);
-  metrics.resize(N + 1);
 
+  // Nodes that did not move since their last linearization keep their derivatives, the values are evaluated at the current point
+  const bool isIncremental = settings_.incrementalLinearizationRefreshPeriod > 1;
+  if (isIncremental) {
+    totalNumSkippedLinearizations_ += incrementalLinearization_.update(time, x, u, this->getReferenceManager().getModeSchedule(),
+                                                                       *ocpDefinitions_.front().targetTrajectoriesPtr);
+  }
+  totalNumLinearizations_ += N + 1;
+  auto needsLinearization = [&](int i) { return !isIncremental || incrementalLinearization_.needsLinearization(i); };
+
+  const bool hasHessianApproximation = settings_.hessianApproximation.strategy != hessian_approximation::Strategy::EXACT;
   std::atomic_int timeIndex{0};
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
@@ -631,8 +829,16 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
     while (i < N) {
       if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
-        auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
+        multiple_shooting::EventTranscription result;
+        if (needsLinearization(i)) {
+          result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
+          if (isIncremental) {
+            incrementalLinearization_.setEventNode(i, result);
+          }
+        } else {
+          const auto metrics = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
+          result = incrementalLinearization_.getEventNode(i, x[i], metrics);
+        }
         performance[workerId] += ipm::computePerformanceIndex(result, barrierParam, slackStateIneq[i]);
         dynamics_[i] = std::move(result.dynamics);
         stateInputEqConstraints_[i].resize(0, x[i].size());
@@ -655,13 +861,25 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
+        multiple_shooting::Transcription result;
+        if (needsLinearization(i)) {
+          if (hasHessianApproximation) {
+            ocpDefinition.costPtr->setHessianApproximationNode(i);
+            ocpDefinition.softConstraintPtr->setHessianApproximationNode(i);
+          }
+          result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
+          if (isIncremental) {
+            incrementalLinearization_.setIntermediateNode(i, result);
+          }
+        } else {
+          const auto metrics = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
+          result = incrementalLinearization_.getIntermediateNode(i, x[i], u[i], metrics);
+        }
         // Disable the state-only inequality constraints at the initial node
         if (i == 0) {
           result.stateIneqConstraints.setZero(0, x[i].size());
           std::fill(result.constraintsSize.stateIneq.begin(), result.constraintsSize.stateIneq.end(), 0);
         }
-        metrics[i] = multiple_shooting::computeMetrics(result);
         performance[workerId] += ipm::computePerformanceIndex(result, dt, barrierParam, slackStateIneq[i], slackStateInputIneq[i]);
         multiple_shooting::projectTranscription(result, settings_.computeLagrangeMultipliers);
         dynamics_[i] = std::move(result.dynamics);
@@ -693,8 +911,16 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
 
     if (i == N) {  // Only one worker will execute this
       const scalar_t tN = getIntervalStart(time[N]);
-      auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
-      metrics[i] = multiple_shooting::computeMetrics(result);
+      multiple_shooting::TerminalTranscription result;
+      if (needsLinearization(N)) {
+        result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
+        if (isIncremental) {
+          incrementalLinearization_.setTerminalNode(result);
+        }
+      } else {
+        const auto metrics = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
+        result = incrementalLinearization_.getTerminalNode(x[N], metrics);
+      }
       performance[workerId] += ipm::computePerformanceIndex(result, barrierParam, slackStateIneq[N]);
       stateInputEqConstraints_[i].resize(0, x[i].size());
       stateIneqConstraints_[i] = std::move(result.ineqConstraints);
@@ -712,9 +938,7 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
   runParallel(std::move(parallelTask));
 
   // Account for initial state in performance
-  const vector_t initDynamicsViolation = initState - x.front();
-  metrics.front().dynamicsViolation += initDynamicsViolation;
-  performance.front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+  performance.front().dynamicsViolationSSE += (initState - x.front()).squaredNorm();
 
   // Sum performance of the threads
   PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
@@ -783,6 +1007,11 @@ ipm::StepInfo IpmSolver::takePrimalStep(const PerformanceIndex& baseline, const
                                         vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics) {
   using StepType = FilterLinesearch::StepType;
 
+  if (settings_.speculativeLinesearch) {
+    return takeSpeculativePrimalStep(baseline, timeDiscretization, initState, subproblemSolution, x, u, barrierParam, slackStateIneq,
+                                     slackStateInputIneq, metrics);
+  }
+
   /*
    * Filter linesearch based on:
    * "On the implementation of an interior-point filter line-search algorithm for large-scale nonlinear programming"
@@ -883,6 +1112,103 @@ ipm::StepInfo IpmSolver::takePrimalStep(const PerformanceIndex& baseline, const
   return stepInfo;
 }
 
+ipm::StepInfo IpmSolver::takeSpeculativePrimalStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
+                                                   const vector_t& initState, const OcpSubproblemSolution& subproblemSolution,
+                                                   vector_array_t& x, vector_array_t& u, scalar_t barrierParam,
+                                                   vector_array_t& slackStateIneq, vector_array_t& slackStateInputIneq,
+                                                   std::vector<Metrics>& metrics) {
+  if (settings_.printLinesearch) {
+    std::cerr << std::setprecision(9) << std::fixed;
+    std::cerr << "\n=== Speculative Linesearch ===\n";
+    std::cerr << "Baseline:\n" << baseline << "\n";
+  }
+
+  // Update norm
+  const auto& dx = subproblemSolution.deltaXSol;
+  const auto& du = subproblemSolution.deltaUSol;
+  const auto deltaUnorm = multiple_shooting::trajectoryNorm(du);
+  const auto deltaXnorm = multiple_shooting::trajectoryNorm(dx);
+
+  // The same step sizes as the serial backtracking
+  const scalar_array_t stepSizes = backtrackingStepSizes(subproblemSolution.maxPrimalStepSize, settings_.alpha_decay, settings_.alpha_min,
+                                                         settings_.deltaTol, deltaXnorm, deltaUnorm);
+
+  // Same evaluation as computePerformance(), node by node. The candidate is {x, u, slackStateIneq, slackStateInputIneq}.
+  const int N = static_cast<int>(timeDiscretization.size()) - 1;
+  auto evaluateNode = [&](int workerId, int i, const std::vector<vector_array_t>& candidate, Metrics& nodeMetrics) {
+    OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
+    const auto& xNew = candidate[0];
+    const auto& uNew = candidate[1];
+    const auto& slackStateIneqNew = candidate[2];
+    const auto& slackStateInputIneqNew = candidate[3];
+    PerformanceIndex performance;
+    if (i == N) {
+      const scalar_t tN = getIntervalStart(timeDiscretization[N]);
+      nodeMetrics = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, xNew[N]);
+      performance = ipm::toPerformanceIndex(nodeMetrics, barrierParam, slackStateIneqNew[N]);
+    } else if (timeDiscretization[i].event == AnnotatedTime::Event::PreEvent) {
+      nodeMetrics = multiple_shooting::computeEventMetrics(ocpDefinition, timeDiscretization[i].time, xNew[i], xNew[i + 1]);
+      performance = ipm::toPerformanceIndex(nodeMetrics, barrierParam, slackStateIneqNew[i]);
+    } else {
+      const scalar_t ti = getIntervalStart(timeDiscretization[i]);
+      const scalar_t dt = getIntervalDuration(timeDiscretization[i], timeDiscretization[i + 1]);
+      nodeMetrics = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, xNew[i], xNew[i + 1], uNew[i]);
+      // Disable the state-only inequality constraints at the initial node
+      if (i == 0) {
+        nodeMetrics.stateIneqConstraint.clear();
+      }
+      performance = ipm::toPerformanceIndex(nodeMetrics, dt, barrierParam, slackStateIneqNew[i], slackStateInputIneqNew[i]);
+    }
+    if (i == 0) {  // Account for initial state in performance
+      const vector_t initDynamicsViolation = initState - xNew.front();
+      nodeMetrics.dynamicsViolation += initDynamicsViolation;
+      performance.dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+    }
+    return performance;
+  };
+
+  std::vector<vector_array_t> trajectories{std::move(x), std::move(u), std::move(slackStateIneq), std::move(slackStateInputIneq)};
+  const auto result = speculativeLinesearch(
+      filterLinesearch_, threadPool_, settings_.nThreads, baseline, subproblemSolution.armijoDescentMetric, stepSizes, N + 1, evaluateNode,
+      {dx, du, subproblemSolution.deltaSlackStateIneq, subproblemSolution.deltaSlackStateInputIneq}, trajectories, metrics);
+  x = std::move(trajectories[0]);
+  u = std::move(trajectories[1]);
+  slackStateIneq = std::move(trajectories[2]);
+  slackStateInputIneq = std::move(trajectories[3]);
+
+  ipm::StepInfo stepInfo;
+  if (result.stepIndex >= 0) {
+    const scalar_t alpha = stepSizes[result.stepIndex];
+    stepInfo.primalStepSize = alpha;
+    stepInfo.stepType = result.stepType;
+    stepInfo.dx_norm = alpha * deltaXnorm;
+    stepInfo.du_norm = alpha * deltaUnorm;
+    stepInfo.performanceAfterStep = result.performance;
+    stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(result.performance);
+
+    if (settings_.printLinesearch) {
+      std::cerr << "Step size: " << alpha << ", Step Type: " << toString(stepInfo.stepType) << " (Accepted)\n";
+      std::cerr << "|dx| = " << stepInfo.dx_norm << "\t|du| = " << stepInfo.du_norm << "\n";
+      std::cerr << result.performance << "\n";
+    }
+
+  } else {  // All step sizes rejected -> Don't take a step
+    stepInfo.primalStepSize = 0.0;
+    stepInfo.stepType = FilterLinesearch::StepType::ZERO;
+    stepInfo.dx_norm = 0.0;
+    stepInfo.du_norm = 0.0;
+    stepInfo.performanceAfterStep = baseline;
+    stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(baseline);
+
+    if (settings_.printLinesearch) {
+      std::cerr << "[Linesearch terminated] Primal Step size: " << stepInfo.primalStepSize
+                << ", Step Type: " << toString(stepInfo.stepType) << "\n";
+    }
+  }
+
+  return stepInfo;
+}
+
 void IpmSolver::takeDualStep(const OcpSubproblemSolution& subproblemSolution, const ipm::StepInfo& stepInfo, vector_array_t& lmd,
                              vector_array_t& nu, vector_array_t& dualStateIneq, vector_array_t& dualStateInputIneq) const {
   if (settings_.computeLagrangeMultipliers) {
@@ -925,6 +1251,9 @@ ipm::Convergence IpmSolver::checkConvergence(int iteration, scalar_t barrierPara
              barrierParam <= settings_.targetBarrierParameter) {
     // Converged because the change in primal variables is below the specified tolerance
     return Convergence::PRIMAL;
+  } else if (isTerminationRequested()) {
+    // Stopped because the termination was requested from outside
+    return Convergence::TERMINATED;
   } else {
     // None of the above convergence criteria were met -> not converged.
     return Convergence::FALSE;
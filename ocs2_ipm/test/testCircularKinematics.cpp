@@ -246,6 +246,146 @@ TEST(test_circular_kinematics, solve_projected_EqConstraints_IneqConstraints) {
   }
 }
 
+TEST(test_circular_kinematics, solve_projected_EqConstraints_IneqConstraints_SpeculativeLinesearch) {
+  constexpr size_t INPUT_DIM = 2;
+
+  // optimal control problem
+  OptimalControlProblem problem = createCircularKinematicsProblem("/tmp/ocs2/ipm_test_generated");
+
+  // inequality constraints
+  const vector_t umin = (vector_t(2) << -0.5, -0.5).finished();
+  const vector_t umax = (vector_t(2) << 0.5, 0.5).finished();
+  const vector_t e = (vector_t(2 * INPUT_DIM) << -umin, umax).finished();
+  const matrix_t C = matrix_t::Zero(2 * INPUT_DIM, 2);
+  const matrix_t D =
+      (matrix_t(2 * INPUT_DIM, INPUT_DIM) << matrix_t::Identity(INPUT_DIM, INPUT_DIM), -matrix_t::Identity(INPUT_DIM, INPUT_DIM)).finished();
+  problem.inequalityConstraintPtr->add("ubound", std::make_unique<LinearStateInputConstraint>(e, C, D));
+
+  // Initializer
+  DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  auto getSettings = [](bool speculativeLinesearch) {
+    ipm::Settings s;
+    s.dt = 0.01;
+    s.ipmIteration = 20;
+    s.useFeedbackPolicy = true;
+    s.printLinesearch = true;
+    s.nThreads = 4;
+    s.initialBarrierParameter = 1.0e-02;
+    s.targetBarrierParameter = 1.0e-04;
+    s.speculativeLinesearch = speculativeLinesearch;
+    return s;
+  };
+
+  // Additional problem definitions
+  const scalar_t startTime = 0.0;
+  const scalar_t finalTime = 1.0;
+  const vector_t initState = (vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Solve
+  IpmSolver solverSerial(getSettings(false), problem, zeroInitializer);
+  solverSerial.run(startTime, initState, finalTime);
+  IpmSolver solverSpeculative(getSettings(true), problem, zeroInitializer);
+  solverSpeculative.run(startTime, initState, finalTime);
+
+  // The speculative linesearch takes the same steps as the serial one
+  const auto& iterationsSerial = solverSerial.getIterationsLog();
+  const auto& iterationsSpeculative = solverSpeculative.getIterationsLog();
+  ASSERT_EQ(iterationsSerial.size(), iterationsSpeculative.size());
+  for (int i = 0; i < iterationsSerial.size(); i++) {
+    EXPECT_NEAR(iterationsSerial[i].merit, iterationsSpeculative[i].merit, 1e-9);
+  }
+
+  const auto primalSolutionSerial = solverSerial.primalSolution(finalTime);
+  const auto primalSolutionSpeculative = solverSpeculative.primalSolution(finalTime);
+  ASSERT_EQ(primalSolutionSerial.timeTrajectory_.size(), primalSolutionSpeculative.timeTrajectory_.size());
+  for (int i = 0; i < primalSolutionSerial.timeTrajectory_.size(); i++) {
+    ASSERT_TRUE(primalSolutionSerial.stateTrajectory_[i].isApprox(primalSolutionSpeculative.stateTrajectory_[i], 1e-9));
+    ASSERT_TRUE(primalSolutionSerial.inputTrajectory_[i].isApprox(primalSolutionSpeculative.inputTrajectory_[i], 1e-9));
+  }
+}
+
+TEST(test_circular_kinematics, solve_projected_EqConstraints_IneqConstraints_PredictorCorrector) {
+  constexpr size_t INPUT_DIM = 2;
+
+  // optimal control problem
+  OptimalControlProblem problem = createCircularKinematicsProblem("/tmp/ocs2/ipm_test_generated");
+
+  // inequality constraints
+  const vector_t umin = (vector_t(2) << -0.5, -0.5).finished();
+  const vector_t umax = (vector_t(2) << 0.5, 0.5).finished();
+  const vector_t e = (vector_t(2 * INPUT_DIM) << -umin, umax).finished();
+  const matrix_t C = matrix_t::Zero(2 * INPUT_DIM, 2);
+  const matrix_t D =
+      (matrix_t(2 * INPUT_DIM, INPUT_DIM) << matrix_t::Identity(INPUT_DIM, INPUT_DIM), -matrix_t::Identity(INPUT_DIM, INPUT_DIM)).finished();
+  problem.inequalityConstraintPtr->add("ubound", std::make_unique<LinearStateInputConstraint>(e, C, D));
+
+  // Initializer
+  DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  const auto settings = []() {
+    ipm::Settings s;
+    s.dt = 0.01;
+    s.ipmIteration = 20;
+    s.useFeedbackPolicy = true;
+    s.createValueFunction = true;
+    s.computeLagrangeMultipliers = true;
+    s.printSolverStatistics = true;
+    s.printSolverStatus = true;
+    s.printLinesearch = true;
+    s.nThreads = 2;
+    s.initialBarrierParameter = 1.0e-02;
+    s.targetBarrierParameter = 1.0e-04;
+    s.usePredictorCorrector = true;
+    return s;
+  }();
+
+  // Additional problem definitions
+  const scalar_t startTime = 0.0;
+  const scalar_t finalTime = 1.0;
+  const vector_t initState = (vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Solve
+  IpmSolver solver(settings, problem, zeroInitializer);
+  solver.run(startTime, initState, finalTime);
+
+  const auto primalSolution = solver.primalSolution(finalTime);
+
+  // check constraint satisfaction
+  for (const auto& u : primalSolution.inputTrajectory_) {
+    if (u.size() > 0) {
+      ASSERT_TRUE((u - umin).minCoeff() >= 0);
+      ASSERT_TRUE((umax - u).minCoeff() >= 0);
+    }
+  }
+
+  // Check initial condition
+  ASSERT_TRUE(primalSolution.stateTrajectory_.front().isApprox(initState));
+
+  // Check constraint satisfaction.
+  const auto performance = solver.getPerformanceIndeces();
+  ASSERT_LT(performance.dynamicsViolationSSE, 1e-6);
+  ASSERT_LT(performance.equalityConstraintsSSE, 1e-6);
+
+  // Check feedback controller
+  for (int i = 0; i < primalSolution.timeTrajectory_.size() - 1; i++) {
+    const auto t = primalSolution.timeTrajectory_[i];
+    const auto& x = primalSolution.stateTrajectory_[i];
+    const auto& u = primalSolution.inputTrajectory_[i];
+    ASSERT_TRUE(u.isApprox(primalSolution.controllerPtr_->computeInput(t, x)));
+  }
+
+  // The dual variables remain strictly positive
+  for (int i = 0; i < primalSolution.timeTrajectory_.size() - 1; i++) {
+    const auto dualSolution = solver.getIntermediateDualSolution(primalSolution.timeTrajectory_[i]);
+    for (const auto& multiplier : dualSolution.stateInputIneq) {
+      ASSERT_GT(multiplier.lagrangian.minCoeff(), 0.0);
+    }
+  }
+}
+
 TEST(test_circular_kinematics, solve_projected_EqConstraints_MixedIneqConstraints) {
   // optimal control problem
   OptimalControlProblem problem = createCircularKinematicsProblem("/tmp/ocs2/ipm_test_generated");
@@ -0,0 +1,129 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/reference/ModeSchedule.h>
+#include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_oc/synchronized_module/ReferenceManagerInterface.h>
+
+#include "ocs2_mpc/SystemObservation.h"
+
+namespace ocs2 {
+
+/** The inputs and the outcome of one MPC call in closed loop. */
+struct ClosedLoopFrame {
+  SystemObservation observation;  // the observation passed to the MPC
+
+  // The references as they were set to the reference manager, before its modifications in preSolverRun(). They are only stored in the
+  // frames of the MPC calls that activated a newly set reference.
+  bool isTargetTrajectoriesUpdated = false;
+  TargetTrajectories targetTrajectories;
+  bool isModeScheduleUpdated = false;
+  ModeSchedule modeSchedule;
+
+  bool isPolicyUpdated = false;  // whether the MPC call returned a new policy
+  scalar_t latency = 0.0;        // [ms] duration of the MPC call
+  vector_t policyInput;          // input of the new policy at the observation, empty if the policy is not updated
+};
+
+/**
+ * Records the closed-loop inputs of an MPC, i.e., the observations and the references that were used in each MPC call, to a binary file.
+ * The recording can be replayed through any MPC_BASE without ROS (see replayClosedLoop()) to benchmark its latency and to compare the
+ * policies on a real-world workload.
+ *
+ * The references are recorded as they were passed to setTargetTrajectories() and setModeSchedule() of the reference manager (see
+ * ReferenceManagerInterface::getInputTargetTrajectories()), such that the replay applies the modifications of the reference manager in
+ * the same way as the recorded MPC. A reference manager whose references are also changed by other means, e.g., by a gait schedule
+ * that a synchronized module modifies, has to report these changes through the same functions, otherwise the replay misses them. The
+ * frames are written to the file by a background thread, such that record() does not wait for the file system.
+ */
+class ClosedLoopRecorder {
+ public:
+  /**
+   * Constructor. Opens the file and writes the header, any existing content of the file is discarded.
+   *
+   * @param [in] filename : The file to which the frames are recorded.
+   */
+  explicit ClosedLoopRecorder(const std::string& filename);
+
+  /** Destructor. Writes the pending frames and closes the file. */
+  ~ClosedLoopRecorder();
+
+  /**
+   * Queues the frame of an MPC call for writing. Must be called after the MPC call and before the next one.
+   *
+   * @param [in] observation : The observation passed to the MPC.
+   * @param [in] referenceManager : The reference manager of the solver.
+   * @param [in] isPolicyUpdated : Whether the MPC call returned a new policy.
+   * @param [in] latency : The duration of the MPC call in milliseconds.
+   * @param [in] policyInput : The input of the new policy at the observation. Ignored if the policy is not updated.
+   */
+  void record(const SystemObservation& observation, const ReferenceManagerInterface& referenceManager, bool isPolicyUpdated,
+              scalar_t latency, vector_t policyInput);
+
+  /** Number of frames passed to record(). */
+  size_t getNumRecorded() const { return numRecorded_; }
+
+ private:
+  /** Writes the queued frames to the file until the recorder is destroyed. */
+  void writerWorker();
+
+  size_t numRecorded_ = 0;
+  size_t lastNumTargetTrajectoriesUpdates_ = 0;
+  size_t lastNumModeScheduleUpdates_ = 0;
+  std::ofstream file_;
+
+  std::deque<ClosedLoopFrame> frameQueue_;
+  std::mutex frameQueueMutex_;
+  std::condition_variable frameQueued_;
+  bool terminateWriter_ = false;
+  std::atomic_bool writeFailed_{false};
+  std::thread writerThread_;
+};
+
+/**
+ * Loads the frames recorded by ClosedLoopRecorder.
+ *
+ * @param [in] filename : The recording.
+ * @return The recorded frames in the order of the MPC calls.
+ */
+std::vector<ClosedLoopFrame> loadClosedLoopRecording(const std::string& filename);
+
+}  // namespace ocs2
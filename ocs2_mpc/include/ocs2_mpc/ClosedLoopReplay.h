@@ -0,0 +1,96 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ostream>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+#include "ocs2_mpc/ClosedLoopRecorder.h"
+#include "ocs2_mpc/MPC_BASE.h"
+
+namespace ocs2 {
+
+/** The outcome of the MPC calls of a closed-loop recording or of its replay. */
+struct ClosedLoopResult {
+  std::vector<bool> isPolicyUpdated;  // for each MPC call, whether it returned a new policy
+  scalar_array_t latencies;           // [ms] for each MPC call
+  vector_array_t policyInputs;        // for each MPC call, the input of the new policy at the observation, empty if not updated
+};
+
+/** Distribution of the latencies of the MPC calls that returned a new policy. */
+struct LatencyStatistics {
+  size_t numSamples = 0;
+  scalar_t mean = 0.0;          // [ms]
+  scalar_t min = 0.0;           // [ms]
+  scalar_t median = 0.0;        // [ms]
+  scalar_t percentile90 = 0.0;  // [ms]
+  scalar_t percentile99 = 0.0;  // [ms]
+  scalar_t max = 0.0;           // [ms]
+};
+
+/** Difference between the policies of two closed-loop results of the same frames. */
+struct PolicyComparison {
+  size_t numCompared = 0;             // number of MPC calls for which both results have a new policy
+  size_t numUpdateMismatches = 0;     // number of MPC calls for which only one of the results has a new policy
+  scalar_t maxInputDeviation = 0.0;   // maximum over the compared calls of the infinity norm of the input difference
+  scalar_t meanInputDeviation = 0.0;  // mean over the compared calls of the infinity norm of the input difference
+};
+
+/**
+ * Replays a closed-loop recording through an MPC. The MPC is reset, and for each frame the recorded references are set in the
+ * reference manager of the solver before the MPC is called with the recorded observation. This does not require ROS, such that the
+ * latency of an MPC can be benchmarked offline on real-world workloads.
+ *
+ * The recorded references are the inputs of the reference manager, before its modifications in preSolverRun(). They are set before the
+ * same MPC calls in which they were activated during the recording, such that a reference manager that modifies the references
+ * reproduces the recorded references, as long as it is in the same state as the recorded one when the replay starts.
+ *
+ * @param [in] mpc : The MPC to be benchmarked.
+ * @param [in] frames : The recorded frames, see loadClosedLoopRecording().
+ * @return The latencies and the policies of the MPC calls.
+ */
+ClosedLoopResult replayClosedLoop(MPC_BASE& mpc, const std::vector<ClosedLoopFrame>& frames);
+
+/** Extracts the latencies and the policies of the recorded MPC calls. */
+ClosedLoopResult getRecordedResult(const std::vector<ClosedLoopFrame>& frames);
+
+/** Computes the latency distribution of the MPC calls that returned a new policy. */
+LatencyStatistics getLatencyStatistics(const ClosedLoopResult& result);
+
+/** Compares the policies of two closed-loop results of the same frames, e.g., of a replay and of the recording. */
+PolicyComparison comparePolicies(const ClosedLoopResult& lhs, const ClosedLoopResult& rhs);
+
+std::ostream& operator<<(std::ostream& out, const LatencyStatistics& statistics);
+
+std::ostream& operator<<(std::ostream& out, const PolicyComparison& comparison);
+
+}  // namespace ocs2
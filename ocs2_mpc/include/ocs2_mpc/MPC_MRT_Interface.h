@@ -38,6 +38,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/model_data/Multiplier.h>
+#include "ocs2_mpc/ClosedLoopRecorder.h"
 #include "ocs2_mpc/MPC_BASE.h"
 #include "ocs2_mpc/MRT_BASE.h"
 
@@ -115,13 +116,34 @@ class MPC_MRT_Interface final : public MRT_BASE {
    */
   MultiplierCollection getIntermediateDualSolution(scalar_t time) const;
 
+  /**
+   * Starts recording the observations and references of the following MPC iterations, such that they can be replayed offline with
+   * replayClosedLoop(). A running recording is stopped.
+   *
+   * @note This method must not be called while advanceMpc() is running.
+   *
+   * @param [in] filename: The file to which the recording is written.
+   */
+  void startRecording(const std::string& filename);
+
+  /**
+   * Stops the recording.
+   *
+   * @note This method must not be called while advanceMpc() is running.
+   */
+  void stopRecording();
+
  private:
   /**
    * Updates the buffer variables from the MPC object. This method is automatically called by advanceMpc()
    *
    * @param [in] mpcInitObservation: The observation used to run the MPC.
+   * @param [out] policyInputPtr: If not nullptr, the input of the buffered policy at the observation.
    */
-  void copyToBuffer(const SystemObservation& mpcInitObservation);
+  void copyToBuffer(const SystemObservation& mpcInitObservation, vector_t* policyInputPtr = nullptr);
+
+  /** Records the MPC iteration if a recording is running. Called after the policy is buffered. */
+  void recordMpcIteration(const SystemObservation& mpcInitObservation, bool controllerIsUpdated, scalar_t latency, vector_t policyInput);
 
   MPC_BASE& mpc_;
   benchmark::RepeatedTimer mpcTimer_;
@@ -129,6 +151,8 @@ class MPC_MRT_Interface final : public MRT_BASE {
   // MPC inputs
   SystemObservation currentObservation_;
   std::mutex observationMutex_;
+
+  std::unique_ptr<ClosedLoopRecorder> recorderPtr_;
 };
 
 }  // namespace ocs2
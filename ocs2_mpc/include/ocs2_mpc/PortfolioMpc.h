@@ -0,0 +1,141 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_mpc/MPC_BASE.h"
+#include "ocs2_mpc/PortfolioMpcSettings.h"
+
+namespace ocs2 {
+
+/**
+ * This is an MPC implementation that races a portfolio of solvers, e.g., GaussNewtonDDP, SqpSolver and IpmSolver. In each call, all
+ * solvers start on their own thread from the same observation. The first policy whose constraint violation is below
+ * portfolio_mpc::Settings::constraintTolerance is published, i.e., getSolverPtr() returns the solver that produced it. The other solvers
+ * are cancelled as soon as it returns (see SolverBase::requestTermination()) and stop after their current iteration in the background.
+ * The next call does not wait for them: a solver that is still finishing its last iteration sits out that race. If no policy is accepted,
+ * the one with the smallest constraint violation is published.
+ *
+ * Each solver keeps its own worker threads, so the cores are partitioned between the solvers through their nThreads settings.
+ *
+ * @note The ReferenceManager and the SolverSynchronizedModules must be set on this class and not on the solvers. They are updated once
+ * per call before the solvers start, and the modules receive the published policy. Each solver works on its own copy of the references,
+ * such that the update does not interfere with a cancelled solver. Therefore, the optimal control problems must read the references
+ * through the solver and must not hold the ReferenceManager of the portfolio.
+ */
+class PortfolioMpc final : public MPC_BASE {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] mpcSettings: Structure containing the settings for the MPC algorithm.
+   * @param [in] settings: Structure containing the settings for the portfolio.
+   * @param [in] solverNames: The names of the solvers which are used for logging.
+   * @param [in] solvers: The solvers of the portfolio.
+   */
+  PortfolioMpc(mpc::Settings mpcSettings, portfolio_mpc::Settings settings, std::vector<std::string> solverNames,
+               std::vector<std::unique_ptr<SolverBase>> solvers);
+
+  /** Destructor. Waits for the solvers which are still running. */
+  ~PortfolioMpc() override;
+
+  void reset() override;
+
+  /** Gets the solver which produced the latest policy. */
+  SolverBase* getSolverPtr() override { return solvers_[winnerIndex_].get(); }
+  const SolverBase* getSolverPtr() const override { return solvers_[winnerIndex_].get(); }
+
+  /** Sets the ReferenceManager which is shared by all solvers of the portfolio. */
+  void setReferenceManager(std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr);
+
+  /** Gets the ReferenceManager which is shared by all solvers of the portfolio. */
+  ReferenceManagerInterface& getReferenceManager() { return *referenceManagerPtr_; }
+  const ReferenceManagerInterface& getReferenceManager() const { return *referenceManagerPtr_; }
+
+  /** Adds a module that is updated once before the solvers start and receives the published policy. */
+  void addSynchronizedModule(std::shared_ptr<SolverSynchronizedModule> synchronizedModule) {
+    synchronizedModules_.push_back(std::move(synchronizedModule));
+  }
+
+  /** Gets the number of solvers in the portfolio. */
+  size_t getNumSolvers() const { return solvers_.size(); }
+
+  /** Gets the name of a solver. */
+  const std::string& getSolverName(size_t index) const { return solverNames_[index]; }
+
+  /** Gets the index of the solver which produced the latest policy. */
+  size_t getWinnerIndex() const { return winnerIndex_; }
+
+  /** Gets for each solver the number of calls in which its policy was published. */
+  const std::vector<size_t>& getNumWins() const { return numWins_; }
+
+ private:
+  void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override;
+
+  /** Checks whether a solver has not yet returned from its last run. */
+  bool isRunning(size_t index) const;
+
+  /** Waits until all solvers have returned. */
+  void waitForSolvers();
+
+  class SolverReferenceManager;
+
+  const portfolio_mpc::Settings portfolioSettings_;
+  const std::vector<std::string> solverNames_;
+  std::vector<std::unique_ptr<SolverBase>> solvers_;
+
+  std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr_;  // this pointer cannot be nullptr
+  std::vector<std::shared_ptr<SolverReferenceManager>> solverReferenceManagers_;
+  std::vector<std::shared_ptr<SolverSynchronizedModule>> synchronizedModules_;
+
+  size_t winnerIndex_ = 0;
+  std::vector<size_t> numWins_;
+
+  // The state of the race, raceId_, finishOrder_ and errors_ are protected by raceMutex_. The solvers of previous races do not report.
+  size_t raceId_ = 0;
+  std::mutex raceMutex_;
+  std::condition_variable raceCondition_;
+  std::vector<size_t> finishOrder_;
+  std::vector<std::exception_ptr> errors_;
+  std::vector<std::future<void>> runningSolvers_;  // the last run of each solver
+
+  ThreadPool threadPool_;
+};
+
+}  // namespace ocs2
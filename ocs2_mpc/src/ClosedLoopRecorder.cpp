@@ -0,0 +1,308 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/ClosedLoopRecorder.h"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace ocs2 {
+
+namespace {
+constexpr char fileHeader[] = "OCS2_CLOSED_LOOP_V1";
+constexpr size_t fileHeaderSize = sizeof(fileHeader) - 1;
+
+void writeInt(std::ostream& stream, int64_t value) {
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+int64_t readInt(std::istream& stream) {
+  int64_t value = 0;
+  stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+  if (!stream) {
+    throw std::runtime_error("[ClosedLoopRecorder] The recording is corrupted.");
+  }
+  return value;
+}
+
+void writeScalar(std::ostream& stream, scalar_t value) {
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+scalar_t readScalar(std::istream& stream) {
+  scalar_t value = 0.0;
+  stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+  if (!stream) {
+    throw std::runtime_error("[ClosedLoopRecorder] The recording is corrupted.");
+  }
+  return value;
+}
+
+/** Reads a size and checks it against an upper bound, such that a corrupted file does not trigger huge allocations. */
+size_t readSize(std::istream& stream) {
+  const auto size = readInt(stream);
+  if (size < 0 || size > (int64_t(1) << 32)) {
+    throw std::runtime_error("[ClosedLoopRecorder] The recording is corrupted.");
+  }
+  return static_cast<size_t>(size);
+}
+
+void writeVector(std::ostream& stream, const vector_t& v) {
+  writeInt(stream, v.size());
+  stream.write(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(scalar_t));
+}
+
+vector_t readVector(std::istream& stream) {
+  vector_t v(readSize(stream));
+  stream.read(reinterpret_cast<char*>(v.data()), v.size() * sizeof(scalar_t));
+  if (!stream) {
+    throw std::runtime_error("[ClosedLoopRecorder] The recording is corrupted.");
+  }
+  return v;
+}
+
+void writeScalarArray(std::ostream& stream, const scalar_array_t& values) {
+  writeInt(stream, values.size());
+  for (const auto v : values) {
+    writeScalar(stream, v);
+  }
+}
+
+scalar_array_t readScalarArray(std::istream& stream) {
+  scalar_array_t values(readSize(stream));
+  for (auto& v : values) {
+    v = readScalar(stream);
+  }
+  return values;
+}
+
+void writeVectorArray(std::ostream& stream, const vector_array_t& values) {
+  writeInt(stream, values.size());
+  for (const auto& v : values) {
+    writeVector(stream, v);
+  }
+}
+
+vector_array_t readVectorArray(std::istream& stream) {
+  vector_array_t values(readSize(stream));
+  for (auto& v : values) {
+    v = readVector(stream);
+  }
+  return values;
+}
+
+void writeObservation(std::ostream& stream, const SystemObservation& observation) {
+  writeInt(stream, observation.mode);
+  writeScalar(stream, observation.time);
+  writeVector(stream, observation.state);
+  writeVector(stream, observation.input);
+}
+
+SystemObservation readObservation(std::istream& stream) {
+  SystemObservation observation;
+  observation.mode = static_cast<size_t>(readInt(stream));
+  observation.time = readScalar(stream);
+  observation.state = readVector(stream);
+  observation.input = readVector(stream);
+  return observation;
+}
+
+void writeTargetTrajectories(std::ostream& stream, const TargetTrajectories& targetTrajectories) {
+  writeScalarArray(stream, targetTrajectories.timeTrajectory);
+  writeVectorArray(stream, targetTrajectories.stateTrajectory);
+  writeVectorArray(stream, targetTrajectories.inputTrajectory);
+}
+
+TargetTrajectories readTargetTrajectories(std::istream& stream) {
+  TargetTrajectories targetTrajectories;
+  targetTrajectories.timeTrajectory = readScalarArray(stream);
+  targetTrajectories.stateTrajectory = readVectorArray(stream);
+  targetTrajectories.inputTrajectory = readVectorArray(stream);
+  return targetTrajectories;
+}
+
+void writeModeSchedule(std::ostream& stream, const ModeSchedule& modeSchedule) {
+  writeScalarArray(stream, modeSchedule.eventTimes);
+  writeInt(stream, modeSchedule.modeSequence.size());
+  for (const auto mode : modeSchedule.modeSequence) {
+    writeInt(stream, mode);
+  }
+}
+
+ModeSchedule readModeSchedule(std::istream& stream) {
+  auto eventTimes = readScalarArray(stream);
+  std::vector<size_t> modeSequence(readSize(stream));
+  for (auto& mode : modeSequence) {
+    mode = static_cast<size_t>(readInt(stream));
+  }
+  if (modeSequence.size() != eventTimes.size() + 1) {
+    throw std::runtime_error("[ClosedLoopRecorder] The recording is corrupted.");
+  }
+  return {std::move(eventTimes), std::move(modeSequence)};
+}
+
+void writeFrame(std::ostream& stream, const ClosedLoopFrame& frame) {
+  writeObservation(stream, frame.observation);
+  writeInt(stream, frame.isTargetTrajectoriesUpdated);
+  if (frame.isTargetTrajectoriesUpdated) {
+    writeTargetTrajectories(stream, frame.targetTrajectories);
+  }
+  writeInt(stream, frame.isModeScheduleUpdated);
+  if (frame.isModeScheduleUpdated) {
+    writeModeSchedule(stream, frame.modeSchedule);
+  }
+  writeInt(stream, frame.isPolicyUpdated);
+  writeScalar(stream, frame.latency);
+  writeVector(stream, frame.policyInput);
+}
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ClosedLoopRecorder::ClosedLoopRecorder(const std::string& filename) : file_(filename, std::ios::binary | std::ios::trunc) {
+  if (!file_) {
+    throw std::runtime_error("[ClosedLoopRecorder] Could not open " + filename);
+  }
+  file_.write(fileHeader, fileHeaderSize);
+  writerThread_ = std::thread([this]() { writerWorker(); });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ClosedLoopRecorder::~ClosedLoopRecorder() {
+  {
+    std::lock_guard<std::mutex> lock(frameQueueMutex_);
+    terminateWriter_ = true;
+  }
+  frameQueued_.notify_one();
+  writerThread_.join();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ClosedLoopRecorder::record(const SystemObservation& observation, const ReferenceManagerInterface& referenceManager,
+                                bool isPolicyUpdated, scalar_t latency, vector_t policyInput) {
+  if (writeFailed_) {
+    throw std::runtime_error("[ClosedLoopRecorder] Failed to write the recording.");
+  }
+
+  ClosedLoopFrame frame;
+  frame.observation = observation;
+
+  // the references of the first frame are always written
+  const size_t numTargetTrajectoriesUpdates = referenceManager.getNumTargetTrajectoriesUpdates();
+  frame.isTargetTrajectoriesUpdated = numRecorded_ == 0 || numTargetTrajectoriesUpdates != lastNumTargetTrajectoriesUpdates_;
+  if (frame.isTargetTrajectoriesUpdated) {
+    frame.targetTrajectories = referenceManager.getInputTargetTrajectories();
+    lastNumTargetTrajectoriesUpdates_ = numTargetTrajectoriesUpdates;
+  }
+  const size_t numModeScheduleUpdates = referenceManager.getNumModeScheduleUpdates();
+  frame.isModeScheduleUpdated = numRecorded_ == 0 || numModeScheduleUpdates != lastNumModeScheduleUpdates_;
+  if (frame.isModeScheduleUpdated) {
+    frame.modeSchedule = referenceManager.getInputModeSchedule();
+    lastNumModeScheduleUpdates_ = numModeScheduleUpdates;
+  }
+
+  frame.isPolicyUpdated = isPolicyUpdated;
+  frame.latency = latency;
+  if (isPolicyUpdated) {
+    frame.policyInput = std::move(policyInput);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(frameQueueMutex_);
+    frameQueue_.push_back(std::move(frame));
+  }
+  frameQueued_.notify_one();
+  ++numRecorded_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ClosedLoopRecorder::writerWorker() {
+  std::unique_lock<std::mutex> lock(frameQueueMutex_);
+  while (true) {
+    frameQueued_.wait(lock, [this] { return !frameQueue_.empty() || terminateWriter_; });
+    if (frameQueue_.empty()) {
+      break;  // terminated and all frames are written
+    }
+
+    // write without holding the lock, such that record() is not blocked by the file system
+    auto frame = std::move(frameQueue_.front());
+    frameQueue_.pop_front();
+    lock.unlock();
+    writeFrame(file_, frame);
+    if (!file_) {
+      writeFailed_ = true;
+    }
+    lock.lock();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<ClosedLoopFrame> loadClosedLoopRecording(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("[loadClosedLoopRecording] Could not open " + filename);
+  }
+
+  char header[fileHeaderSize];
+  file.read(header, fileHeaderSize);
+  if (!file || std::memcmp(header, fileHeader, fileHeaderSize) != 0) {
+    throw std::runtime_error("[loadClosedLoopRecording] " + filename + " is not a closed-loop recording.");
+  }
+
+  std::vector<ClosedLoopFrame> frames;
+  while (file.peek() != std::char_traits<char>::eof()) {
+    ClosedLoopFrame frame;
+    frame.observation = readObservation(file);
+    frame.isTargetTrajectoriesUpdated = readInt(file) != 0;
+    if (frame.isTargetTrajectoriesUpdated) {
+      frame.targetTrajectories = readTargetTrajectories(file);
+    }
+    frame.isModeScheduleUpdated = readInt(file) != 0;
+    if (frame.isModeScheduleUpdated) {
+      frame.modeSchedule = readModeSchedule(file);
+    }
+    frame.isPolicyUpdated = readInt(file) != 0;
+    frame.latency = readScalar(file);
+    frame.policyInput = readVector(file);
+    frames.push_back(std::move(frame));
+  }
+  return frames;
+}
+
+}  // namespace ocs2
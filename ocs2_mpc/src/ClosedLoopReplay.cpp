@@ -0,0 +1,175 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/ClosedLoopReplay.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace ocs2 {
+
+namespace {
+/** Nearest-rank percentile of sorted samples. */
+scalar_t getPercentile(const scalar_array_t& sortedSamples, scalar_t percentile) {
+  const auto rank = static_cast<size_t>(std::ceil(percentile * sortedSamples.size()));
+  return sortedSamples[std::min(std::max(rank, size_t(1)), sortedSamples.size()) - 1];
+}
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ClosedLoopResult replayClosedLoop(MPC_BASE& mpc, const std::vector<ClosedLoopFrame>& frames) {
+  ClosedLoopResult result;
+  result.isPolicyUpdated.reserve(frames.size());
+  result.latencies.reserve(frames.size());
+  result.policyInputs.reserve(frames.size());
+
+  mpc.reset();
+  auto& referenceManager = mpc.getSolverPtr()->getReferenceManager();
+  for (const auto& frame : frames) {
+    if (frame.isTargetTrajectoriesUpdated) {
+      referenceManager.setTargetTrajectories(frame.targetTrajectories);
+    }
+    if (frame.isModeScheduleUpdated) {
+      referenceManager.setModeSchedule(frame.modeSchedule);
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+    const bool isPolicyUpdated = mpc.run(frame.observation.time, frame.observation.state);
+    const auto endTime = std::chrono::steady_clock::now();
+
+    result.isPolicyUpdated.push_back(isPolicyUpdated);
+    result.latencies.push_back(std::chrono::duration<scalar_t, std::milli>(endTime - startTime).count());
+    if (isPolicyUpdated) {
+      const auto primalSolution = mpc.getSolverPtr()->primalSolution(mpc.getSolverPtr()->getFinalTime());
+      result.policyInputs.push_back(primalSolution.controllerPtr_->computeInput(frame.observation.time, frame.observation.state));
+    } else {
+      result.policyInputs.emplace_back();
+    }
+  }
+  return result;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ClosedLoopResult getRecordedResult(const std::vector<ClosedLoopFrame>& frames) {
+  ClosedLoopResult result;
+  result.isPolicyUpdated.reserve(frames.size());
+  result.latencies.reserve(frames.size());
+  result.policyInputs.reserve(frames.size());
+  for (const auto& frame : frames) {
+    result.isPolicyUpdated.push_back(frame.isPolicyUpdated);
+    result.latencies.push_back(frame.latency);
+    result.policyInputs.push_back(frame.policyInput);
+  }
+  return result;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LatencyStatistics getLatencyStatistics(const ClosedLoopResult& result) {
+  scalar_array_t samples;
+  samples.reserve(result.latencies.size());
+  for (size_t i = 0; i < result.latencies.size(); ++i) {
+    if (result.isPolicyUpdated[i]) {
+      samples.push_back(result.latencies[i]);
+    }
+  }
+
+  LatencyStatistics statistics;
+  statistics.numSamples = samples.size();
+  if (samples.empty()) {
+    return statistics;
+  }
+
+  std::sort(samples.begin(), samples.end());
+  statistics.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+  statistics.min = samples.front();
+  statistics.median = getPercentile(samples, 0.5);
+  statistics.percentile90 = getPercentile(samples, 0.9);
+  statistics.percentile99 = getPercentile(samples, 0.99);
+  statistics.max = samples.back();
+  return statistics;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PolicyComparison comparePolicies(const ClosedLoopResult& lhs, const ClosedLoopResult& rhs) {
+  if (lhs.isPolicyUpdated.size() != rhs.isPolicyUpdated.size()) {
+    throw std::runtime_error("[comparePolicies] The results have a different number of MPC calls.");
+  }
+
+  PolicyComparison comparison;
+  for (size_t i = 0; i < lhs.isPolicyUpdated.size(); ++i) {
+    if (lhs.isPolicyUpdated[i] != rhs.isPolicyUpdated[i]) {
+      ++comparison.numUpdateMismatches;
+    } else if (lhs.isPolicyUpdated[i]) {
+      const auto& lhsInput = lhs.policyInputs[i];
+      const auto& rhsInput = rhs.policyInputs[i];
+      const scalar_t deviation = (lhsInput.size() == rhsInput.size()) ? (lhsInput - rhsInput).lpNorm<Eigen::Infinity>()
+                                                                      : std::numeric_limits<scalar_t>::infinity();
+      ++comparison.numCompared;
+      comparison.maxInputDeviation = std::max(comparison.maxInputDeviation, deviation);
+      comparison.meanInputDeviation += deviation;
+    }
+  }
+  if (comparison.numCompared > 0) {
+    comparison.meanInputDeviation /= comparison.numCompared;
+  }
+  return comparison;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::ostream& operator<<(std::ostream& out, const LatencyStatistics& statistics) {
+  out << "#samples: " << statistics.numSamples << ", mean: " << statistics.mean << " [ms], min: " << statistics.min
+      << " [ms], median: " << statistics.median << " [ms], p90: " << statistics.percentile90 << " [ms], p99: " << statistics.percentile99
+      << " [ms], max: " << statistics.max << " [ms]";
+  return out;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::ostream& operator<<(std::ostream& out, const PolicyComparison& comparison) {
+  out << "#compared: " << comparison.numCompared << ", #update mismatches: " << comparison.numUpdateMismatches
+      << ", max input deviation: " << comparison.maxInputDeviation << ", mean input deviation: " << comparison.meanInputDeviation;
+  return out;
+}
+
+}  // namespace ocs2
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_mpc/MPC_MRT_Interface.h"
 
+#include <chrono>
+
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/control/LinearController.h>
 
@@ -85,15 +87,21 @@ void MPC_MRT_Interface::advanceMpc() {
     currentObservation = currentObservation_;
   }
 
+  const auto runStartTime = std::chrono::steady_clock::now();
   bool controllerIsUpdated = mpc_.run(currentObservation.time, currentObservation.state);
+  const scalar_t runLatency = std::chrono::duration<scalar_t, std::milli>(std::chrono::steady_clock::now() - runStartTime).count();
   if (!controllerIsUpdated) {
+    recordMpcIteration(currentObservation, controllerIsUpdated, runLatency, vector_t());
     return;
   }
-  copyToBuffer(currentObservation);
+  vector_t policyInput;
+  copyToBuffer(currentObservation, recorderPtr_ != nullptr ? &policyInput : nullptr);
 
   // measure the delay for sending ROS messages
   mpcTimer_.endTimer();
 
+  recordMpcIteration(currentObservation, controllerIsUpdated, runLatency, std::move(policyInput));
+
   // check MPC delay and solution window compatibility
   scalar_t timeWindow = mpc_.settings().solutionTimeWindow_;
   if (mpc_.settings().solutionTimeWindow_ < 0) {
@@ -115,13 +123,16 @@ void MPC_MRT_Interface::advanceMpc() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void MPC_MRT_Interface::copyToBuffer(const SystemObservation& mpcInitObservation) {
+void MPC_MRT_Interface::copyToBuffer(const SystemObservation& mpcInitObservation, vector_t* policyInputPtr) {
   // policy
   auto primalSolutionPtr = std::make_unique<PrimalSolution>();
   const scalar_t startTime = mpcInitObservation.time;
   const scalar_t finalTime =
       (mpc_.settings().solutionTimeWindow_ < 0) ? mpc_.getSolverPtr()->getFinalTime() : startTime + mpc_.settings().solutionTimeWindow_;
   mpc_.getSolverPtr()->getPrimalSolution(finalTime, primalSolutionPtr.get());
+  if (policyInputPtr != nullptr) {
+    *policyInputPtr = primalSolutionPtr->controllerPtr_->computeInput(mpcInitObservation.time, mpcInitObservation.state);
+  }
 
   // command
   auto commandPtr = std::make_unique<CommandData>();
@@ -135,6 +146,31 @@ void MPC_MRT_Interface::copyToBuffer(const SystemObservation& mpcInitObservation
   this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_MRT_Interface::recordMpcIteration(const SystemObservation& mpcInitObservation, bool controllerIsUpdated, scalar_t latency,
+                                           vector_t policyInput) {
+  if (recorderPtr_ != nullptr) {
+    recorderPtr_->record(mpcInitObservation, getReferenceManager(), controllerIsUpdated, latency, std::move(policyInput));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_MRT_Interface::startRecording(const std::string& filename) {
+  recorderPtr_.reset();  // closes the previous recording before a new file is opened
+  recorderPtr_.reset(new ClosedLoopRecorder(filename));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_MRT_Interface::stopRecording() {
+  recorderPtr_.reset();
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
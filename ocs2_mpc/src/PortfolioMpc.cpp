@@ -0,0 +1,278 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/PortfolioMpc.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+
+namespace ocs2 {
+
+/**
+ * The ReferenceManager that each solver of the portfolio sees. It holds a copy of the references of the portfolio, which are updated once
+ * before the race, such that a cancelled solver that finishes its last iteration is not affected by the update for the next call.
+ * Therefore, its preSolverRun() does nothing. The references are set to the ReferenceManager of the portfolio.
+ */
+class PortfolioMpc::SolverReferenceManager final : public ReferenceManagerInterface {
+ public:
+  explicit SolverReferenceManager(const std::shared_ptr<ReferenceManagerInterface>& referenceManagerPtr)
+      : referenceManagerPtr_(referenceManagerPtr) {}
+  ~SolverReferenceManager() override = default;
+
+  /** Copies the active references of the portfolio. Must not be called while the solver is running. */
+  void updateReferences() {
+    modeSchedule_ = referenceManagerPtr_->getModeSchedule();
+    targetTrajectories_ = referenceManagerPtr_->getTargetTrajectories();
+  }
+
+  const ModeSchedule& getModeSchedule() const override { return modeSchedule_; }
+  void setModeSchedule(const ModeSchedule& modeSchedule) override { referenceManagerPtr_->setModeSchedule(modeSchedule); }
+  void setModeSchedule(ModeSchedule&& modeSchedule) override { referenceManagerPtr_->setModeSchedule(std::move(modeSchedule)); }
+
+  const TargetTrajectories& getTargetTrajectories() const override { return targetTrajectories_; }
+  void setTargetTrajectories(const TargetTrajectories& targetTrajectories) override {
+    referenceManagerPtr_->setTargetTrajectories(targetTrajectories);
+  }
+  void setTargetTrajectories(TargetTrajectories&& targetTrajectories) override {
+    referenceManagerPtr_->setTargetTrajectories(std::move(targetTrajectories));
+  }
+
+  const ModeSchedule& getInputModeSchedule() const override { return referenceManagerPtr_->getInputModeSchedule(); }
+  size_t getNumModeScheduleUpdates() const override { return referenceManagerPtr_->getNumModeScheduleUpdates(); }
+
+  const TargetTrajectories& getInputTargetTrajectories() const override { return referenceManagerPtr_->getInputTargetTrajectories(); }
+  size_t getNumTargetTrajectoriesUpdates() const override { return referenceManagerPtr_->getNumTargetTrajectoriesUpdates(); }
+
+ private:
+  const std::shared_ptr<ReferenceManagerInterface>& referenceManagerPtr_;
+  ModeSchedule modeSchedule_;
+  TargetTrajectories targetTrajectories_;
+};
+
+namespace {
+scalar_t constraintViolation(const SolverBase& solver) {
+  const auto& performance = solver.getPerformanceIndeces();
+  return std::sqrt(performance.dynamicsViolationSSE + performance.equalityConstraintsSSE + performance.inequalityConstraintsSSE);
+}
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PortfolioMpc::PortfolioMpc(mpc::Settings mpcSettings, portfolio_mpc::Settings settings, std::vector<std::string> solverNames,
+                           std::vector<std::unique_ptr<SolverBase>> solvers)
+    : MPC_BASE(std::move(mpcSettings)),
+      portfolioSettings_(std::move(settings)),
+      solverNames_(std::move(solverNames)),
+      solvers_(std::move(solvers)),
+      referenceManagerPtr_(new ReferenceManager),
+      numWins_(solvers_.size(), 0),
+      runningSolvers_(solvers_.size()),
+      threadPool_(solvers_.size(), portfolioSettings_.threadPriority) {
+  if (solvers_.empty()) {
+    throw std::runtime_error("[PortfolioMpc] The portfolio needs at least one solver!");
+  }
+  if (solverNames_.size() != solvers_.size()) {
+    throw std::runtime_error("[PortfolioMpc] The number of solver names does not match the number of solvers!");
+  }
+  for (auto& solverPtr : solvers_) {
+    if (solverPtr == nullptr) {
+      throw std::runtime_error("[PortfolioMpc] Solver pointer cannot be a nullptr!");
+    }
+    solverReferenceManagers_.push_back(std::make_shared<SolverReferenceManager>(referenceManagerPtr_));
+    solverPtr->setReferenceManager(solverReferenceManagers_.back());
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PortfolioMpc::~PortfolioMpc() {
+  for (auto& solverPtr : solvers_) {
+    solverPtr->requestTermination();
+  }
+  waitForSolvers();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PortfolioMpc::reset() {
+  waitForSolvers();
+  for (auto& solverPtr : solvers_) {
+    solverPtr->reset();
+  }
+  winnerIndex_ = 0;
+  std::fill(numWins_.begin(), numWins_.end(), 0);
+  MPC_BASE::reset();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PortfolioMpc::setReferenceManager(std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr) {
+  if (referenceManagerPtr == nullptr) {
+    throw std::runtime_error("[PortfolioMpc] ReferenceManager pointer cannot be a nullptr!");
+  }
+  waitForSolvers();
+  referenceManagerPtr_ = std::move(referenceManagerPtr);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PortfolioMpc::calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  // update the references and modules once for all solvers
+  referenceManagerPtr_->preSolverRun(initTime, finalTime, initState);
+  for (auto& module : synchronizedModules_) {
+    module->preSolverRun(initTime, finalTime, initState, *referenceManagerPtr_);
+  }
+
+  // The cancelled solvers of the previous call which are still finishing their last iteration sit out this race. The solver of the
+  // previous policy has returned, so at least one solver takes part.
+  const size_t numSolvers = solvers_.size();
+  std::vector<size_t> racingSolvers;
+  for (size_t i = 0; i < numSolvers; ++i) {
+    if (!isRunning(i)) {
+      racingSolvers.push_back(i);
+    }
+  }
+
+  // start the race, the solvers get their own copy of the initial state
+  {
+    std::lock_guard<std::mutex> lock(raceMutex_);
+    ++raceId_;
+    finishOrder_.clear();
+    errors_.assign(numSolvers, nullptr);
+  }
+  for (const size_t i : racingSolvers) {
+    if (settings().coldStart_) {
+      solvers_[i]->reset();
+    }
+    solvers_[i]->requestTermination(false);
+    solverReferenceManagers_[i]->updateReferences();
+  }
+  for (const size_t i : racingSolvers) {
+    runningSolvers_[i] = threadPool_.run([this, i, initTime, initState, finalTime, raceId = raceId_](int) {
+      std::exception_ptr error = nullptr;
+      try {
+        solvers_[i]->run(initTime, initState, finalTime);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      std::lock_guard<std::mutex> lock(raceMutex_);
+      if (raceId == raceId_) {
+        errors_[i] = error;
+        finishOrder_.push_back(i);
+        raceCondition_.notify_one();
+      }
+    });
+  }
+
+  // wait for the first accepted policy or for all racing solvers
+  size_t numChecked = 0;
+  bool isAccepted = false;
+  std::unique_lock<std::mutex> lock(raceMutex_);
+  while (!isAccepted && numChecked < racingSolvers.size()) {
+    raceCondition_.wait(lock, [&] { return finishOrder_.size() > numChecked; });
+    for (; numChecked < finishOrder_.size(); ++numChecked) {
+      const size_t i = finishOrder_[numChecked];
+      if (errors_[i] == nullptr && constraintViolation(*solvers_[i]) < portfolioSettings_.constraintTolerance) {
+        winnerIndex_ = i;
+        isAccepted = true;
+        break;
+      }
+    }
+  }
+
+  // cancel the others as soon as the winner is known, they stop after their current iteration in the background
+  if (isAccepted) {
+    for (const size_t i : racingSolvers) {
+      if (i != winnerIndex_) {
+        solvers_[i]->requestTermination();
+      }
+    }
+  }
+
+  // without an accepted policy, the one with the smallest constraint violation is taken
+  if (!isAccepted) {
+    scalar_t minConstraintViolation = std::numeric_limits<scalar_t>::infinity();
+    for (const size_t i : finishOrder_) {
+      if (errors_[i] == nullptr && constraintViolation(*solvers_[i]) < minConstraintViolation) {
+        minConstraintViolation = constraintViolation(*solvers_[i]);
+        winnerIndex_ = i;
+      }
+    }
+    if (std::isinf(minConstraintViolation)) {
+      std::rethrow_exception(errors_[finishOrder_.front()]);
+    }
+  }
+  lock.unlock();
+  ++numWins_[winnerIndex_];
+
+  if (settings().debugPrint_) {
+    std::cerr << "\n### Portfolio MPC: the policy of " << solverNames_[winnerIndex_] << " is published";
+    std::cerr << (isAccepted ? " (accepted)" : " (smallest constraint violation)");
+    std::cerr << ", constraint violation: " << constraintViolation(*solvers_[winnerIndex_]) << "\n";
+  }
+
+  if (!synchronizedModules_.empty()) {
+    const auto& winner = *solvers_[winnerIndex_];
+    const auto solution = winner.primalSolution(winner.getFinalTime());
+    for (auto& module : synchronizedModules_) {
+      module->postSolverRun(solution);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool PortfolioMpc::isRunning(size_t index) const {
+  const auto& runningSolver = runningSolvers_[index];
+  return runningSolver.valid() && runningSolver.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PortfolioMpc::waitForSolvers() {
+  for (auto& runningSolver : runningSolvers_) {
+    if (runningSolver.valid()) {
+      runningSolver.wait();
+    }
+  }
+}
+
+}  // namespace ocs2
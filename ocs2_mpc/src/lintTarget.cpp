@@ -1,7 +1,11 @@
+#include <ocs2_mpc/ClosedLoopRecorder.h>
+#include <ocs2_mpc/ClosedLoopReplay.h>
 #include <ocs2_mpc/MPC_BASE.h>
 #include <ocs2_mpc/MPC_MRT_Interface.h>
 #include <ocs2_mpc/MPC_Settings.h>
 #include <ocs2_mpc/MRT_BASE.h>
+#include <ocs2_mpc/PortfolioMpc.h>
+#include <ocs2_mpc/PortfolioMpcSettings.h>
 
 #include <ocs2_mpc/CommandData.h>
 #include <ocs2_mpc/SystemObservation.h>
@@ -0,0 +1,132 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/model_data/Metrics.h>
+#include <ocs2_core/reference/ModeSchedule.h>
+#include <ocs2_core/reference/TargetTrajectories.h>
+
+#include "ocs2_oc/multiple_shooting/Transcription.h"
+#include "ocs2_oc/oc_data/TimeDiscretization.h"
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+/**
+ * Keeps track of the point at which each node of the multiple shooting transcription was last linearized. A node whose state, input,
+ * reference and mode did not change by more than a tolerance since its last linearization can keep its transcription.
+ *
+ * A kept transcription is re-centered at the current point: only its Jacobians and Hessians are reused. The zeroth-order terms, i.e. the
+ * cost, the dynamics defect and the constraint values, are always the ones evaluated at the current point, such that the performance
+ * index used by the linesearch and the convergence check is the true merit. The cost gradient is shifted with the stored Hessian. The LQ
+ * subproblem then stays a model about the current point, such that the step does not repeat the part of an earlier step that has
+ * already been taken.
+ *
+ * A node is identified by its index in the time discretization. The node i < N depends on x[i], x[i + 1] and, for intermediate nodes,
+ * u[i]. The terminal node N depends on x[N]. The reference and the mode are evaluated at the start of the interval. The time of the
+ * node itself is not compared, such that the nodes of a shifted horizon at MPC steady state can be reused. Cost and constraint terms
+ * that vary with time in another way are only refreshed by the periodic full refresh.
+ */
+class IncrementalLinearization {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] tolerance : The maximum change (infinity norm) of the state, input and reference of a node for reusing its linearization.
+   * @param [in] refreshPeriod : All nodes are linearized at least every refreshPeriod calls of update(). Values smaller than 2 disable
+   * the incremental linearization.
+   */
+  IncrementalLinearization(scalar_t tolerance, size_t refreshPeriod);
+
+  /** Forgets all linearization points such that the next update() requests the linearization of all nodes. */
+  void reset();
+
+  /**
+   * Determines the nodes that need to be linearized at the current {t, x(t), u(t)} and stores their new linearization points.
+   *
+   * @param [in] time : The annotated time trajectory.
+   * @param [in] x : The state trajectory.
+   * @param [in] u : The input trajectory.
+   * @param [in] modeSchedule : The mode schedule.
+   * @param [in] targetTrajectories : The target trajectories.
+   * @return The number of nodes that keep their previous linearization.
+   */
+  size_t update(const std::vector<AnnotatedTime>& time, const vector_array_t& x, const vector_array_t& u, const ModeSchedule& modeSchedule,
+                const TargetTrajectories& targetTrajectories);
+
+  /** Whether node i has to be linearized after the last update(). */
+  bool needsLinearization(size_t i) const { return needsLinearization_[i]; }
+
+  /** Stores the (unprojected) transcription of node i at its linearization point. Different nodes can be set concurrently. */
+  void setIntermediateNode(size_t i, const Transcription& transcription) { intermediateNodes_[i] = transcription; }
+  void setEventNode(size_t i, const EventTranscription& transcription) { eventNodes_[i] = transcription; }
+  void setTerminalNode(const TerminalTranscription& transcription) { terminalNode_ = transcription; }
+
+  /**
+   * Returns the stored transcription of intermediate node i re-centered at {x, u}.
+   *
+   * @param [in] i : The node index.
+   * @param [in] x : State at start of the interval.
+   * @param [in] u : Input of the interval.
+   * @param [in] metrics : The cost, dynamics defect and constraint values evaluated at the current point, see computeIntermediateMetrics.
+   */
+  Transcription getIntermediateNode(size_t i, const vector_t& x, const vector_t& u, const Metrics& metrics) const;
+
+  /** Returns the stored transcription of event node i re-centered at x, with the values of computeEventMetrics at the current point. */
+  EventTranscription getEventNode(size_t i, const vector_t& x, const Metrics& metrics) const;
+
+  /** Returns the stored transcription of the terminal node re-centered at x, with the values of computeTerminalMetrics at x. */
+  TerminalTranscription getTerminalNode(const vector_t& x, const Metrics& metrics) const;
+
+ private:
+  struct LinearizationPoint {
+    AnnotatedTime::Event event = AnnotatedTime::Event::None;
+    scalar_t duration = 0.0;  // duration of the interval, zero for event and terminal nodes
+    size_t mode = 0;
+    vector_t state;
+    vector_t nextState;
+    vector_t input;
+    vector_t desiredState;
+    vector_t desiredInput;
+  };
+
+  scalar_t tolerance_;
+  size_t refreshPeriod_;
+  size_t updatesSinceRefresh_ = 0;
+  std::vector<LinearizationPoint> points_;
+  std::vector<bool> needsLinearization_;
+  std::vector<Transcription> intermediateNodes_;
+  std::vector<EventTranscription> eventNodes_;
+  TerminalTranscription terminalNode_;
+};
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
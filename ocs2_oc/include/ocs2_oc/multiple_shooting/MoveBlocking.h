@@ -0,0 +1,136 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+
+#include "ocs2_oc/oc_data/TimeDiscretization.h"
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+/**
+ * Move blocking ties the inputs of consecutive intervals to the input of the first interval of their block. The blocks are described
+ * by an array that holds for each interval i the index of the first interval of its block, i.e., blocks[i] == i for an interval with a
+ * free input (a block leader) and blocks[i] < i for an interval whose input is tied (a block follower).
+ *
+ * In the LQ subproblem, each block is condensed into a single stage. For a block starting at interval k, the states of the followers
+ * are affine in the state at the leader and the held input: dx_j = M_j [dx_k; du] + m_j. Substituting them in the dynamics, cost and
+ * constraints of the block results in one stage from dx_k to the state at the next leader. The QP keeps its stage-wise structure with
+ * one stage per block, and the states of the followers are recovered by a forward simulation of the block.
+ */
+
+/** LQ subproblem with one stage per block. */
+struct BlockedLqProblem {
+  std::vector<VectorFunctionLinearApproximation> dynamics;
+  std::vector<ScalarFunctionQuadraticApproximation> cost;
+  std::vector<VectorFunctionLinearApproximation> constraints;
+};
+
+/**
+ * Computes the input blocks of a time discretization. Intervals starting before blockingStartTime keep their own input. After
+ * blockingStartTime, blockSize consecutive intervals share one input. Blocks are not extended over events.
+ *
+ * @param [in] time : The annotated time trajectory.
+ * @param [in] blockingStartTime : The time from which on inputs are blocked.
+ * @param [in] blockSize : The maximum number of intervals in a block. Values smaller than 2 disable move blocking.
+ * @return For each interval, the index of the first interval of its block.
+ */
+std::vector<int> computeMoveBlocks(const std::vector<AnnotatedTime>& time, scalar_t blockingStartTime, size_t blockSize);
+
+/**
+ * Splits the blocks where the input dimension of the LQ subproblem changes, e.g., when the number of projected inputs changes due to a
+ * change in the active state-input equality constraints.
+ *
+ * @param [in] dynamics : Linear approximation of the dynamics.
+ * @param [in, out] blocks : The input blocks.
+ */
+void splitMoveBlocks(const std::vector<VectorFunctionLinearApproximation>& dynamics, std::vector<int>& blocks);
+
+/** Returns true if at least one interval shares the input of another interval. */
+bool hasBlockedInputs(const std::vector<int>& blocks);
+
+/** Ties the input trajectory to the blocks: u[i] = u[blocks[i]]. */
+void applyMoveBlocks(const std::vector<int>& blocks, vector_array_t& u);
+
+/**
+ * Condenses the LQ subproblem to one stage per block.
+ *
+ * @param [in] blocks : The input blocks.
+ * @param [in] dynamics : Linear approximation of the dynamics.
+ * @param [in] cost : Quadratic approximation of the cost.
+ * @param [in] constraints : Linear approximation of the constraints. Pass nullptr if there is no constraints.
+ * @param [out] blockedProblem : The blocked LQ subproblem. The constraints are left empty if constraints is nullptr.
+ */
+void blockLinearQuadraticProblem(const std::vector<int>& blocks, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                 const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                                 const std::vector<VectorFunctionLinearApproximation>* constraints, BlockedLqProblem& blockedProblem);
+
+/**
+ * Maps the solution of the blocked LQ subproblem back to all nodes. The held input is repeated over the block and the states of the
+ * followers are recovered by a forward simulation of the linearized dynamics.
+ *
+ * @param [in] blocks : The input blocks.
+ * @param [in] dynamics : Linear approximation of the original (unblocked) dynamics.
+ * @param [in, out] deltaXSol : The state trajectory of the QP subproblem solution, one entry per block plus the final state on input.
+ * @param [in, out] deltaUSol : The input trajectory of the QP subproblem solution, one entry per block on input.
+ */
+void unblockSolution(const std::vector<int>& blocks, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                     vector_array_t& deltaXSol, vector_array_t& deltaUSol);
+
+/**
+ * Maps the Riccati cost-to-go of the blocked LQ subproblem back to all nodes. At the block followers, the cost-to-go is the one of the
+ * remaining block with the held input minimized out.
+ *
+ * @param [in] blocks : The input blocks.
+ * @param [in] dynamics : Linear approximation of the original (unblocked) dynamics.
+ * @param [in] cost : Quadratic approximation of the original (unblocked) cost.
+ * @param [in, out] costToGo : The cost-to-go, one entry per block plus the final state on input.
+ */
+void unblockCostToGo(const std::vector<int>& blocks, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                     const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                     std::vector<ScalarFunctionQuadraticApproximation>& costToGo);
+
+/**
+ * Maps the Riccati feedback gains of the blocked LQ subproblem back to all intervals. The gain of a block follower re-optimizes the
+ * held input over the remaining block for a deviation of the state: K = -inv(Suu) * Sux, with S the cost-to-go on [dx; du].
+ *
+ * @param [in] blocks : The input blocks.
+ * @param [in] dynamics : Linear approximation of the original (unblocked) dynamics.
+ * @param [in] cost : Quadratic approximation of the original (unblocked) cost.
+ * @param [in] costToGo : The cost-to-go of the blocked LQ subproblem, one entry per block plus the final state.
+ * @param [in, out] KMatrices : The feedback gains, one entry per block on input.
+ */
+void unblockFeedback(const std::vector<int>& blocks, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                     const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                     const std::vector<ScalarFunctionQuadraticApproximation>& costToGo, matrix_array_t& KMatrices);
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
@@ -76,6 +76,26 @@ std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scala
                                                         const scalar_array_t& eventTimes,
                                                         scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>());
 
+/**
+ * Decides on a graded time discretization along the horizon. The discretization step starts with dt at initTime and grows
+ * geometrically by dtGrowthFactor per node until it reaches dtMax, such that the far end of the horizon is discretized coarser than
+ * its beginning. The event times are part of the discretization as in timeDiscretizationWithEvents(). For dtGrowthFactor = 1, the
+ * result is identical to timeDiscretizationWithEvents().
+ *
+ * @param initTime : start time.
+ * @param finalTime : final time.
+ * @param dt : discretization step at the start of the horizon.
+ * @param dtGrowthFactor : growth factor of the discretization step per node. Throws std::invalid_argument if it is less than 1.
+ * @param dtMax : maximum discretization step.
+ * @param eventTimes : Event times where a time discretization must be made.
+ * @param dt_min : minimum discretization step. Smaller intervals will be merged. Needs to be bigger than limitEpsilon to avoid
+ * interpolation problems
+ * @return vector of discrete time points
+ */
+std::vector<AnnotatedTime> gradedTimeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt, scalar_t dtGrowthFactor,
+                                                              scalar_t dtMax, const scalar_array_t& eventTimes,
+                                                              scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>());
+
 /**
  * Extracts the time trajectory from the annotated time trajectory.
  *
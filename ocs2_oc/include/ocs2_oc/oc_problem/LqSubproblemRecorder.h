@@ -0,0 +1,97 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+#include "ocs2_oc/oc_problem/OcpSize.h"
+
+namespace ocs2 {
+
+/** The linear quadratic subproblem as it is passed to the QP solvers. */
+struct LqSubproblem {
+  OcpSize ocpSize;
+  vector_t x0;                                                 // initial state (deviation)
+  std::vector<VectorFunctionLinearApproximation> dynamics;     // N stages
+  std::vector<ScalarFunctionQuadraticApproximation> cost;      // N + 1 nodes
+  std::vector<VectorFunctionLinearApproximation> constraints;  // N + 1 nodes, empty if the problem is unconstrained
+};
+
+/**
+ * Records the linear quadratic subproblems of a solver to a binary file, such that the QP solvers can be compared offline on real
+ * problems (see loadLqSubproblems()). The file starts with a header that identifies the format and each subproblem is appended as one
+ * record of its sizes and the matrices of its dynamics, cost and constraints in double precision.
+ */
+class LqSubproblemRecorder {
+ public:
+  /**
+   * Constructor. Opens the file and writes the header, any existing content of the file is discarded.
+   *
+   * @param [in] filename : The file to which the subproblems are recorded.
+   * @param [in] recordingPeriod : Every recordingPeriod-th subproblem passed to record() is written to the file, starting with the first.
+   */
+  explicit LqSubproblemRecorder(const std::string& filename, size_t recordingPeriod = 1);
+
+  /**
+   * Records a subproblem if it is selected by the recording period. The file is buffered and only flushed once the recorder is destroyed.
+   *
+   * @param [in] x0 : Initial state (deviation).
+   * @param [in] dynamics : Linearized approximation of the discrete dynamics.
+   * @param [in] cost : Quadratic approximation of the cost.
+   * @param [in] constraints : Linearized approximation of the constraints. Pass nullptr if there is no constraints.
+   */
+  void record(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+              const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+              const std::vector<VectorFunctionLinearApproximation>* constraints);
+
+  /** Number of subproblems written to the file. */
+  size_t getNumRecorded() const { return numRecorded_; }
+
+ private:
+  const size_t recordingPeriod_;
+  size_t numCalls_ = 0;
+  size_t numRecorded_ = 0;
+  std::ofstream file_;
+};
+
+/**
+ * Loads all subproblems of a file written by LqSubproblemRecorder. Throws if the file is not a recording or if it is corrupted, i.e.,
+ * if a size read from the file exceeds the rest of the file.
+ *
+ * @param [in] filename : The recorded file.
+ * @return The subproblems in the order in which they were recorded.
+ */
+std::vector<LqSubproblem> loadLqSubproblems(const std::string& filename);
+
+}  // namespace ocs2
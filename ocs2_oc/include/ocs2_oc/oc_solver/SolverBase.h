@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -139,6 +140,24 @@ class SolverBase {
    */
   void addSolverObserver(std::unique_ptr<SolverObserver> observerModule) { solverObservers_.push_back(std::move(observerModule)); }
 
+  /**
+   * Requests the solution metrics (see getSolutionMetrics()) also when no observer is attached. Solvers that collect the metrics on
+   * demand leave them empty otherwise.
+   */
+  void requestSolutionMetrics(bool request) { isSolutionMetricsRequested_ = request; }
+
+  /** Whether the next run has to collect the solution metrics, i.e., they are requested or an observer is attached. */
+  bool isSolutionMetricsRequired() const { return isSolutionMetricsRequested_ || !solverObservers_.empty(); }
+
+  /**
+   * Requests the solver to stop after its current iteration. This method can be called from another thread while run() is executing,
+   * in which case run() returns the latest iterate. The request holds until it is withdrawn with requestTermination(false).
+   */
+  void requestTermination(bool request = true) { isTerminationRequested_ = request; }
+
+  /** Whether the solver is requested to stop after its current iteration. */
+  bool isTerminationRequested() const { return isTerminationRequested_; }
+
   /**
    * @brief Returns a const reference to the definition of optimal control problem.
    *
@@ -199,6 +218,7 @@ class SolverBase {
 
   /**
    * @brief Returns the optimized value of the Metrics.
+   * The multiple shooting solvers only collect them if isSolutionMetricsRequired(), otherwise they are empty.
    *
    * @return: The solution's metrics.
    */
@@ -270,6 +290,8 @@ class SolverBase {
   std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr_;  // this pointer cannot be nullptr
   std::vector<std::shared_ptr<SolverSynchronizedModule>> synchronizedModules_;
   std::vector<std::unique_ptr<SolverObserver>> solverObservers_;
+  bool isSolutionMetricsRequested_ = false;
+  std::atomic_bool isTerminationRequested_{false};
 };
 
 }  // namespace ocs2
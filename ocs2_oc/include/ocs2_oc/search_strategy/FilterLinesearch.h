@@ -29,7 +29,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
+#include <functional>
+
 #include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
 #include <ocs2_oc/oc_data/PerformanceIndex.h>
 
 namespace ocs2 {
@@ -59,12 +63,48 @@ struct FilterLinesearch {
   std::pair<bool, StepType> acceptStep(const PerformanceIndex& baselinePerformance, const PerformanceIndex& stepPerformance,
                                        scalar_t armijoDescentMetric) const;
 
+  /**
+   * Speculative linesearch: evaluates the candidate step sizes concurrently on the thread pool and accepts the largest step size
+   * which passes acceptStep(), i.e., the same step as a serial backtracking over stepSizes. As soon as this step is known, the
+   * ongoing evaluations are cancelled.
+   *
+   * @param [in] threadPool : The thread pool.
+   * @param [in] numWorkers : The number of concurrent step evaluations.
+   * @param [in] baselinePerformance : The zero step PerformanceIndex
+   * @param [in] armijoDescentMetric : The full step Armijo descent metric defined as dc/dw' * delta_w
+   * @param [in] stepSizes : The candidate step sizes in decreasing order.
+   * @param [in] evaluateStep : Computes the PerformanceIndex of a step size with the resources of the given worker. The evaluation may
+   *                            return early once the given flag is set, in which case its result is discarded.
+   * @param [in] storeStep : Stores the step of the given worker as the best accepted step so far. It is called under a lock.
+   * @return The index of the accepted step size in stepSizes (-1 if all steps are rejected) and its step type.
+   */
+  std::pair<int, StepType> speculativeStep(
+      ThreadPool& threadPool, size_t numWorkers, const PerformanceIndex& baselinePerformance, scalar_t armijoDescentMetric,
+      const scalar_array_t& stepSizes,
+      const std::function<PerformanceIndex(int workerId, scalar_t stepSize, const std::atomic_bool& cancelled)>& evaluateStep,
+      const std::function<void(int workerId, const PerformanceIndex& stepPerformance)>& storeStep) const;
+
   /** Compute total constraint violation */
   static scalar_t totalConstraintViolation(const PerformanceIndex& performance) {
     return std::sqrt(performance.dynamicsViolationSSE + performance.equalityConstraintsSSE);
   }
 };
 
+/**
+ * Computes the step sizes of a backtracking linesearch. Starting from maxStepSize, the step size is multiplied by alphaDecay until
+ * it drops below alphaMin, or until the primal steps |dx| and |du| both drop below deltaTol. The first step size is always tried.
+ *
+ * @param [in] maxStepSize: The first step size.
+ * @param [in] alphaDecay: The backtracking factor.
+ * @param [in] alphaMin: The minimum step size.
+ * @param [in] deltaTol: The minimum primal step norm.
+ * @param [in] deltaXnorm: The norm of the full state step.
+ * @param [in] deltaUnorm: The norm of the full input step.
+ * @return The candidate step sizes in decreasing order.
+ */
+scalar_array_t backtrackingStepSizes(scalar_t maxStepSize, scalar_t alphaDecay, scalar_t alphaMin, scalar_t deltaTol, scalar_t deltaXnorm,
+                                     scalar_t deltaUnorm);
+
 /** Transforms the StepType to string */
 std::string toString(const FilterLinesearch::StepType& stepType);
 
@@ -0,0 +1,83 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <functional>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/model_data/Metrics.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_oc/oc_data/PerformanceIndex.h"
+#include "ocs2_oc/search_strategy/FilterLinesearch.h"
+
+namespace ocs2 {
+
+/** The result of speculativeLinesearch() */
+struct SpeculativeLinesearchResult {
+  int stepIndex = -1;  // index of the accepted step size, -1 if all step sizes are rejected
+  FilterLinesearch::StepType stepType = FilterLinesearch::StepType::ZERO;
+  PerformanceIndex performance;  // performance of the accepted step
+};
+
+/**
+ * Backtracking filter linesearch of the multiple shooting solvers which evaluates the backtracking step sizes speculatively.
+ *
+ * The first step size is evaluated with all workers sharing its nodes, i.e. as fast as a serial linesearch. Only if it is rejected, the
+ * remaining step sizes are evaluated concurrently with one step size per worker, see FilterLinesearch::speculativeStep(). The accepted
+ * step is the same as the one of a serial backtracking over stepSizes.
+ *
+ * The trajectories of a candidate are {trajectories[k] + stepSize * searchDirections[k]}, e.g. {x, u} or {x, u, slacks}. The
+ * PerformanceIndex of a candidate is the sum of evaluateNode() over its numNodes nodes, with the merit set to cost + equalityLagrangian +
+ * inequalityLagrangian.
+ *
+ * @param [in] filterLinesearch : The filter linesearch.
+ * @param [in] threadPool : The thread pool.
+ * @param [in] numWorkers : The number of workers. The workerId passed to evaluateNode is in [0, numWorkers).
+ * @param [in] baselinePerformance : The zero step PerformanceIndex.
+ * @param [in] armijoDescentMetric : The full step Armijo descent metric defined as dc/dw' * delta_w.
+ * @param [in] stepSizes : The candidate step sizes in decreasing order, see backtrackingStepSizes().
+ * @param [in] numNodes : The number of nodes of a candidate.
+ * @param [in] evaluateNode : Computes the metrics of a node of the given candidate with the resources of the given worker and returns the
+ *                            contribution of the node to the PerformanceIndex.
+ * @param [in] searchDirections : The search direction of each trajectory.
+ * @param [in, out] trajectories : The current trajectories. They are replaced by the accepted step.
+ * @param [out] metrics : The metrics of the accepted step. Unchanged if all step sizes are rejected.
+ * @return The accepted step.
+ */
+SpeculativeLinesearchResult speculativeLinesearch(
+    const FilterLinesearch& filterLinesearch, ThreadPool& threadPool, size_t numWorkers, const PerformanceIndex& baselinePerformance,
+    scalar_t armijoDescentMetric, const scalar_array_t& stepSizes, size_t numNodes,
+    const std::function<PerformanceIndex(int workerId, int nodeIndex, const std::vector<vector_array_t>& candidate, Metrics& metrics)>&
+        evaluateNode,
+    const std::vector<std::reference_wrapper<const vector_array_t>>& searchDirections, std::vector<vector_array_t>& trajectories,
+    std::vector<Metrics>& metrics);
+
+}  // namespace ocs2
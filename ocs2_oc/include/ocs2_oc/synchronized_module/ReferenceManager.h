@@ -59,6 +59,12 @@ class ReferenceManager : public ReferenceManagerInterface {
     return targetTrajectories_.setBuffer(std::move(targetTrajectories));
   }
 
+  const ModeSchedule& getInputModeSchedule() const override { return inputModeSchedule_; }
+  size_t getNumModeScheduleUpdates() const override { return numModeScheduleUpdates_; }
+
+  const TargetTrajectories& getInputTargetTrajectories() const override { return inputTargetTrajectories_; }
+  size_t getNumTargetTrajectoriesUpdates() const override { return numTargetTrajectoriesUpdates_; }
+
  protected:
   /**
    * Modifies the active ModeSchedule and TargetTrajectories.
@@ -77,6 +83,12 @@ class ReferenceManager : public ReferenceManagerInterface {
  private:
   BufferedValue<ModeSchedule> modeSchedule_;
   BufferedValue<TargetTrajectories> targetTrajectories_;
+
+  // The references before modifyReferences(), only copied when a new reference is activated
+  ModeSchedule inputModeSchedule_;
+  size_t numModeScheduleUpdates_ = 0;
+  TargetTrajectories inputTargetTrajectories_;
+  size_t numTargetTrajectoriesUpdates_ = 0;
 };
 
 }  // namespace ocs2
@@ -64,6 +64,12 @@ class ReferenceManagerDecorator : public ReferenceManagerInterface {
     referenceManagerPtr_->setTargetTrajectories(std::move(targetTrajectories));
   }
 
+  const ModeSchedule& getInputModeSchedule() const override { return referenceManagerPtr_->getInputModeSchedule(); }
+  size_t getNumModeScheduleUpdates() const override { return referenceManagerPtr_->getNumModeScheduleUpdates(); }
+
+  const TargetTrajectories& getInputTargetTrajectories() const override { return referenceManagerPtr_->getInputTargetTrajectories(); }
+  size_t getNumTargetTrajectoriesUpdates() const override { return referenceManagerPtr_->getNumTargetTrajectoriesUpdates(); }
+
  protected:
   std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr_;
 };
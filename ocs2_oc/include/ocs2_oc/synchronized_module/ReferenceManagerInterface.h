@@ -90,6 +90,25 @@ class ReferenceManagerInterface {
    * @note: This method must be thread safe.
    */
   virtual void setTargetTrajectories(TargetTrajectories&& targetTrajectories) = 0;
+
+  /**
+   * Returns a const reference to the ModeSchedule as it was set by setModeSchedule() and activated by the last preSolverRun(), i.e.,
+   * before any modification in preSolverRun(). Used to record the inputs of the solver, such that they can be replayed.
+   */
+  virtual const ModeSchedule& getInputModeSchedule() const { return getModeSchedule(); }
+
+  /** Returns the number of times that preSolverRun() has activated a ModeSchedule set by setModeSchedule(). */
+  virtual size_t getNumModeScheduleUpdates() const { return 0; }
+
+  /**
+   * Returns a const reference to the TargetTrajectories as they were set by setTargetTrajectories() and activated by the last
+   * preSolverRun(), i.e., before any modification in preSolverRun(). Used to record the inputs of the solver, such that they can be
+   * replayed.
+   */
+  virtual const TargetTrajectories& getInputTargetTrajectories() const { return getTargetTrajectories(); }
+
+  /** Returns the number of times that preSolverRun() has activated TargetTrajectories set by setTargetTrajectories(). */
+  virtual size_t getNumTargetTrajectoriesUpdates() const { return 0; }
 };
 
 }  // namespace ocs2
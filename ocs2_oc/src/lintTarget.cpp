@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // oc_problem
 #include <ocs2_oc/oc_problem/LoopshapingOptimalControlProblem.h>
+#include <ocs2_oc/oc_problem/LqSubproblemRecorder.h>
 #include <ocs2_oc/oc_problem/OcpSize.h>
 #include <ocs2_oc/oc_problem/OcpToKkt.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
@@ -0,0 +1,176 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/multiple_shooting/IncrementalLinearization.h"
+
+#include <ocs2_core/NumericTraits.h>
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+namespace {
+bool isWithinTolerance(const vector_t& current, const vector_t& previous, scalar_t tolerance) {
+  if (current.size() != previous.size()) {
+    return false;
+  }
+  return current.size() == 0 || (current - previous).lpNorm<Eigen::Infinity>() <= tolerance;
+}
+
+/** Shifts the gradient of a quadratic approximation by dx and du. Pass an empty du for state-only functions. */
+void shiftGradient(ScalarFunctionQuadraticApproximation& approximation, const vector_t& dx, const vector_t& du) {
+  approximation.dfdx.noalias() += approximation.dfdxx * dx;
+  if (du.size() > 0) {
+    approximation.dfdx.noalias() += approximation.dfdux.transpose() * du;
+    approximation.dfdu.noalias() += approximation.dfduu * du;
+    approximation.dfdu.noalias() += approximation.dfdux * dx;
+  }
+}
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+IncrementalLinearization::IncrementalLinearization(scalar_t tolerance, size_t refreshPeriod)
+    : tolerance_(tolerance), refreshPeriod_(refreshPeriod) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void IncrementalLinearization::reset() {
+  updatesSinceRefresh_ = 0;
+  points_.clear();
+  needsLinearization_.clear();
+  intermediateNodes_.clear();
+  eventNodes_.clear();
+  terminalNode_ = TerminalTranscription();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t IncrementalLinearization::update(const std::vector<AnnotatedTime>& time, const vector_array_t& x, const vector_array_t& u,
+                                        const ModeSchedule& modeSchedule, const TargetTrajectories& targetTrajectories) {
+  const int N = static_cast<int>(time.size()) - 1;
+  const bool refreshAll = refreshPeriod_ < 2 || points_.size() != time.size() || updatesSinceRefresh_ + 1 >= refreshPeriod_;
+  updatesSinceRefresh_ = refreshAll ? 0 : updatesSinceRefresh_ + 1;
+  points_.resize(N + 1);
+  needsLinearization_.assign(N + 1, true);
+  intermediateNodes_.resize(N);
+  eventNodes_.resize(N);
+
+  const bool hasStateReference = !targetTrajectories.empty();
+  const bool hasInputReference = hasStateReference && !targetTrajectories.inputTrajectory.empty();
+
+  size_t numSkippedNodes = 0;
+  for (int i = 0; i <= N; ++i) {
+    // The point at which node i is evaluated
+    LinearizationPoint current;
+    current.event = time[i].event;
+    const scalar_t ti = (i < N && time[i].event == AnnotatedTime::Event::PreEvent) ? time[i].time : getIntervalStart(time[i]);
+    current.mode = modeSchedule.modeAtTime(ti);
+    current.state = x[i];
+    if (i < N) {
+      current.nextState = x[i + 1];
+      if (time[i].event != AnnotatedTime::Event::PreEvent) {
+        current.duration = getIntervalDuration(time[i], time[i + 1]);
+        current.input = u[i];
+      }
+    }
+    if (hasStateReference) {
+      current.desiredState = targetTrajectories.getDesiredState(ti);
+    }
+    if (hasInputReference) {
+      current.desiredInput = targetTrajectories.getDesiredInput(ti);
+    }
+
+    auto& previous = points_[i];
+    const bool isUnchanged = !refreshAll && current.event == previous.event &&
+                             std::abs(current.duration - previous.duration) < numeric_traits::weakEpsilon<scalar_t>() &&
+                             current.mode == previous.mode && isWithinTolerance(current.state, previous.state, tolerance_) &&
+                             isWithinTolerance(current.nextState, previous.nextState, tolerance_) &&
+                             isWithinTolerance(current.input, previous.input, tolerance_) &&
+                             isWithinTolerance(current.desiredState, previous.desiredState, tolerance_) &&
+                             isWithinTolerance(current.desiredInput, previous.desiredInput, tolerance_);
+
+    if (isUnchanged) {
+      needsLinearization_[i] = false;
+      ++numSkippedNodes;
+    } else {
+      // Keep the point of the new linearization. The transcription is set by the caller.
+      previous = std::move(current);
+    }
+  }
+
+  return numSkippedNodes;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Transcription IncrementalLinearization::getIntermediateNode(size_t i, const vector_t& x, const vector_t& u, const Metrics& metrics) const {
+  const auto& point = points_[i];
+
+  Transcription transcription = intermediateNodes_[i];
+  shiftGradient(transcription.cost, x - point.state, u - point.input);
+  transcription.cost.f = metrics.cost;
+  transcription.dynamics.f = metrics.dynamicsViolation;
+  transcription.stateEqConstraints.f = toVector(metrics.stateEqConstraint);
+  transcription.stateInputEqConstraints.f = toVector(metrics.stateInputEqConstraint);
+  transcription.stateIneqConstraints.f = toVector(metrics.stateIneqConstraint);
+  transcription.stateInputIneqConstraints.f = toVector(metrics.stateInputIneqConstraint);
+  return transcription;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+EventTranscription IncrementalLinearization::getEventNode(size_t i, const vector_t& x, const Metrics& metrics) const {
+  EventTranscription transcription = eventNodes_[i];
+  shiftGradient(transcription.cost, x - points_[i].state, vector_t());
+  transcription.cost.f = metrics.cost;
+  transcription.dynamics.f = metrics.dynamicsViolation;
+  transcription.eqConstraints.f = toVector(metrics.stateEqConstraint);
+  transcription.ineqConstraints.f = toVector(metrics.stateIneqConstraint);
+  return transcription;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TerminalTranscription IncrementalLinearization::getTerminalNode(const vector_t& x, const Metrics& metrics) const {
+  TerminalTranscription transcription = terminalNode_;
+  shiftGradient(transcription.cost, x - points_.back().state, vector_t());
+  transcription.cost.f = metrics.cost;
+  transcription.eqConstraints.f = toVector(metrics.stateEqConstraint);
+  transcription.ineqConstraints.f = toVector(metrics.stateIneqConstraint);
+  return transcription;
+}
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
@@ -0,0 +1,369 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/multiple_shooting/MoveBlocking.h"
+
+#include <algorithm>
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+namespace {
+/** The input of interval i is tied to the one of an earlier interval. */
+inline bool isBlockFollower(const std::vector<int>& blocks, int i) {
+  return blocks[i] != i;
+}
+
+/** The first interval of each block. */
+std::vector<int> getBlockLeaders(const std::vector<int>& blocks) {
+  std::vector<int> leaders;
+  leaders.reserve(blocks.size());
+  for (int i = 0; i < blocks.size(); ++i) {
+    if (!isBlockFollower(blocks, i)) {
+      leaders.push_back(i);
+    }
+  }
+  return leaders;
+}
+
+/**
+ * Computes the cost-to-go on [dx_j; du] for the followers j of the block [k, end), backwards from the cost-to-go at the state after
+ * the block. Sm[j - k] and Sv[j - k] hold the Hessian and gradient of follower j.
+ */
+void computeFollowerCostToGo(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                             const std::vector<ScalarFunctionQuadraticApproximation>& cost, int k, int end,
+                             const ScalarFunctionQuadraticApproximation& nextCostToGo, matrix_array_t& Sm, vector_array_t& Sv) {
+  const int nx = dynamics[k].dfdx.cols();
+  const int nu = dynamics[k].dfdu.cols();
+  Sm.resize(end - k);
+  Sv.resize(end - k);
+
+  // Cost-to-go on [dx_end; du], the held input has no cost after the block
+  matrix_t SmNext = matrix_t::Zero(nx + nu, nx + nu);
+  SmNext.topLeftCorner(nx, nx) = nextCostToGo.dfdxx;
+  vector_t SvNext = vector_t::Zero(nx + nu);
+  SvNext.head(nx) = nextCostToGo.dfdx;
+
+  matrix_t T = matrix_t::Identity(nx + nu, nx + nu);  // [dx_{j+1}; du] = T [dx_j; du] + [b_j; 0]
+  for (int j = end - 1; j > k; --j) {
+    T.topLeftCorner(nx, nx) = dynamics[j].dfdx;
+    T.topRightCorner(nx, nu) = dynamics[j].dfdu;
+    SvNext.head(nx).noalias() += SmNext.topLeftCorner(nx, nx) * dynamics[j].f;
+    SvNext.tail(nu).noalias() += SmNext.bottomLeftCorner(nu, nx) * dynamics[j].f;
+
+    auto& Smj = Sm[j - k];
+    Smj.resize(nx + nu, nx + nu);
+    Smj << cost[j].dfdxx, cost[j].dfdux.transpose(), cost[j].dfdux, cost[j].dfduu;
+    Smj.noalias() += T.transpose() * SmNext * T;
+    auto& Svj = Sv[j - k];
+    Svj.resize(nx + nu);
+    Svj << cost[j].dfdx, cost[j].dfdu;
+    Svj.noalias() += T.transpose() * SvNext;
+
+    SmNext = Smj;
+    SvNext = Svj;
+  }
+}
+}  // namespace
+
+std::vector<int> computeMoveBlocks(const std::vector<AnnotatedTime>& time, scalar_t blockingStartTime, size_t blockSize) {
+  const int N = static_cast<int>(time.size()) - 1;
+  std::vector<int> blocks(std::max(N, 0));
+
+  int leader = 0;
+  for (int i = 0; i < N; ++i) {
+    // Event intervals have no input. Their successors start a new block.
+    const bool joinsBlock = i > 0 && time[i].event != AnnotatedTime::Event::PreEvent &&
+                            time[leader].event != AnnotatedTime::Event::PreEvent && time[leader].time >= blockingStartTime &&
+                            static_cast<size_t>(i - leader) < blockSize;
+    if (!joinsBlock) {
+      leader = i;
+    }
+    blocks[i] = leader;
+  }
+
+  return blocks;
+}
+
+void splitMoveBlocks(const std::vector<VectorFunctionLinearApproximation>& dynamics, std::vector<int>& blocks) {
+  assert(dynamics.size() >= blocks.size());
+  int leader = 0;
+  for (int i = 0; i < blocks.size(); ++i) {
+    const bool joinsBlock = isBlockFollower(blocks, i) && dynamics[i].dfdx.cols() == dynamics[leader].dfdx.cols() &&
+                            dynamics[i].dfdu.cols() == dynamics[leader].dfdu.cols();
+    if (!joinsBlock) {
+      leader = i;
+    }
+    blocks[i] = leader;
+  }
+}
+
+bool hasBlockedInputs(const std::vector<int>& blocks) {
+  for (int i = 0; i < blocks.size(); ++i) {
+    if (isBlockFollower(blocks, i)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void applyMoveBlocks(const std::vector<int>& blocks, vector_array_t& u) {
+  for (int i = 0; i < blocks.size(); ++i) {
+    if (isBlockFollower(blocks, i)) {
+      u[i] = u[blocks[i]];
+    }
+  }
+}
+
+void blockLinearQuadraticProblem(const std::vector<int>& blocks, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                 const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                                 const std::vector<VectorFunctionLinearApproximation>* constraints, BlockedLqProblem& blockedProblem) {
+  const int N = blocks.size();
+  const auto leaders = getBlockLeaders(blocks);
+  const int numBlocks = leaders.size();
+
+  blockedProblem.dynamics.resize(numBlocks);
+  blockedProblem.cost.resize(numBlocks + 1);
+  blockedProblem.cost[numBlocks] = cost[N];
+  if (constraints != nullptr) {
+    blockedProblem.constraints.resize(numBlocks + 1);
+    blockedProblem.constraints[numBlocks] = (*constraints)[N];
+  } else {
+    blockedProblem.constraints.clear();
+  }
+
+  // Temporaries for re-use.
+  matrix_t M, T, Hj, HjT, Cz;
+  vector_t m, t, gj, Hjt;
+  std::vector<matrix_t> constraintJacobians;
+  std::vector<vector_t> constraintValues;
+
+  for (int s = 0; s < numBlocks; ++s) {
+    const int k = leaders[s];
+    const int end = (s + 1 < numBlocks) ? leaders[s + 1] : N;
+    if (end == k + 1) {
+      blockedProblem.dynamics[s] = dynamics[k];
+      blockedProblem.cost[s] = cost[k];
+      if (constraints != nullptr) {
+        blockedProblem.constraints[s] = (*constraints)[k];
+      }
+      continue;
+    }
+
+    // Decision variables of the block: z = [dx_k; du]. The state at node j is dx_j = M z + m.
+    const int nx = dynamics[k].dfdx.cols();
+    const int nu = dynamics[k].dfdu.cols();
+    const int nz = nx + nu;
+    M.setIdentity(nx, nz);
+    m.setZero(nx);
+
+    auto& blockedCost = blockedProblem.cost[s];
+    matrix_t H = matrix_t::Zero(nz, nz);
+    vector_t h = vector_t::Zero(nz);
+    scalar_t f = 0.0;
+    constraintJacobians.clear();
+    constraintValues.clear();
+
+    T.setZero(nz, nz);  // [dx_j; du] = T z + t
+    T.bottomRightCorner(nu, nu).setIdentity();
+    t.setZero(nz);
+    for (int j = k; j < end; ++j) {
+      T.topRows(nx) = M;
+      t.head(nx) = m;
+
+      // Cost
+      Hj.resize(nz, nz);
+      Hj << cost[j].dfdxx, cost[j].dfdux.transpose(), cost[j].dfdux, cost[j].dfduu;
+      gj.resize(nz);
+      gj << cost[j].dfdx, cost[j].dfdu;
+      HjT.noalias() = Hj * T;
+      Hjt.noalias() = Hj * t;
+      H.noalias() += T.transpose() * HjT;
+      h.noalias() += T.transpose() * (Hjt + gj);
+      f += 0.5 * t.dot(Hjt) + gj.dot(t) + cost[j].f;
+
+      // Constraints
+      if (constraints != nullptr && (*constraints)[j].f.size() > 0) {
+        const auto& Cj = (*constraints)[j];
+        Cz.noalias() = Cj.dfdx * M;
+        Cz.rightCols(nu) += Cj.dfdu;
+        constraintJacobians.push_back(Cz);
+        constraintValues.push_back(Cj.f);
+        constraintValues.back().noalias() += Cj.dfdx * m;
+      }
+
+      // Dynamics
+      const auto& Aj = dynamics[j].dfdx;
+      const auto& Bj = dynamics[j].dfdu;
+      M = Aj * M;
+      M.rightCols(nu) += Bj;
+      m = Aj * m + dynamics[j].f;
+    }
+
+    auto& blockedDynamics = blockedProblem.dynamics[s];
+    blockedDynamics.dfdx = M.leftCols(nx);
+    blockedDynamics.dfdu = M.rightCols(nu);
+    blockedDynamics.f = m;
+
+    blockedCost.dfdxx = H.topLeftCorner(nx, nx);
+    blockedCost.dfdux = H.bottomLeftCorner(nu, nx);
+    blockedCost.dfduu = H.bottomRightCorner(nu, nu);
+    blockedCost.dfdx = h.head(nx);
+    blockedCost.dfdu = h.tail(nu);
+    blockedCost.f = f;
+
+    if (constraints != nullptr) {
+      int numConstraints = 0;
+      for (const auto& c : constraintValues) {
+        numConstraints += c.size();
+      }
+      auto& blockedConstraints = blockedProblem.constraints[s];
+      blockedConstraints.dfdx.resize(numConstraints, nx);
+      blockedConstraints.dfdu.resize(numConstraints, nu);
+      blockedConstraints.f.resize(numConstraints);
+      int row = 0;
+      for (int c = 0; c < constraintValues.size(); ++c) {
+        const int nc = constraintValues[c].size();
+        blockedConstraints.dfdx.middleRows(row, nc) = constraintJacobians[c].leftCols(nx);
+        blockedConstraints.dfdu.middleRows(row, nc) = constraintJacobians[c].rightCols(nu);
+        blockedConstraints.f.segment(row, nc) = constraintValues[c];
+        row += nc;
+      }
+    }
+  }
+}
+
+void unblockSolution(const std::vector<int>& blocks, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                     vector_array_t& deltaXSol, vector_array_t& deltaUSol) {
+  const int N = blocks.size();
+  const auto leaders = getBlockLeaders(blocks);
+  const int numBlocks = leaders.size();
+  assert(deltaXSol.size() == numBlocks + 1);
+  assert(deltaUSol.size() == numBlocks);
+
+  vector_array_t deltaX(N + 1);
+  vector_array_t deltaU(N);
+  for (int s = 0; s < numBlocks; ++s) {
+    const int k = leaders[s];
+    const int end = (s + 1 < numBlocks) ? leaders[s + 1] : N;
+    deltaX[k] = std::move(deltaXSol[s]);
+    deltaU[k] = std::move(deltaUSol[s]);
+    for (int j = k + 1; j < end; ++j) {
+      deltaU[j] = deltaU[k];
+      deltaX[j] = dynamics[j - 1].f;
+      deltaX[j].noalias() += dynamics[j - 1].dfdx * deltaX[j - 1];
+      deltaX[j].noalias() += dynamics[j - 1].dfdu * deltaU[k];
+    }
+  }
+  deltaX[N] = std::move(deltaXSol[numBlocks]);
+
+  deltaXSol.swap(deltaX);
+  deltaUSol.swap(deltaU);
+}
+
+void unblockCostToGo(const std::vector<int>& blocks, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                     const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                     std::vector<ScalarFunctionQuadraticApproximation>& costToGo) {
+  const int N = blocks.size();
+  const auto leaders = getBlockLeaders(blocks);
+  const int numBlocks = leaders.size();
+  assert(costToGo.size() == numBlocks + 1);
+
+  std::vector<ScalarFunctionQuadraticApproximation> unblockedCostToGo(N + 1);
+  for (int s = 0; s < numBlocks; ++s) {
+    unblockedCostToGo[leaders[s]] = std::move(costToGo[s]);
+  }
+  unblockedCostToGo[N] = std::move(costToGo[numBlocks]);
+
+  matrix_array_t Sm;
+  vector_array_t Sv;
+  matrix_t SuuInvSux;
+  vector_t SuuInvSu;
+  for (int s = 0; s < numBlocks; ++s) {
+    const int k = leaders[s];
+    const int end = (s + 1 < numBlocks) ? leaders[s + 1] : N;
+    if (end == k + 1) {
+      continue;
+    }
+    const int nx = dynamics[k].dfdx.cols();
+    const int nu = dynamics[k].dfdu.cols();
+    computeFollowerCostToGo(dynamics, cost, k, end, unblockedCostToGo[end], Sm, Sv);
+
+    // Minimize the held input out of the cost-to-go: Sxx - Sxu * inv(Suu) * Sux and sx - Sxu * inv(Suu) * su
+    for (int j = k + 1; j < end; ++j) {
+      const auto& Smj = Sm[j - k];
+      const auto& Svj = Sv[j - k];
+      const Eigen::LDLT<matrix_t> SuuLdlt(Smj.bottomRightCorner(nu, nu));
+      SuuInvSux = SuuLdlt.solve(Smj.bottomLeftCorner(nu, nx));
+      SuuInvSu = SuuLdlt.solve(Svj.tail(nu));
+      auto& Vj = unblockedCostToGo[j];
+      Vj.dfdxx = Smj.topLeftCorner(nx, nx);
+      Vj.dfdxx.noalias() -= Smj.topRightCorner(nx, nu) * SuuInvSux;
+      Vj.dfdx = Svj.head(nx);
+      Vj.dfdx.noalias() -= Smj.topRightCorner(nx, nu) * SuuInvSu;
+      Vj.f = 0.0;
+    }
+  }
+
+  costToGo.swap(unblockedCostToGo);
+}
+
+void unblockFeedback(const std::vector<int>& blocks, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                     const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                     const std::vector<ScalarFunctionQuadraticApproximation>& costToGo, matrix_array_t& KMatrices) {
+  const int N = blocks.size();
+  const auto leaders = getBlockLeaders(blocks);
+  const int numBlocks = leaders.size();
+  assert(costToGo.size() == numBlocks + 1);
+  assert(KMatrices.size() == numBlocks);
+
+  matrix_array_t unblockedKMatrices(N);
+  matrix_array_t Sm;
+  vector_array_t Sv;
+  for (int s = 0; s < numBlocks; ++s) {
+    const int k = leaders[s];
+    const int end = (s + 1 < numBlocks) ? leaders[s + 1] : N;
+    unblockedKMatrices[k] = std::move(KMatrices[s]);
+    if (end == k + 1) {
+      continue;
+    }
+    const int nx = dynamics[k].dfdx.cols();
+    const int nu = dynamics[k].dfdu.cols();
+    computeFollowerCostToGo(dynamics, cost, k, end, costToGo[s + 1], Sm, Sv);
+    for (int j = k + 1; j < end; ++j) {
+      const auto& Smj = Sm[j - k];
+      unblockedKMatrices[j] = -Smj.bottomRightCorner(nu, nu).ldlt().solve(Smj.bottomLeftCorner(nu, nx));
+    }
+  }
+
+  KMatrices.swap(unblockedKMatrices);
+}
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
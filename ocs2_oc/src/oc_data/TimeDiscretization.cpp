@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_oc/oc_data/TimeDiscretization.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 #include <ocs2_core/misc/Lookup.h>
 
 namespace ocs2 {
@@ -59,8 +62,16 @@ scalar_t getIntervalDuration(const AnnotatedTime& start, const AnnotatedTime& en
 
 std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt,
                                                         const scalar_array_t& eventTimes, scalar_t dt_min) {
+  return gradedTimeDiscretizationWithEvents(initTime, finalTime, dt, 1.0, dt, eventTimes, dt_min);
+}
+
+std::vector<AnnotatedTime> gradedTimeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt, scalar_t dtGrowthFactor,
+                                                              scalar_t dtMax, const scalar_array_t& eventTimes, scalar_t dt_min) {
   assert(dt > 0);
   assert(finalTime > initTime);
+  if (dtGrowthFactor < 1.0) {
+    throw std::invalid_argument("[gradedTimeDiscretizationWithEvents] dtGrowthFactor must be at least 1.0.");
+  }
   std::vector<AnnotatedTime> timeDiscretization;
 
   // Initialize
@@ -68,10 +79,14 @@ std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scala
   scalar_t nextEventIdx = lookup::findIndexInTimeArray(eventTimes, initTime);
 
   // Fill iteratively with pre event, post events are added later
+  // The discretization step grows from dt to dtMax
   AnnotatedTime nextNode = timeDiscretization.back();
+  const scalar_t maxDt = std::max(dtMax, dt);
+  scalar_t nextDt = dt;
   while (timeDiscretization.back().time < finalTime) {
-    nextNode.time = nextNode.time + dt;
+    nextNode.time = nextNode.time + nextDt;
     nextNode.event = AnnotatedTime::Event::None;
+    nextDt = std::min(nextDt * dtGrowthFactor, maxDt);
 
     // Check if an event has passed
     if (nextEventIdx < eventTimes.size() && nextNode.time >= eventTimes[nextEventIdx]) {
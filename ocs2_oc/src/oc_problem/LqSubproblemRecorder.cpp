@@ -0,0 +1,277 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/oc_problem/LqSubproblemRecorder.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace ocs2 {
+
+namespace {
+constexpr char fileHeader[] = "OCS2_LQ_SUBPROBLEM_V1";
+constexpr size_t fileHeaderSize = sizeof(fileHeader) - 1;
+
+void writeInt(std::ostream& stream, int64_t value) {
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/**
+ * Throws if fewer than numBytes are left in the file. The sizes read from the file are checked with it before allocating memory, such
+ * that a corrupted size cannot trigger a huge allocation.
+ */
+void checkRemainingSize(std::istream& stream, int64_t fileSize, int64_t numBytes) {
+  const int64_t position = stream.tellg();
+  if (!stream || position < 0 || numBytes < 0 || numBytes > fileSize - position) {
+    throw std::runtime_error("[loadLqSubproblems] The recording is corrupted.");
+  }
+}
+
+int64_t readInt(std::istream& stream) {
+  int64_t value = 0;
+  stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+  return value;
+}
+
+void writeScalar(std::ostream& stream, scalar_t value) {
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+scalar_t readScalar(std::istream& stream) {
+  scalar_t value = 0.0;
+  stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+  return value;
+}
+
+void writeIntArray(std::ostream& stream, const std::vector<int>& values) {
+  writeInt(stream, values.size());
+  for (const auto v : values) {
+    writeInt(stream, v);
+  }
+}
+
+std::vector<int> readIntArray(std::istream& stream, int64_t fileSize) {
+  const auto size = readInt(stream);
+  checkRemainingSize(stream, fileSize, std::min(size, fileSize) * static_cast<int64_t>(sizeof(int64_t)));
+  std::vector<int> values(size);
+  for (auto& v : values) {
+    v = static_cast<int>(readInt(stream));
+  }
+  return values;
+}
+
+/** Writes the dimensions followed by the column-major data. */
+void writeMatrix(std::ostream& stream, const matrix_t& m) {
+  writeInt(stream, m.rows());
+  writeInt(stream, m.cols());
+  stream.write(reinterpret_cast<const char*>(m.data()), m.size() * sizeof(scalar_t));
+}
+
+void writeMatrix(std::ostream& stream, const vector_t& v) {
+  writeInt(stream, v.rows());
+  writeInt(stream, 1);
+  stream.write(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(scalar_t));
+}
+
+matrix_t readMatrix(std::istream& stream, int64_t fileSize) {
+  const auto rows = readInt(stream);
+  const auto cols = readInt(stream);
+  if (rows < 0 || cols < 0 || (cols > 0 && rows > fileSize / cols)) {
+    throw std::runtime_error("[loadLqSubproblems] The recording is corrupted.");
+  }
+  checkRemainingSize(stream, fileSize, rows * cols * static_cast<int64_t>(sizeof(scalar_t)));
+  matrix_t m(rows, cols);
+  stream.read(reinterpret_cast<char*>(m.data()), m.size() * sizeof(scalar_t));
+  return m;
+}
+
+vector_t readVector(std::istream& stream, int64_t fileSize) {
+  const matrix_t m = readMatrix(stream, fileSize);
+  if (m.cols() != 1 && m.size() != 0) {
+    throw std::runtime_error("[loadLqSubproblems] The recording is corrupted.");
+  }
+  return Eigen::Map<const vector_t>(m.data(), m.size());
+}
+
+void writeLinearApproximation(std::ostream& stream, const VectorFunctionLinearApproximation& approximation) {
+  writeMatrix(stream, approximation.f);
+  writeMatrix(stream, approximation.dfdx);
+  writeMatrix(stream, approximation.dfdu);
+}
+
+VectorFunctionLinearApproximation readLinearApproximation(std::istream& stream, int64_t fileSize) {
+  VectorFunctionLinearApproximation approximation;
+  approximation.f = readVector(stream, fileSize);
+  approximation.dfdx = readMatrix(stream, fileSize);
+  approximation.dfdu = readMatrix(stream, fileSize);
+  return approximation;
+}
+
+void writeQuadraticApproximation(std::ostream& stream, const ScalarFunctionQuadraticApproximation& approximation) {
+  writeScalar(stream, approximation.f);
+  writeMatrix(stream, approximation.dfdx);
+  writeMatrix(stream, approximation.dfdu);
+  writeMatrix(stream, approximation.dfdxx);
+  writeMatrix(stream, approximation.dfdux);
+  writeMatrix(stream, approximation.dfduu);
+}
+
+ScalarFunctionQuadraticApproximation readQuadraticApproximation(std::istream& stream, int64_t fileSize) {
+  ScalarFunctionQuadraticApproximation approximation;
+  approximation.f = readScalar(stream);
+  approximation.dfdx = readVector(stream, fileSize);
+  approximation.dfdu = readVector(stream, fileSize);
+  approximation.dfdxx = readMatrix(stream, fileSize);
+  approximation.dfdux = readMatrix(stream, fileSize);
+  approximation.dfduu = readMatrix(stream, fileSize);
+  return approximation;
+}
+
+void writeOcpSize(std::ostream& stream, const OcpSize& ocpSize) {
+  writeInt(stream, ocpSize.numStages);
+  writeIntArray(stream, ocpSize.numInputs);
+  writeIntArray(stream, ocpSize.numStates);
+  writeIntArray(stream, ocpSize.numInputBoxConstraints);
+  writeIntArray(stream, ocpSize.numStateBoxConstraints);
+  writeIntArray(stream, ocpSize.numIneqConstraints);
+  writeIntArray(stream, ocpSize.numInputBoxSlack);
+  writeIntArray(stream, ocpSize.numStateBoxSlack);
+  writeIntArray(stream, ocpSize.numIneqSlack);
+}
+
+OcpSize readOcpSize(std::istream& stream, int64_t fileSize) {
+  OcpSize ocpSize;
+  const auto numStages = readInt(stream);
+  ocpSize.numInputs = readIntArray(stream, fileSize);
+  ocpSize.numStates = readIntArray(stream, fileSize);
+  ocpSize.numInputBoxConstraints = readIntArray(stream, fileSize);
+  ocpSize.numStateBoxConstraints = readIntArray(stream, fileSize);
+  ocpSize.numIneqConstraints = readIntArray(stream, fileSize);
+  ocpSize.numInputBoxSlack = readIntArray(stream, fileSize);
+  ocpSize.numStateBoxSlack = readIntArray(stream, fileSize);
+  ocpSize.numIneqSlack = readIntArray(stream, fileSize);
+  // all arrays are of size N + 1, which bounds the number of stages by the file length
+  const auto numNodes = static_cast<size_t>(std::max<int64_t>(numStages, 0)) + 1;
+  if (numStages < 0 || ocpSize.numStates.size() != numNodes || ocpSize.numInputs.size() != numNodes) {
+    throw std::runtime_error("[loadLqSubproblems] The recording is corrupted.");
+  }
+  ocpSize.numStages = static_cast<int>(numStages);
+  return ocpSize;
+}
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LqSubproblemRecorder::LqSubproblemRecorder(const std::string& filename, size_t recordingPeriod)
+    : recordingPeriod_(std::max<size_t>(recordingPeriod, 1)), file_(filename, std::ios::binary | std::ios::trunc) {
+  if (!file_) {
+    throw std::runtime_error("[LqSubproblemRecorder] Could not open " + filename);
+  }
+  file_.write(fileHeader, fileHeaderSize);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LqSubproblemRecorder::record(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                  const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                                  const std::vector<VectorFunctionLinearApproximation>* constraints) {
+  if (numCalls_++ % recordingPeriod_ != 0) {
+    return;
+  }
+
+  writeOcpSize(file_, extractSizesFromProblem(dynamics, cost, constraints));
+  writeMatrix(file_, x0);
+  for (const auto& d : dynamics) {
+    writeLinearApproximation(file_, d);
+  }
+  for (const auto& c : cost) {
+    writeQuadraticApproximation(file_, c);
+  }
+  writeInt(file_, constraints != nullptr ? 1 : 0);
+  if (constraints != nullptr) {
+    for (const auto& c : *constraints) {
+      writeLinearApproximation(file_, c);
+    }
+  }
+  ++numRecorded_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<LqSubproblem> loadLqSubproblems(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("[loadLqSubproblems] Could not open " + filename);
+  }
+
+  file.seekg(0, std::ios::end);
+  const int64_t fileSize = file.tellg();
+  file.seekg(0, std::ios::beg);
+
+  char header[fileHeaderSize];
+  file.read(header, fileHeaderSize);
+  if (!file || std::strncmp(header, fileHeader, fileHeaderSize) != 0) {
+    throw std::runtime_error("[loadLqSubproblems] " + filename + " is not an LQ subproblem recording.");
+  }
+
+  std::vector<LqSubproblem> subproblems;
+  while (file.peek() != std::ifstream::traits_type::eof()) {
+    LqSubproblem subproblem;
+    subproblem.ocpSize = readOcpSize(file, fileSize);
+    const int N = subproblem.ocpSize.numStages;
+    subproblem.x0 = readVector(file, fileSize);
+    subproblem.dynamics.reserve(N);
+    for (int i = 0; i < N; ++i) {
+      subproblem.dynamics.push_back(readLinearApproximation(file, fileSize));
+    }
+    subproblem.cost.reserve(N + 1);
+    for (int i = 0; i <= N; ++i) {
+      subproblem.cost.push_back(readQuadraticApproximation(file, fileSize));
+    }
+    if (readInt(file) != 0) {
+      subproblem.constraints.reserve(N + 1);
+      for (int i = 0; i <= N; ++i) {
+        subproblem.constraints.push_back(readLinearApproximation(file, fileSize));
+      }
+    }
+    if (!file) {
+      throw std::runtime_error("[loadLqSubproblems] " + filename + " ends with an incomplete subproblem.");
+    }
+    subproblems.push_back(std::move(subproblem));
+  }
+
+  return subproblems;
+}
+
+}  // namespace ocs2
@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_oc/search_strategy/FilterLinesearch.h"
 
+#include <algorithm>
+#include <mutex>
+
 namespace ocs2 {
 
 std::pair<bool, FilterLinesearch::StepType> FilterLinesearch::acceptStep(const PerformanceIndex& baselinePerformance,
@@ -56,6 +59,73 @@ std::pair<bool, FilterLinesearch::StepType> FilterLinesearch::acceptStep(const P
   }
 }
 
+std::pair<int, FilterLinesearch::StepType> FilterLinesearch::speculativeStep(
+    ThreadPool& threadPool, size_t numWorkers, const PerformanceIndex& baselinePerformance, scalar_t armijoDescentMetric,
+    const scalar_array_t& stepSizes,
+    const std::function<PerformanceIndex(int workerId, scalar_t stepSize, const std::atomic_bool& cancelled)>& evaluateStep,
+    const std::function<void(int workerId, const PerformanceIndex& stepPerformance)>& storeStep) const {
+  const int numCandidates = static_cast<int>(stepSizes.size());
+
+  std::mutex resultMutex;
+  std::vector<bool> isProcessed(numCandidates, false);
+  int acceptedIndex = numCandidates;
+  StepType acceptedStepType = StepType::ZERO;
+
+  std::atomic_int nextIndex{0};
+  std::atomic_bool cancelled{false};
+  auto task = [&](int workerId) {
+    int k;
+    while (!cancelled && (k = nextIndex++) < numCandidates) {
+      {  // Skip if a larger step is already accepted
+        std::lock_guard<std::mutex> lock(resultMutex);
+        if (k > acceptedIndex) {
+          break;
+        }
+      }
+
+      const PerformanceIndex stepPerformance = evaluateStep(workerId, stepSizes[k], cancelled);
+      if (cancelled) {
+        break;
+      }
+
+      bool stepAccepted;
+      StepType stepType;
+      std::tie(stepAccepted, stepType) = acceptStep(baselinePerformance, stepPerformance, stepSizes[k] * armijoDescentMetric);
+
+      std::lock_guard<std::mutex> lock(resultMutex);
+      isProcessed[k] = true;
+      if (stepAccepted && k < acceptedIndex) {
+        acceptedIndex = k;
+        acceptedStepType = stepType;
+        storeStep(workerId, stepPerformance);
+      }
+      // The accepted step is final once all larger steps have been rejected. Cancel the remaining evaluations.
+      if (acceptedIndex < numCandidates &&
+          std::all_of(isProcessed.cbegin(), isProcessed.cbegin() + acceptedIndex, [](bool processed) { return processed; })) {
+        cancelled = true;
+      }
+    }
+  };
+  threadPool.runParallel(std::move(task), static_cast<int>(std::max(numWorkers, size_t(1))));
+
+  if (acceptedIndex < numCandidates) {
+    return {acceptedIndex, acceptedStepType};
+  } else {
+    return {-1, StepType::ZERO};
+  }
+}
+
+scalar_array_t backtrackingStepSizes(scalar_t maxStepSize, scalar_t alphaDecay, scalar_t alphaMin, scalar_t deltaTol, scalar_t deltaXnorm,
+                                     scalar_t deltaUnorm) {
+  scalar_array_t stepSizes{maxStepSize};
+  scalar_t alpha = maxStepSize * alphaDecay;
+  while (alpha >= alphaMin && (alpha * deltaXnorm >= deltaTol || alpha * deltaUnorm >= deltaTol)) {
+    stepSizes.push_back(alpha);
+    alpha *= alphaDecay;
+  }
+  return stepSizes;
+}
+
 std::string toString(const FilterLinesearch::StepType& stepType) {
   using StepType = FilterLinesearch::StepType;
   switch (stepType) {
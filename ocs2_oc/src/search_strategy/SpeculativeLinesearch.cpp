@@ -0,0 +1,131 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/search_strategy/SpeculativeLinesearch.h"
+
+#include <atomic>
+#include <numeric>
+
+#include "ocs2_oc/multiple_shooting/Helpers.h"
+
+namespace ocs2 {
+
+SpeculativeLinesearchResult speculativeLinesearch(
+    const FilterLinesearch& filterLinesearch, ThreadPool& threadPool, size_t numWorkers, const PerformanceIndex& baselinePerformance,
+    scalar_t armijoDescentMetric, const scalar_array_t& stepSizes, size_t numNodes,
+    const std::function<PerformanceIndex(int workerId, int nodeIndex, const std::vector<vector_array_t>& candidate, Metrics& metrics)>&
+        evaluateNode,
+    const std::vector<std::reference_wrapper<const vector_array_t>>& searchDirections, std::vector<vector_array_t>& trajectories,
+    std::vector<Metrics>& metrics) {
+  numWorkers = std::max(numWorkers, size_t(1));
+  const int N = static_cast<int>(numNodes);
+
+  SpeculativeLinesearchResult result;
+  if (stepSizes.empty()) {
+    return result;
+  }
+
+  // Worker specific candidates
+  std::vector<std::vector<vector_array_t>> candidates(numWorkers, trajectories);
+  std::vector<std::vector<Metrics>> candidateMetrics(numWorkers, std::vector<Metrics>(numNodes));
+  auto setCandidate = [&](scalar_t stepSize, std::vector<vector_array_t>& candidate) {
+    for (size_t k = 0; k < trajectories.size(); ++k) {
+      multiple_shooting::incrementTrajectory(trajectories[k], searchDirections[k].get(), stepSize, candidate[k]);
+    }
+  };
+  auto setMerit = [](PerformanceIndex& performance) {
+    performance.merit = performance.cost + performance.equalityLagrangian + performance.inequalityLagrangian;
+  };
+
+  // The first step size with all workers sharing its nodes
+  {
+    setCandidate(stepSizes.front(), candidates.front());
+    std::vector<PerformanceIndex> performance(numWorkers);
+    std::atomic_int nodeIndex{0};
+    auto task = [&](int workerId) {
+      PerformanceIndex workerPerformance;
+      int i;
+      while ((i = nodeIndex++) < N) {
+        workerPerformance += evaluateNode(workerId, i, candidates.front(), candidateMetrics.front()[i]);
+      }
+      performance[workerId] += workerPerformance;
+    };
+    threadPool.runParallel(std::move(task), static_cast<int>(numWorkers));
+
+    PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
+    setMerit(totalPerformance);
+
+    bool stepAccepted;
+    FilterLinesearch::StepType stepType;
+    std::tie(stepAccepted, stepType) =
+        filterLinesearch.acceptStep(baselinePerformance, totalPerformance, stepSizes.front() * armijoDescentMetric);
+    if (stepAccepted) {
+      result.stepIndex = 0;
+      result.stepType = stepType;
+      result.performance = totalPerformance;
+      trajectories.swap(candidates.front());
+      metrics.swap(candidateMetrics.front());
+      return result;
+    }
+  }
+
+  // The backtracking step sizes with one step size per worker
+  auto evaluateStep = [&](int workerId, scalar_t stepSize, const std::atomic_bool& cancelled) {
+    auto& candidate = candidates[workerId];
+    setCandidate(stepSize, candidate);
+    PerformanceIndex performance;
+    for (int i = 0; i < N && !cancelled; ++i) {
+      performance += evaluateNode(workerId, i, candidate, candidateMetrics[workerId][i]);
+    }
+    setMerit(performance);
+    return performance;
+  };
+  std::vector<vector_array_t> bestCandidate = trajectories;
+  std::vector<Metrics> bestMetrics(numNodes);
+  auto storeStep = [&](int workerId, const PerformanceIndex& performance) {
+    bestCandidate.swap(candidates[workerId]);
+    bestMetrics.swap(candidateMetrics[workerId]);
+    result.performance = performance;
+  };
+
+  const scalar_array_t remainingStepSizes(std::next(stepSizes.begin()), stepSizes.end());
+  int stepIndex;
+  FilterLinesearch::StepType stepType;
+  std::tie(stepIndex, stepType) = filterLinesearch.speculativeStep(threadPool, numWorkers, baselinePerformance, armijoDescentMetric,
+                                                                   remainingStepSizes, evaluateStep, storeStep);
+  if (stepIndex >= 0) {
+    result.stepIndex = stepIndex + 1;
+    result.stepType = stepType;
+    trajectories.swap(bestCandidate);
+    metrics.swap(bestMetrics);
+  }
+  return result;
+}
+
+}  // namespace ocs2
@@ -35,14 +35,23 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 ReferenceManager::ReferenceManager(TargetTrajectories initialTargetTrajectories, ModeSchedule initialModeSchedule)
-    : targetTrajectories_(std::move(initialTargetTrajectories)), modeSchedule_(std::move(initialModeSchedule)) {}
+    : targetTrajectories_(std::move(initialTargetTrajectories)), modeSchedule_(std::move(initialModeSchedule)) {
+  inputModeSchedule_ = modeSchedule_.get();
+  inputTargetTrajectories_ = targetTrajectories_.get();
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void ReferenceManager::preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState) {
-  targetTrajectories_.updateFromBuffer();
-  modeSchedule_.updateFromBuffer();
+  if (targetTrajectories_.updateFromBuffer()) {
+    inputTargetTrajectories_ = targetTrajectories_.get();
+    ++numTargetTrajectoriesUpdates_;
+  }
+  if (modeSchedule_.updateFromBuffer()) {
+    inputModeSchedule_ = modeSchedule_.get();
+    ++numModeScheduleUpdates_;
+  }
   modifyReferences(initTime, finalTime, initState, targetTrajectories_.get(), modeSchedule_.get());
 }
 
@@ -0,0 +1,204 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_oc/multiple_shooting/IncrementalLinearization.h>
+#include <ocs2_oc/multiple_shooting/MetricsComputation.h>
+
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+using namespace ocs2;
+
+class IncrementalLinearizationTest : public ::testing::Test {
+ protected:
+  static constexpr size_t N = 5;
+  static constexpr size_t nx = 3;
+  static constexpr size_t nu = 2;
+  static constexpr scalar_t tolerance = 1e-3;
+
+  IncrementalLinearizationTest() : modeSchedule({0.9}, {0, 1}), targetTrajectories({0.0}, {vector_t::Zero(nx)}, {vector_t::Zero(nu)}) {
+    for (size_t i = 0; i <= N; ++i) {
+      time.emplace_back(0.5 * i);
+      x.push_back(vector_t::Random(nx));
+    }
+    for (size_t i = 0; i < N; ++i) {
+      u.push_back(vector_t::Random(nu));
+    }
+  }
+
+  std::vector<AnnotatedTime> time;
+  vector_array_t x;
+  vector_array_t u;
+  ModeSchedule modeSchedule;
+  TargetTrajectories targetTrajectories;
+};
+
+constexpr size_t IncrementalLinearizationTest::N;
+constexpr scalar_t IncrementalLinearizationTest::tolerance;
+
+TEST_F(IncrementalLinearizationTest, disabled) {
+  multiple_shooting::IncrementalLinearization incrementalLinearization(tolerance, 1);
+  for (int iter = 0; iter < 3; ++iter) {
+    ASSERT_EQ(incrementalLinearization.update(time, x, u, modeSchedule, targetTrajectories), 0);
+    for (size_t i = 0; i <= N; ++i) {
+      ASSERT_TRUE(incrementalLinearization.needsLinearization(i));
+    }
+  }
+}
+
+TEST_F(IncrementalLinearizationTest, skipsUnchangedNodes) {
+  multiple_shooting::IncrementalLinearization incrementalLinearization(tolerance, 10);
+
+  // First call linearizes all nodes
+  ASSERT_EQ(incrementalLinearization.update(time, x, u, modeSchedule, targetTrajectories), 0);
+
+  // Changes within the tolerance keep all linearizations
+  x[2] += vector_t::Constant(nx, 0.5 * tolerance);
+  ASSERT_EQ(incrementalLinearization.update(time, x, u, modeSchedule, targetTrajectories), N + 1);
+  for (size_t i = 0; i <= N; ++i) {
+    ASSERT_FALSE(incrementalLinearization.needsLinearization(i));
+  }
+
+  // A state affects the nodes before and after it, an input only its own interval
+  x[2] += vector_t::Constant(nx, 10.0 * tolerance);
+  u[4] += vector_t::Constant(nu, 10.0 * tolerance);
+  ASSERT_EQ(incrementalLinearization.update(time, x, u, modeSchedule, targetTrajectories), N + 1 - 3);
+  for (size_t i = 0; i <= N; ++i) {
+    const bool isChanged = (i == 1 || i == 2 || i == 4);
+    ASSERT_EQ(incrementalLinearization.needsLinearization(i), isChanged) << "node " << i;
+  }
+
+  // The comparison is against the point of the last linearization, so the changes are not accumulated
+  ASSERT_EQ(incrementalLinearization.update(time, x, u, modeSchedule, targetTrajectories), N + 1);
+}
+
+TEST_F(IncrementalLinearizationTest, referenceAndModeChanges) {
+  multiple_shooting::IncrementalLinearization incrementalLinearization(tolerance, 10);
+  incrementalLinearization.update(time, x, u, modeSchedule, targetTrajectories);
+
+  // A new reference invalidates all nodes
+  targetTrajectories.stateTrajectory.front() += vector_t::Ones(nx);
+  ASSERT_EQ(incrementalLinearization.update(time, x, u, modeSchedule, targetTrajectories), 0);
+
+  // Moving the switch from t = 0.9 to t = 1.2 changes the mode of the interval starting at t = 1.0
+  modeSchedule.eventTimes.front() = 1.2;
+  ASSERT_EQ(incrementalLinearization.update(time, x, u, modeSchedule, targetTrajectories), N);
+  ASSERT_TRUE(incrementalLinearization.needsLinearization(2));
+}
+
+TEST_F(IncrementalLinearizationTest, periodicRefresh) {
+  const size_t refreshPeriod = 3;
+  multiple_shooting::IncrementalLinearization incrementalLinearization(tolerance, refreshPeriod);
+  for (int iter = 0; iter < 7; ++iter) {
+    const size_t numSkipped = incrementalLinearization.update(time, x, u, modeSchedule, targetTrajectories);
+    const bool isRefresh = (iter % refreshPeriod == 0);
+    ASSERT_EQ(numSkipped, isRefresh ? 0 : N + 1) << "iteration " << iter;
+  }
+
+  // A change of the horizon size or a reset linearizes all nodes
+  ASSERT_EQ(incrementalLinearization.update(time, x, u, modeSchedule, targetTrajectories), N + 1);
+  incrementalLinearization.reset();
+  ASSERT_EQ(incrementalLinearization.update(time, x, u, modeSchedule, targetTrajectories), 0);
+  time.emplace_back(0.5 * (N + 1));
+  x.push_back(vector_t::Zero(nx));
+  u.push_back(vector_t::Zero(nu));
+  incrementalLinearization.update(time, x, u, modeSchedule, targetTrajectories);
+  ASSERT_EQ(incrementalLinearization.update(time, x, u, modeSchedule, targetTrajectories), N + 2);
+}
+
+TEST_F(IncrementalLinearizationTest, recentersTranscription) {
+  multiple_shooting::IncrementalLinearization incrementalLinearization(tolerance, 10);
+  incrementalLinearization.update(time, x, u, modeSchedule, targetTrajectories);
+
+  // Linear dynamics, quadratic cost and linear constraints are reproduced exactly at any other point
+  const matrix_t A = matrix_t::Random(nx, nx);
+  const matrix_t B = matrix_t::Random(nx, nu);
+  const vector_t b = vector_t::Random(nx);
+  const auto cost = getRandomCost(nx, nu);
+  const auto constraint = getRandomConstraints(nx, nu, 2);
+  auto evaluate = [&](const vector_t& xi, const vector_t& xNext, const vector_t& ui) {
+    multiple_shooting::Transcription transcription;
+    transcription.constraintsSize.stateInputEq = {2};
+    transcription.dynamics = VectorFunctionLinearApproximation(nx, nx, nu);
+    transcription.dynamics.dfdx = A;
+    transcription.dynamics.dfdu = B;
+    transcription.dynamics.f = A * xi + B * ui + b - xNext;
+    transcription.cost = cost;
+    transcription.cost.f = cost.f + cost.dfdx.dot(xi) + cost.dfdu.dot(ui) + 0.5 * xi.dot(cost.dfdxx * xi) + 0.5 * ui.dot(cost.dfduu * ui) +
+                           ui.dot(cost.dfdux * xi);
+    transcription.cost.dfdx = cost.dfdx + cost.dfdxx * xi + cost.dfdux.transpose() * ui;
+    transcription.cost.dfdu = cost.dfdu + cost.dfduu * ui + cost.dfdux * xi;
+    transcription.stateInputEqConstraints = constraint;
+    transcription.stateInputEqConstraints.f = constraint.f + constraint.dfdx * xi + constraint.dfdu * ui;
+    return transcription;
+  };
+
+  const size_t i = 1;
+  incrementalLinearization.setIntermediateNode(i, evaluate(x[i], x[i + 1], u[i]));
+  const vector_t xi = x[i] + vector_t::Random(nx);
+  const vector_t xNext = x[i + 1] + vector_t::Random(nx);
+  const vector_t ui = u[i] + vector_t::Random(nu);
+  const auto expected = evaluate(xi, xNext, ui);
+  const auto recentered = incrementalLinearization.getIntermediateNode(i, xi, ui, multiple_shooting::computeMetrics(expected));
+
+  EXPECT_TRUE(recentered.dynamics.f.isApprox(expected.dynamics.f));
+  EXPECT_TRUE(recentered.dynamics.dfdx.isApprox(expected.dynamics.dfdx));
+  EXPECT_NEAR(recentered.cost.f, expected.cost.f, 1e-9);
+  EXPECT_TRUE(recentered.cost.dfdx.isApprox(expected.cost.dfdx));
+  EXPECT_TRUE(recentered.cost.dfdu.isApprox(expected.cost.dfdu));
+  EXPECT_TRUE(recentered.stateInputEqConstraints.f.isApprox(expected.stateInputEqConstraints.f));
+}
+
+TEST_F(IncrementalLinearizationTest, usesEvaluatedValues) {
+  multiple_shooting::IncrementalLinearization incrementalLinearization(tolerance, 10);
+  incrementalLinearization.update(time, x, u, modeSchedule, targetTrajectories);
+
+  multiple_shooting::Transcription transcription;
+  transcription.constraintsSize.stateInputEq = {2};
+  transcription.cost = getRandomCost(nx, nu);
+  transcription.dynamics = getRandomDynamics(nx, nu);
+  transcription.stateInputEqConstraints = getRandomConstraints(nx, nu, 2);
+  const size_t i = 3;
+  incrementalLinearization.setIntermediateNode(i, transcription);
+
+  // The zeroth-order terms are never predicted by the stored model, the derivatives are kept
+  Metrics metrics;
+  metrics.cost = 42.0;
+  metrics.dynamicsViolation = vector_t::Random(nx);
+  metrics.stateInputEqConstraint = {vector_t::Random(2)};
+  const auto result = incrementalLinearization.getIntermediateNode(i, x[i] + vector_t::Ones(nx), u[i], metrics);
+
+  EXPECT_DOUBLE_EQ(result.cost.f, metrics.cost);
+  EXPECT_TRUE(result.dynamics.f.isApprox(metrics.dynamicsViolation));
+  EXPECT_TRUE(result.stateInputEqConstraints.f.isApprox(metrics.stateInputEqConstraint.front()));
+  EXPECT_TRUE(result.dynamics.dfdx.isApprox(transcription.dynamics.dfdx));
+  EXPECT_TRUE(result.stateInputEqConstraints.dfdu.isApprox(transcription.stateInputEqConstraints.dfdu));
+  EXPECT_TRUE(result.cost.dfdxx.isApprox(transcription.cost.dfdxx));
+}
@@ -0,0 +1,271 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_oc/multiple_shooting/MoveBlocking.h>
+#include <ocs2_oc/oc_problem/OcpSize.h>
+#include <ocs2_oc/oc_problem/OcpToKkt.h>
+
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+using namespace ocs2;
+
+namespace {
+/** Solves the equality constrained QP: min 0.5 z' H z + h' z s.t. G z = g */
+vector_t solveDenseQp(const matrix_t& H, const vector_t& h, const matrix_t& G, const vector_t& g) {
+  const int nz = H.rows();
+  const int nc = G.rows();
+  matrix_t kkt = matrix_t::Zero(nz + nc, nz + nc);
+  kkt.topLeftCorner(nz, nz) = H;
+  kkt.topRightCorner(nz, nc) = G.transpose();
+  kkt.bottomLeftCorner(nc, nz) = G;
+  vector_t rhs(nz + nc);
+  rhs << -h, g;
+  return kkt.fullPivLu().solve(rhs).head(nz);
+}
+
+/**
+ * Solves the LQ problem with the additional equality constraints u[i] = u[blocks[i]] through the dense KKT system. Blocks that start
+ * before the first interval are tied to the first interval.
+ */
+void solveTiedLqProblem(const std::vector<int>& blocks, const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                        const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                        const std::vector<VectorFunctionLinearApproximation>* constraints, vector_array_t& x, vector_array_t& u) {
+  const int N = dynamics.size();
+  const auto ocpSize = extractSizesFromProblem(dynamics, cost, constraints);
+  VectorFunctionLinearApproximation constraintsApproximation;
+  ScalarFunctionQuadraticApproximation costApproximation;
+  getConstraintMatrix(ocpSize, x0, dynamics, constraints, nullptr, constraintsApproximation);
+  getCostMatrix(ocpSize, x0, cost, costApproximation);
+
+  std::vector<int> inputIndices(N);
+  int index = 0;
+  int numTies = 0;
+  for (int i = 0; i < N; i++) {
+    inputIndices[i] = index;
+    index += ocpSize.numInputs[i] + ocpSize.numStates[i + 1];
+    if (i > 0 && blocks[i] != i) {
+      numTies += ocpSize.numInputs[i];
+    }
+  }
+
+  const int numConstraints = constraintsApproximation.dfdx.rows();
+  matrix_t G = matrix_t::Zero(numConstraints + numTies, constraintsApproximation.dfdx.cols());
+  vector_t g = vector_t::Zero(G.rows());
+  G.topRows(numConstraints) = constraintsApproximation.dfdx;
+  g.head(numConstraints) = constraintsApproximation.f;
+  int row = numConstraints;
+  for (int i = 1; i < N; i++) {
+    if (blocks[i] != i) {
+      const int nu = ocpSize.numInputs[i];
+      G.block(row, inputIndices[i], nu, nu).setIdentity();
+      G.block(row, inputIndices[std::max(blocks[i], 0)], nu, nu) -= matrix_t::Identity(nu, nu);
+      row += nu;
+    }
+  }
+  toOcpSolution(ocpSize, solveDenseQp(costApproximation.dfdxx, costApproximation.dfdx, G, g), x0, x, u);
+}
+
+/** Evaluates the total cost of the state and input trajectories. */
+scalar_t evaluateCost(const std::vector<ScalarFunctionQuadraticApproximation>& cost, const vector_array_t& x, const vector_array_t& u) {
+  scalar_t totalCost = 0.0;
+  for (int i = 0; i < cost.size(); i++) {
+    const auto& c = cost[i];
+    totalCost += 0.5 * x[i].dot(c.dfdxx * x[i]) + c.dfdx.dot(x[i]) + c.f;
+    if (i < u.size()) {
+      totalCost += u[i].dot(c.dfdux * x[i]) + 0.5 * u[i].dot(c.dfduu * u[i]) + c.dfdu.dot(u[i]);
+    }
+  }
+  return totalCost;
+}
+
+/** Riccati backward pass of an unconstrained LQ problem. */
+void riccatiBackwardPass(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                         const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                         std::vector<ScalarFunctionQuadraticApproximation>& costToGo, matrix_array_t& KMatrices) {
+  const int N = dynamics.size();
+  costToGo.resize(N + 1);
+  KMatrices.resize(N);
+  costToGo[N].dfdxx = cost[N].dfdxx;
+  costToGo[N].dfdx = cost[N].dfdx;
+  for (int k = N - 1; k >= 0; k--) {
+    const auto& A = dynamics[k].dfdx;
+    const auto& B = dynamics[k].dfdu;
+    const matrix_t& P = costToGo[k + 1].dfdxx;
+    const vector_t p = costToGo[k + 1].dfdx + P * dynamics[k].f;
+    const matrix_t Huu = cost[k].dfduu + B.transpose() * P * B;
+    const matrix_t Hux = cost[k].dfdux + B.transpose() * P * A;
+    const vector_t hu = cost[k].dfdu + B.transpose() * p;
+    KMatrices[k] = -Huu.ldlt().solve(Hux);
+    const vector_t feedforward = -Huu.ldlt().solve(hu);
+    costToGo[k].dfdxx = cost[k].dfdxx + A.transpose() * P * A + Hux.transpose() * KMatrices[k];
+    costToGo[k].dfdx = cost[k].dfdx + A.transpose() * p + Hux.transpose() * feedforward;
+  }
+}
+}  // namespace
+
+class MoveBlockingTest : public testing::Test {
+ protected:
+  static constexpr size_t nx_ = 4;
+  static constexpr size_t nu_ = 3;
+
+  MoveBlockingTest() {
+    srand(0);
+    time = timeDiscretizationWithEvents(0.0, 1.0, 0.1, {0.55});
+    const int N = static_cast<int>(time.size()) - 1;
+
+    x0 = vector_t::Random(nx_);
+    for (int i = 0; i < N; i++) {
+      const int nu = (time[i].event == AnnotatedTime::Event::PreEvent) ? 0 : nu_;
+      dynamicsArray.push_back(getRandomDynamics(nx_, nu));
+      costArray.push_back(getRandomCost(nx_, nu));
+      constraintsArray.push_back(getRandomConstraints(nx_, nu, (nu > 0) ? 1 : 0));
+    }
+    costArray.push_back(getRandomCost(nx_, 0));
+    constraintsArray.push_back(getRandomConstraints(nx_, 0, 0));
+  }
+
+  std::vector<AnnotatedTime> time;
+  vector_t x0;
+  std::vector<VectorFunctionLinearApproximation> dynamicsArray;
+  std::vector<ScalarFunctionQuadraticApproximation> costArray;
+  std::vector<VectorFunctionLinearApproximation> constraintsArray;
+};
+
+constexpr size_t MoveBlockingTest::nx_;
+constexpr size_t MoveBlockingTest::nu_;
+
+TEST_F(MoveBlockingTest, computeMoveBlocks) {
+  // Nodes: 0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.55 (PreEvent), 0.55 (PostEvent), 0.65, 0.75, 0.85, 0.95, 1.0
+  ASSERT_EQ(time.size(), 13);
+
+  // No blocking
+  auto blocks = multiple_shooting::computeMoveBlocks(time, 0.0, 1);
+  for (int i = 0; i < blocks.size(); i++) {
+    EXPECT_EQ(blocks[i], i);
+  }
+  EXPECT_FALSE(multiple_shooting::hasBlockedInputs(blocks));
+
+  // Blocks of three intervals after 0.25, the event interval and its successor start new blocks
+  blocks = multiple_shooting::computeMoveBlocks(time, 0.25, 3);
+  const std::vector<int> expectedBlocks{0, 1, 2, 3, 3, 3, 6, 7, 7, 7, 10, 10};
+  EXPECT_EQ(blocks, expectedBlocks);
+  EXPECT_TRUE(multiple_shooting::hasBlockedInputs(blocks));
+
+  // A change of the input dimension splits a block
+  auto dynamics = dynamicsArray;
+  dynamics[8] = getRandomDynamics(nx_, nu_ - 1);
+  multiple_shooting::splitMoveBlocks(dynamics, blocks);
+  const std::vector<int> expectedSplitBlocks{0, 1, 2, 3, 3, 3, 6, 7, 8, 9, 10, 10};
+  EXPECT_EQ(blocks, expectedSplitBlocks);
+
+  // Inputs are tied to the first interval of the block
+  vector_array_t u(blocks.size());
+  for (auto& ui : u) {
+    ui = vector_t::Random(nu_);
+  }
+  multiple_shooting::applyMoveBlocks(blocks, u);
+  for (int i = 0; i < blocks.size(); i++) {
+    EXPECT_TRUE(u[i].isApprox(u[blocks[i]]));
+  }
+}
+
+TEST_F(MoveBlockingTest, blockedSolution) {
+  const auto blocks = multiple_shooting::computeMoveBlocks(time, 0.25, 3);
+
+  auto checkSolution = [&](const std::vector<VectorFunctionLinearApproximation>* constraints) {
+    // Reference: the original QP with the additional equality constraints u[i] = u[blocks[i]]
+    vector_array_t xRef, uRef;
+    solveTiedLqProblem(blocks, x0, dynamicsArray, costArray, constraints, xRef, uRef);
+
+    // Blocked QP has one stage per block
+    multiple_shooting::BlockedLqProblem blockedProblem;
+    multiple_shooting::blockLinearQuadraticProblem(blocks, dynamicsArray, costArray, constraints, blockedProblem);
+    ASSERT_EQ(blockedProblem.dynamics.size(), 7);
+    ASSERT_EQ(blockedProblem.cost.size(), 8);
+    ASSERT_EQ(blockedProblem.constraints.size(), (constraints != nullptr) ? 8 : 0);
+
+    vector_array_t x, u;
+    const std::vector<int> noBlocks{0, 1, 2, 3, 4, 5, 6};
+    solveTiedLqProblem(noBlocks, x0, blockedProblem.dynamics, blockedProblem.cost,
+                       (constraints != nullptr) ? &blockedProblem.constraints : nullptr, x, u);
+    multiple_shooting::unblockSolution(blocks, dynamicsArray, x, u);
+
+    ASSERT_EQ(x.size(), xRef.size());
+    ASSERT_EQ(u.size(), uRef.size());
+    for (int i = 0; i < x.size(); i++) {
+      EXPECT_TRUE(x[i].isApprox(xRef[i], 1e-8)) << "x[" << i << "]";
+    }
+    for (int i = 0; i < u.size(); i++) {
+      EXPECT_TRUE(u[i].isApprox(uRef[i], 1e-8)) << "u[" << i << "]";
+    }
+  };
+
+  checkSolution(nullptr);
+  checkSolution(&constraintsArray);
+}
+
+TEST_F(MoveBlockingTest, unblockCostToGoAndFeedback) {
+  const auto blocks = multiple_shooting::computeMoveBlocks(time, 0.25, 3);
+  const int N = blocks.size();
+
+  multiple_shooting::BlockedLqProblem blockedProblem;
+  multiple_shooting::blockLinearQuadraticProblem(blocks, dynamicsArray, costArray, nullptr, blockedProblem);
+  std::vector<ScalarFunctionQuadraticApproximation> costToGo;
+  matrix_array_t KMatrices;
+  riccatiBackwardPass(blockedProblem.dynamics, blockedProblem.cost, costToGo, KMatrices);
+  multiple_shooting::unblockFeedback(blocks, dynamicsArray, costArray, costToGo, KMatrices);
+  multiple_shooting::unblockCostToGo(blocks, dynamicsArray, costArray, costToGo);
+  ASSERT_EQ(costToGo.size(), N + 1);
+  ASSERT_EQ(KMatrices.size(), N);
+
+  // Compare against the tail problems starting at node i, in which the input of node i is free and the remaining block is tied to it
+  const vector_t dx = vector_t::Random(nx_);
+  const vector_t zero = vector_t::Zero(nx_);
+  for (int i = 0; i < N; i++) {
+    const std::vector<VectorFunctionLinearApproximation> dynamicsTail(dynamicsArray.begin() + i, dynamicsArray.end());
+    const std::vector<ScalarFunctionQuadraticApproximation> costTail(costArray.begin() + i, costArray.end());
+    std::vector<int> blocksTail(N - i);
+    for (int j = i; j < N; j++) {
+      blocksTail[j - i] = blocks[j] - i;
+    }
+
+    vector_array_t x, u, xNominal, uNominal;
+    solveTiedLqProblem(blocksTail, dx, dynamicsTail, costTail, nullptr, x, u);
+    solveTiedLqProblem(blocksTail, zero, dynamicsTail, costTail, nullptr, xNominal, uNominal);
+
+    ASSERT_EQ(KMatrices[i].rows(), dynamicsArray[i].dfdu.cols());
+    ASSERT_EQ(KMatrices[i].cols(), nx_);
+    EXPECT_TRUE((u.front() - uNominal.front()).isApprox(KMatrices[i] * dx, 1e-8)) << "K[" << i << "]";
+
+    const scalar_t valueDifference = evaluateCost(costTail, x, u) - evaluateCost(costTail, xNominal, uNominal);
+    EXPECT_NEAR(valueDifference, 0.5 * dx.dot(costToGo[i].dfdxx * dx) + costToGo[i].dfdx.dot(dx), 1e-8) << "V[" << i << "]";
+  }
+}
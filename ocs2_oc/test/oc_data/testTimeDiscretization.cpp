@@ -27,6 +27,8 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
+
 #include <gtest/gtest.h>
 
 #include "ocs2_oc/oc_data/TimeDiscretization.h"
@@ -127,4 +129,80 @@ TEST(test_time_discretization, withEvents) {
   ASSERT_EQ(time[12].event, AnnotatedTime::Event::PreEvent);
   ASSERT_EQ(time[13].event, AnnotatedTime::Event::PostEvent);
   ASSERT_EQ(time[14].event, AnnotatedTime::Event::None);
-}
\ No newline at end of file
+}
+
+TEST(test_time_discretization, graded_uniform) {
+  scalar_t initTime = 0.1;
+  scalar_t finalTime = 3.9;
+  scalar_t dt = 0.1;
+  scalar_array_t eventTimes{1.05, 1.25, 1.35, 3.85};
+
+  const auto uniform = timeDiscretizationWithEvents(initTime, finalTime, dt, eventTimes);
+  const auto graded = gradedTimeDiscretizationWithEvents(initTime, finalTime, dt, 1.0, 1.0, eventTimes);
+  ASSERT_EQ(uniform.size(), graded.size());
+  for (size_t i = 0; i < uniform.size(); ++i) {
+    ASSERT_EQ(uniform[i].time, graded[i].time);
+    ASSERT_EQ(uniform[i].event, graded[i].event);
+  }
+}
+
+TEST(test_time_discretization, graded_noEvents) {
+  scalar_t initTime = 0.0;
+  scalar_t finalTime = 1.0;
+  scalar_t dt = 0.015;
+  scalar_t dtGrowthFactor = 1.05;
+  scalar_t dtMax = 0.05;
+  scalar_array_t eventTimes{};
+
+  auto time = gradedTimeDiscretizationWithEvents(initTime, finalTime, dt, dtGrowthFactor, dtMax, eventTimes);
+  ASSERT_EQ(time.front().time, initTime);
+  ASSERT_DOUBLE_EQ(time[1].time, initTime + dt);
+  ASSERT_DOUBLE_EQ(time[2].time, initTime + dt + dtGrowthFactor * dt);
+  ASSERT_EQ(time.back().time, finalTime);
+
+  // Steps are growing until saturated at dtMax, the last step can be shorter
+  for (size_t i = 2; i + 1 < time.size(); ++i) {
+    const scalar_t previousDt = time[i].time - time[i - 1].time;
+    const scalar_t currentDt = time[i + 1].time - time[i].time;
+    if (i + 2 < time.size()) {
+      ASSERT_GE(currentDt, previousDt - 1e-12);
+    }
+    ASSERT_LE(currentDt, dtMax + 1e-12);
+    ASSERT_EQ(time[i].event, AnnotatedTime::Event::None);
+  }
+
+  // Compared to 67 intervals on the uniform grid
+  ASSERT_EQ(time.size(), 32);
+}
+
+TEST(test_time_discretization, graded_withEvents) {
+  scalar_t initTime = 0.0;
+  scalar_t finalTime = 1.0;
+  scalar_t dt = 0.015;
+  scalar_t dtGrowthFactor = 1.1;
+  scalar_t dtMax = 0.1;
+  scalar_array_t eventTimes{0.4, 0.82};
+
+  auto time = gradedTimeDiscretizationWithEvents(initTime, finalTime, dt, dtGrowthFactor, dtMax, eventTimes);
+  const auto uniform = timeDiscretizationWithEvents(initTime, finalTime, dt, eventTimes);
+  ASSERT_LT(time.size(), uniform.size());
+
+  // All events are present as pre- and post-event nodes
+  for (const auto eventTime : eventTimes) {
+    const auto preEventIt = std::find_if(time.begin(), time.end(), [&](const AnnotatedTime& t) { return t.time == eventTime; });
+    ASSERT_NE(preEventIt, time.end());
+    ASSERT_EQ(preEventIt->event, AnnotatedTime::Event::PreEvent);
+    ASSERT_EQ(std::next(preEventIt)->time, eventTime);
+    ASSERT_EQ(std::next(preEventIt)->event, AnnotatedTime::Event::PostEvent);
+  }
+
+  // Time is non-decreasing and steps are bounded by dtMax
+  for (size_t i = 0; i + 1 < time.size(); ++i) {
+    ASSERT_GE(time[i + 1].time, time[i].time);
+    ASSERT_LE(time[i + 1].time - time[i].time, dtMax + 1e-12);
+  }
+}
+
+TEST(test_time_discretization, graded_invalidGrowthFactor) {
+  ASSERT_THROW(gradedTimeDiscretizationWithEvents(0.0, 1.0, 0.015, 0.9, 0.05, {}), std::invalid_argument);
+}
@@ -0,0 +1,150 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <fstream>
+#include <iterator>
+
+#include <gtest/gtest.h>
+
+#include "ocs2_oc/oc_problem/LqSubproblemRecorder.h"
+
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+namespace {
+ocs2::LqSubproblem getRandomLqSubproblem(int N, int nx, int nu, int nc) {
+  ocs2::LqSubproblem subproblem;
+  subproblem.x0 = ocs2::vector_t::Random(nx);
+  for (int i = 0; i < N; i++) {
+    subproblem.dynamics.push_back(ocs2::getRandomDynamics(nx, nu));
+    subproblem.cost.push_back(ocs2::getRandomCost(nx, nu));
+  }
+  subproblem.cost.push_back(ocs2::getRandomCost(nx, 0));
+  if (nc > 0) {
+    for (int i = 0; i < N; i++) {
+      subproblem.constraints.push_back(ocs2::getRandomConstraints(nx, nu, nc));
+    }
+    subproblem.constraints.push_back(ocs2::getRandomConstraints(nx, 0, nc));
+  }
+  subproblem.ocpSize =
+      ocs2::extractSizesFromProblem(subproblem.dynamics, subproblem.cost, subproblem.constraints.empty() ? nullptr : &subproblem.constraints);
+  return subproblem;
+}
+
+bool isEqual(const ocs2::VectorFunctionLinearApproximation& lhs, const ocs2::VectorFunctionLinearApproximation& rhs) {
+  return lhs.f == rhs.f && lhs.dfdx == rhs.dfdx && lhs.dfdu == rhs.dfdu;
+}
+
+bool isEqual(const ocs2::ScalarFunctionQuadraticApproximation& lhs, const ocs2::ScalarFunctionQuadraticApproximation& rhs) {
+  return lhs.f == rhs.f && lhs.dfdx == rhs.dfdx && lhs.dfdu == rhs.dfdu && lhs.dfdxx == rhs.dfdxx && lhs.dfdux == rhs.dfdux &&
+         lhs.dfduu == rhs.dfduu;
+}
+}  // namespace
+
+TEST(testLqSubproblemRecorder, recordAndLoad) {
+  srand(0);
+  const std::string filename = "/tmp/ocs2_lq_subproblem_recording.bin";
+
+  std::vector<ocs2::LqSubproblem> subproblems;
+  for (int k = 0; k < 5; ++k) {
+    subproblems.push_back(getRandomLqSubproblem(5 + k, 4, 3, (k % 2 == 0) ? 2 : 0));
+  }
+
+  {
+    ocs2::LqSubproblemRecorder recorder(filename, 2);
+    for (const auto& s : subproblems) {
+      recorder.record(s.x0, s.dynamics, s.cost, s.constraints.empty() ? nullptr : &s.constraints);
+    }
+    EXPECT_EQ(recorder.getNumRecorded(), 3);
+  }
+
+  // every second subproblem is recorded
+  const auto loaded = ocs2::loadLqSubproblems(filename);
+  ASSERT_EQ(loaded.size(), 3);
+  for (int k = 0; k < loaded.size(); ++k) {
+    const auto& expected = subproblems[2 * k];
+    const auto& actual = loaded[k];
+    EXPECT_TRUE(actual.ocpSize == expected.ocpSize);
+    EXPECT_EQ(actual.x0, expected.x0);
+    ASSERT_EQ(actual.dynamics.size(), expected.dynamics.size());
+    ASSERT_EQ(actual.cost.size(), expected.cost.size());
+    ASSERT_EQ(actual.constraints.size(), expected.constraints.size());
+    for (int i = 0; i < expected.dynamics.size(); ++i) {
+      EXPECT_TRUE(isEqual(actual.dynamics[i], expected.dynamics[i]));
+    }
+    for (int i = 0; i < expected.cost.size(); ++i) {
+      EXPECT_TRUE(isEqual(actual.cost[i], expected.cost[i]));
+    }
+    for (int i = 0; i < expected.constraints.size(); ++i) {
+      EXPECT_TRUE(isEqual(actual.constraints[i], expected.constraints[i]));
+    }
+  }
+}
+
+TEST(testLqSubproblemRecorder, rejectForeignFile) {
+  const std::string filename = "/tmp/ocs2_lq_subproblem_foreign.bin";
+  {
+    std::ofstream file(filename);
+    file << "not a recording";
+  }
+  EXPECT_THROW(ocs2::loadLqSubproblems(filename), std::runtime_error);
+}
+
+TEST(testLqSubproblemRecorder, rejectCorruptedFile) {
+  srand(0);
+  const std::string filename = "/tmp/ocs2_lq_subproblem_corrupted.bin";
+  const auto subproblem = getRandomLqSubproblem(5, 4, 3, 2);
+  {
+    ocs2::LqSubproblemRecorder recorder(filename);
+    recorder.record(subproblem.x0, subproblem.dynamics, subproblem.cost, &subproblem.constraints);
+  }
+  std::string recording;
+  {
+    std::ifstream file(filename, std::ios::binary);
+    recording.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  ASSERT_EQ(ocs2::loadLqSubproblems(filename).size(), 1);
+
+  const auto writeAndLoad = [&](const std::string& content) {
+    {
+      std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+      file << content;
+    }
+    return ocs2::loadLqSubproblems(filename);
+  };
+
+  // truncated recording
+  EXPECT_THROW(writeAndLoad(recording.substr(0, recording.size() - 1)), std::runtime_error);
+
+  // a size larger than the file, i.e., the size of the first array of OcpSize after the header and the number of stages
+  auto oversized = recording;
+  const int64_t hugeSize = int64_t(1) << 40;
+  oversized.replace(sizeof("OCS2_LQ_SUBPROBLEM_V1") - 1 + sizeof(int64_t), sizeof(int64_t), reinterpret_cast<const char*>(&hugeSize),
+                    sizeof(int64_t));
+  EXPECT_THROW(writeAndLoad(oversized), std::runtime_error);
+}
@@ -0,0 +1,162 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_oc/search_strategy/FilterLinesearch.h"
+#include "ocs2_oc/search_strategy/SpeculativeLinesearch.h"
+
+namespace {
+/** A step performance which is only accepted for step sizes up to maxAcceptedStepSize */
+ocs2::PerformanceIndex getStepPerformance(ocs2::scalar_t stepSize, ocs2::scalar_t maxAcceptedStepSize) {
+  ocs2::PerformanceIndex performance;
+  performance.merit = (stepSize <= maxAcceptedStepSize) ? 1.0 - stepSize : 2.0;
+  return performance;
+}
+}  // namespace
+
+TEST(testFilterLinesearch, backtrackingStepSizes) {
+  const auto stepSizes = ocs2::backtrackingStepSizes(1.0, 0.5, 1e-2, 1e-6, 1.0, 1.0);
+  ASSERT_EQ(stepSizes.size(), 7);
+  for (int i = 0; i < stepSizes.size(); i++) {
+    EXPECT_DOUBLE_EQ(stepSizes[i], std::pow(0.5, i));
+  }
+
+  // early exit due to small primal steps
+  EXPECT_EQ(ocs2::backtrackingStepSizes(1.0, 0.5, 1e-2, 0.3, 1.0, 0.1).size(), 2);
+  // the first step size is always tried
+  EXPECT_EQ(ocs2::backtrackingStepSizes(1e-3, 0.5, 1e-2, 1e-6, 1.0, 1.0).size(), 1);
+}
+
+TEST(testFilterLinesearch, speculativeStep) {
+  constexpr size_t numWorkers = 4;
+  ocs2::ThreadPool threadPool(numWorkers - 1);
+  const ocs2::FilterLinesearch filterLinesearch;
+
+  ocs2::PerformanceIndex baseline;
+  baseline.merit = 1.0;
+  const ocs2::scalar_t armijoDescentMetric = -1.0;
+  const auto stepSizes = ocs2::backtrackingStepSizes(1.0, 0.5, 1e-4, 1e-6, 1.0, 1.0);
+
+  for (const ocs2::scalar_t maxAcceptedStepSize : {1.0, 0.3, 0.01, 1e-5}) {
+    // serial backtracking
+    int serialIndex = -1;
+    for (int i = 0; i < stepSizes.size(); i++) {
+      const auto stepPerformance = getStepPerformance(stepSizes[i], maxAcceptedStepSize);
+      if (filterLinesearch.acceptStep(baseline, stepPerformance, stepSizes[i] * armijoDescentMetric).first) {
+        serialIndex = i;
+        break;
+      }
+    }
+
+    // speculative
+    std::vector<ocs2::scalar_t> workerStepSize(threadPool.numThreads() + 1);
+    ocs2::scalar_t storedStepSize = 0.0;
+    ocs2::PerformanceIndex storedPerformance;
+    auto evaluateStep = [&](int workerId, ocs2::scalar_t stepSize, const std::atomic_bool&) {
+      workerStepSize[workerId] = stepSize;
+      return getStepPerformance(stepSize, maxAcceptedStepSize);
+    };
+    auto storeStep = [&](int workerId, const ocs2::PerformanceIndex& stepPerformance) {
+      storedStepSize = workerStepSize[workerId];
+      storedPerformance = stepPerformance;
+    };
+    const auto result =
+        filterLinesearch.speculativeStep(threadPool, numWorkers, baseline, armijoDescentMetric, stepSizes, evaluateStep, storeStep);
+
+    ASSERT_EQ(result.first, serialIndex);
+    if (serialIndex >= 0) {
+      EXPECT_DOUBLE_EQ(storedStepSize, stepSizes[serialIndex]);
+      EXPECT_DOUBLE_EQ(storedPerformance.merit, getStepPerformance(stepSizes[serialIndex], maxAcceptedStepSize).merit);
+    } else {
+      EXPECT_EQ(result.second, ocs2::FilterLinesearch::StepType::ZERO);
+    }
+  }
+}
+
+TEST(testFilterLinesearch, speculativeLinesearch) {
+  constexpr size_t numWorkers = 4;
+  constexpr size_t numNodes = 10;
+  ocs2::ThreadPool threadPool(numWorkers - 1);
+  const ocs2::FilterLinesearch filterLinesearch;
+
+  ocs2::PerformanceIndex baseline;
+  baseline.cost = 1.0;
+  baseline.merit = 1.0;
+  const ocs2::scalar_t armijoDescentMetric = -1.0;
+  const auto stepSizes = ocs2::backtrackingStepSizes(1.0, 0.5, 1e-4, 1e-6, 1.0, 1.0);
+  const ocs2::vector_array_t direction(numNodes, ocs2::vector_t::Ones(1));
+
+  for (const ocs2::scalar_t maxAcceptedStepSize : {1.0, 0.3, 0.01, 1e-5}) {
+    // The candidate at step size alpha is x = alpha at all nodes. Each node contributes to the cost.
+    std::atomic_int numEvaluations{0};
+    auto evaluateNode = [&](int workerId, int i, const std::vector<ocs2::vector_array_t>& candidate, ocs2::Metrics& metrics) {
+      ++numEvaluations;
+      metrics.cost = getStepPerformance(candidate[0][i](0), maxAcceptedStepSize).merit / numNodes;
+      ocs2::PerformanceIndex performance;
+      performance.cost = metrics.cost;
+      return performance;
+    };
+
+    std::vector<ocs2::vector_array_t> trajectories{ocs2::vector_array_t(numNodes, ocs2::vector_t::Zero(1))};
+    std::vector<ocs2::Metrics> metrics;
+    const auto result = ocs2::speculativeLinesearch(filterLinesearch, threadPool, numWorkers, baseline, armijoDescentMetric, stepSizes,
+                                                    numNodes, evaluateNode, {direction}, trajectories, metrics);
+
+    // serial backtracking
+    int serialIndex = -1;
+    for (int i = 0; i < stepSizes.size(); i++) {
+      const auto stepPerformance = getStepPerformance(stepSizes[i], maxAcceptedStepSize);
+      if (filterLinesearch.acceptStep(baseline, stepPerformance, stepSizes[i] * armijoDescentMetric).first) {
+        serialIndex = i;
+        break;
+      }
+    }
+
+    ASSERT_EQ(result.stepIndex, serialIndex);
+    if (serialIndex >= 0) {
+      ASSERT_EQ(metrics.size(), numNodes);
+      EXPECT_NEAR(result.performance.merit, getStepPerformance(stepSizes[serialIndex], maxAcceptedStepSize).merit, 1e-12);
+      for (size_t i = 0; i < numNodes; i++) {
+        EXPECT_DOUBLE_EQ(trajectories[0][i](0), stepSizes[serialIndex]);
+      }
+    } else {
+      EXPECT_EQ(result.stepType, ocs2::FilterLinesearch::StepType::ZERO);
+      EXPECT_TRUE(metrics.empty());
+      EXPECT_DOUBLE_EQ(trajectories[0].front()(0), 0.0);
+    }
+
+    // An accepted full step is evaluated once, node by node, like the serial linesearch
+    if (serialIndex == 0) {
+      EXPECT_EQ(numEvaluations, numNodes);
+    }
+  }
+}
@@ -29,7 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <tuple>
 #include <utility>
+#include <vector>
 
 #include <ocs2_core/Types.h>
 
@@ -56,6 +58,24 @@ class DistanceTransformInterface {
 
   /** Gets the distance's value and its gradient at the given point. */
   virtual std::pair<scalar_t, vector3_t> getLinearApproximation(const vector3_t& p) const = 0;
+
+  /** Gets the distances to a batch of points. The default implementation queries the points one by one. */
+  virtual void getValues(const std::vector<vector3_t>& points, scalar_array_t& values) const {
+    values.resize(points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+      values[i] = getValue(points[i]);
+    }
+  }
+
+  /** Gets the distances' values and gradients at a batch of points. The default implementation queries the points one by one. */
+  virtual void getLinearApproximations(const std::vector<vector3_t>& points, scalar_array_t& values,
+                                       std::vector<vector3_t>& gradients) const {
+    values.resize(points.size());
+    gradients.resize(points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+      std::tie(values[i], gradients[i]) = getLinearApproximation(points[i]);
+    }
+  }
 };
 
 /** Identity distance transform with constant zero value and zero gradients. */
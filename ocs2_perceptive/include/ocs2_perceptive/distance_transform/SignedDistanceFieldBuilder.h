@@ -0,0 +1,140 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+namespace ocs2 {
+
+/** Index box [begin, end) of a 3D grid. */
+struct GridRegion {
+  std::array<size_t, 3> begin{{0, 0, 0}};
+  std::array<size_t, 3> end{{0, 0, 0}};
+};
+
+/**
+ * Builds the Euclidean signed distance field (SDF) of a 2D or 3D occupancy grid. The field is positive in the free cells and holds
+ * the distance to the nearest occupied cell center. In the occupied cells, it is negative and holds the distance to the nearest free
+ * cell center.
+ *
+ * The grid is stored contiguously with x as the fastest index: index = x + sizeX * (y + sizeY * z). A 2D grid has sizeZ = 1.
+ *
+ * The squared distances are computed with the separable lower envelope method of computeDistanceTransform(), one pass per axis. The
+ * lines of a pass are independent and distributed over a thread pool. The strided y and z lines are processed in blocks of adjacent
+ * x-lines which are gathered into contiguous buffers row by row, such that all memory accesses to the grid are sequential.
+ *
+ * If the field is truncated at maxDistance, a change of the occupancy only affects the cells within maxDistance. update() then
+ * recomputes only these cells.
+ */
+class SignedDistanceFieldBuilder {
+ public:
+  struct Settings {
+    /** Number of threads, including the calling thread. */
+    size_t nThreads = 1;
+    /** Priority of the worker threads. */
+    int threadPriority = 50;
+    /** Size of a grid cell [m]. */
+    float resolution = 1.0;
+    /** The magnitude of the field is clamped to this value [m]. */
+    float maxDistance = std::numeric_limits<float>::max();
+  };
+
+  /**
+   * Constructor
+   * @param [in] size : The number of cells along x, y and z.
+   * @param [in] settings : The settings.
+   */
+  SignedDistanceFieldBuilder(std::array<size_t, 3> size, Settings settings);
+
+  ~SignedDistanceFieldBuilder() = default;
+
+  /** Gets the number of cells along x, y and z. */
+  const std::array<size_t, 3>& getSize() const { return size_; }
+
+  /** Gets the number of cells of the grid. */
+  size_t getNumCells() const { return size_[0] * size_[1] * size_[2]; }
+
+  /** Gets the index of cell (x, y, z) in the contiguous grid. */
+  size_t getIndex(size_t x, size_t y, size_t z) const { return x + size_[0] * (y + size_[1] * z); }
+
+  /**
+   * Computes the signed distance field of the whole grid.
+   *
+   * @param [in] occupancy : The occupancy of each cell, non-zero for occupied cells.
+   * @param [out] signedDistance : The signed distance of each cell [m].
+   */
+  void compute(const std::vector<uint8_t>& occupancy, std::vector<float>& signedDistance);
+
+  /**
+   * Updates the signed distance field after the occupancy has changed within a region. Only the cells within maxDistance of the
+   * region are recomputed. The result is identical to compute().
+   *
+   * @param [in] occupancy : The new occupancy of each cell, non-zero for occupied cells.
+   * @param [in] dirtyRegion : The region which contains all the cells whose occupancy has changed.
+   * @param [in, out] signedDistance : The signed distance field of the previous occupancy, which is updated.
+   */
+  void update(const std::vector<uint8_t>& occupancy, const GridRegion& dirtyRegion, std::vector<float>& signedDistance);
+
+ private:
+  /** Computes the squared distances [cells^2] to the cells with the given occupancy within the region. */
+  void computeSquaredDistance(const std::vector<uint8_t>& occupancy, bool toOccupied, const GridRegion& region,
+                              std::vector<float>& squaredDistance);
+
+  /** Runs the task on nThreads threads. */
+  void runParallel(std::function<void(int)> taskFunction);
+
+  /** Per thread memory of the one-dimensional transforms. */
+  struct LineBuffer {
+    std::vector<float> input;
+    std::vector<float> output;
+    std::vector<float> heights;
+    std::vector<int> vertices;
+    std::vector<float> boundaries;
+  };
+
+  const std::array<size_t, 3> size_;
+  const Settings settings_;
+  const size_t truncationRadius_;  // maxDistance in cells
+
+  ThreadPool threadPool_;
+  std::vector<LineBuffer> lineBuffers_;
+  std::vector<float> squares_;  // q^2 for q in [0, maximum size)
+  std::vector<float> distanceToOccupied_;
+  std::vector<float> distanceToFree_;
+};
+
+}  // namespace ocs2
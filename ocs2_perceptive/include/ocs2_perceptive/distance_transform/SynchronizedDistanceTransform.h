@@ -0,0 +1,117 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <ocs2_oc/synchronized_module/SolverSynchronizedModule.h>
+
+#include "ocs2_perceptive/distance_transform/DistanceTransformInterface.h"
+
+namespace ocs2 {
+
+/**
+ * A distance field which can be replaced while the MPC is running.
+ *
+ * The class is double-buffered. A perception thread builds the next field in the background and hands it over with publish(). The
+ * published field becomes active at the start of the next MPC iteration, when the solver calls preSolverRun(). The active field does
+ * not change during a solve, so the solver threads read it through the DistanceTransformInterface of this class without locking.
+ * The field that is replaced is released on the next call of publish(), i.e., on the perception thread.
+ *
+ * Usage:
+ *   auto distanceTransformPtr = std::make_shared<SynchronizedDistanceTransform>();
+ *   solver.addSynchronizedModule(distanceTransformPtr);
+ *   constraint.set(*distanceTransformPtr);
+ *   // on the perception thread
+ *   distanceTransformPtr->publish(std::make_shared<TiledDistanceField>(...));
+ *
+ * @note The queries must only be called by the solver, i.e., between preSolverRun() and postSolverRun().
+ */
+class SynchronizedDistanceTransform final : public DistanceTransformInterface, public SolverSynchronizedModule {
+ public:
+  using field_ptr_t = std::shared_ptr<const DistanceTransformInterface>;
+
+  /**
+   * Constructor
+   * @param [in] initialField : The field that is active until the first published field. Defaults to IdentityDistanceTransform.
+   */
+  explicit SynchronizedDistanceTransform(field_ptr_t initialField = std::make_shared<IdentityDistanceTransform>());
+
+  ~SynchronizedDistanceTransform() override = default;
+
+  /**
+   * Publishes the next field. It becomes active at the next preSolverRun(). A field that was published earlier but has not become
+   * active yet is discarded. This method is thread-safe.
+   *
+   * @param [in] field : The next field.
+   * @return The version of the published field.
+   */
+  size_t publish(field_ptr_t field);
+
+  /** Gets the version of the active field. The initial field has version 0. */
+  size_t getActiveVersion() const { return activeVersion_; }
+
+  /** Gets the active field. */
+  const DistanceTransformInterface& getActive() const { return *activeFieldPtr_; }
+
+  void preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
+                    const ReferenceManagerInterface& referenceManager) override;
+  void postSolverRun(const PrimalSolution& primalSolution) override {}
+
+  scalar_t getValue(const vector3_t& p) const override { return activeFieldPtr_->getValue(p); }
+  vector3_t getProjectedPoint(const vector3_t& p) const override { return activeFieldPtr_->getProjectedPoint(p); }
+  std::pair<scalar_t, vector3_t> getLinearApproximation(const vector3_t& p) const override {
+    return activeFieldPtr_->getLinearApproximation(p);
+  }
+  void getValues(const std::vector<vector3_t>& points, scalar_array_t& values) const override {
+    activeFieldPtr_->getValues(points, values);
+  }
+  void getLinearApproximations(const std::vector<vector3_t>& points, scalar_array_t& values,
+                               std::vector<vector3_t>& gradients) const override {
+    activeFieldPtr_->getLinearApproximations(points, values, gradients);
+  }
+
+ private:
+  // accessed by the solver only
+  field_ptr_t activeFieldPtr_;
+  size_t activeVersion_ = 0;
+
+  // shared with the perception thread, protected by mutex_
+  std::mutex mutex_;
+  field_ptr_t pendingFieldPtr_;
+  field_ptr_t retiredFieldPtr_;
+  size_t pendingVersion_ = 0;
+  size_t latestVersion_ = 0;
+};
+
+}  // namespace ocs2
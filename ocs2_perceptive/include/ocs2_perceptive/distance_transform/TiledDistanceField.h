@@ -0,0 +1,121 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "ocs2_perceptive/distance_transform/DistanceTransformInterface.h"
+
+namespace ocs2 {
+
+/**
+ * Distance field on a regular 3D grid which is interpolated tri-linearly.
+ *
+ * The voxels are stored in tiles of 4x4x4 voxels and the tiles are ordered along a Morton (Z-order) curve, such that voxels which are
+ * close in space are close in memory. A query interpolates the distance from the eight voxels around the point, and the gradient is the
+ * exact derivative of this interpolation.
+ *
+ * The batched queries sort the points along the storage order before evaluating them, which makes the queries of many nearby points
+ * cache-friendly. Note that the constraints are evaluated node by node, thus EndEffectorDistanceConstraint batches the end-effectors of
+ * one node.
+ *
+ * Points outside of the grid are clamped to the grid. The distance is then constant along the clamped axes, thus the gradient along
+ * them is zero.
+ */
+class TiledDistanceField final : public DistanceTransformInterface {
+ public:
+  /**
+   * Constructor
+   * @param [in] signedDistance : The distance of each voxel on a contiguous grid with x as the fastest index, e.g., the output of
+   *                              SignedDistanceFieldBuilder.
+   * @param [in] size : The number of voxels along x, y and z.
+   * @param [in] resolution : The size of a voxel.
+   * @param [in] origin : The position of the center of voxel (0, 0, 0).
+   */
+  TiledDistanceField(const std::vector<float>& signedDistance, const std::array<size_t, 3>& size, scalar_t resolution,
+                     const vector3_t& origin);
+
+  ~TiledDistanceField() override = default;
+
+  scalar_t getValue(const vector3_t& p) const override;
+  vector3_t getProjectedPoint(const vector3_t& p) const override;
+  std::pair<scalar_t, vector3_t> getLinearApproximation(const vector3_t& p) const override;
+
+  void getValues(const std::vector<vector3_t>& points, scalar_array_t& values) const override;
+  void getLinearApproximations(const std::vector<vector3_t>& points, scalar_array_t& values,
+                               std::vector<vector3_t>& gradients) const override;
+
+  /** Gets the number of voxels along x, y and z. */
+  const std::array<size_t, 3>& getSize() const { return size_; }
+
+  /** Gets the size of a voxel. */
+  scalar_t getResolution() const { return resolution_; }
+
+  /** Gets the position of the center of voxel (0, 0, 0). */
+  const vector3_t& getOrigin() const { return origin_; }
+
+ private:
+  /** The eight voxels around a point and the interpolation weights along each axis. */
+  struct Cell {
+    std::array<uint32_t, 8> voxels;  // in the order (0, 0, 0), (1, 0, 0), (0, 1, 0), (1, 1, 0), (0, 0, 1), (1, 0, 1), (0, 1, 1), (1, 1, 1)
+    std::array<scalar_t, 3> weights;
+    std::array<scalar_t, 3> weightDerivatives;  // derivative of the weights w.r.t. the position, zero along the clamped axes
+  };
+
+  static constexpr size_t TileWidth = 4;
+  static constexpr size_t TileSize = TileWidth * TileWidth * TileWidth;
+
+  /** Gets the storage index of voxel (x, y, z). */
+  uint32_t getStorageIndex(size_t x, size_t y, size_t z) const;
+
+  /** Finds the voxels around the point. */
+  Cell getCell(const vector3_t& p) const;
+
+  /** Interpolates the distance. */
+  scalar_t interpolateValue(const Cell& cell) const;
+
+  /** Interpolates the distance and its gradient. */
+  std::pair<scalar_t, vector3_t> interpolateLinearApproximation(const Cell& cell) const;
+
+  /** Finds the cells of the points and returns the order of the points along the storage. */
+  std::vector<size_t> getSortedCells(const std::vector<vector3_t>& points, std::vector<Cell>& cells) const;
+
+  const std::array<size_t, 3> size_;
+  const scalar_t resolution_;
+  const vector3_t origin_;
+  std::array<size_t, 3> numTiles_;
+  std::vector<uint32_t> tileOffsets_;  // storage offset of each tile, indexed by tx + numTilesX * (ty + numTilesY * tz)
+  std::vector<float> values_;
+};
+
+}  // namespace ocs2
@@ -43,6 +43,9 @@ namespace ocs2 {
 
 /**
  * End-effector distance constraint Function.
+ *
+ * The distances of all end-effectors are queried with one batched call to the distance transform. Since constraints are evaluated node
+ * by node, the batch does not span several nodes.
  */
 class EndEffectorDistanceConstraint final : public ocs2::StateConstraint {
  public:
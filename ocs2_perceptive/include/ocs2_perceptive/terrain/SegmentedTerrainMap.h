@@ -0,0 +1,163 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/**
+ * Segments a 2.5D height map into steppable planar regions and builds an index from each cell of the map to a nearby foothold region.
+ *
+ * All the processing is done once in the constructor, such that the queries of a controller only read the precomputed index:
+ * 1. A plane is fitted to the neighbourhood of each cell. Summed-area tables of the moments of the heights make each fit O(1). A cell
+ *    is steppable if the slope and the RMS residual of its plane are small enough.
+ * 2. Neighbouring steppable cells with similar planes are grouped into segments by a flood fill. A plane is fitted to each segment.
+ * 3. For each cell of a segment, the Chebyshev distance to the closest cell outside the segment is computed. It gives the largest
+ *    square, aligned with the grid and centered at the cell, that lies inside the segment.
+ * 4. Each cell of the map is assigned the closest cell whose square is at least minRegionHalfWidth wide.
+ *
+ * The map is stored contiguously with x as the fastest index: index = x + sizeX * y. Unknown heights are NaN.
+ */
+class SegmentedTerrainMap {
+ public:
+  using vector2_t = Eigen::Matrix<scalar_t, 2, 1>;
+  using vector3_t = Eigen::Matrix<scalar_t, 3, 1>;
+
+  struct Settings {
+    /** The plane of a cell is fitted to the (2 * planeFitRadius + 1)^2 cells around it. */
+    size_t planeFitRadius = 1;
+    /** Maximum slope of a steppable cell [rad]. */
+    scalar_t maxSlope = 0.5;
+    /** Maximum RMS residual of the plane of a steppable cell [m]. */
+    scalar_t maxRoughness = 0.01;
+    /** Maximum angle between the planes of neighbouring cells of a segment [rad]. */
+    scalar_t maxNormalDeviation = 0.2;
+    /** Maximum distance of a cell to the plane of its neighbour in the same segment [m]. */
+    scalar_t maxStepHeight = 0.02;
+    /** Segments with fewer cells are not steppable. */
+    size_t minSegmentSize = 4;
+    /** Minimum half width of the square of a foothold region [m]. */
+    scalar_t minRegionHalfWidth = 0.05;
+  };
+
+  /**
+   * A steppable region: The square of the xy-plane with the given center and half width, on the plane of a segment.
+   * Its points p satisfy |p.x - center.x| <= halfWidth and |p.y - center.y| <= halfWidth.
+   */
+  struct Region {
+    int segmentId = -1;
+    vector3_t center = vector3_t::Zero();
+    vector3_t normal = vector3_t::UnitZ();
+    scalar_t halfWidth = 0.0;
+
+    /** Gets the height of the plane of the region at the given xy-position. */
+    scalar_t getHeight(const vector2_t& position) const {
+      return center.z() - (normal.x() * (position.x() - center.x()) + normal.y() * (position.y() - center.y())) / normal.z();
+    }
+  };
+
+  /**
+   * Constructor
+   * @param [in] heights : The height of each cell, NaN for unknown cells.
+   * @param [in] size : The number of cells along x and y.
+   * @param [in] resolution : The size of a cell.
+   * @param [in] origin : The position of the center of cell (0, 0).
+   * @param [in] settings : The settings.
+   */
+  SegmentedTerrainMap(const std::vector<float>& heights, const std::array<size_t, 2>& size, scalar_t resolution, const vector2_t& origin,
+                      Settings settings);
+
+  ~SegmentedTerrainMap() = default;
+
+  /** Gets the number of cells along x and y. */
+  const std::array<size_t, 2>& getSize() const { return size_; }
+
+  /** Gets the size of a cell. */
+  scalar_t getResolution() const { return resolution_; }
+
+  /** Gets the position of the center of cell (0, 0). */
+  const vector2_t& getOrigin() const { return origin_; }
+
+  /** Gets the number of segments. */
+  size_t getNumSegments() const { return segmentPlanes_.size(); }
+
+  /** Gets the segment of the cell that contains the position, -1 if the cell is not steppable. Positions are clamped to the map. */
+  int getSegmentId(const vector2_t& position) const { return segmentIds_[getIndex(position)]; }
+
+  /**
+   * Gets the foothold region closest to the position. Positions are clamped to the map.
+   *
+   * @param [in] position : The xy-position.
+   * @param [out] region : The foothold region.
+   * @return false if the map does not contain a region of at least minRegionHalfWidth.
+   */
+  bool getFootholdRegion(const vector2_t& position, Region& region) const;
+
+ private:
+  /** A plane through point with the given normal. */
+  struct Plane {
+    vector3_t point;
+    vector3_t normal;
+  };
+
+  /** Gets the index of the cell that contains the position. */
+  size_t getIndex(const vector2_t& position) const;
+
+  /** Gets the position of the center of a cell. */
+  vector2_t getPosition(size_t index) const;
+
+  /** Fits a plane to the neighbourhood of each cell and marks the steppable cells. */
+  void fitLocalPlanes(const std::vector<float>& heights, std::vector<Plane>& localPlanes, std::vector<bool>& isSteppable) const;
+
+  /** Groups the steppable cells into segments and fits their planes. */
+  void segment(const std::vector<float>& heights, const std::vector<Plane>& localPlanes, const std::vector<bool>& isSteppable);
+
+  /** Computes the Chebyshev distance of each cell to the closest cell outside of its segment. */
+  void computeRegionSizes();
+
+  /** Assigns each cell the closest cell with a large enough region. */
+  void computeFootholdIndices();
+
+  const std::array<size_t, 2> size_;
+  const scalar_t resolution_;
+  const vector2_t origin_;
+  const Settings settings_;
+
+  std::vector<Plane> segmentPlanes_;
+  std::vector<int> segmentIds_;       // -1 for cells which are not steppable
+  std::vector<int> regionSizes_;      // Chebyshev distance [cells] to the closest cell outside the segment, 0 outside of segments
+  std::vector<int> footholdIndices_;  // closest cell with a large enough region, -1 if there is none
+};
+
+}  // namespace ocs2
@@ -0,0 +1,281 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_perceptive/distance_transform/SignedDistanceFieldBuilder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include <Eigen/Core>
+
+namespace ocs2 {
+
+namespace {
+
+/** Number of adjacent x-lines that are processed together in the y and z passes. */
+constexpr size_t BlockWidth = 16;
+
+/** Squared distance of the cells without a site. It is finite such that the intersections of the parabolas stay well-defined. */
+constexpr float Infinity = 1e20f;
+
+using array_t = Eigen::Array<float, Eigen::Dynamic, 1>;
+
+/** Dilates the region by the given number of cells and clamps it to the grid. */
+GridRegion dilate(const GridRegion& region, size_t numCells, const std::array<size_t, 3>& size) {
+  GridRegion dilated;
+  for (size_t i = 0; i < 3; i++) {
+    dilated.begin[i] = region.begin[i] > numCells ? region.begin[i] - numCells : 0;
+    dilated.end[i] = std::min(size[i], region.end[i] + std::min(numCells, size[i]));
+  }
+  return dilated;
+}
+
+/**
+ * One-dimensional squared distance transform of a contiguous line, see computeDistanceTransform().
+ *
+ * @param [in] n : The number of samples.
+ * @param [in] squares : The array q^2 for q in [0, n).
+ * @param [in] f : The sampled function.
+ * @param [out] d : The distance transform of f.
+ * @param [in] heights : Memory of size n for f(q) + q^2.
+ * @param [in] v : Memory of size n for the locations of the parabolas in the lower envelope.
+ * @param [in] z : Memory of size n + 1 for the boundaries between the parabolas.
+ */
+void distanceTransform(size_t n, const float* squares, const float* f, float* d, float* heights, int* v, float* z) {
+  // heights of the parabola vertices, shifted to the origin
+  Eigen::Map<array_t>(heights, n) = Eigen::Map<const array_t>(f, n) + Eigen::Map<const array_t>(squares, n);
+
+  // compute lower envelope
+  int k = 0;  // index of rightmost parabola in lower envelope
+  v[0] = 0;
+  z[0] = std::numeric_limits<float>::lowest();
+  z[1] = std::numeric_limits<float>::max();
+  for (int q = 1; q < static_cast<int>(n); q++) {
+    float s = 0;
+    while (true) {
+      // horizontal position of the intersection between the parabola from q & the current lowest parabola
+      s = (heights[q] - heights[v[k]]) / static_cast<float>(2 * (q - v[k]));
+      if (s > z[k]) {
+        break;
+      }
+      k--;
+    }
+    k++;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = std::numeric_limits<float>::max();
+  }
+
+  // fill in values of distance transform
+  k = 0;
+  for (int q = 0; q < static_cast<int>(n); q++) {
+    while (z[k + 1] < static_cast<float>(q)) {
+      k++;
+    }
+    d[q] = heights[v[k]] - static_cast<float>(2 * q * v[k]) + squares[q];
+  }
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SignedDistanceFieldBuilder::SignedDistanceFieldBuilder(std::array<size_t, 3> size, Settings settings)
+    : size_(size),
+      settings_(std::move(settings)),
+      truncationRadius_([&]() -> size_t {
+        const size_t maxSize = *std::max_element(size_.begin(), size_.end());
+        const double radius = std::ceil(static_cast<double>(settings_.maxDistance) / static_cast<double>(settings_.resolution));
+        return radius < static_cast<double>(maxSize) ? static_cast<size_t>(radius) : maxSize;
+      }()),
+      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority),
+      lineBuffers_(std::max(settings_.nThreads, size_t(1))) {
+  if (getNumCells() == 0) {
+    throw std::runtime_error("[SignedDistanceFieldBuilder] The grid has no cells!");
+  }
+  if (settings_.resolution <= 0.0 || settings_.maxDistance <= 0.0) {
+    throw std::runtime_error("[SignedDistanceFieldBuilder] The resolution and the maximum distance must be positive!");
+  }
+
+  const size_t maxSize = *std::max_element(size_.begin(), size_.end());
+  squares_.resize(maxSize);
+  for (size_t q = 0; q < maxSize; q++) {
+    squares_[q] = static_cast<float>(q * q);
+  }
+  for (auto& buffer : lineBuffers_) {
+    buffer.input.resize(BlockWidth * maxSize);
+    buffer.output.resize(BlockWidth * maxSize);
+    buffer.heights.resize(maxSize);
+    buffer.vertices.resize(maxSize);
+    buffer.boundaries.resize(maxSize + 1);
+  }
+  distanceToOccupied_.resize(getNumCells());
+  distanceToFree_.resize(getNumCells());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SignedDistanceFieldBuilder::compute(const std::vector<uint8_t>& occupancy, std::vector<float>& signedDistance) {
+  GridRegion grid;
+  grid.end = size_;
+  signedDistance.resize(getNumCells());
+  update(occupancy, grid, signedDistance);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SignedDistanceFieldBuilder::update(const std::vector<uint8_t>& occupancy, const GridRegion& dirtyRegion,
+                                        std::vector<float>& signedDistance) {
+  if (occupancy.size() != getNumCells() || signedDistance.size() != getNumCells()) {
+    throw std::runtime_error("[SignedDistanceFieldBuilder::update] The size of the occupancy or the distance field is incorrect!");
+  }
+  for (size_t i = 0; i < 3; i++) {
+    if (dirtyRegion.begin[i] >= dirtyRegion.end[i]) {
+      return;  // empty region
+    }
+    if (dirtyRegion.end[i] > size_[i]) {
+      throw std::runtime_error("[SignedDistanceFieldBuilder::update] The dirty region exceeds the grid!");
+    }
+  }
+
+  // The changed cells affect the field up to the truncation radius. The sites of the affected cells lie within twice the radius.
+  const GridRegion affectedRegion = dilate(dirtyRegion, truncationRadius_, size_);
+  const GridRegion sitesRegion = dilate(dirtyRegion, 2 * truncationRadius_, size_);
+  computeSquaredDistance(occupancy, true, sitesRegion, distanceToOccupied_);
+  computeSquaredDistance(occupancy, false, sitesRegion, distanceToFree_);
+
+  // signed distance of the affected cells, one x-line at a time
+  const size_t sizeX = affectedRegion.end[0] - affectedRegion.begin[0];
+  const size_t sizeY = affectedRegion.end[1] - affectedRegion.begin[1];
+  const size_t numLines = sizeY * (affectedRegion.end[2] - affectedRegion.begin[2]);
+  std::atomic_size_t lineIndex{0};
+  auto signTask = [&](int) {
+    for (size_t l = lineIndex++; l < numLines; l = lineIndex++) {
+      const size_t index = getIndex(affectedRegion.begin[0], affectedRegion.begin[1] + l % sizeY, affectedRegion.begin[2] + l / sizeY);
+      const Eigen::Map<const Eigen::Array<uint8_t, Eigen::Dynamic, 1>> isOccupied(occupancy.data() + index, sizeX);
+      const Eigen::Map<const array_t> toOccupied(distanceToOccupied_.data() + index, sizeX);
+      const Eigen::Map<const array_t> toFree(distanceToFree_.data() + index, sizeX);
+      Eigen::Map<array_t>(signedDistance.data() + index, sizeX) =
+          ((isOccupied.cast<float>() > 0.0f).select(-toFree.sqrt(), toOccupied.sqrt()) * settings_.resolution)
+              .max(-settings_.maxDistance)
+              .min(settings_.maxDistance);
+    }
+  };
+  runParallel(signTask);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SignedDistanceFieldBuilder::computeSquaredDistance(const std::vector<uint8_t>& occupancy, bool toOccupied, const GridRegion& region,
+                                                        std::vector<float>& squaredDistance) {
+  const std::array<size_t, 3> extent{{region.end[0] - region.begin[0], region.end[1] - region.begin[1], region.end[2] - region.begin[2]}};
+  const size_t strideY = size_[0];
+  const size_t strideZ = size_[0] * size_[1];
+
+  // initialization and x pass: the x-lines are contiguous
+  const size_t numLinesX = extent[1] * extent[2];
+  std::atomic_size_t lineIndex{0};
+  auto xTask = [&](int workerId) {
+    auto& buffer = lineBuffers_[workerId];
+    for (size_t l = lineIndex++; l < numLinesX; l = lineIndex++) {
+      const size_t index = getIndex(region.begin[0], region.begin[1] + l % extent[1], region.begin[2] + l / extent[1]);
+      for (size_t i = 0; i < extent[0]; i++) {
+        buffer.input[i] = ((occupancy[index + i] != 0) == toOccupied) ? 0.0f : Infinity;
+      }
+      distanceTransform(extent[0], squares_.data(), buffer.input.data(), squaredDistance.data() + index, buffer.heights.data(),
+                        buffer.vertices.data(), buffer.boundaries.data());
+    }
+  };
+  runParallel(xTask);
+
+  // y and z passes: blocks of adjacent x-lines are gathered row by row into contiguous lines
+  auto blockedPass = [&](size_t axis) {
+    const size_t otherAxis = (axis == 1) ? 2 : 1;
+    const size_t stride = (axis == 1) ? strideY : strideZ;
+    const size_t lineLength = extent[axis];
+    const size_t numBlocksX = (extent[0] + BlockWidth - 1) / BlockWidth;
+    const size_t numBlocks = numBlocksX * extent[otherAxis];
+
+    std::atomic_size_t blockIndex{0};
+    auto blockTask = [&](int workerId) {
+      auto& buffer = lineBuffers_[workerId];
+      for (size_t b = blockIndex++; b < numBlocks; b = blockIndex++) {
+        const size_t x0 = region.begin[0] + (b % numBlocksX) * BlockWidth;
+        const size_t width = std::min(BlockWidth, region.end[0] - x0);
+        std::array<size_t, 3> origin{{x0, region.begin[1], region.begin[2]}};
+        origin[otherAxis] += b / numBlocksX;
+        float* lineStart = squaredDistance.data() + getIndex(origin[0], origin[1], origin[2]);
+
+        // gather
+        for (size_t j = 0; j < lineLength; j++) {
+          const float* row = lineStart + j * stride;
+          for (size_t c = 0; c < width; c++) {
+            buffer.input[c * lineLength + j] = row[c];
+          }
+        }
+        // transform
+        for (size_t c = 0; c < width; c++) {
+          distanceTransform(lineLength, squares_.data(), buffer.input.data() + c * lineLength, buffer.output.data() + c * lineLength,
+                            buffer.heights.data(), buffer.vertices.data(), buffer.boundaries.data());
+        }
+        // scatter
+        for (size_t j = 0; j < lineLength; j++) {
+          float* row = lineStart + j * stride;
+          for (size_t c = 0; c < width; c++) {
+            row[c] = buffer.output[c * lineLength + j];
+          }
+        }
+      }
+    };
+    runParallel(blockTask);
+  };
+
+  if (extent[1] > 1) {
+    blockedPass(1);
+  }
+  if (extent[2] > 1) {
+    blockedPass(2);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SignedDistanceFieldBuilder::runParallel(std::function<void(int)> taskFunction) {
+  threadPool_.runParallel(std::move(taskFunction), std::max(settings_.nThreads, size_t(1)));
+}
+
+}  // namespace ocs2
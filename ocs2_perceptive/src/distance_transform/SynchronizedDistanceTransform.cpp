@@ -0,0 +1,82 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_perceptive/distance_transform/SynchronizedDistanceTransform.h"
+
+#include <stdexcept>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SynchronizedDistanceTransform::SynchronizedDistanceTransform(field_ptr_t initialField) : activeFieldPtr_(std::move(initialField)) {
+  if (activeFieldPtr_ == nullptr) {
+    throw std::runtime_error("[SynchronizedDistanceTransform] The initial field cannot be a nullptr!");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t SynchronizedDistanceTransform::publish(field_ptr_t field) {
+  if (field == nullptr) {
+    throw std::runtime_error("[SynchronizedDistanceTransform::publish] The field cannot be a nullptr!");
+  }
+
+  // the discarded fields are released after unlocking
+  field_ptr_t retiredFieldPtr;
+  field_ptr_t discardedFieldPtr;
+  size_t version;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    version = ++latestVersion_;
+    discardedFieldPtr = std::move(pendingFieldPtr_);
+    retiredFieldPtr = std::move(retiredFieldPtr_);
+    pendingFieldPtr_ = std::move(field);
+    pendingVersion_ = version;
+  }
+  return version;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SynchronizedDistanceTransform::preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
+                                                 const ReferenceManagerInterface& referenceManager) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (pendingFieldPtr_ != nullptr) {
+    // the replaced field is kept until the next publish() so that it is not released on the MPC thread
+    retiredFieldPtr_ = std::move(activeFieldPtr_);
+    activeFieldPtr_ = std::move(pendingFieldPtr_);
+    activeVersion_ = pendingVersion_;
+  }
+}
+
+}  // namespace ocs2
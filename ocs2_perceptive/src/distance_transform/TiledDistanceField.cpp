@@ -0,0 +1,244 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_perceptive/distance_transform/TiledDistanceField.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace ocs2 {
+
+namespace {
+
+/** Spreads the lower 10 bits of x such that there are two zero bits between each of them. */
+uint32_t spreadBits(uint32_t x) {
+  x &= 0x000003ff;
+  x = (x ^ (x << 16)) & 0xff0000ff;
+  x = (x ^ (x << 8)) & 0x0300f00f;
+  x = (x ^ (x << 4)) & 0x030c30c3;
+  x = (x ^ (x << 2)) & 0x09249249;
+  return x;
+}
+
+/** Morton code of a 3D index with at most 10 bits per coordinate. */
+uint32_t mortonCode(uint32_t x, uint32_t y, uint32_t z) {
+  return spreadBits(x) | (spreadBits(y) << 1) | (spreadBits(z) << 2);
+}
+
+}  // unnamed namespace
+
+constexpr size_t TiledDistanceField::TileWidth;
+constexpr size_t TiledDistanceField::TileSize;
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TiledDistanceField::TiledDistanceField(const std::vector<float>& signedDistance, const std::array<size_t, 3>& size, scalar_t resolution,
+                                       const vector3_t& origin)
+    : size_(size), resolution_(resolution), origin_(origin) {
+  const size_t numVoxels = size_[0] * size_[1] * size_[2];
+  if (numVoxels == 0 || signedDistance.size() != numVoxels) {
+    throw std::runtime_error("[TiledDistanceField] The size of the distance field is incorrect!");
+  }
+  if (resolution_ <= 0.0) {
+    throw std::runtime_error("[TiledDistanceField] The resolution must be positive!");
+  }
+
+  // order the tiles along the Morton curve
+  for (size_t i = 0; i < 3; i++) {
+    numTiles_[i] = (size_[i] + TileWidth - 1) / TileWidth;
+    if (numTiles_[i] > 1024) {
+      throw std::runtime_error("[TiledDistanceField] The grid is too large!");
+    }
+  }
+  std::vector<std::pair<uint32_t, uint32_t>> mortonCodes;  // Morton code and linear index of each tile
+  for (size_t tz = 0; tz < numTiles_[2]; tz++) {
+    for (size_t ty = 0; ty < numTiles_[1]; ty++) {
+      for (size_t tx = 0; tx < numTiles_[0]; tx++) {
+        mortonCodes.emplace_back(mortonCode(tx, ty, tz), tx + numTiles_[0] * (ty + numTiles_[1] * tz));
+      }
+    }
+  }
+  std::sort(mortonCodes.begin(), mortonCodes.end());
+  if (mortonCodes.size() * TileSize > std::numeric_limits<uint32_t>::max()) {
+    throw std::runtime_error("[TiledDistanceField] The grid is too large!");
+  }
+  tileOffsets_.resize(mortonCodes.size());
+  for (size_t i = 0; i < mortonCodes.size(); i++) {
+    tileOffsets_[mortonCodes[i].second] = i * TileSize;
+  }
+
+  // reorder the distances
+  values_.resize(mortonCodes.size() * TileSize, 0.0f);
+  for (size_t z = 0; z < size_[2]; z++) {
+    for (size_t y = 0; y < size_[1]; y++) {
+      for (size_t x = 0; x < size_[0]; x++) {
+        values_[getStorageIndex(x, y, z)] = signedDistance[x + size_[0] * (y + size_[1] * z)];
+      }
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t TiledDistanceField::getValue(const vector3_t& p) const {
+  return interpolateValue(getCell(p));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto TiledDistanceField::getProjectedPoint(const vector3_t& p) const -> vector3_t {
+  const auto valueGradient = interpolateLinearApproximation(getCell(p));
+  const scalar_t gradientNorm = valueGradient.second.norm();
+  if (gradientNorm < std::numeric_limits<scalar_t>::epsilon()) {
+    return p;
+  }
+  return p - valueGradient.first * valueGradient.second / gradientNorm;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::pair<scalar_t, TiledDistanceField::vector3_t> TiledDistanceField::getLinearApproximation(const vector3_t& p) const {
+  return interpolateLinearApproximation(getCell(p));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void TiledDistanceField::getValues(const std::vector<vector3_t>& points, scalar_array_t& values) const {
+  std::vector<Cell> cells;
+  const auto order = getSortedCells(points, cells);
+  values.resize(points.size());
+  for (const auto i : order) {
+    values[i] = interpolateValue(cells[i]);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void TiledDistanceField::getLinearApproximations(const std::vector<vector3_t>& points, scalar_array_t& values,
+                                                 std::vector<vector3_t>& gradients) const {
+  std::vector<Cell> cells;
+  const auto order = getSortedCells(points, cells);
+  values.resize(points.size());
+  gradients.resize(points.size());
+  for (const auto i : order) {
+    std::tie(values[i], gradients[i]) = interpolateLinearApproximation(cells[i]);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+uint32_t TiledDistanceField::getStorageIndex(size_t x, size_t y, size_t z) const {
+  const size_t tileIndex = x / TileWidth + numTiles_[0] * (y / TileWidth + numTiles_[1] * (z / TileWidth));
+  return tileOffsets_[tileIndex] + (x % TileWidth) + TileWidth * ((y % TileWidth) + TileWidth * (z % TileWidth));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto TiledDistanceField::getCell(const vector3_t& p) const -> Cell {
+  std::array<std::array<size_t, 2>, 3> indices;
+  Cell cell;
+  for (size_t i = 0; i < 3; i++) {
+    const scalar_t maxCoordinate = static_cast<scalar_t>(size_[i] - 1);
+    const scalar_t unclampedCoordinate = (p[i] - origin_[i]) / resolution_;
+    const scalar_t coordinate = std::min(std::max(unclampedCoordinate, 0.0), maxCoordinate);
+    const size_t lower = std::min(static_cast<size_t>(coordinate), size_[i] > 1 ? size_[i] - 2 : 0);
+    indices[i][0] = lower;
+    indices[i][1] = std::min(lower + 1, size_[i] - 1);
+    cell.weights[i] = coordinate - static_cast<scalar_t>(lower);
+    cell.weightDerivatives[i] = (unclampedCoordinate < 0.0 || unclampedCoordinate > maxCoordinate) ? 0.0 : 1.0 / resolution_;
+  }
+  for (size_t k = 0; k < 8; k++) {
+    cell.voxels[k] = getStorageIndex(indices[0][k & 1], indices[1][(k >> 1) & 1], indices[2][(k >> 2) & 1]);
+  }
+  return cell;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t TiledDistanceField::interpolateValue(const Cell& cell) const {
+  const auto& w = cell.weights;
+  const auto f = [&](size_t k) -> scalar_t { return values_[cell.voxels[k]]; };
+  const scalar_t f00 = (1.0 - w[0]) * f(0) + w[0] * f(1);
+  const scalar_t f10 = (1.0 - w[0]) * f(2) + w[0] * f(3);
+  const scalar_t f01 = (1.0 - w[0]) * f(4) + w[0] * f(5);
+  const scalar_t f11 = (1.0 - w[0]) * f(6) + w[0] * f(7);
+  return (1.0 - w[2]) * ((1.0 - w[1]) * f00 + w[1] * f10) + w[2] * ((1.0 - w[1]) * f01 + w[1] * f11);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::pair<scalar_t, TiledDistanceField::vector3_t> TiledDistanceField::interpolateLinearApproximation(const Cell& cell) const {
+  const auto& w = cell.weights;
+  const std::array<std::array<scalar_t, 2>, 3> axisWeights{{{1.0 - w[0], w[0]}, {1.0 - w[1], w[1]}, {1.0 - w[2], w[2]}}};
+
+  scalar_t value = 0.0;
+  vector3_t gradient = vector3_t::Zero();
+  for (size_t k = 0; k < 8; k++) {
+    const scalar_t f = values_[cell.voxels[k]];
+    const auto& wx = axisWeights[0][k & 1];
+    const auto& wy = axisWeights[1][(k >> 1) & 1];
+    const auto& wz = axisWeights[2][(k >> 2) & 1];
+    value += wx * wy * wz * f;
+    // the derivative of the weight along an axis is +1 for the upper and -1 for the lower voxel
+    gradient.x() += ((k & 1) ? 1.0 : -1.0) * wy * wz * f;
+    gradient.y() += ((k & 2) ? 1.0 : -1.0) * wx * wz * f;
+    gradient.z() += ((k & 4) ? 1.0 : -1.0) * wx * wy * f;
+  }
+  gradient.array() *= Eigen::Map<const vector3_t>(cell.weightDerivatives.data()).array();
+
+  return {value, gradient};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<size_t> TiledDistanceField::getSortedCells(const std::vector<vector3_t>& points, std::vector<Cell>& cells) const {
+  cells.resize(points.size());
+  std::transform(points.cbegin(), points.cend(), cells.begin(), [this](const vector3_t& p) { return getCell(p); });
+
+  std::vector<size_t> order(points.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](size_t i, size_t j) { return cells[i].voxels[0] < cells[j].voxels[0]; });
+  return order;
+}
+
+}  // namespace ocs2
@@ -103,9 +103,12 @@ vector_t EndEffectorDistanceConstraint::getValue(scalar_t time, const vector_t&
   const auto numEEs = kinematicsPtr_->getIds().size();
   const auto eePositions = kinematicsPtr_->getPosition(state);
 
+  scalar_array_t distances;
+  distanceTransformPtr_->getValues(eePositions, distances);
+
   vector_t g(numEEs);
   for (size_t i = 0; i < numEEs; i++) {
-    g(i) = weight_ * (distanceTransformPtr_->getValue(eePositions[i]) - clearances_[i]);
+    g(i) = weight_ * (distances[i] - clearances_[i]);
   }  // end of i loop
 
   return g;
@@ -123,11 +126,18 @@ VectorFunctionLinearApproximation EndEffectorDistanceConstraint::getLinearApprox
   const auto numEEs = kinematicsPtr_->getIds().size();
   const auto eePosLinApprox = kinematicsPtr_->getPositionLinearApproximation(state);
 
+  std::vector<DistanceTransformInterface::vector3_t> eePositions(numEEs);
+  for (size_t i = 0; i < numEEs; i++) {
+    eePositions[i] = eePosLinApprox[i].f;
+  }
+  scalar_array_t distances;
+  std::vector<DistanceTransformInterface::vector3_t> gradients;
+  distanceTransformPtr_->getLinearApproximations(eePositions, distances, gradients);
+
   VectorFunctionLinearApproximation approx = VectorFunctionLinearApproximation::Zero(numEEs, stateDim_, 0);
   for (size_t i = 0; i < numEEs; i++) {
-    const auto distanceValueGradient = distanceTransformPtr_->getLinearApproximation(eePosLinApprox[i].f);
-    approx.f(i) = weight_ * (distanceValueGradient.first - clearances_[i]);
-    approx.dfdx.row(i).noalias() = weight_ * (distanceValueGradient.second.transpose() * eePosLinApprox[i].dfdx);
+    approx.f(i) = weight_ * (distances[i] - clearances_[i]);
+    approx.dfdx.row(i).noalias() = weight_ * (gradients[i].transpose() * eePosLinApprox[i].dfdx);
   }  // end of i loop
 
   return approx;
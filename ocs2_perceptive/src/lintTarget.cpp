@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_perceptive/distance_transform/ComputeDistanceTransform.h>
 #include <ocs2_perceptive/distance_transform/DistanceTransformInterface.h>
+#include <ocs2_perceptive/distance_transform/SignedDistanceFieldBuilder.h>
+#include <ocs2_perceptive/distance_transform/SynchronizedDistanceTransform.h>
+#include <ocs2_perceptive/distance_transform/TiledDistanceField.h>
 
 #include <ocs2_perceptive/end_effector/EndEffectorDistanceConstraint.h>
 #include <ocs2_perceptive/end_effector/EndEffectorDistanceConstraintCppAd.h>
@@ -36,6 +39,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_perceptive/interpolation/BilinearInterpolation.h>
 #include <ocs2_perceptive/interpolation/TrilinearInterpolation.h>
 
+#include <ocs2_perceptive/terrain/SegmentedTerrainMap.h>
+
 // dummy target for clang toolchain
 int main() {
   return 0;
@@ -0,0 +1,377 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_perceptive/terrain/SegmentedTerrainMap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace ocs2 {
+
+namespace {
+/** Sums of 1, x, y, z, xx, xy, yy, xz, yz and zz over a set of points. */
+using moments_t = Eigen::Matrix<scalar_t, 10, 1>;
+
+moments_t getMoments(scalar_t x, scalar_t y, scalar_t z) {
+  moments_t m;
+  m << 1.0, x, y, z, x * x, x * y, y * y, x * z, y * z, z * z;
+  return m;
+}
+
+/** Least squares fit of z = mean.z + a * (x - mean.x) + b * (y - mean.y). Returns false if the points are (almost) collinear. */
+bool fitPlane(const moments_t& m, Eigen::Matrix<scalar_t, 3, 1>& mean, scalar_t& a, scalar_t& b, scalar_t& residualVariance) {
+  const scalar_t n = m(0);
+  if (n < 3.0) {
+    return false;
+  }
+  mean << m(1) / n, m(2) / n, m(3) / n;
+  const scalar_t cxx = m(4) / n - mean.x() * mean.x();
+  const scalar_t cxy = m(5) / n - mean.x() * mean.y();
+  const scalar_t cyy = m(6) / n - mean.y() * mean.y();
+  const scalar_t cxz = m(7) / n - mean.x() * mean.z();
+  const scalar_t cyz = m(8) / n - mean.y() * mean.z();
+  const scalar_t czz = m(9) / n - mean.z() * mean.z();
+  const scalar_t det = cxx * cyy - cxy * cxy;
+  if (det < 1e-6 * (cxx + cyy) * (cxx + cyy)) {
+    return false;
+  }
+  a = (cyy * cxz - cxy * cyz) / det;
+  b = (cxx * cyz - cxy * cxz) / det;
+  residualVariance = std::max(czz - a * cxz - b * cyz, 0.0);
+  return true;
+}
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SegmentedTerrainMap::SegmentedTerrainMap(const std::vector<float>& heights, const std::array<size_t, 2>& size, scalar_t resolution,
+                                         const vector2_t& origin, Settings settings)
+    : size_(size), resolution_(resolution), origin_(origin), settings_(std::move(settings)) {
+  if (heights.size() != size_[0] * size_[1] || heights.empty()) {
+    throw std::runtime_error("[SegmentedTerrainMap] The number of heights does not match the size of the map!");
+  }
+  if (resolution_ <= 0.0) {
+    throw std::runtime_error("[SegmentedTerrainMap] The resolution should be positive!");
+  }
+
+  std::vector<Plane> localPlanes;
+  std::vector<bool> isSteppable;
+  fitLocalPlanes(heights, localPlanes, isSteppable);
+  segment(heights, localPlanes, isSteppable);
+  computeRegionSizes();
+  computeFootholdIndices();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SegmentedTerrainMap::getFootholdRegion(const vector2_t& position, Region& region) const {
+  const int index = footholdIndices_[getIndex(position)];
+  if (index < 0) {
+    return false;
+  }
+
+  const auto& plane = segmentPlanes_[segmentIds_[index]];
+  region.segmentId = segmentIds_[index];
+  region.normal = plane.normal;
+  region.center.head<2>() = getPosition(index);
+  region.center.z() = plane.point.z() - plane.normal.head<2>().dot(region.center.head<2>() - plane.point.head<2>()) / plane.normal.z();
+  region.halfWidth = (regionSizes_[index] - 0.5) * resolution_;
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t SegmentedTerrainMap::getIndex(const vector2_t& position) const {
+  const vector2_t cell = ((position - origin_) / resolution_).array().round();
+  const auto x = static_cast<size_t>(std::min(std::max(cell.x(), 0.0), static_cast<scalar_t>(size_[0] - 1)));
+  const auto y = static_cast<size_t>(std::min(std::max(cell.y(), 0.0), static_cast<scalar_t>(size_[1] - 1)));
+  return x + size_[0] * y;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SegmentedTerrainMap::vector2_t SegmentedTerrainMap::getPosition(size_t index) const {
+  return origin_ + resolution_ * vector2_t(index % size_[0], index / size_[0]);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SegmentedTerrainMap::fitLocalPlanes(const std::vector<float>& heights, std::vector<Plane>& localPlanes,
+                                         std::vector<bool>& isSteppable) const {
+  const size_t sizeX = size_[0];
+  const size_t sizeY = size_[1];
+
+  // summed-area table of the moments in cell coordinates, with a leading row and column of zeros
+  const size_t stride = sizeX + 1;
+  std::vector<moments_t, Eigen::aligned_allocator<moments_t>> summedMoments((sizeX + 1) * (sizeY + 1), moments_t::Zero());
+  for (size_t y = 0; y < sizeY; y++) {
+    moments_t rowMoments = moments_t::Zero();
+    for (size_t x = 0; x < sizeX; x++) {
+      const float h = heights[x + sizeX * y];
+      if (!std::isnan(h)) {
+        rowMoments += getMoments(x, y, h);
+      }
+      summedMoments[(x + 1) + stride * (y + 1)] = summedMoments[(x + 1) + stride * y] + rowMoments;
+    }
+  }
+
+  const scalar_t minNormalZ = std::cos(settings_.maxSlope);
+  const scalar_t maxResidualVariance = settings_.maxRoughness * settings_.maxRoughness;
+  const size_t r = settings_.planeFitRadius;
+
+  localPlanes.resize(sizeX * sizeY);
+  isSteppable.assign(sizeX * sizeY, false);
+  for (size_t y = 0; y < sizeY; y++) {
+    const size_t y0 = (y > r) ? y - r : 0;
+    const size_t y1 = std::min(y + r + 1, sizeY);
+    for (size_t x = 0; x < sizeX; x++) {
+      const size_t index = x + sizeX * y;
+      if (std::isnan(heights[index])) {
+        continue;
+      }
+      const size_t x0 = (x > r) ? x - r : 0;
+      const size_t x1 = std::min(x + r + 1, sizeX);
+      const moments_t m = summedMoments[x1 + stride * y1] - summedMoments[x0 + stride * y1] - summedMoments[x1 + stride * y0] +
+                          summedMoments[x0 + stride * y0];
+
+      vector3_t mean;
+      scalar_t a, b, residualVariance;
+      if (!fitPlane(m, mean, a, b, residualVariance)) {
+        continue;
+      }
+
+      // the slopes are per cell
+      auto& plane = localPlanes[index];
+      plane.normal = vector3_t(-a / resolution_, -b / resolution_, 1.0).normalized();
+      plane.point << getPosition(index), mean.z() + a * (x - mean.x()) + b * (y - mean.y());
+      isSteppable[index] = plane.normal.z() >= minNormalZ && residualVariance <= maxResidualVariance;
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SegmentedTerrainMap::segment(const std::vector<float>& heights, const std::vector<Plane>& localPlanes,
+                                  const std::vector<bool>& isSteppable) {
+  const size_t sizeX = size_[0];
+  const size_t sizeY = size_[1];
+  const scalar_t minNormalDot = std::cos(settings_.maxNormalDeviation);
+
+  // flood fill over the 4-connected steppable cells
+  std::vector<int> labels(sizeX * sizeY, -1);
+  std::vector<size_t> labelSizes;
+  std::vector<size_t> stack;
+  for (size_t seed = 0; seed < labels.size(); seed++) {
+    if (!isSteppable[seed] || labels[seed] >= 0) {
+      continue;
+    }
+    const int label = labelSizes.size();
+    labelSizes.push_back(0);
+    labels[seed] = label;
+    stack.push_back(seed);
+
+    while (!stack.empty()) {
+      const size_t index = stack.back();
+      stack.pop_back();
+      labelSizes.back()++;
+
+      const auto& plane = localPlanes[index];
+      auto visit = [&](size_t neighbor) {
+        if (!isSteppable[neighbor] || labels[neighbor] >= 0) {
+          return;
+        }
+        const vector3_t point(plane.point.x() + (neighbor % sizeX - index % sizeX) * resolution_,
+                              plane.point.y() + (neighbor / sizeX - index / sizeX) * resolution_, heights[neighbor]);
+        if (plane.normal.dot(localPlanes[neighbor].normal) >= minNormalDot &&
+            std::abs(plane.normal.dot(point - plane.point)) <= settings_.maxStepHeight) {
+          labels[neighbor] = label;
+          stack.push_back(neighbor);
+        }
+      };
+      const size_t x = index % sizeX;
+      const size_t y = index / sizeX;
+      if (x > 0) visit(index - 1);
+      if (x + 1 < sizeX) visit(index + 1);
+      if (y > 0) visit(index - sizeX);
+      if (y + 1 < sizeY) visit(index + sizeX);
+    }
+  }
+
+  // drop the small segments
+  std::vector<int> segmentOfLabel(labelSizes.size(), -1);
+  int numSegments = 0;
+  for (size_t label = 0; label < labelSizes.size(); label++) {
+    if (labelSizes[label] >= settings_.minSegmentSize) {
+      segmentOfLabel[label] = numSegments++;
+    }
+  }
+  segmentIds_.resize(labels.size());
+  std::transform(labels.cbegin(), labels.cend(), segmentIds_.begin(), [&](int label) { return label < 0 ? -1 : segmentOfLabel[label]; });
+
+  // plane of each segment, fitted in world coordinates
+  std::vector<moments_t, Eigen::aligned_allocator<moments_t>> segmentMoments(numSegments, moments_t::Zero());
+  for (size_t index = 0; index < segmentIds_.size(); index++) {
+    if (segmentIds_[index] >= 0) {
+      const vector2_t position = getPosition(index);
+      segmentMoments[segmentIds_[index]] += getMoments(position.x(), position.y(), heights[index]);
+    }
+  }
+
+  segmentPlanes_.resize(numSegments);
+  for (int i = 0; i < numSegments; i++) {
+    const auto& m = segmentMoments[i];
+    vector3_t mean;
+    scalar_t a, b, residualVariance;
+    if (fitPlane(m, mean, a, b, residualVariance)) {
+      segmentPlanes_[i].normal = vector3_t(-a, -b, 1.0).normalized();
+    } else {
+      // collinear cells, the slope across the line is unknown
+      mean = m.segment<3>(1) / m(0);
+      segmentPlanes_[i].normal = vector3_t::UnitZ();
+    }
+    segmentPlanes_[i].point = mean;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SegmentedTerrainMap::computeRegionSizes() {
+  const int sizeX = size_[0];
+  const int sizeY = size_[1];
+  auto id = [&](int x, int y) { return (x < 0 || y < 0 || x >= sizeX || y >= sizeY) ? -1 : segmentIds_[x + sizeX * y]; };
+
+  // the cells next to another segment or the border of the map are at distance 1
+  regionSizes_.assign(segmentIds_.size(), 0);
+  for (int y = 0; y < sizeY; y++) {
+    for (int x = 0; x < sizeX; x++) {
+      const int segmentId = id(x, y);
+      if (segmentId < 0) {
+        continue;
+      }
+      bool isBoundary = false;
+      for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+          isBoundary = isBoundary || id(x + dx, y + dy) != segmentId;
+        }
+      }
+      regionSizes_[x + sizeX * y] = isBoundary ? 1 : std::numeric_limits<int>::max() - 1;
+    }
+  }
+
+  // two-pass chamfer propagation with unit weights, which is exact for the Chebyshev distance
+  auto propagate = [&](int x, int y, const std::array<std::array<int, 2>, 4>& offsets) {
+    const int segmentId = id(x, y);
+    if (segmentId < 0) {
+      return;
+    }
+    int& d = regionSizes_[x + sizeX * y];
+    for (const auto& offset : offsets) {
+      if (id(x + offset[0], y + offset[1]) == segmentId) {
+        d = std::min(d, regionSizes_[(x + offset[0]) + sizeX * (y + offset[1])] + 1);
+      }
+    }
+  };
+  const std::array<std::array<int, 2>, 4> forwardOffsets{{{-1, 0}, {-1, -1}, {0, -1}, {1, -1}}};
+  const std::array<std::array<int, 2>, 4> backwardOffsets{{{1, 0}, {1, 1}, {0, 1}, {-1, 1}}};
+  for (int y = 0; y < sizeY; y++) {
+    for (int x = 0; x < sizeX; x++) {
+      propagate(x, y, forwardOffsets);
+    }
+  }
+  for (int y = sizeY - 1; y >= 0; y--) {
+    for (int x = sizeX - 1; x >= 0; x--) {
+      propagate(x, y, backwardOffsets);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SegmentedTerrainMap::computeFootholdIndices() {
+  const int sizeX = size_[0];
+  const int sizeY = size_[1];
+
+  // the cells whose square is wide enough are their own foothold
+  const scalar_t minRegionSize = settings_.minRegionHalfWidth / resolution_ + 0.5;
+  footholdIndices_.resize(segmentIds_.size());
+  for (size_t index = 0; index < footholdIndices_.size(); index++) {
+    footholdIndices_[index] = (regionSizes_[index] > 0 && regionSizes_[index] >= minRegionSize) ? index : -1;
+  }
+
+  // propagates the closest foothold of the neighbours, in two sweeps over the map
+  auto squaredDistance = [&](int x, int y, int index) {
+    const int dx = x - index % sizeX;
+    const int dy = y - index / sizeX;
+    return dx * dx + dy * dy;
+  };
+  auto propagate = [&](int x, int y, int dx, int dy) {
+    if (x + dx < 0 || y + dy < 0 || x + dx >= sizeX || y + dy >= sizeY) {
+      return;
+    }
+    const int candidate = footholdIndices_[(x + dx) + sizeX * (y + dy)];
+    int& foothold = footholdIndices_[x + sizeX * y];
+    if (candidate >= 0 && (foothold < 0 || squaredDistance(x, y, candidate) < squaredDistance(x, y, foothold))) {
+      foothold = candidate;
+    }
+  };
+  for (int y = 0; y < sizeY; y++) {
+    for (int x = 0; x < sizeX; x++) {
+      propagate(x, y, -1, 0);
+      propagate(x, y, -1, -1);
+      propagate(x, y, 0, -1);
+      propagate(x, y, 1, -1);
+    }
+    for (int x = sizeX - 1; x >= 0; x--) {
+      propagate(x, y, 1, 0);
+    }
+  }
+  for (int y = sizeY - 1; y >= 0; y--) {
+    for (int x = sizeX - 1; x >= 0; x--) {
+      propagate(x, y, 1, 0);
+      propagate(x, y, 1, 1);
+      propagate(x, y, 0, 1);
+      propagate(x, y, -1, 1);
+    }
+    for (int x = 0; x < sizeX; x++) {
+      propagate(x, y, -1, 0);
+    }
+  }
+}
+
+}  // namespace ocs2
@@ -0,0 +1,160 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "ocs2_perceptive/distance_transform/SignedDistanceFieldBuilder.h"
+
+namespace ocs2 {
+
+class TestSignedDistanceFieldBuilder : public ::testing::Test {
+ protected:
+  using Settings = SignedDistanceFieldBuilder::Settings;
+
+  /** Random occupancy with the given fraction of occupied cells. */
+  static std::vector<uint8_t> randomOccupancy(size_t numCells, double occupiedFraction, std::mt19937& generator) {
+    std::bernoulli_distribution distribution(occupiedFraction);
+    std::vector<uint8_t> occupancy(numCells);
+    std::generate(occupancy.begin(), occupancy.end(), [&]() { return distribution(generator) ? 1 : 0; });
+    return occupancy;
+  }
+
+  /** Brute force signed distance field. */
+  static std::vector<float> bruteForce(const SignedDistanceFieldBuilder& builder, const std::vector<uint8_t>& occupancy,
+                                       const Settings& settings) {
+    const auto& size = builder.getSize();
+    std::vector<float> signedDistance(builder.getNumCells());
+    for (size_t z = 0; z < size[2]; z++) {
+      for (size_t y = 0; y < size[1]; y++) {
+        for (size_t x = 0; x < size[0]; x++) {
+          const bool isOccupied = occupancy[builder.getIndex(x, y, z)] != 0;
+          float minSquaredDistance = std::numeric_limits<float>::max();
+          for (size_t k = 0; k < size[2]; k++) {
+            for (size_t j = 0; j < size[1]; j++) {
+              for (size_t i = 0; i < size[0]; i++) {
+                if ((occupancy[builder.getIndex(i, j, k)] != 0) != isOccupied) {
+                  const float dx = static_cast<float>(i) - x;
+                  const float dy = static_cast<float>(j) - y;
+                  const float dz = static_cast<float>(k) - z;
+                  minSquaredDistance = std::min(minSquaredDistance, dx * dx + dy * dy + dz * dz);
+                }
+              }
+            }
+          }
+          const float distance = std::min(std::sqrt(minSquaredDistance) * settings.resolution, settings.maxDistance);
+          signedDistance[builder.getIndex(x, y, z)] = isOccupied ? -distance : distance;
+        }
+      }
+    }
+    return signedDistance;
+  }
+
+  static void compare(const std::vector<float>& signedDistance, const std::vector<float>& reference) {
+    ASSERT_EQ(signedDistance.size(), reference.size());
+    for (size_t i = 0; i < reference.size(); i++) {
+      ASSERT_NEAR(signedDistance[i], reference[i], 1e-4 * std::max(1.0f, std::abs(reference[i]))) << "cell " << i;
+    }
+  }
+
+  std::mt19937 generator{0};
+};
+
+TEST_F(TestSignedDistanceFieldBuilder, grid2d) {
+  Settings settings;
+  settings.resolution = 0.1;
+  settings.maxDistance = 2.0;
+  SignedDistanceFieldBuilder builder({{37, 23, 1}}, settings);
+
+  const auto occupancy = randomOccupancy(builder.getNumCells(), 0.05, generator);
+  std::vector<float> signedDistance;
+  builder.compute(occupancy, signedDistance);
+  compare(signedDistance, bruteForce(builder, occupancy, settings));
+}
+
+TEST_F(TestSignedDistanceFieldBuilder, grid3d) {
+  Settings settings;
+  settings.nThreads = 4;
+  settings.resolution = 0.05;
+  SignedDistanceFieldBuilder builder({{21, 18, 11}}, settings);
+
+  const auto occupancy = randomOccupancy(builder.getNumCells(), 0.02, generator);
+  std::vector<float> signedDistance;
+  builder.compute(occupancy, signedDistance);
+  compare(signedDistance, bruteForce(builder, occupancy, settings));
+}
+
+TEST_F(TestSignedDistanceFieldBuilder, emptyGrid) {
+  Settings settings;
+  settings.maxDistance = 3.0;
+  SignedDistanceFieldBuilder builder({{8, 8, 8}}, settings);
+
+  std::vector<float> signedDistance;
+  builder.compute(std::vector<uint8_t>(builder.getNumCells(), 0), signedDistance);
+  for (const auto& d : signedDistance) {
+    EXPECT_FLOAT_EQ(d, settings.maxDistance);
+  }
+}
+
+TEST_F(TestSignedDistanceFieldBuilder, incrementalUpdate) {
+  Settings settings;
+  settings.nThreads = 3;
+  settings.resolution = 0.1;
+  settings.maxDistance = 0.45;
+  SignedDistanceFieldBuilder builder({{40, 35, 12}}, settings);
+
+  auto occupancy = randomOccupancy(builder.getNumCells(), 0.01, generator);
+  std::vector<float> signedDistance;
+  builder.compute(occupancy, signedDistance);
+
+  // change the occupancy within a region
+  GridRegion dirtyRegion;
+  dirtyRegion.begin = {{10, 5, 3}};
+  dirtyRegion.end = {{18, 14, 7}};
+  std::bernoulli_distribution distribution(0.3);
+  for (size_t z = dirtyRegion.begin[2]; z < dirtyRegion.end[2]; z++) {
+    for (size_t y = dirtyRegion.begin[1]; y < dirtyRegion.end[1]; y++) {
+      for (size_t x = dirtyRegion.begin[0]; x < dirtyRegion.end[0]; x++) {
+        occupancy[builder.getIndex(x, y, z)] = distribution(generator) ? 1 : 0;
+      }
+    }
+  }
+
+  builder.update(occupancy, dirtyRegion, signedDistance);
+  std::vector<float> reference;
+  builder.compute(occupancy, reference);
+  compare(signedDistance, reference);
+  compare(signedDistance, bruteForce(builder, occupancy, settings));
+}
+
+}  // namespace ocs2
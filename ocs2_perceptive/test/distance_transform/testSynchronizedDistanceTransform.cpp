@@ -0,0 +1,147 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <atomic>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+
+#include "ocs2_perceptive/distance_transform/SynchronizedDistanceTransform.h"
+
+namespace ocs2 {
+
+namespace {
+/** A field with a constant value everywhere. */
+class ConstantDistanceTransform final : public DistanceTransformInterface {
+ public:
+  explicit ConstantDistanceTransform(scalar_t value) : value_(value) {}
+  scalar_t getValue(const vector3_t&) const override { return value_; }
+  vector3_t getProjectedPoint(const vector3_t& p) const override { return p; }
+  std::pair<scalar_t, vector3_t> getLinearApproximation(const vector3_t&) const override { return {value_, vector3_t::Zero()}; }
+
+ private:
+  const scalar_t value_;
+};
+}  // unnamed namespace
+
+class TestSynchronizedDistanceTransform : public ::testing::Test {
+ protected:
+  using vector3_t = DistanceTransformInterface::vector3_t;
+
+  void solverRun() { distanceTransform.preSolverRun(0.0, 1.0, vector_t::Zero(1), referenceManager); }
+
+  ReferenceManager referenceManager;
+  SynchronizedDistanceTransform distanceTransform{std::make_shared<ConstantDistanceTransform>(0.0)};
+};
+
+TEST_F(TestSynchronizedDistanceTransform, publishOnPreSolverRun) {
+  const vector3_t p(0.1, 0.2, 0.3);
+  ASSERT_EQ(distanceTransform.getActiveVersion(), 0u);
+  ASSERT_DOUBLE_EQ(distanceTransform.getValue(p), 0.0);
+
+  // not visible until the next solver run
+  ASSERT_EQ(distanceTransform.publish(std::make_shared<ConstantDistanceTransform>(1.0)), 1u);
+  ASSERT_EQ(distanceTransform.getActiveVersion(), 0u);
+  ASSERT_DOUBLE_EQ(distanceTransform.getValue(p), 0.0);
+
+  solverRun();
+  ASSERT_EQ(distanceTransform.getActiveVersion(), 1u);
+  ASSERT_DOUBLE_EQ(distanceTransform.getValue(p), 1.0);
+  ASSERT_DOUBLE_EQ(distanceTransform.getActive().getValue(p), 1.0);
+
+  // nothing published
+  solverRun();
+  ASSERT_EQ(distanceTransform.getActiveVersion(), 1u);
+  ASSERT_DOUBLE_EQ(distanceTransform.getValue(p), 1.0);
+}
+
+TEST_F(TestSynchronizedDistanceTransform, latestWins) {
+  const vector3_t p(0.1, 0.2, 0.3);
+  distanceTransform.publish(std::make_shared<ConstantDistanceTransform>(1.0));
+  distanceTransform.publish(std::make_shared<ConstantDistanceTransform>(2.0));
+  ASSERT_EQ(distanceTransform.publish(std::make_shared<ConstantDistanceTransform>(3.0)), 3u);
+
+  solverRun();
+  ASSERT_EQ(distanceTransform.getActiveVersion(), 3u);
+  ASSERT_DOUBLE_EQ(distanceTransform.getValue(p), 3.0);
+}
+
+TEST_F(TestSynchronizedDistanceTransform, releaseReplacedField) {
+  auto fieldPtr = std::make_shared<ConstantDistanceTransform>(1.0);
+  std::weak_ptr<const DistanceTransformInterface> fieldWeakPtr = fieldPtr;
+  distanceTransform.publish(std::move(fieldPtr));
+  solverRun();
+  distanceTransform.publish(std::make_shared<ConstantDistanceTransform>(2.0));
+  solverRun();
+
+  // the replaced field is released by the next publish
+  ASSERT_FALSE(fieldWeakPtr.expired());
+  distanceTransform.publish(std::make_shared<ConstantDistanceTransform>(3.0));
+  ASSERT_TRUE(fieldWeakPtr.expired());
+}
+
+TEST_F(TestSynchronizedDistanceTransform, concurrentPublish) {
+  constexpr size_t numSolverRuns = 200;
+  const std::vector<vector3_t> points(10, vector3_t(0.1, 0.2, 0.3));
+
+  std::atomic_bool stop{false};
+  std::thread publisher([&]() {
+    size_t i = 0;
+    while (!stop) {
+      distanceTransform.publish(std::make_shared<ConstantDistanceTransform>(static_cast<scalar_t>(++i)));
+    }
+  });
+
+  // EXPECT instead of ASSERT such that the publisher is always joined
+  size_t previousVersion = 0;
+  scalar_array_t values;
+  for (size_t i = 0; i < numSolverRuns && !HasFailure(); i++) {
+    solverRun();
+    const size_t version = distanceTransform.getActiveVersion();
+    EXPECT_GE(version, previousVersion);
+    previousVersion = version;
+
+    // all reads within one solver run see the same field, i.e., the field of the active version
+    const scalar_t value = distanceTransform.getValue(points.front());
+    EXPECT_DOUBLE_EQ(value, static_cast<scalar_t>(version));
+    for (size_t j = 0; j < 100 && !HasFailure(); j++) {
+      distanceTransform.getValues(points, values);
+      for (const auto v : values) {
+        EXPECT_DOUBLE_EQ(v, value);
+      }
+    }
+  }
+
+  stop = true;
+  publisher.join();
+}
+
+}  // namespace ocs2
@@ -0,0 +1,197 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "ocs2_perceptive/distance_transform/SignedDistanceFieldBuilder.h"
+#include "ocs2_perceptive/distance_transform/TiledDistanceField.h"
+#include "ocs2_perceptive/interpolation/TrilinearInterpolation.h"
+
+namespace ocs2 {
+
+class TestTiledDistanceField : public ::testing::Test {
+ protected:
+  using vector3_t = DistanceTransformInterface::vector3_t;
+
+  TestTiledDistanceField() : origin(-0.5, -0.4, -0.3) {
+    // distance to a sphere
+    signedDistance.resize(size[0] * size[1] * size[2]);
+    for (size_t z = 0; z < size[2]; z++) {
+      for (size_t y = 0; y < size[1]; y++) {
+        for (size_t x = 0; x < size[0]; x++) {
+          signedDistance[x + size[0] * (y + size[1] * z)] = sphereDistance(getPosition(x, y, z));
+        }
+      }
+    }
+  }
+
+  vector3_t getPosition(size_t x, size_t y, size_t z) const { return origin + resolution * vector3_t(x, y, z); }
+
+  float sphereDistance(const vector3_t& p) const { return (p - sphereCenter).norm() - sphereRadius; }
+
+  /** Random points within the grid. */
+  std::vector<vector3_t> randomPoints(size_t numPoints) {
+    std::uniform_real_distribution<scalar_t> distribution(0.0, 1.0);
+    std::vector<vector3_t> points(numPoints);
+    for (auto& p : points) {
+      const vector3_t scale(size[0] - 1, size[1] - 1, size[2] - 1);
+      p = origin + resolution * vector3_t(distribution(generator), distribution(generator), distribution(generator)).cwiseProduct(scale);
+    }
+    return points;
+  }
+
+  const std::array<size_t, 3> size{{23, 18, 13}};
+  const scalar_t resolution = 0.05;
+  const vector3_t origin;
+  const vector3_t sphereCenter{0.1, 0.05, 0.0};
+  const scalar_t sphereRadius = 0.2;
+  std::vector<float> signedDistance;
+  std::mt19937 generator{0};
+};
+
+TEST_F(TestTiledDistanceField, voxelValues) {
+  const TiledDistanceField distanceField(signedDistance, size, resolution, origin);
+  for (size_t z = 0; z < size[2]; z++) {
+    for (size_t y = 0; y < size[1]; y++) {
+      for (size_t x = 0; x < size[0]; x++) {
+        ASSERT_NEAR(distanceField.getValue(getPosition(x, y, z)), signedDistance[x + size[0] * (y + size[1] * z)], 1e-6);
+      }
+    }
+  }
+}
+
+TEST_F(TestTiledDistanceField, trilinearInterpolation) {
+  const TiledDistanceField distanceField(signedDistance, size, resolution, origin);
+  for (const auto& p : randomPoints(100)) {
+    const vector3_t index = ((p - origin) / resolution).array().floor();
+    const size_t x = index.x(), y = index.y(), z = index.z();
+    std::array<scalar_t, 8> cornerValues;
+    for (size_t k = 0; k < 8; k++) {
+      cornerValues[k] = signedDistance[(x + (k & 1)) + size[0] * ((y + ((k >> 1) & 1)) + size[1] * (z + ((k >> 2) & 1)))];
+    }
+    const scalar_t expected = trilinear_interpolation::getValue(resolution, getPosition(x, y, z), cornerValues, p);
+    EXPECT_NEAR(distanceField.getValue(p), expected, 1e-6);
+  }
+}
+
+TEST_F(TestTiledDistanceField, gradient) {
+  const TiledDistanceField distanceField(signedDistance, size, resolution, origin);
+  for (const auto& p : randomPoints(100)) {
+    const vector3_t direction = (p - sphereCenter).normalized();
+    const auto valueGradient = distanceField.getLinearApproximation(p);
+    EXPECT_NEAR(valueGradient.first, sphereDistance(p), 0.1 * resolution);
+    // the interpolated distance is piecewise linear, thus its gradient deviates more where the direction changes faster
+    const scalar_t tolerance = std::max(0.1, resolution / (p - sphereCenter).norm());
+    EXPECT_LT((valueGradient.second - direction).norm(), tolerance);
+  }
+}
+
+TEST_F(TestTiledDistanceField, gradientOfInterpolation) {
+  const TiledDistanceField distanceField(signedDistance, size, resolution, origin);
+  const auto finiteDifference = [&](const vector3_t& p) {
+    constexpr scalar_t eps = 1e-7;
+    vector3_t gradient;
+    for (size_t i = 0; i < 3; i++) {
+      const vector3_t dp = eps * vector3_t::Unit(i);
+      gradient(i) = (distanceField.getValue(p + dp) - distanceField.getValue(p - dp)) / (2.0 * eps);
+    }
+    return gradient;
+  };
+
+  auto points = randomPoints(100);
+  // outside of the grid along x, and along y and z
+  points.emplace_back(origin.x() - 1.0, 0.012, 0.013);
+  points.emplace_back(0.012, origin.y() + 10.0, origin.z() - 10.0);
+
+  for (const auto& p : points) {
+    const auto valueGradient = distanceField.getLinearApproximation(p);
+    EXPECT_DOUBLE_EQ(valueGradient.first, distanceField.getValue(p));
+    EXPECT_TRUE(valueGradient.second.isApprox(finiteDifference(p), 1e-5)) << "p: " << p.transpose();
+  }
+  EXPECT_EQ(distanceField.getLinearApproximation(points[100]).second.x(), 0.0);
+  EXPECT_NE(distanceField.getLinearApproximation(points[100]).second.y(), 0.0);
+  EXPECT_EQ(distanceField.getLinearApproximation(points[101]).second.y(), 0.0);
+  EXPECT_EQ(distanceField.getLinearApproximation(points[101]).second.z(), 0.0);
+}
+
+TEST_F(TestTiledDistanceField, projectedPoint) {
+  const TiledDistanceField distanceField(signedDistance, size, resolution, origin);
+  for (const auto& p : randomPoints(100)) {
+    EXPECT_NEAR(sphereDistance(distanceField.getProjectedPoint(p)), 0.0, 0.05);
+  }
+}
+
+TEST_F(TestTiledDistanceField, batchedQueries) {
+  const TiledDistanceField distanceField(signedDistance, size, resolution, origin);
+  auto points = randomPoints(200);
+  points.emplace_back(10.0, -10.0, 0.0);  // outside of the grid
+
+  scalar_array_t values;
+  distanceField.getValues(points, values);
+  scalar_array_t linearValues;
+  std::vector<vector3_t> gradients;
+  distanceField.getLinearApproximations(points, linearValues, gradients);
+
+  ASSERT_EQ(values.size(), points.size());
+  ASSERT_EQ(gradients.size(), points.size());
+  for (size_t i = 0; i < points.size(); i++) {
+    const auto valueGradient = distanceField.getLinearApproximation(points[i]);
+    EXPECT_DOUBLE_EQ(values[i], distanceField.getValue(points[i]));
+    EXPECT_DOUBLE_EQ(linearValues[i], valueGradient.first);
+    EXPECT_TRUE(gradients[i].isApprox(valueGradient.second));
+  }
+}
+
+TEST_F(TestTiledDistanceField, signedDistanceFieldBuilder) {
+  // 2D occupancy grid with an occupied square
+  const std::array<size_t, 3> gridSize{{30, 20, 1}};
+  SignedDistanceFieldBuilder::Settings settings;
+  settings.resolution = 0.1;
+  SignedDistanceFieldBuilder builder(gridSize, settings);
+  std::vector<uint8_t> occupancy(builder.getNumCells(), 0);
+  for (size_t y = 8; y < 12; y++) {
+    for (size_t x = 10; x < 14; x++) {
+      occupancy[builder.getIndex(x, y, 0)] = 1;
+    }
+  }
+  std::vector<float> field;
+  builder.compute(occupancy, field);
+
+  const TiledDistanceField distanceField(field, gridSize, settings.resolution, vector3_t::Zero());
+  EXPECT_NEAR(distanceField.getValue(vector3_t(0.5, 1.0, 0.0)), 0.5, 1e-6);
+  EXPECT_NEAR(distanceField.getValue(vector3_t(1.1, 0.2, 0.0)), 0.6, 1e-6);
+  EXPECT_LT(distanceField.getValue(vector3_t(1.15, 0.95, 0.0)), 0.0);
+  EXPECT_LT(distanceField.getLinearApproximation(vector3_t(0.6, 1.0, 0.0)).second.x(), 0.0);
+}
+
+}  // namespace ocs2
@@ -0,0 +1,197 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "ocs2_perceptive/terrain/SegmentedTerrainMap.h"
+
+namespace ocs2 {
+
+class TestSegmentedTerrainMap : public ::testing::Test {
+ protected:
+  using vector2_t = SegmentedTerrainMap::vector2_t;
+  using vector3_t = SegmentedTerrainMap::vector3_t;
+
+  /** Fills the map with heightFunction(x, y) evaluated at the cell centers. */
+  template <typename Function>
+  std::vector<float> getHeights(Function heightFunction) const {
+    std::vector<float> heights(size[0] * size[1]);
+    for (size_t y = 0; y < size[1]; y++) {
+      for (size_t x = 0; x < size[0]; x++) {
+        const vector2_t p = origin + resolution * vector2_t(x, y);
+        heights[x + size[0] * y] = heightFunction(p.x(), p.y());
+      }
+    }
+    return heights;
+  }
+
+  /** Checks that the square of the region only contains cells of its segment. */
+  void checkRegionIsInSegment(const SegmentedTerrainMap& map, const SegmentedTerrainMap::Region& region) const {
+    const int n = std::round(region.halfWidth / resolution - 0.5);
+    for (int dy = -n; dy <= n; dy++) {
+      for (int dx = -n; dx <= n; dx++) {
+        const vector2_t p = region.center.head<2>() + resolution * vector2_t(dx, dy);
+        ASSERT_GE(p.x(), origin.x() - 1e-9);
+        ASSERT_GE(p.y(), origin.y() - 1e-9);
+        ASSERT_LE(p.x(), origin.x() + resolution * (size[0] - 1) + 1e-9);
+        ASSERT_LE(p.y(), origin.y() + resolution * (size[1] - 1) + 1e-9);
+        ASSERT_EQ(map.getSegmentId(p), region.segmentId);
+      }
+    }
+  }
+
+  const std::array<size_t, 2> size{{40, 20}};
+  const scalar_t resolution = 0.05;
+  const vector2_t origin{-0.5, -0.3};
+  const scalar_t nan = std::numeric_limits<float>::quiet_NaN();
+  SegmentedTerrainMap::Settings settings;
+};
+
+TEST_F(TestSegmentedTerrainMap, flat) {
+  const SegmentedTerrainMap map(getHeights([](scalar_t, scalar_t) { return 0.1; }), size, resolution, origin, settings);
+  ASSERT_EQ(map.getNumSegments(), 1u);
+
+  SegmentedTerrainMap::Region region;
+  const vector2_t center = origin + resolution * vector2_t(20, 10);
+  ASSERT_TRUE(map.getFootholdRegion(center, region));
+  EXPECT_TRUE(region.center.head<2>().isApprox(center));
+  EXPECT_NEAR(region.center.z(), 0.1, 1e-6);
+  EXPECT_TRUE(region.normal.isApprox(vector3_t::UnitZ()));
+  // 9 cells to the closest border in y
+  EXPECT_NEAR(region.halfWidth, 9.5 * resolution, 1e-9);
+  checkRegionIsInSegment(map, region);
+}
+
+TEST_F(TestSegmentedTerrainMap, slope) {
+  const scalar_t slope = 0.3;
+  const SegmentedTerrainMap map(getHeights([&](scalar_t x, scalar_t) { return slope * x; }), size, resolution, origin, settings);
+  ASSERT_EQ(map.getNumSegments(), 1u);
+
+  SegmentedTerrainMap::Region region;
+  ASSERT_TRUE(map.getFootholdRegion(vector2_t(0.4, 0.2), region));
+  EXPECT_TRUE(region.normal.isApprox(vector3_t(-slope, 0.0, 1.0).normalized(), 1e-6));
+  EXPECT_NEAR(region.center.z(), slope * region.center.x(), 1e-6);
+  EXPECT_NEAR(region.getHeight(vector2_t(0.1, 0.0)), slope * 0.1, 1e-6);
+}
+
+TEST_F(TestSegmentedTerrainMap, tooSteep) {
+  const SegmentedTerrainMap map(getHeights([](scalar_t x, scalar_t) { return 2.0 * x; }), size, resolution, origin, settings);
+  ASSERT_EQ(map.getNumSegments(), 0u);
+  ASSERT_EQ(map.getSegmentId(vector2_t::Zero()), -1);
+
+  SegmentedTerrainMap::Region region;
+  ASSERT_FALSE(map.getFootholdRegion(vector2_t::Zero(), region));
+}
+
+TEST_F(TestSegmentedTerrainMap, gap) {
+  // two plateaus separated by the unknown cells 18 to 21
+  const scalar_t gapBegin = origin.x() + 17.5 * resolution;
+  const scalar_t gapEnd = origin.x() + 21.5 * resolution;
+  const auto heights = getHeights([&](scalar_t x, scalar_t) { return x < gapBegin ? 0.0 : (x < gapEnd ? nan : 0.2); });
+
+  settings.minRegionHalfWidth = 0.1;  // 2.5 cells
+  const SegmentedTerrainMap map(heights, size, resolution, origin, settings);
+  ASSERT_EQ(map.getNumSegments(), 2u);
+
+  // the closest region large enough is on the second plateau: cell 24 is 3 cells away from the gap
+  const vector2_t query = origin + resolution * vector2_t(20, 10);
+  ASSERT_EQ(map.getSegmentId(query), -1);
+  SegmentedTerrainMap::Region region;
+  ASSERT_TRUE(map.getFootholdRegion(query, region));
+  EXPECT_NEAR(region.center.x(), origin.x() + 24 * resolution, 1e-9);
+  EXPECT_NEAR(region.center.y(), query.y(), 1e-9);
+  EXPECT_NEAR(region.center.z(), 0.2, 1e-6);
+  EXPECT_NEAR(region.halfWidth, 2.5 * resolution, 1e-9);
+  checkRegionIsInSegment(map, region);
+}
+
+TEST_F(TestSegmentedTerrainMap, step) {
+  const scalar_t stepPosition = origin.x() + 19.5 * resolution;
+  const auto heights = getHeights([&](scalar_t x, scalar_t) { return x < stepPosition ? 0.0 : 0.2; });
+  const SegmentedTerrainMap map(heights, size, resolution, origin, settings);
+  ASSERT_EQ(map.getNumSegments(), 2u);
+
+  // the cells next to the step are not steppable
+  const scalar_t y = origin.y() + 10 * resolution;
+  EXPECT_EQ(map.getSegmentId(vector2_t(stepPosition - 0.5 * resolution, y)), -1);
+  EXPECT_EQ(map.getSegmentId(vector2_t(stepPosition + 0.5 * resolution, y)), -1);
+  const int lowSegment = map.getSegmentId(vector2_t(origin.x(), y));
+  const int highSegment = map.getSegmentId(vector2_t(stepPosition + 0.5, y));
+  ASSERT_GE(lowSegment, 0);
+  ASSERT_GE(highSegment, 0);
+  ASSERT_NE(lowSegment, highSegment);
+}
+
+TEST_F(TestSegmentedTerrainMap, regionsOnBlocks) {
+  // blocks of 6 x 6 cells with random heights
+  std::mt19937 generator(0);
+  std::uniform_int_distribution<int> distribution(0, 3);
+  std::vector<scalar_t> blockHeights(7 * 4);
+  for (auto& h : blockHeights) {
+    h = 0.1 * distribution(generator);
+  }
+  std::vector<float> heights(size[0] * size[1]);
+  for (size_t y = 0; y < size[1]; y++) {
+    for (size_t x = 0; x < size[0]; x++) {
+      heights[x + size[0] * y] = blockHeights[x / 6 + 7 * (y / 6)];
+    }
+  }
+
+  settings.minRegionHalfWidth = 0.0;
+  const SegmentedTerrainMap map(heights, size, resolution, origin, settings);
+  ASSERT_GT(map.getNumSegments(), 0u);
+
+  std::uniform_real_distribution<scalar_t> xDistribution(origin.x(), origin.x() + resolution * size[0]);
+  std::uniform_real_distribution<scalar_t> yDistribution(origin.y(), origin.y() + resolution * size[1]);
+  for (size_t i = 0; i < 100; i++) {
+    SegmentedTerrainMap::Region region;
+    ASSERT_TRUE(map.getFootholdRegion(vector2_t(xDistribution(generator), yDistribution(generator)), region));
+    ASSERT_GE(region.segmentId, 0);
+    checkRegionIsInSegment(map, region);
+
+    // the region is the largest square in the segment: the next larger square leaves the segment or the map
+    const int n = std::round(region.halfWidth / resolution + 0.5);
+    bool leavesSegment = false;
+    for (int dy = -n; dy <= n; dy++) {
+      for (int dx = -n; dx <= n; dx++) {
+        const vector2_t p = region.center.head<2>() + resolution * vector2_t(dx, dy);
+        const vector2_t cell = (p - origin) / resolution;
+        const bool isInMap = cell.x() > -0.5 && cell.y() > -0.5 && cell.x() < size[0] - 0.5 && cell.y() < size[1] - 0.5;
+        leavesSegment = leavesSegment || !isInMap || map.getSegmentId(p) != region.segmentId;
+      }
+    }
+    ASSERT_TRUE(leavesSegment);
+  }
+}
+
+}  // namespace ocs2
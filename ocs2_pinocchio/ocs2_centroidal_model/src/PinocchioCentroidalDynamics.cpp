@@ -125,8 +125,8 @@ void PinocchioCentroidalDynamics::computeNormalizedCentroidalMomentumRateGradien
     normalizedAngularMomentumRateDerivativeQ_.noalias() -= f_hat * J;
     normalizedLinearMomentumRateDerivativeInput_.block<3, 3>(0, inputIdx).diagonal().array() = 1.0 / info.robotMass;
     p_hat = skewSymmetricMatrix(getPositionComToContactPointInWorldFrame(interface, info, i)) / info.robotMass;
-    normalizedAngularMomentumRateDerivativeInput_.block<3, 3>(0, 3 * inputIdx) = p_hat;
-    normalizedAngularMomentumRateDerivativeInput_.block<3, 3>(0, 3 * inputIdx + 3).diagonal().array() = 1.0 / info.robotMass;
+    normalizedAngularMomentumRateDerivativeInput_.block<3, 3>(0, inputIdx) = p_hat;
+    normalizedAngularMomentumRateDerivativeInput_.block<3, 3>(0, inputIdx + 3).diagonal().array() = 1.0 / info.robotMass;
   }
 }
 
@@ -51,15 +51,16 @@ class TestAnymalCentroidalModel : public ::testing::TestWithParam<CentroidalMode
     pinocchioInterfacePtr.reset(new PinocchioInterface(createPinocchioInterface(anymalUrdfFile)));
   }
 
-  CentroidalModelInfo createInfo(CentroidalModelType type) const {
+  CentroidalModelInfo createInfo(CentroidalModelType type, const std::vector<std::string>& threeDofContactNames = anymal3DofContactNames,
+                                 const std::vector<std::string>& sixDofContactNames = anymal6DofContactNames) const {
     const size_t nq = pinocchioInterfacePtr->getModel().nq;
     const size_t numJoints = nq - 6;
-    return createCentroidalModelInfo(*pinocchioInterfacePtr, type, getInitialState().tail(numJoints), anymal3DofContactNames,
-                                     anymal6DofContactNames);
+    return createCentroidalModelInfo(*pinocchioInterfacePtr, type, getInitialState().tail(numJoints), threeDofContactNames,
+                                     sixDofContactNames);
   }
 
-  std::unique_ptr<CentroidalModelPinocchioMapping> createMapping(CentroidalModelType type) const {
-    std::unique_ptr<CentroidalModelPinocchioMapping> mappingPtr(new CentroidalModelPinocchioMapping(createInfo(type)));
+  std::unique_ptr<CentroidalModelPinocchioMapping> createMapping(const CentroidalModelInfo& info) const {
+    std::unique_ptr<CentroidalModelPinocchioMapping> mappingPtr(new CentroidalModelPinocchioMapping(info));
     mappingPtr->setPinocchioInterface(*pinocchioInterfacePtr);
     return mappingPtr;
   }
@@ -87,7 +88,7 @@ TEST_P(TestAnymalCentroidalModel, info) {
 /******************************************************************************************************/
 TEST_P(TestAnymalCentroidalModel, dynamis_flowMap) {
   const CentroidalModelType type = GetParam();
-  auto mappingPtr = createMapping(type);
+  auto mappingPtr = createMapping(createInfo(type));
   const auto& info = mappingPtr->getCentroidalModelInfo();
 
   // Analytical model
@@ -123,6 +124,43 @@ TEST_P(TestAnymalCentroidalModel, dynamis_flowMap) {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_P(TestAnymalCentroidalModel, dynamics_sixDofContacts) {
+  const CentroidalModelType type = GetParam();
+  // The hind feet take contact wrenches, such that the input holds two forces, two wrenches and the joint velocities
+  const auto info = createInfo(type, {"LF_FOOT", "RF_FOOT"}, {"LH_FOOT", "RH_FOOT"});
+  auto mappingPtr = createMapping(info);
+  ASSERT_EQ(info.inputDim, 2 * 3 + 2 * 6 + 12);
+
+  // Analytical model
+  PinocchioCentroidalDynamics anymalDynamics(info);
+  anymalDynamics.setPinocchioInterface(*pinocchioInterfacePtr);
+
+  // CppAD model
+  const std::string modelName = "TestAnymal" + toString(type) + "SixDofAd";
+  PinocchioCentroidalDynamicsAD anymalDynamicsAd(*pinocchioInterfacePtr, info, modelName);
+
+  for (size_t i = 0; i < numTests; i++) {
+    const scalar_t time = 0.0;
+    const vector_t state = 10.0 * vector_t::Random(info.stateDim);
+    const vector_t input = 10000.0 * vector_t::Random(info.inputDim);
+
+    const vector_t qPinocchio = mappingPtr->getPinocchioJointPosition(state);
+    updateCentroidalDynamics(*pinocchioInterfacePtr, info, qPinocchio);
+    const vector_t vPinocchio = mappingPtr->getPinocchioJointVelocity(state, input);
+    updateCentroidalDynamicsDerivatives(*pinocchioInterfacePtr, info, qPinocchio, vPinocchio);
+
+    const auto linearApproximation = anymalDynamics.getLinearApproximation(time, state, input);
+    const auto linearApproximationAd = anymalDynamicsAd.getLinearApproximation(time, state, input);
+
+    EXPECT_TRUE(linearApproximationAd.f.isApprox(linearApproximation.f, tol));
+    EXPECT_TRUE(linearApproximationAd.dfdx.isApprox(linearApproximation.dfdx, tol));
+    EXPECT_TRUE(linearApproximationAd.dfdu.isApprox(linearApproximation.dfdu, tol));
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
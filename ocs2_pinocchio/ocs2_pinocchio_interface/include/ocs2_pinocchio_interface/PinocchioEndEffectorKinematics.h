@@ -50,12 +50,40 @@ namespace ocs2 {
  *   pinocchio::updateFramePlacements(pinocchioInterface.getModel(), pinocchioInterface.getData());
  *   kinematics.setPinocchioInterface(pinocchioInterface);
  *   const auto pos = kinematics.getPosition(x);
+ *
+ * When several terms query the same end-effectors, the kinematics of all of them can be evaluated once with computeKinematics(),
+ * e.g., in a PreComputation, and shared with the terms through setPinocchioInterface(pinocchioInterface, kinematics). The getters then
+ * read the shared buffers instead of evaluating the frame Jacobians again.
  */
 class PinocchioEndEffectorKinematics final : public EndEffectorKinematics<scalar_t> {
  public:
   using EndEffectorKinematics<scalar_t>::vector3_t;
   using EndEffectorKinematics<scalar_t>::matrix3x_t;
   using EndEffectorKinematics<scalar_t>::quaternion_t;
+  using matrix3_t = Eigen::Matrix<scalar_t, 3, 3>;
+
+  /**
+   * Kinematics of a set of end-effectors evaluated in one pass by computeKinematics(). The buffers are resized on the first call
+   * and reused afterwards. The derivatives are with respect to the OCS2 state and input.
+   */
+  struct Kinematics {
+    std::vector<size_t> frameIds;
+    std::vector<vector3_t> positions;
+    std::vector<matrix3_t> rotations;
+    std::vector<vector3_t> velocities;               // linear velocities, only if hasVelocities
+    std::vector<matrix_t> positionDerivatives;       // 3 x stateDim, only if hasDerivatives
+    std::vector<matrix_t> angularDerivatives;        // 3 x stateDim, rotational part of the frame Jacobian, only if hasDerivatives
+    std::vector<matrix_t> velocityStateDerivatives;  // 3 x stateDim, only if hasVelocities and hasDerivatives
+    std::vector<matrix_t> velocityInputDerivatives;  // 3 x inputDim, only if hasVelocities and hasDerivatives
+    bool hasVelocities = false;
+    bool hasDerivatives = false;
+
+    // workspace of computeKinematics()
+    matrix_t frameJacobian;
+    matrix_t frameVelocityDerivative;
+    matrix_t stackedJq;
+    matrix_t stackedJv;
+  };
 
   /** Constructor
    * @param [in] pinocchioInterface: pinocchio interface.
@@ -76,8 +104,36 @@ class PinocchioEndEffectorKinematics final : public EndEffectorKinematics<scalar
   void setPinocchioInterface(const PinocchioInterface& pinocchioInterface) {
     pinocchioInterfacePtr_ = &pinocchioInterface;
     mappingPtr_->setPinocchioInterface(pinocchioInterface);
+    kinematicsPtr_ = nullptr;
   }
 
+  /** Set the pinocchio interface and the kinematics computed on it.
+   * The getters read the positions, velocities, orientations and their derivatives from the kinematics if it contains all end-effectors
+   * of this class and the requested quantities. Otherwise, they fall back to evaluating the pinocchio interface.
+   * @param [in] pinocchioInterface: pinocchio interface on which computations are expected. It will keep a pointer for the getters.
+   * @param [in] kinematics: kinematics computed by computeKinematics() on pinocchioInterface. It will keep a pointer for the getters.
+   */
+  void setPinocchioInterface(const PinocchioInterface& pinocchioInterface, const Kinematics& kinematics);
+
+  /** Computes the positions, orientations, velocities and their derivatives of all end-effectors in one pass.
+   * The derivatives of all end-effectors are mapped to the OCS2 coordinates with a single call to the state-input mapping.
+   * @note requires pinocchioInterface to be updated with:
+   *       pinocchio::forwardKinematics(model, data, q)
+   *       pinocchio::updateFramePlacements(model, data)
+   *       and, if the derivatives are requested, with:
+   *       pinocchio::computeJointJacobians(model, data)
+   *       If the velocities are requested, forwardKinematics and computeJointJacobians are replaced by:
+   *       pinocchio::forwardKinematics(model, data, q, v), or
+   *       pinocchio::computeForwardKinematicsDerivatives(model, data, q, v, a)
+   * @param [in] pinocchioInterface: pinocchio interface. The frame Jacobians are evaluated in place on its data.
+   * @param [in] state: system state vector
+   * @param [in] inputPtr: system input vector, or nullptr to skip the velocities.
+   * @param [in] computeDerivatives: whether to compute the derivatives.
+   * @param [out] kinematics: the kinematics of all end-effectors.
+   */
+  void computeKinematics(PinocchioInterface& pinocchioInterface, const vector_t& state, const vector_t* inputPtr, bool computeDerivatives,
+                         Kinematics& kinematics);
+
   /** Get end-effector IDs (names) */
   const std::vector<std::string>& getIds() const override;
 
@@ -128,7 +184,14 @@ class PinocchioEndEffectorKinematics final : public EndEffectorKinematics<scalar
  private:
   PinocchioEndEffectorKinematics(const PinocchioEndEffectorKinematics& rhs);
 
+  /** Whether the getters can read the requested quantities from the kinematics set by setPinocchioInterface(). */
+  bool hasKinematics(bool velocities, bool derivatives) const {
+    return kinematicsPtr_ != nullptr && (!velocities || kinematicsPtr_->hasVelocities) && (!derivatives || kinematicsPtr_->hasDerivatives);
+  }
+
   const PinocchioInterface* pinocchioInterfacePtr_;
+  const Kinematics* kinematicsPtr_ = nullptr;
+  std::vector<size_t> kinematicsIndices_;  // index of each end-effector in *kinematicsPtr_
   std::unique_ptr<PinocchioStateInputMapping<scalar_t>> mappingPtr_;
   const std::vector<std::string> endEffectorIds_;
   std::vector<size_t> endEffectorFrameIds_;
@@ -0,0 +1,80 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/dynamics/SystemDynamicsBase.h>
+
+#include <ocs2_pinocchio_interface/PinocchioInterface.h>
+
+namespace ocs2 {
+
+/**
+ * Full-order rigid body dynamics using the articulated body algorithm (ABA) of pinocchio.
+ *
+ * State: x = [ q, v ]', the generalized positions and velocities of the pinocchio model.
+ * Input: u = tau, the generalized forces.
+ *
+ * The flow map is dx/dt = [ v, aba(q, v, tau) ]'. The linear approximation uses the analytical ABA derivatives of pinocchio
+ * (computeABADerivatives), such that no code is generated. Each instance owns a copy of the PinocchioInterface. Since the model is
+ * shared between the copies and the solvers clone the dynamics for each worker thread, every thread works on its own pinocchio data.
+ *
+ * @note This class requires nq == nv, i.e., the model cannot contain joints whose configuration space differs from their tangent
+ * space, like free-flyer, spherical, or continuous joints.
+ */
+class PinocchioRigidBodyDynamics final : public SystemDynamicsBase {
+ public:
+  /**
+   * Constructor
+   * @param [in] pinocchioInterface : The pinocchio interface. A copy is kept.
+   * @throw std::runtime_error if the model has nq != nv.
+   */
+  explicit PinocchioRigidBodyDynamics(const PinocchioInterface& pinocchioInterface);
+
+  ~PinocchioRigidBodyDynamics() override = default;
+  PinocchioRigidBodyDynamics* clone() const override { return new PinocchioRigidBodyDynamics(*this); }
+
+  vector_t computeFlowMap(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp) override;
+  VectorFunctionLinearApproximation linearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                        const PreComputation& preComp) override;
+
+  /** Get the state dimension: nq + nv */
+  size_t getStateDim() const { return 2 * numGeneralizedCoordinates_; }
+
+  /** Get the input dimension: nv */
+  size_t getInputDim() const { return numGeneralizedCoordinates_; }
+
+ private:
+  PinocchioRigidBodyDynamics(const PinocchioRigidBodyDynamics& rhs) = default;
+
+  PinocchioInterface pinocchioInterface_;
+  size_t numGeneralizedCoordinates_;
+};
+
+}  // namespace ocs2
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <pinocchio/fwd.hpp>
 
+#include <algorithm>
+
 #include <pinocchio/algorithm/frames-derivatives.hpp>
 #include <pinocchio/algorithm/frames.hpp>
 #include <pinocchio/algorithm/kinematics.hpp>
@@ -63,6 +65,105 @@ PinocchioEndEffectorKinematics::PinocchioEndEffectorKinematics(const PinocchioEn
       endEffectorIds_(rhs.endEffectorIds_),
       endEffectorFrameIds_(rhs.endEffectorFrameIds_) {}
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioEndEffectorKinematics::setPinocchioInterface(const PinocchioInterface& pinocchioInterface, const Kinematics& kinematics) {
+  setPinocchioInterface(pinocchioInterface);
+
+  kinematicsIndices_.clear();
+  for (const auto& frameId : endEffectorFrameIds_) {
+    const auto it = std::find(kinematics.frameIds.cbegin(), kinematics.frameIds.cend(), frameId);
+    if (it == kinematics.frameIds.cend()) {
+      return;  // the getters evaluate the pinocchio interface
+    }
+    kinematicsIndices_.push_back(std::distance(kinematics.frameIds.cbegin(), it));
+  }
+  kinematicsPtr_ = &kinematics;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioEndEffectorKinematics::computeKinematics(PinocchioInterface& pinocchioInterface, const vector_t& state,
+                                                       const vector_t* inputPtr, bool computeDerivatives, Kinematics& kinematics) {
+  setPinocchioInterface(pinocchioInterface);
+
+  const pinocchio::ReferenceFrame rf = pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED;
+  const pinocchio::Model& model = pinocchioInterface.getModel();
+  pinocchio::Data& data = pinocchioInterface.getData();
+
+  const size_t numEndEffectors = endEffectorFrameIds_.size();
+  const bool computeVelocities = inputPtr != nullptr;
+  // rows of each end-effector in the stacked Jacobians: position, orientation and, if requested, velocity
+  const size_t numRows = computeVelocities ? 9 : 6;
+
+  kinematics.frameIds = endEffectorFrameIds_;
+  kinematics.hasVelocities = computeVelocities;
+  kinematics.hasDerivatives = computeDerivatives;
+  kinematics.positions.resize(numEndEffectors);
+  kinematics.rotations.resize(numEndEffectors);
+  if (computeVelocities) {
+    kinematics.velocities.resize(numEndEffectors);
+  }
+  if (computeDerivatives) {
+    kinematics.stackedJq.setZero(numRows * numEndEffectors, model.nv);
+    kinematics.stackedJv.setZero(numRows * numEndEffectors, model.nv);
+    kinematics.frameJacobian.resize(6, model.nv);
+    kinematics.frameVelocityDerivative.resize(6, model.nv);
+  }
+
+  for (size_t i = 0; i < numEndEffectors; i++) {
+    const size_t frameId = endEffectorFrameIds_[i];
+    kinematics.positions[i] = data.oMf[frameId].translation();
+    kinematics.rotations[i] = data.oMf[frameId].rotation();
+
+    vector3_t angularVelocity;
+    if (computeVelocities) {
+      const auto frameVel = pinocchio::getFrameVelocity(model, data, frameId, rf);
+      kinematics.velocities[i] = frameVel.linear();
+      angularVelocity = frameVel.angular();
+    }
+
+    if (computeDerivatives) {
+      auto& J = kinematics.frameJacobian;
+      J.setZero();
+      if (computeVelocities) {
+        // the partial derivative of the frame velocity w.r.t. v is the frame Jacobian
+        auto& v_partial_dq = kinematics.frameVelocityDerivative;
+        v_partial_dq.setZero();
+        pinocchio::getFrameVelocityDerivatives(model, data, frameId, rf, v_partial_dq, J);
+        // For reference frame LOCAL_WORLD_ALIGNED the jacobian needs to be corrected.
+        v_partial_dq.topRows<3>() += skewSymmetricMatrix(angularVelocity) * J.topRows<3>();
+        kinematics.stackedJq.middleRows<3>(numRows * i + 6) = v_partial_dq.topRows<3>();
+        kinematics.stackedJv.middleRows<3>(numRows * i + 6) = J.topRows<3>();
+      } else {
+        pinocchio::getFrameJacobian(model, data, frameId, rf, J);
+      }
+      kinematics.stackedJq.middleRows<6>(numRows * i) = J;
+    }
+  }
+
+  if (computeDerivatives) {
+    matrix_t dfdx, dfdu;
+    std::tie(dfdx, dfdu) = mappingPtr_->getOcs2Jacobian(state, kinematics.stackedJq, kinematics.stackedJv);
+    kinematics.positionDerivatives.resize(numEndEffectors);
+    kinematics.angularDerivatives.resize(numEndEffectors);
+    for (size_t i = 0; i < numEndEffectors; i++) {
+      kinematics.positionDerivatives[i] = dfdx.middleRows<3>(numRows * i);
+      kinematics.angularDerivatives[i] = dfdx.middleRows<3>(numRows * i + 3);
+    }
+    if (computeVelocities) {
+      kinematics.velocityStateDerivatives.resize(numEndEffectors);
+      kinematics.velocityInputDerivatives.resize(numEndEffectors);
+      for (size_t i = 0; i < numEndEffectors; i++) {
+        kinematics.velocityStateDerivatives[i] = dfdx.middleRows<3>(numRows * i + 6);
+        kinematics.velocityInputDerivatives[i] = dfdu.middleRows<3>(numRows * i + 6);
+      }
+    }
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -85,9 +186,15 @@ auto PinocchioEndEffectorKinematics::getPosition(const vector_t& state) const ->
     throw std::runtime_error("[PinocchioEndEffectorKinematics] pinocchioInterfacePtr_ is not set. Use setPinocchioInterface()");
   }
 
-  const pinocchio::Data& data = pinocchioInterfacePtr_->getData();
-
   std::vector<vector3_t> positions;
+  if (hasKinematics(false, false)) {
+    for (const auto& index : kinematicsIndices_) {
+      positions.push_back(kinematicsPtr_->positions[index]);
+    }
+    return positions;
+  }
+
+  const pinocchio::Data& data = pinocchioInterfacePtr_->getData();
   for (const auto& frameId : endEffectorFrameIds_) {
     positions.emplace_back(data.oMf[frameId].translation());
   }
@@ -102,11 +209,17 @@ auto PinocchioEndEffectorKinematics::getVelocity(const vector_t& state, const ve
     throw std::runtime_error("[PinocchioEndEffectorKinematics] pinocchioInterfacePtr_ is not set. Use setPinocchioInterface()");
   }
 
+  std::vector<vector3_t> velocities;
+  if (hasKinematics(true, false)) {
+    for (const auto& index : kinematicsIndices_) {
+      velocities.push_back(kinematicsPtr_->velocities[index]);
+    }
+    return velocities;
+  }
+
   const pinocchio::ReferenceFrame rf = pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED;
   const pinocchio::Model& model = pinocchioInterfacePtr_->getModel();
   const pinocchio::Data& data = pinocchioInterfacePtr_->getData();
-
-  std::vector<vector3_t> velocities;
   for (const auto& frameId : endEffectorFrameIds_) {
     velocities.emplace_back(pinocchio::getFrameVelocity(model, data, frameId, rf).linear());
   }
@@ -121,6 +234,17 @@ std::vector<VectorFunctionLinearApproximation> PinocchioEndEffectorKinematics::g
     throw std::runtime_error("[PinocchioEndEffectorKinematics] pinocchioInterfacePtr_ is not set. Use setPinocchioInterface()");
   }
 
+  if (hasKinematics(false, true)) {
+    std::vector<VectorFunctionLinearApproximation> positions;
+    for (const auto& index : kinematicsIndices_) {
+      VectorFunctionLinearApproximation pos;
+      pos.f = kinematicsPtr_->positions[index];
+      pos.dfdx = kinematicsPtr_->positionDerivatives[index];
+      positions.emplace_back(std::move(pos));
+    }
+    return positions;
+  }
+
   const pinocchio::ReferenceFrame rf = pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED;
   const pinocchio::Model& model = pinocchioInterfacePtr_->getModel();
   // const pinocchio::Data& data = pinocchioInterfacePtr_->getData();
@@ -149,6 +273,18 @@ std::vector<VectorFunctionLinearApproximation> PinocchioEndEffectorKinematics::g
     throw std::runtime_error("[PinocchioEndEffectorKinematics] pinocchioInterfacePtr_ is not set. Use setPinocchioInterface()");
   }
 
+  if (hasKinematics(true, true)) {
+    std::vector<VectorFunctionLinearApproximation> velocities;
+    for (const auto& index : kinematicsIndices_) {
+      VectorFunctionLinearApproximation vel;
+      vel.f = kinematicsPtr_->velocities[index];
+      vel.dfdx = kinematicsPtr_->velocityStateDerivatives[index];
+      vel.dfdu = kinematicsPtr_->velocityInputDerivatives[index];
+      velocities.emplace_back(std::move(vel));
+    }
+    return velocities;
+  }
+
   const pinocchio::ReferenceFrame rf = pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED;
   const pinocchio::Model& model = pinocchioInterfacePtr_->getModel();
   // const pinocchio::Data& data = pinocchioInterfacePtr_->getData();
@@ -183,10 +319,16 @@ auto PinocchioEndEffectorKinematics::getOrientationError(const vector_t& state,
     throw std::runtime_error("[PinocchioEndEffectorKinematics] pinocchioInterfacePtr_ is not set. Use setPinocchioInterface()");
   }
 
-  const pinocchio::ReferenceFrame rf = pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED;
-  const pinocchio::Data& data = pinocchioInterfacePtr_->getData();
-
   std::vector<vector3_t> errors;
+  if (hasKinematics(false, false)) {
+    for (int i = 0; i < kinematicsIndices_.size(); i++) {
+      const quaternion_t q = matrixToQuaternion(kinematicsPtr_->rotations[kinematicsIndices_[i]]);
+      errors.emplace_back(quaternionDistance(q, referenceOrientations[i]));
+    }
+    return errors;
+  }
+
+  const pinocchio::Data& data = pinocchioInterfacePtr_->getData();
   for (int i = 0; i < endEffectorFrameIds_.size(); i++) {
     const size_t frameId = endEffectorFrameIds_[i];
     errors.emplace_back(quaternionDistance(matrixToQuaternion(data.oMf[frameId].rotation()), referenceOrientations[i]));
@@ -203,6 +345,20 @@ std::vector<VectorFunctionLinearApproximation> PinocchioEndEffectorKinematics::g
     throw std::runtime_error("[PinocchioEndEffectorKinematics] pinocchioInterfacePtr_ is not set. Use setPinocchioInterface()");
   }
 
+  if (hasKinematics(false, true)) {
+    std::vector<VectorFunctionLinearApproximation> errors;
+    for (int i = 0; i < kinematicsIndices_.size(); i++) {
+      const size_t index = kinematicsIndices_[i];
+      const quaternion_t q = matrixToQuaternion(kinematicsPtr_->rotations[index]);
+      VectorFunctionLinearApproximation err;
+      err.f = quaternionDistance(q, referenceOrientations[i]);
+      err.dfdx = (quaternionDistanceJacobian(q, referenceOrientations[i]) * angularVelocityToQuaternionTimeDerivative(q)) *
+                 kinematicsPtr_->angularDerivatives[index];
+      errors.emplace_back(std::move(err));
+    }
+    return errors;
+  }
+
   const pinocchio::ReferenceFrame rf = pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED;
   const pinocchio::Model& model = pinocchioInterfacePtr_->getModel();
   // const pinocchio::Data& data = pinocchioInterfacePtr_->getData();
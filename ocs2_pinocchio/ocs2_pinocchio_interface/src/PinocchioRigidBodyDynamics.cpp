@@ -0,0 +1,98 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>
+
+#include <string>
+
+#include <pinocchio/algorithm/aba-derivatives.hpp>
+#include <pinocchio/algorithm/aba.hpp>
+
+#include <ocs2_pinocchio_interface/PinocchioRigidBodyDynamics.h>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PinocchioRigidBodyDynamics::PinocchioRigidBodyDynamics(const PinocchioInterface& pinocchioInterface)
+    : pinocchioInterface_(pinocchioInterface), numGeneralizedCoordinates_(pinocchioInterface.getModel().nv) {
+  const auto& model = pinocchioInterface_.getModel();
+  if (model.nq != model.nv) {
+    throw std::runtime_error("[PinocchioRigidBodyDynamics] The pinocchio model has nq = " + std::to_string(model.nq) + " and nv = " +
+                             std::to_string(model.nv) +
+                             ", but the state [q, v] requires nq == nv. A floating base with a quaternion (JointModelFreeFlyer), "
+                             "spherical and continuous joints are not supported. Model the base with 1-DoF joints instead, e.g., "
+                             "translations and ZYX Euler angles.");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t PinocchioRigidBodyDynamics::computeFlowMap(scalar_t time, const vector_t& state, const vector_t& input,
+                                                    const PreComputation& preComp) {
+  const auto& model = pinocchioInterface_.getModel();
+  auto& data = pinocchioInterface_.getData();
+  const auto n = numGeneralizedCoordinates_;
+  assert(state.size() == 2 * n);
+  assert(input.size() == n);
+
+  vector_t dxdt(2 * n);
+  dxdt.head(n) = state.tail(n);
+  dxdt.tail(n) = pinocchio::aba(model, data, state.head(n), state.tail(n), input);
+  return dxdt;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation PinocchioRigidBodyDynamics::linearApproximation(scalar_t time, const vector_t& state,
+                                                                                  const vector_t& input, const PreComputation& preComp) {
+  const auto& model = pinocchioInterface_.getModel();
+  auto& data = pinocchioInterface_.getData();
+  const auto n = numGeneralizedCoordinates_;
+  assert(state.size() == 2 * n);
+  assert(input.size() == n);
+
+  // computes data.ddq, data.ddq_dq, data.ddq_dv, and data.Minv (only its upper triangular part)
+  pinocchio::computeABADerivatives(model, data, state.head(n), state.tail(n), input);
+  data.Minv.triangularView<Eigen::StrictlyLower>() = data.Minv.transpose().triangularView<Eigen::StrictlyLower>();
+
+  auto dynamics = VectorFunctionLinearApproximation::Zero(2 * n, 2 * n, n);
+  dynamics.f.head(n) = state.tail(n);
+  dynamics.f.tail(n) = data.ddq;
+  dynamics.dfdx.topRightCorner(n, n).setIdentity();
+  dynamics.dfdx.bottomLeftCorner(n, n) = data.ddq_dq;
+  dynamics.dfdx.bottomRightCorner(n, n) = data.ddq_dv;
+  dynamics.dfdu.bottomRows(n) = data.Minv;
+  return dynamics;
+}
+
+}  // namespace ocs2
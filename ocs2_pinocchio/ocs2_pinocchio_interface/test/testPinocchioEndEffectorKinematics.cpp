@@ -265,6 +265,40 @@ TEST_F(TestEndEffectorKinematics, testClone) {
   EXPECT_TRUE(eeVel.isApprox(eeVelAd));
 }
 
+TEST_F(TestEndEffectorKinematics, testComputeKinematics) {
+  const auto& model = pinocchioInterfacePtr->getModel();
+  auto& data = pinocchioInterfacePtr->getData();
+
+  const auto a = ocs2::vector_t::Zero(q.rows());
+  pinocchio::computeForwardKinematicsDerivatives(model, data, q, v, a);
+  pinocchio::updateFramePlacements(model, data);
+
+  ocs2::PinocchioEndEffectorKinematics fusedKinematics(*pinocchioInterfacePtr, pinocchioMapping, {"WRIST_1", "WRIST_2"});
+  ocs2::PinocchioEndEffectorKinematics::Kinematics kinematics;
+  fusedKinematics.computeKinematics(*pinocchioInterfacePtr, x, &u, /* computeDerivatives = */ true, kinematics);
+  ASSERT_EQ(kinematics.positions.size(), 2u);
+
+  // reference: the getters evaluating the pinocchio interface
+  eeKinematicsPtr->setPinocchioInterface(*pinocchioInterfacePtr);
+  const quaternion_t qRef(1, 0, 0, 0);
+  const auto eePosLin = eeKinematicsPtr->getPositionLinearApproximation(x)[0];
+  const auto eeVelLin = eeKinematicsPtr->getVelocityLinearApproximation(x, u)[0];
+  const auto eeOrientationErrorLin = eeKinematicsPtr->getOrientationErrorLinearApproximation(x, {qRef})[0];
+
+  // the getters reading the kinematics
+  auto clonePtr = std::unique_ptr<ocs2::PinocchioEndEffectorKinematics>(eeKinematicsPtr->clone());
+  clonePtr->setPinocchioInterface(*pinocchioInterfacePtr, kinematics);
+  compareApproximation(clonePtr->getPositionLinearApproximation(x)[0], eePosLin);
+  compareApproximation(clonePtr->getVelocityLinearApproximation(x, u)[0], eeVelLin, /* functionOfInput = */ true);
+  compareApproximation(clonePtr->getOrientationErrorLinearApproximation(x, {qRef})[0], eeOrientationErrorLin);
+  EXPECT_TRUE(clonePtr->getPosition(x)[0].isApprox(eePosLin.f));
+  EXPECT_TRUE(clonePtr->getVelocity(x, u)[0].isApprox(eeVelLin.f));
+  EXPECT_TRUE(clonePtr->getOrientationError(x, {qRef})[0].isApprox(eeOrientationErrorLin.f));
+
+  // compare against auto-diff
+  compareApproximation(eePosLin, eeKinematicsCppAdPtr->getPositionLinearApproximation(x)[0]);
+}
+
 /* Test to understand the frame jacobian */
 TEST_F(TestEndEffectorKinematics, testPinocchioOrientationErrorJacoiban) {
   const auto& model = pinocchioInterfacePtr->getModel();
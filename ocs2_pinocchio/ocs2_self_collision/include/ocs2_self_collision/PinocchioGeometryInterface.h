@@ -77,6 +77,27 @@ class PinocchioGeometryInterface final {
    */
   std::vector<hpp::fcl::DistanceResult> computeDistances(const PinocchioInterface& pinocchioInterface) const;
 
+  /**
+   * Compute collision pair distances with a bounding sphere broad phase
+   *
+   * The pairs whose bounding spheres are further apart than the activation distance skip the narrow phase. For these pairs, the
+   * distance result only holds the distance between the bounding spheres, which is a lower bound of the distance between the objects,
+   * and isActive is set to false.
+   *
+   * @note Requires pinocchioInterface with updated joint placements by calling forwardKinematics().
+   *
+   * @param [in] pinocchioInterface: pinocchio interface of the robot model
+   * @param [in] activationDistance: Pairs with a lower bound of the distance above this value are not checked by the narrow phase.
+   * @param [out] isActive: For each collision pair, whether the narrow phase has been evaluated.
+   * @param [in] previousResults: Optional distance results of a previous call, e.g. at the same node of the previous iteration. When
+   *                              given, their cached GJK guesses are used to warm start the narrow phase. Ignored for versions of
+   *                              hpp-fcl without cached GJK guesses (before 1.5.0).
+   * @return An array of distances between pairs of collision bodies defined in the constructor.
+   */
+  std::vector<hpp::fcl::DistanceResult> computeDistances(const PinocchioInterface& pinocchioInterface, scalar_t activationDistance,
+                                                         std::vector<bool>& isActive,
+                                                         const std::vector<hpp::fcl::DistanceResult>* previousResults = nullptr) const;
+
   /** Get the number of collision pairs */
   size_t getNumCollisionPairs() const;
 
@@ -91,8 +112,13 @@ class PinocchioGeometryInterface final {
                                const std::vector<std::pair<size_t, size_t>>& collisionObjectPairs);
   void addCollisionLinkPairs(const PinocchioInterface& pinocchioInterface,
                              const std::vector<std::pair<std::string, std::string>>& collisionLinkPairs);
+  void computeBoundingSpheres();
 
   std::shared_ptr<pinocchio::GeometryModel> geometryModelPtr_;
+
+  // Bounding spheres of the geometry objects in their local frame
+  std::vector<hpp::fcl::Vec3f> boundingSphereCenters_;
+  std::vector<scalar_t> boundingSphereRadii_;
 };
 
 }  // namespace ocs2
@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <limits>
+#include <map>
+
 #include <ocs2_pinocchio_interface/PinocchioInterface.h>
 #include <ocs2_self_collision/PinocchioGeometryInterface.h>
 
@@ -43,8 +46,14 @@ class SelfCollision {
    *
    * @param [in] pinocchioGeometryInterface: pinocchio geometry interface of the robot model
    * @parma [in] minimumDistance: minimum allowed distance between each collision pair
+   * @param [in] activationDistance: The distances are saturated at this value, such that pairs further apart have a constant value
+   *                                 and a zero derivative. The pairs whose bounding spheres are further apart skip the narrow phase and
+   *                                 the Jacobian computation. Must be larger than minimumDistance. The default value checks all pairs.
+   * @param [in] warmStart: If true, the narrow phase is warm started with the witness points of the last linear approximation at the
+   *                        closest time. Each copy of this class keeps its own cache.
    */
-  SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance);
+  SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance,
+                scalar_t activationDistance = std::numeric_limits<scalar_t>::infinity(), bool warmStart = false);
 
   /** Get the number of collision pairs */
   size_t getNumCollisionPairs() const { return pinocchioGeometryInterface_.getNumCollisionPairs(); }
@@ -61,6 +70,9 @@ class SelfCollision {
    */
   vector_t getValue(const PinocchioInterface& pinocchioInterface) const;
 
+  /** Same as getValue(pinocchioInterface), where time identifies the node for the warm start of the narrow phase. */
+  vector_t getValue(scalar_t time, const PinocchioInterface& pinocchioInterface) const;
+
   /**
    * Evaluate the linear approximation of the distance function
    * This method analytically computes the first derivative of distance against the pinocchio generalized coordinates
@@ -73,9 +85,26 @@ class SelfCollision {
    */
   std::pair<vector_t, matrix_t> getLinearApproximation(const PinocchioInterface& pinocchioInterface) const;
 
+  /** Same as getLinearApproximation(pinocchioInterface), where time identifies the node for the warm start of the narrow phase. */
+  std::pair<vector_t, matrix_t> getLinearApproximation(scalar_t time, const PinocchioInterface& pinocchioInterface) const;
+
  private:
+  /**
+   * Computes the distances of all pairs. If time is given, the narrow phase is warm started from the cache. The cache is only updated
+   * if updateWarmStart is true, i.e., for the linear approximation but not for the trial points of a line search.
+   */
+  std::vector<hpp::fcl::DistanceResult> computeDistances(const scalar_t* time, const PinocchioInterface& pinocchioInterface,
+                                                         bool updateWarmStart, std::vector<bool>& isActive) const;
+  vector_t computeValue(const scalar_t* time, const PinocchioInterface& pinocchioInterface) const;
+  std::pair<vector_t, matrix_t> computeLinearApproximation(const scalar_t* time, const PinocchioInterface& pinocchioInterface) const;
+
   PinocchioGeometryInterface pinocchioGeometryInterface_;
   scalar_t minimumDistance_;
+  scalar_t activationDistance_;
+  bool warmStart_;
+
+  // The distance results of the last linear approximation per node time. A copy is used by a single thread.
+  mutable std::map<scalar_t, std::vector<hpp::fcl::DistanceResult>> warmStartCache_;
 };
 
 }  // namespace ocs2
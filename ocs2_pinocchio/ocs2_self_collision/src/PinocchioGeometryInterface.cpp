@@ -40,6 +40,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <urdf_parser/urdf_parser.h>
 
+// OCS2_HPP_FCL_HAS_CACHED_GJK_GUESS is defined by CMake if the installed hpp-fcl provides the cached GJK guesses of the distance queries
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -51,6 +53,7 @@ PinocchioGeometryInterface::PinocchioGeometryInterface(const PinocchioInterface&
   buildGeomFromPinocchioInterface(pinocchioInterface, *geometryModelPtr_);
 
   addCollisionObjectPairs(pinocchioInterface, collisionObjectPairs);
+  computeBoundingSpheres();
 }
 
 PinocchioGeometryInterface::PinocchioGeometryInterface(const PinocchioInterface& pinocchioInterface,
@@ -61,6 +64,7 @@ PinocchioGeometryInterface::PinocchioGeometryInterface(const PinocchioInterface&
 
   addCollisionObjectPairs(pinocchioInterface, collisionObjectPairs);
   addCollisionLinkPairs(pinocchioInterface, collisionLinkPairs);
+  computeBoundingSpheres();
 }
 
 /******************************************************************************************************/
@@ -75,6 +79,61 @@ std::vector<hpp::fcl::DistanceResult> PinocchioGeometryInterface::computeDistanc
   return std::move(geometryData.distanceResults);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<hpp::fcl::DistanceResult> PinocchioGeometryInterface::computeDistances(
+    const PinocchioInterface& pinocchioInterface, scalar_t activationDistance, std::vector<bool>& isActive,
+    const std::vector<hpp::fcl::DistanceResult>* previousResults) const {
+  const auto& geometryModel = *geometryModelPtr_;
+  const size_t numCollisionPairs = geometryModel.collisionPairs.size();
+#ifdef OCS2_HPP_FCL_HAS_CACHED_GJK_GUESS
+  const bool warmStart = previousResults != nullptr && previousResults->size() == numCollisionPairs;
+#endif
+
+  pinocchio::GeometryData geometryData(geometryModel);
+  pinocchio::updateGeometryPlacements(pinocchioInterface.getModel(), pinocchioInterface.getData(), geometryModel, geometryData);
+
+  isActive.assign(numCollisionPairs, true);
+  for (size_t i = 0; i < numCollisionPairs; ++i) {
+    const auto& collisionPair = geometryModel.collisionPairs[i];
+    auto& result = geometryData.distanceResults[i];
+
+    // broad phase: distance between the bounding spheres
+    const hpp::fcl::Vec3f center1 = geometryData.oMg[collisionPair.first].act(boundingSphereCenters_[collisionPair.first]);
+    const hpp::fcl::Vec3f center2 = geometryData.oMg[collisionPair.second].act(boundingSphereCenters_[collisionPair.second]);
+    const scalar_t lowerBound =
+        (center2 - center1).norm() - boundingSphereRadii_[collisionPair.first] - boundingSphereRadii_[collisionPair.second];
+
+    if (lowerBound > activationDistance) {
+      isActive[i] = false;
+      result = hpp::fcl::DistanceResult();
+      result.min_distance = lowerBound;
+#ifdef OCS2_HPP_FCL_HAS_CACHED_GJK_GUESS
+      if (warmStart) {
+        // keep the guesses for the next time this pair is activated
+        result.cached_gjk_guess = (*previousResults)[i].cached_gjk_guess;
+        result.cached_support_func_guess = (*previousResults)[i].cached_support_func_guess;
+      }
+#endif
+      continue;
+    }
+
+    // narrow phase
+#ifdef OCS2_HPP_FCL_HAS_CACHED_GJK_GUESS
+    if (warmStart) {
+      auto& request = geometryData.distanceRequests[i];
+      request.enable_cached_gjk_guess = true;
+      request.cached_gjk_guess = (*previousResults)[i].cached_gjk_guess;
+      request.cached_support_func_guess = (*previousResults)[i].cached_support_func_guess;
+    }
+#endif
+    pinocchio::computeDistance(geometryModel, geometryData, i);
+  }
+
+  return std::move(geometryData.distanceResults);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -139,4 +198,19 @@ void PinocchioGeometryInterface::addCollisionLinkPairs(const PinocchioInterface&
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioGeometryInterface::computeBoundingSpheres() {
+  const auto& geometryObjects = geometryModelPtr_->geometryObjects;
+  boundingSphereCenters_.resize(geometryObjects.size());
+  boundingSphereRadii_.resize(geometryObjects.size());
+  for (size_t i = 0; i < geometryObjects.size(); ++i) {
+    auto& geometry = *geometryObjects[i].geometry;
+    geometry.computeLocalAABB();
+    boundingSphereCenters_[i] = geometry.aabb_center;
+    boundingSphereRadii_[i] = geometry.aabb_radius;
+  }
+}
+
 }  // namespace ocs2
@@ -29,6 +29,10 @@
 
 #include <pinocchio/fwd.hpp>
 
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
 #include <pinocchio/algorithm/jacobian.hpp>
 #include <pinocchio/multibody/geometry.hpp>
 
@@ -42,18 +46,92 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-SelfCollision::SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance)
-    : pinocchioGeometryInterface_(std::move(pinocchioGeometryInterface)), minimumDistance_(minimumDistance) {}
+SelfCollision::SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance, scalar_t activationDistance,
+                             bool warmStart)
+    : pinocchioGeometryInterface_(std::move(pinocchioGeometryInterface)),
+      minimumDistance_(minimumDistance),
+      activationDistance_(activationDistance),
+      warmStart_(warmStart) {
+  if (activationDistance_ <= minimumDistance_) {
+    throw std::runtime_error("[SelfCollision] activationDistance must be larger than minimumDistance!");
+  }
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t SelfCollision::getValue(const PinocchioInterface& pinocchioInterface) const {
-  const std::vector<hpp::fcl::DistanceResult> distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface);
+  return computeValue(nullptr, pinocchioInterface);
+}
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t SelfCollision::getValue(scalar_t time, const PinocchioInterface& pinocchioInterface) const {
+  return computeValue(&time, pinocchioInterface);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::pair<vector_t, matrix_t> SelfCollision::getLinearApproximation(const PinocchioInterface& pinocchioInterface) const {
+  return computeLinearApproximation(nullptr, pinocchioInterface);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::pair<vector_t, matrix_t> SelfCollision::getLinearApproximation(scalar_t time, const PinocchioInterface& pinocchioInterface) const {
+  return computeLinearApproximation(&time, pinocchioInterface);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<hpp::fcl::DistanceResult> SelfCollision::computeDistances(const scalar_t* time, const PinocchioInterface& pinocchioInterface,
+                                                                       bool updateWarmStart, std::vector<bool>& isActive) const {
+  // maximum number of nodes kept in the warm start cache
+  constexpr size_t maxNumCachedNodes = 1000;
+
+  if (time == nullptr || !warmStart_) {
+    return pinocchioGeometryInterface_.computeDistances(pinocchioInterface, activationDistance_, isActive);
+  }
+
+  // the guesses of the cached node closest in time
+  const std::vector<hpp::fcl::DistanceResult>* previousResults = nullptr;
+  auto it = warmStartCache_.lower_bound(*time);
+  if (it != warmStartCache_.begin() && (it == warmStartCache_.end() || *time - std::prev(it)->first < it->first - *time)) {
+    --it;
+  }
+  if (it != warmStartCache_.end()) {
+    previousResults = &it->second;
+  }
+
+  auto distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface, activationDistance_, isActive, previousResults);
+
+  if (updateWarmStart) {
+    warmStartCache_[*time] = distanceArray;
+    // MPC moves forward in time: drop the oldest nodes
+    while (warmStartCache_.size() > maxNumCachedNodes) {
+      warmStartCache_.erase(warmStartCache_.begin());
+    }
+  }
+
+  return distanceArray;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t SelfCollision::computeValue(const scalar_t* time, const PinocchioInterface& pinocchioInterface) const {
+  std::vector<bool> isActive;
+  const std::vector<hpp::fcl::DistanceResult> distanceArray = computeDistances(time, pinocchioInterface, false, isActive);
+
+  // The distances are saturated at the activation distance. The bounding sphere distance of the culled pairs is larger than the
+  // activation distance, so their value is continuous when they become active.
   vector_t violations = vector_t::Zero(distanceArray.size());
   for (size_t i = 0; i < distanceArray.size(); ++i) {
-    violations[i] = distanceArray[i].min_distance - minimumDistance_;
+    violations[i] = std::min(distanceArray[i].min_distance, activationDistance_) - minimumDistance_;
   }
 
   return violations;
@@ -62,41 +140,51 @@ vector_t SelfCollision::getValue(const PinocchioInterface& pinocchioInterface) c
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-std::pair<vector_t, matrix_t> SelfCollision::getLinearApproximation(const PinocchioInterface& pinocchioInterface) const {
-  const std::vector<hpp::fcl::DistanceResult> distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface);
+std::pair<vector_t, matrix_t> SelfCollision::computeLinearApproximation(const scalar_t* time,
+                                                                        const PinocchioInterface& pinocchioInterface) const {
+  std::vector<bool> isActive;
+  const std::vector<hpp::fcl::DistanceResult> distanceArray = computeDistances(time, pinocchioInterface, true, isActive);
 
   const auto& model = pinocchioInterface.getModel();
   const auto& data = pinocchioInterface.getData();
 
   const auto& geometryModel = pinocchioGeometryInterface_.getGeometryModel();
 
+  // Joint jacobians are computed once per joint, and only for the joints of the active pairs.
+  // Jacobians from pinocchio are given as
+  // [ position jacobian ]
+  // [ rotation jacobian ]
+  std::vector<matrix_t> jointJacobians(model.njoints);
+  auto getPointJacobian = [&](pinocchio::JointIndex joint, const vector3_t& point) -> matrix_t {
+    auto& jointJacobian = jointJacobians[joint];
+    if (jointJacobian.size() == 0) {
+      jointJacobian.setZero(6, model.nv);
+      pinocchio::getJointJacobian(model, data, joint, pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED, jointJacobian);
+    }
+    // use the joint jacobian translated to the point
+    const vector3_t pointOffset = point - data.oMi[joint].translation();
+    return jointJacobian.topRows(3) - skewSymmetricMatrix(pointOffset) * jointJacobian.bottomRows(3);
+  };
+
   vector_t f(distanceArray.size());
-  matrix_t dfdq(distanceArray.size(), model.nq);
+  matrix_t dfdq = matrix_t::Zero(distanceArray.size(), model.nq);
   for (size_t i = 0; i < distanceArray.size(); ++i) {
-    // Distance violation
-    f[i] = distanceArray[i].min_distance - minimumDistance_;
+    // Distance violation, saturated at the activation distance as in computeValue()
+    f[i] = std::min(distanceArray[i].min_distance, activationDistance_) - minimumDistance_;
+
+    // The saturated distances are constant, and the pairs culled by the broad phase have no nearest points
+    if (!isActive[i] || distanceArray[i].min_distance >= activationDistance_) {
+      continue;
+    }
 
     // Jacobian calculation
     const auto& collisionPair = geometryModel.collisionPairs[i];
     const auto& joint1 = geometryModel.geometryObjects[collisionPair.first].parentJoint;
     const auto& joint2 = geometryModel.geometryObjects[collisionPair.second].parentJoint;
 
-    // We need to get the jacobian of the point on the first object; use the joint jacobian translated to the point
-    const vector3_t joint1Position = data.oMi[joint1].translation();
-    const vector3_t pt1Offset = distanceArray[i].nearest_points[0] - joint1Position;
-    matrix_t joint1Jacobian = matrix_t::Zero(6, model.nv);
-    pinocchio::getJointJacobian(model, data, joint1, pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED, joint1Jacobian);
-    // Jacobians from pinocchio are given as
-    // [ position jacobian ]
-    // [ rotation jacobian ]
-    const matrix_t pt1Jacobian = joint1Jacobian.topRows(3) - skewSymmetricMatrix(pt1Offset) * joint1Jacobian.bottomRows(3);
-
-    // We need to get the jacobian of the point on the second object; use the joint jacobian translated to the point
-    const vector3_t joint2Position = data.oMi[joint2].translation();
-    const vector3_t pt2Offset = distanceArray[i].nearest_points[1] - joint2Position;
-    matrix_t joint2Jacobian = matrix_t::Zero(6, model.nv);
-    pinocchio::getJointJacobian(model, data, joint2, pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED, joint2Jacobian);
-    const matrix_t pt2Jacobian = joint2Jacobian.topRows(3) - skewSymmetricMatrix(pt2Offset) * joint2Jacobian.bottomRows(3);
+    // We need to get the jacobian of the nearest points on both objects
+    const matrix_t pt1Jacobian = getPointJacobian(joint1, distanceArray[i].nearest_points[0]);
+    const matrix_t pt2Jacobian = getPointJacobian(joint2, distanceArray[i].nearest_points[1]);
 
     // To get the (approximate) jacobian of the distance, get the difference between the two nearest point jacobians, then multiply by the
     // vector from point to point
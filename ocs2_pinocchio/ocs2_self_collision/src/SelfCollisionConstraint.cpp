@@ -36,9 +36,10 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 SelfCollisionConstraint::SelfCollisionConstraint(const PinocchioStateInputMapping<scalar_t>& mapping,
-                                                 PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance)
+                                                 PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance,
+                                                 scalar_t activationDistance, bool warmStart)
     : StateConstraint(ConstraintOrder::Linear),
-      selfCollision_(std::move(pinocchioGeometryInterface), minimumDistance),
+      selfCollision_(std::move(pinocchioGeometryInterface), minimumDistance, activationDistance, warmStart),
       mappingPtr_(mapping.clone()) {}
 
 /******************************************************************************************************/
@@ -59,7 +60,7 @@ size_t SelfCollisionConstraint::getNumConstraints(scalar_t time) const {
 /******************************************************************************************************/
 vector_t SelfCollisionConstraint::getValue(scalar_t time, const vector_t& state, const PreComputation& preComputation) const {
   const auto& pinocchioInterface = getPinocchioInterface(preComputation);
-  return selfCollision_.getValue(pinocchioInterface);
+  return selfCollision_.getValue(time, pinocchioInterface);
 }
 
 /******************************************************************************************************/
@@ -72,7 +73,7 @@ VectorFunctionLinearApproximation SelfCollisionConstraint::getLinearApproximatio
 
   VectorFunctionLinearApproximation constraint;
   matrix_t dfdq, dfdv;
-  std::tie(constraint.f, dfdq) = selfCollision_.getLinearApproximation(pinocchioInterface);
+  std::tie(constraint.f, dfdq) = selfCollision_.getLinearApproximation(time, pinocchioInterface);
   dfdv.setZero(dfdq.rows(), dfdq.cols());
   std::tie(constraint.dfdx, std::ignore) = mappingPtr_->getOcs2Jacobian(state, dfdq, dfdv);
   return constraint;
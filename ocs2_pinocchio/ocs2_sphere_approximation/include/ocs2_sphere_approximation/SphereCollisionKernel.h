@@ -0,0 +1,104 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/**
+ * Distance kernel between sets of collision spheres.
+ *
+ * The spheres are partitioned into groups of consecutive spheres, e.g., the spheres approximating one link. The sphere data is stored
+ * as a structure of arrays: the x, y, and z coordinates of the centers and the radii are each stored contiguously. This way, the
+ * distances between one sphere and all the spheres of another group are evaluated with the packet (SIMD) operations of Eigen.
+ *
+ * For each pair of groups, the kernel returns the smallest distance between the surfaces of their spheres together with the normal of
+ * this distance, from which the gradient with respect to the sphere centers follows.
+ */
+class SphereCollisionKernel {
+ public:
+  using vector3_t = Eigen::Matrix<scalar_t, 3, 1>;
+  /** Sphere centers with one row per sphere. Since the matrix is column-major, each coordinate is stored contiguously. */
+  using sphere_centers_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, 3>;
+
+  /** The closest spheres of a pair of groups. */
+  struct GroupPairDistance {
+    /** Distance between the surfaces of the closest spheres. It is negative if the spheres penetrate. */
+    scalar_t distance;
+    /** Index of the closest sphere of the first group. */
+    size_t sphere1;
+    /** Index of the closest sphere of the second group. */
+    size_t sphere2;
+    /** Unit vector from the center of sphere1 to the center of sphere2, i.e., the gradient of distance with respect to sphere2. */
+    vector3_t normal;
+  };
+
+  /**
+   * Constructor
+   *
+   * @param [in] numSpheresPerGroup : The number of spheres of each group. The spheres of a group are consecutive.
+   * @param [in] sphereRadii : The radius of each sphere.
+   * @param [in] groupPairs : The pairs of groups to be checked.
+   */
+  SphereCollisionKernel(const size_array_t& numSpheresPerGroup, const scalar_array_t& sphereRadii,
+                        std::vector<std::pair<size_t, size_t>> groupPairs);
+
+  /** Get the number of spheres in total */
+  size_t getNumSpheres() const { return static_cast<size_t>(sphereRadii_.size()); }
+
+  /** Get the number of checked pairs of groups */
+  size_t getNumGroupPairs() const { return groupPairs_.size(); }
+
+  /** Get the checked pairs of groups */
+  const std::vector<std::pair<size_t, size_t>>& getGroupPairs() const { return groupPairs_; }
+
+  /** Packs an array of sphere centers into the structure of arrays layout. */
+  static sphere_centers_t packCenters(const std::vector<vector3_t>& sphereCenters);
+
+  /**
+   * Computes the closest spheres of all pairs of groups.
+   *
+   * @param [in] sphereCenters : The centers of all spheres.
+   * @return The closest spheres of each pair of groups, in the order of the group pairs given in the constructor.
+   */
+  std::vector<GroupPairDistance> computeDistances(const sphere_centers_t& sphereCenters) const;
+
+ private:
+  size_array_t groupOffsets_;  // index of the first sphere of each group, with the total number of spheres appended
+  Eigen::Array<scalar_t, Eigen::Dynamic, 1> sphereRadii_;
+  std::vector<std::pair<size_t, size_t>> groupPairs_;
+  size_t maxNumSpheresPerGroup_ = 0;
+};
+
+}  // namespace ocs2
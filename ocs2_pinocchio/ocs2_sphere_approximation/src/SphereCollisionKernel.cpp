@@ -0,0 +1,134 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_sphere_approximation/SphereCollisionKernel.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SphereCollisionKernel::SphereCollisionKernel(const size_array_t& numSpheresPerGroup, const scalar_array_t& sphereRadii,
+                                             std::vector<std::pair<size_t, size_t>> groupPairs)
+    : sphereRadii_(Eigen::Map<const Eigen::Array<scalar_t, Eigen::Dynamic, 1>>(sphereRadii.data(), sphereRadii.size())),
+      groupPairs_(std::move(groupPairs)) {
+  groupOffsets_.reserve(numSpheresPerGroup.size() + 1);
+  groupOffsets_.push_back(0);
+  for (const auto numSpheres : numSpheresPerGroup) {
+    groupOffsets_.push_back(groupOffsets_.back() + numSpheres);
+    maxNumSpheresPerGroup_ = std::max(maxNumSpheresPerGroup_, numSpheres);
+  }
+
+  if (groupOffsets_.back() != sphereRadii.size()) {
+    throw std::runtime_error("[SphereCollisionKernel] The number of sphere radii (" + std::to_string(sphereRadii.size()) +
+                             ") does not match the number of spheres in the groups (" + std::to_string(groupOffsets_.back()) + ")!");
+  }
+  for (const auto& groupPair : groupPairs_) {
+    if (groupPair.first >= numSpheresPerGroup.size() || groupPair.second >= numSpheresPerGroup.size()) {
+      throw std::runtime_error("[SphereCollisionKernel] Group pair (" + std::to_string(groupPair.first) + ", " +
+                               std::to_string(groupPair.second) + ") is out of range!");
+    }
+    if (numSpheresPerGroup[groupPair.first] == 0 || numSpheresPerGroup[groupPair.second] == 0) {
+      throw std::runtime_error("[SphereCollisionKernel] Group pair (" + std::to_string(groupPair.first) + ", " +
+                               std::to_string(groupPair.second) + ") contains an empty group!");
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto SphereCollisionKernel::packCenters(const std::vector<vector3_t>& sphereCenters) -> sphere_centers_t {
+  sphere_centers_t packedCenters(sphereCenters.size(), 3);
+  for (size_t i = 0; i < sphereCenters.size(); ++i) {
+    packedCenters.row(i) = sphereCenters[i].transpose();
+  }
+  return packedCenters;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto SphereCollisionKernel::computeDistances(const sphere_centers_t& sphereCenters) const -> std::vector<GroupPairDistance> {
+  if (static_cast<size_t>(sphereCenters.rows()) != getNumSpheres()) {
+    throw std::runtime_error("[SphereCollisionKernel] sphereCenters.rows() != getNumSpheres()");
+  }
+
+  // distances between the spheres of a pair of groups, with the larger group along the (contiguous) columns
+  Eigen::Array<scalar_t, Eigen::Dynamic, Eigen::Dynamic> distances(maxNumSpheresPerGroup_, maxNumSpheresPerGroup_);
+
+  std::vector<GroupPairDistance> results;
+  results.reserve(groupPairs_.size());
+  for (const auto& groupPair : groupPairs_) {
+    size_t offsetA = groupOffsets_[groupPair.first];
+    size_t numSpheresA = groupOffsets_[groupPair.first + 1] - offsetA;
+    size_t offsetB = groupOffsets_[groupPair.second];
+    size_t numSpheresB = groupOffsets_[groupPair.second + 1] - offsetB;
+    const bool isSwapped = numSpheresA < numSpheresB;
+    if (isSwapped) {
+      std::swap(offsetA, offsetB);
+      std::swap(numSpheresA, numSpheresB);
+    }
+
+    // one column per sphere of group B, evaluated against all spheres of group A at once
+    auto block = distances.topLeftCorner(numSpheresA, numSpheresB);
+    const auto xA = sphereCenters.col(0).segment(offsetA, numSpheresA).array();
+    const auto yA = sphereCenters.col(1).segment(offsetA, numSpheresA).array();
+    const auto zA = sphereCenters.col(2).segment(offsetA, numSpheresA).array();
+    const auto radiiA = sphereRadii_.segment(offsetA, numSpheresA);
+    for (size_t j = 0; j < numSpheresB; ++j) {
+      const size_t sphereB = offsetB + j;
+      block.col(j) = ((xA - sphereCenters(sphereB, 0)).square() + (yA - sphereCenters(sphereB, 1)).square() +
+                      (zA - sphereCenters(sphereB, 2)).square())
+                         .sqrt() -
+                     radiiA - sphereRadii_[sphereB];
+    }
+
+    Eigen::Index i, j;
+    GroupPairDistance result;
+    result.distance = block.minCoeff(&i, &j);
+    result.sphere1 = isSwapped ? offsetB + j : offsetA + i;
+    result.sphere2 = isSwapped ? offsetA + i : offsetB + j;
+
+    const vector3_t centerDifference = (sphereCenters.row(result.sphere2) - sphereCenters.row(result.sphere1)).transpose();
+    const scalar_t centerDistance = centerDifference.norm();
+    result.normal = centerDistance > std::numeric_limits<scalar_t>::epsilon() ? vector3_t(centerDifference / centerDistance)
+                                                                                : vector3_t::UnitX();
+    results.push_back(result);
+  }
+
+  return results;
+}
+
+}  // namespace ocs2
@@ -0,0 +1,156 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>
+
+#include <pinocchio/algorithm/jacobian.hpp>
+#include <pinocchio/multibody/geometry.hpp>
+
+#include <algorithm>
+
+#include <ocs2_robotic_tools/common/SkewSymmetricMatrix.h>
+
+#include "ocs2_sphere_approximation/SphereSelfCollision.h"
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SphereSelfCollision::SphereSelfCollision(PinocchioSphereInterface pinocchioSphereInterface,
+                                         const std::vector<std::pair<std::string, std::string>>& collisionLinkPairs,
+                                         scalar_t minimumDistance)
+    : pinocchioSphereInterface_(std::move(pinocchioSphereInterface)),
+      kernel_(createKernel(pinocchioSphereInterface_, collisionLinkPairs)),
+      minimumDistance_(minimumDistance) {
+  const auto& geometryModel = pinocchioSphereInterface_.getGeometryModel();
+  const auto& geomObjIds = pinocchioSphereInterface_.getGeomObjIds();
+  const auto& numSpheres = pinocchioSphereInterface_.getNumSpheres();
+
+  sphereParentJoints_.reserve(pinocchioSphereInterface_.getNumSpheresInTotal());
+  for (size_t i = 0; i < pinocchioSphereInterface_.getNumPrimitiveShapes(); i++) {
+    const size_t parentJoint = geometryModel.geometryObjects[geomObjIds[i]].parentJoint;
+    sphereParentJoints_.insert(sphereParentJoints_.end(), numSpheres[i], parentJoint);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SphereCollisionKernel SphereSelfCollision::createKernel(const PinocchioSphereInterface& pinocchioSphereInterface,
+                                                        const std::vector<std::pair<std::string, std::string>>& collisionLinkPairs) {
+  const auto& collisionLinks = pinocchioSphereInterface.getCollisionLinks();
+  const auto& collisionLinkOfEachPrimitiveShape = pinocchioSphereInterface.getCollisionLinkOfEachPrimitveShape();
+  const auto& numSpheres = pinocchioSphereInterface.getNumSpheres();
+
+  auto getLinkIndex = [&](const std::string& link) -> size_t {
+    const auto it = std::find(collisionLinks.begin(), collisionLinks.end(), link);
+    if (it == collisionLinks.end()) {
+      throw std::runtime_error("[SphereSelfCollision] Link " + link + " is not a collision link of the PinocchioSphereInterface!");
+    }
+    return std::distance(collisionLinks.begin(), it);
+  };
+
+  // one group per collision link: the primitive shapes are stored link by link
+  size_array_t numSpheresPerLink(collisionLinks.size(), 0);
+  size_t previousLinkIndex = 0;
+  for (size_t i = 0; i < pinocchioSphereInterface.getNumPrimitiveShapes(); i++) {
+    const size_t linkIndex = getLinkIndex(collisionLinkOfEachPrimitiveShape[i]);
+    if (linkIndex < previousLinkIndex) {
+      throw std::runtime_error("[SphereSelfCollision] The primitive shapes of the PinocchioSphereInterface are not ordered by link!");
+    }
+    numSpheresPerLink[linkIndex] += numSpheres[i];
+    previousLinkIndex = linkIndex;
+  }
+
+  std::vector<std::pair<size_t, size_t>> linkIndexPairs;
+  linkIndexPairs.reserve(collisionLinkPairs.size());
+  for (const auto& linkPair : collisionLinkPairs) {
+    linkIndexPairs.emplace_back(getLinkIndex(linkPair.first), getLinkIndex(linkPair.second));
+  }
+
+  return {numSpheresPerLink, pinocchioSphereInterface.getSphereRadii(), std::move(linkIndexPairs)};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t SphereSelfCollision::getValue(const PinocchioInterface& pinocchioInterface) const {
+  const auto sphereCenters = pinocchioSphereInterface_.computeSphereCentersInWorldFrame(pinocchioInterface);
+  const auto distances = kernel_.computeDistances(SphereCollisionKernel::packCenters(sphereCenters));
+
+  vector_t violations(distances.size());
+  for (size_t i = 0; i < distances.size(); ++i) {
+    violations[i] = distances[i].distance - minimumDistance_;
+  }
+
+  return violations;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::pair<vector_t, matrix_t> SphereSelfCollision::getLinearApproximation(const PinocchioInterface& pinocchioInterface) const {
+  const auto sphereCenters = pinocchioSphereInterface_.computeSphereCentersInWorldFrame(pinocchioInterface);
+  const auto distances = kernel_.computeDistances(SphereCollisionKernel::packCenters(sphereCenters));
+
+  const auto& model = pinocchioInterface.getModel();
+  const auto& data = pinocchioInterface.getData();
+
+  // Joint jacobians are computed once per joint, and only for the joints of the closest spheres.
+  // Jacobians from pinocchio are given as
+  // [ position jacobian ]
+  // [ rotation jacobian ]
+  std::vector<matrix_t> jointJacobians(model.njoints);
+  auto getSphereCenterJacobian = [&](size_t sphere) -> matrix_t {
+    const size_t joint = sphereParentJoints_[sphere];
+    auto& jointJacobian = jointJacobians[joint];
+    if (jointJacobian.size() == 0) {
+      jointJacobian.setZero(6, model.nv);
+      pinocchio::getJointJacobian(model, data, joint, pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED, jointJacobian);
+    }
+    // use the joint jacobian translated to the sphere center
+    const vector3_t sphereCenterOffset = sphereCenters[sphere] - data.oMi[joint].translation();
+    return jointJacobian.topRows(3) - skewSymmetricMatrix(sphereCenterOffset) * jointJacobian.bottomRows(3);
+  };
+
+  vector_t f(distances.size());
+  matrix_t dfdq(distances.size(), model.nv);
+  for (size_t i = 0; i < distances.size(); ++i) {
+    f[i] = distances[i].distance - minimumDistance_;
+
+    // the distance only depends on the centers of the closest spheres
+    const matrix_t differenceJacobian = getSphereCenterJacobian(distances[i].sphere2) - getSphereCenterJacobian(distances[i].sphere1);
+    dfdq.row(i).noalias() = distances[i].normal.transpose() * differenceJacobian;
+  }
+
+  return {f, dfdq};
+}
+
+}  // namespace ocs2
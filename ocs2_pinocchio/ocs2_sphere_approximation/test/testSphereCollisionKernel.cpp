@@ -0,0 +1,109 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_sphere_approximation/SphereCollisionKernel.h>
+
+using namespace ocs2;
+
+namespace {
+using vector3_t = SphereCollisionKernel::vector3_t;
+
+// reference implementation: loop over all sphere pairs
+SphereCollisionKernel::GroupPairDistance bruteForceDistance(const size_array_t& groupOffsets, const std::vector<vector3_t>& centers,
+                                                            const scalar_array_t& radii, size_t group1, size_t group2) {
+  SphereCollisionKernel::GroupPairDistance result;
+  result.distance = std::numeric_limits<scalar_t>::max();
+  for (size_t i = groupOffsets[group1]; i < groupOffsets[group1 + 1]; ++i) {
+    for (size_t j = groupOffsets[group2]; j < groupOffsets[group2 + 1]; ++j) {
+      const scalar_t distance = (centers[j] - centers[i]).norm() - radii[i] - radii[j];
+      if (distance < result.distance) {
+        result.distance = distance;
+        result.sphere1 = i;
+        result.sphere2 = j;
+        result.normal = (centers[j] - centers[i]).normalized();
+      }
+    }
+  }
+  return result;
+}
+}  // unnamed namespace
+
+TEST(SphereCollisionKernel, compareToBruteForce) {
+  const size_array_t numSpheresPerGroup{1, 3, 7, 12};
+  const size_array_t groupOffsets{0, 1, 4, 11, 23};
+  const std::vector<std::pair<size_t, size_t>> groupPairs{{0, 1}, {0, 3}, {1, 2}, {3, 1}, {2, 3}, {3, 2}};
+
+  std::srand(0);
+  scalar_array_t radii(groupOffsets.back());
+  std::vector<vector3_t> centers(groupOffsets.back());
+  for (size_t i = 0; i < radii.size(); ++i) {
+    radii[i] = 0.05 + 0.1 * std::abs(vector_t::Random(1)(0));
+    centers[i] = vector3_t::Random();
+  }
+
+  const SphereCollisionKernel kernel(numSpheresPerGroup, radii, groupPairs);
+  ASSERT_EQ(kernel.getNumSpheres(), radii.size());
+  ASSERT_EQ(kernel.getNumGroupPairs(), groupPairs.size());
+
+  const auto results = kernel.computeDistances(SphereCollisionKernel::packCenters(centers));
+  ASSERT_EQ(results.size(), groupPairs.size());
+  for (size_t k = 0; k < groupPairs.size(); ++k) {
+    const auto expected = bruteForceDistance(groupOffsets, centers, radii, groupPairs[k].first, groupPairs[k].second);
+    EXPECT_NEAR(results[k].distance, expected.distance, 1e-12);
+    EXPECT_EQ(results[k].sphere1, expected.sphere1);
+    EXPECT_EQ(results[k].sphere2, expected.sphere2);
+    EXPECT_TRUE(results[k].normal.isApprox(expected.normal));
+  }
+}
+
+TEST(SphereCollisionKernel, gradient) {
+  const size_array_t numSpheresPerGroup{2, 2};
+  const scalar_array_t radii{0.1, 0.2, 0.3, 0.1};
+  const SphereCollisionKernel kernel(numSpheresPerGroup, radii, {{0, 1}});
+
+  std::vector<vector3_t> centers{vector3_t(0.0, 0.0, 0.0), vector3_t(1.0, 0.0, 0.0), vector3_t(1.0, 1.0, 0.0), vector3_t(3.0, 0.0, 0.0)};
+  const auto result = kernel.computeDistances(SphereCollisionKernel::packCenters(centers)).front();
+  EXPECT_EQ(result.sphere1, 1);
+  EXPECT_EQ(result.sphere2, 2);
+  EXPECT_NEAR(result.distance, 0.5, 1e-12);
+
+  // moving the second sphere along the normal increases the distance by the same amount
+  const scalar_t eps = 1e-6;
+  centers[result.sphere2] += eps * result.normal;
+  const auto perturbedResult = kernel.computeDistances(SphereCollisionKernel::packCenters(centers)).front();
+  EXPECT_NEAR(perturbedResult.distance - result.distance, eps, 1e-9);
+}
+
+TEST(SphereCollisionKernel, invalidGroups) {
+  EXPECT_THROW(SphereCollisionKernel({2, 2}, {0.1, 0.1, 0.1}, {{0, 1}}), std::runtime_error);
+  EXPECT_THROW(SphereCollisionKernel({2, 2}, {0.1, 0.1, 0.1, 0.1}, {{0, 2}}), std::runtime_error);
+  EXPECT_THROW(SphereCollisionKernel({2, 0, 2}, {0.1, 0.1, 0.1, 0.1}, {{0, 1}}), std::runtime_error);
+}
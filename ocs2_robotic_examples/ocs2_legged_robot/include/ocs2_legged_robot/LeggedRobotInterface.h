@@ -37,6 +37,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_ipm/IpmSettings.h>
 #include <ocs2_mpc/MPC_Settings.h>
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+#include <ocs2_pinocchio_interface/PinocchioEndEffectorKinematics.h>
 #include <ocs2_pinocchio_interface/PinocchioInterface.h>
 #include <ocs2_robotic_tools/common/RobotInterface.h>
 #include <ocs2_robotic_tools/end_effector/EndEffectorKinematics.h>
@@ -101,10 +102,25 @@ class LeggedRobotInterface final : public RobotInterface {
   std::unique_ptr<StateInputCost> getFrictionConeSoftConstraint(size_t contactPointIndex, scalar_t frictionCoefficient,
                                                                 const RelaxedBarrierPenalty::Config& barrierPenaltyConfig);
   std::unique_ptr<StateInputConstraint> getZeroForceConstraint(size_t contactPointIndex);
+  // The overloads with PinocchioEndEffectorKinematics read the end-effector kinematics computed by LeggedRobotPreComputation.
   std::unique_ptr<StateInputConstraint> getZeroVelocityConstraint(const EndEffectorKinematics<scalar_t>& eeKinematics,
-                                                                  size_t contactPointIndex, bool useAnalyticalGradients);
+                                                                  size_t contactPointIndex);
+  std::unique_ptr<StateInputConstraint> getZeroVelocityConstraint(const PinocchioEndEffectorKinematics& eeKinematics,
+                                                                  size_t contactPointIndex);
   std::unique_ptr<StateInputConstraint> getNormalVelocityConstraint(const EndEffectorKinematics<scalar_t>& eeKinematics,
-                                                                    size_t contactPointIndex, bool useAnalyticalGradients);
+                                                                    size_t contactPointIndex);
+  std::unique_ptr<StateInputConstraint> getNormalVelocityConstraint(const PinocchioEndEffectorKinematics& eeKinematics,
+                                                                    size_t contactPointIndex);
+
+  /** Computes the foot positions relative to the base in the nominal configuration, in the base frame. */
+  feet_array_t<vector3_t> getNominalFootPositions();
+  RelaxedBarrierPenalty::Config loadFootPlacementSettings(const std::string& taskFile, bool verbose) const;
+  std::unique_ptr<StateInputCost> getFootPlacementSoftConstraint(const EndEffectorKinematics<scalar_t>& eeKinematics,
+                                                                 size_t contactPointIndex,
+                                                                 const RelaxedBarrierPenalty::Config& barrierPenaltyConfig);
+  std::unique_ptr<StateInputCost> getFootPlacementSoftConstraint(const PinocchioEndEffectorKinematics& eeKinematics,
+                                                                 size_t contactPointIndex,
+                                                                 const RelaxedBarrierPenalty::Config& barrierPenaltyConfig);
 
   ModelSettings modelSettings_;
   ddp::Settings ddpSettings_;
@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string>
 
 #include <ocs2_core/PreComputation.h>
+#include <ocs2_pinocchio_interface/PinocchioEndEffectorKinematics.h>
 #include <ocs2_pinocchio_interface/PinocchioInterface.h>
 
 #include <ocs2_centroidal_model/CentroidalModelPinocchioMapping.h>
@@ -47,8 +48,18 @@ namespace legged_robot {
 /** Callback for caching and reference update */
 class LeggedRobotPreComputation : public PreComputation {
  public:
+  /**
+   * Constructor
+   * @param [in] pinocchioInterface : The pinocchio interface.
+   * @param [in] info : The centroidal model information.
+   * @param [in] swingTrajectoryPlanner : The swing trajectory planner.
+   * @param [in] settings : The model settings.
+   * @param [in] computeEndEffectorKinematics : Whether to compute the kinematics of the contact points for the constraints that use
+   *                                            PinocchioEndEffectorKinematics.
+   */
   LeggedRobotPreComputation(PinocchioInterface pinocchioInterface, CentroidalModelInfo info,
-                            const SwingTrajectoryPlanner& swingTrajectoryPlanner, ModelSettings settings);
+                            const SwingTrajectoryPlanner& swingTrajectoryPlanner, ModelSettings settings,
+                            bool computeEndEffectorKinematics = false);
   ~LeggedRobotPreComputation() override = default;
 
   LeggedRobotPreComputation* clone() const override;
@@ -60,11 +71,22 @@ class LeggedRobotPreComputation : public PreComputation {
   PinocchioInterface& getPinocchioInterface() { return pinocchioInterface_; }
   const PinocchioInterface& getPinocchioInterface() const { return pinocchioInterface_; }
 
+  /**
+   * Sets the pinocchio interface and the kinematics of the contact points of this pre-computation to an end-effector kinematics, such
+   * that its getters read the kinematics computed in request() for all contact points in one pass.
+   * @param [out] eeKinematics : The end-effector kinematics of a contact point.
+   * @throw std::runtime_error if computeEndEffectorKinematics was false at construction.
+   */
+  void setEndEffectorKinematics(PinocchioEndEffectorKinematics& eeKinematics) const;
+
  private:
-  LeggedRobotPreComputation(const LeggedRobotPreComputation& other) = default;
+  LeggedRobotPreComputation(const LeggedRobotPreComputation& other);
 
   PinocchioInterface pinocchioInterface_;
   CentroidalModelInfo info_;
+  CentroidalModelPinocchioMapping pinocchioMapping_;
+  std::unique_ptr<PinocchioEndEffectorKinematics> eeKinematicsPtr_;  // nullptr if the kinematics is not computed
+  PinocchioEndEffectorKinematics::Kinematics eeKinematics_;
   const SwingTrajectoryPlanner* swingTrajectoryPlannerPtr_;
   const ModelSettings settings_;
 
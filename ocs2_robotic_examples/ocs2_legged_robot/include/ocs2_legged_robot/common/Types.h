@@ -40,6 +40,7 @@ namespace legged_robot {
 template <typename T>
 using feet_array_t = std::array<T, 4>;
 using contact_flag_t = feet_array_t<bool>;
+using feet_vector_t = Eigen::Matrix<scalar_t, 4, 1>;  // one value per foot
 
 using vector3_t = Eigen::Matrix<scalar_t, 3, 1>;
 using matrix3_t = Eigen::Matrix<scalar_t, 3, 3>;
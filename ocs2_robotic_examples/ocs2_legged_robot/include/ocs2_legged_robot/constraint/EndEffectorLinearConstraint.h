@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/constraint/StateInputConstraint.h>
 
+#include <ocs2_pinocchio_interface/PinocchioEndEffectorKinematics.h>
 #include <ocs2_robotic_tools/end_effector/EndEffectorKinematics.h>
 
 namespace ocs2 {
@@ -73,6 +74,14 @@ class EndEffectorLinearConstraint final : public StateInputConstraint {
   /** Sets a new constraint coefficients. */
   void configure(const Config& config) { this->configure(Config(config)); }
 
+  /**
+   * Replaces the end-effector kinematics by a PinocchioEndEffectorKinematics that reads the kinematics computed by
+   * LeggedRobotPreComputation. Before each evaluation, it is set to the pre-computation with
+   * LeggedRobotPreComputation::setEndEffectorKinematics(). The pre-computation must compute the end-effector kinematics.
+   * @param [in] endEffectorKinematics: The kinematic interface to the target end-effector.
+   */
+  void setPreComputedKinematics(const PinocchioEndEffectorKinematics& endEffectorKinematics);
+
   /** Gets the underlying end-effector kinematics interface. */
   EndEffectorKinematics<scalar_t>& getEndEffectorKinematics() { return *endEffectorKinematicsPtr_; }
 
@@ -85,6 +94,8 @@ class EndEffectorLinearConstraint final : public StateInputConstraint {
   EndEffectorLinearConstraint(const EndEffectorLinearConstraint& rhs);
 
   std::unique_ptr<EndEffectorKinematics<scalar_t>> endEffectorKinematicsPtr_;
+  /** Points to endEffectorKinematicsPtr_ if it reads the kinematics of LeggedRobotPreComputation, otherwise nullptr. */
+  PinocchioEndEffectorKinematics* preComputedKinematicsPtr_ = nullptr;
   const size_t numConstraints_;
   Config config_;
 };
@@ -0,0 +1,85 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/constraint/StateInputConstraint.h>
+
+#include "ocs2_legged_robot/constraint/EndEffectorLinearConstraint.h"
+#include "ocs2_legged_robot/reference_manager/SwitchedModelReferenceManager.h"
+
+namespace ocs2 {
+namespace legged_robot {
+
+/**
+ * Keeps a foot inside the foothold region planned by the FootholdPlanner of the reference manager, with 4 half-space constraints on
+ * the end-effector position. The constraint is only active in the stance phases which have a planned foothold region.
+ *
+ * See also EndEffectorLinearConstraint for the underlying computation.
+ */
+class FootPlacementConstraint final : public StateInputConstraint {
+ public:
+  /**
+   * Constructor
+   * @param [in] referenceManager : Switched model ReferenceManager
+   * @param [in] endEffectorKinematics: The kinematic interface to the target end-effector.
+   * @param [in] contactPointIndex : The 3 DoF contact index.
+   */
+  FootPlacementConstraint(const SwitchedModelReferenceManager& referenceManager,
+                          const EndEffectorKinematics<scalar_t>& endEffectorKinematics, size_t contactPointIndex);
+
+  /**
+   * Constructor for the analytical kinematics. The kinematics of the end-effector is read from LeggedRobotPreComputation, which must
+   * compute the end-effector kinematics. See EndEffectorLinearConstraint::setPreComputedKinematics().
+   * @param [in] referenceManager : Switched model ReferenceManager
+   * @param [in] endEffectorKinematics: The kinematic interface to the target end-effector.
+   * @param [in] contactPointIndex : The 3 DoF contact index.
+   */
+  FootPlacementConstraint(const SwitchedModelReferenceManager& referenceManager,
+                          const PinocchioEndEffectorKinematics& endEffectorKinematics, size_t contactPointIndex);
+
+  ~FootPlacementConstraint() override = default;
+  FootPlacementConstraint* clone() const override { return new FootPlacementConstraint(*this); }
+
+  bool isActive(scalar_t time) const override;
+  size_t getNumConstraints(scalar_t time) const override { return 4; }
+  vector_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp) const override;
+  VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                           const PreComputation& preComp) const override;
+
+ private:
+  FootPlacementConstraint(const FootPlacementConstraint& rhs);
+
+  const SwitchedModelReferenceManager* referenceManagerPtr_;
+  std::unique_ptr<EndEffectorLinearConstraint> eeLinearConstraintPtr_;
+  const size_t contactPointIndex_;
+};
+
+}  // namespace legged_robot
+}  // namespace ocs2
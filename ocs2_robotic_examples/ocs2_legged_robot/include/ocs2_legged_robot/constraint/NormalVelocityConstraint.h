@@ -38,12 +38,12 @@ namespace ocs2 {
 namespace legged_robot {
 
 /**
- * Specializes the CppAd version of normal velocity constraint on an end-effector position and linear velocity.
+ * Specializes the normal velocity constraint on an end-effector position and linear velocity.
  * Constructs the member EndEffectorLinearConstraint object with number of constraints of 1.
  *
  * See also EndEffectorLinearConstraint for the underlying computation.
  */
-class NormalVelocityConstraintCppAd final : public StateInputConstraint {
+class NormalVelocityConstraint final : public StateInputConstraint {
  public:
   /**
    * Constructor
@@ -51,11 +51,21 @@ class NormalVelocityConstraintCppAd final : public StateInputConstraint {
    * @param [in] endEffectorKinematics: The kinematic interface to the target end-effector.
    * @param [in] contactPointIndex : The 3 DoF contact index.
    */
-  NormalVelocityConstraintCppAd(const SwitchedModelReferenceManager& referenceManager,
-                                const EndEffectorKinematics<scalar_t>& endEffectorKinematics, size_t contactPointIndex);
+  NormalVelocityConstraint(const SwitchedModelReferenceManager& referenceManager,
+                           const EndEffectorKinematics<scalar_t>& endEffectorKinematics, size_t contactPointIndex);
 
-  ~NormalVelocityConstraintCppAd() override = default;
-  NormalVelocityConstraintCppAd* clone() const override { return new NormalVelocityConstraintCppAd(*this); }
+  /**
+   * Constructor for the analytical kinematics. The kinematics of the end-effector is read from LeggedRobotPreComputation, which must
+   * compute the end-effector kinematics. See EndEffectorLinearConstraint::setPreComputedKinematics().
+   * @param [in] referenceManager : Switched model ReferenceManager
+   * @param [in] endEffectorKinematics: The kinematic interface to the target end-effector.
+   * @param [in] contactPointIndex : The 3 DoF contact index.
+   */
+  NormalVelocityConstraint(const SwitchedModelReferenceManager& referenceManager,
+                           const PinocchioEndEffectorKinematics& endEffectorKinematics, size_t contactPointIndex);
+
+  ~NormalVelocityConstraint() override = default;
+  NormalVelocityConstraint* clone() const override { return new NormalVelocityConstraint(*this); }
 
   bool isActive(scalar_t time) const override;
   size_t getNumConstraints(scalar_t time) const override { return 1; }
@@ -64,7 +74,7 @@ class NormalVelocityConstraintCppAd final : public StateInputConstraint {
                                                            const PreComputation& preComp) const override;
 
  private:
-  NormalVelocityConstraintCppAd(const NormalVelocityConstraintCppAd& rhs);
+  NormalVelocityConstraint(const NormalVelocityConstraint& rhs);
 
   const SwitchedModelReferenceManager* referenceManagerPtr_;
   std::unique_ptr<EndEffectorLinearConstraint> eeLinearConstraintPtr_;
@@ -38,12 +38,12 @@ namespace ocs2 {
 namespace legged_robot {
 
 /**
- * Specializes the CppAd version of zero velocity constraint on an end-effector position and linear velocity.
+ * Specializes the zero velocity constraint on an end-effector position and linear velocity.
  * Constructs the member EndEffectorLinearConstraint object with number of constraints of 3.
  *
  * See also EndEffectorLinearConstraint for the underlying computation.
  */
-class ZeroVelocityConstraintCppAd final : public StateInputConstraint {
+class ZeroVelocityConstraint final : public StateInputConstraint {
  public:
   /**
    * Constructor
@@ -52,12 +52,24 @@ class ZeroVelocityConstraintCppAd final : public StateInputConstraint {
    * @param [in] contactPointIndex : The 3 DoF contact index.
    * @param [in] config: The constraint coefficients
    */
-  ZeroVelocityConstraintCppAd(const SwitchedModelReferenceManager& referenceManager,
-                              const EndEffectorKinematics<scalar_t>& endEffectorKinematics, size_t contactPointIndex,
-                              EndEffectorLinearConstraint::Config config = EndEffectorLinearConstraint::Config());
+  ZeroVelocityConstraint(const SwitchedModelReferenceManager& referenceManager,
+                         const EndEffectorKinematics<scalar_t>& endEffectorKinematics, size_t contactPointIndex,
+                         EndEffectorLinearConstraint::Config config = EndEffectorLinearConstraint::Config());
 
-  ~ZeroVelocityConstraintCppAd() override = default;
-  ZeroVelocityConstraintCppAd* clone() const override { return new ZeroVelocityConstraintCppAd(*this); }
+  /**
+   * Constructor for the analytical kinematics. The kinematics of the end-effector is read from LeggedRobotPreComputation, which must
+   * compute the end-effector kinematics. See EndEffectorLinearConstraint::setPreComputedKinematics().
+   * @param [in] referenceManager : Switched model ReferenceManager
+   * @param [in] endEffectorKinematics: The kinematic interface to the target end-effector.
+   * @param [in] contactPointIndex : The 3 DoF contact index.
+   * @param [in] config: The constraint coefficients
+   */
+  ZeroVelocityConstraint(const SwitchedModelReferenceManager& referenceManager,
+                         const PinocchioEndEffectorKinematics& endEffectorKinematics, size_t contactPointIndex,
+                         EndEffectorLinearConstraint::Config config = EndEffectorLinearConstraint::Config());
+
+  ~ZeroVelocityConstraint() override = default;
+  ZeroVelocityConstraint* clone() const override { return new ZeroVelocityConstraint(*this); }
 
   bool isActive(scalar_t time) const override;
   size_t getNumConstraints(scalar_t time) const override { return 3; }
@@ -66,7 +78,7 @@ class ZeroVelocityConstraintCppAd final : public StateInputConstraint {
                                                            const PreComputation& preComp) const override;
 
  private:
-  ZeroVelocityConstraintCppAd(const ZeroVelocityConstraintCppAd& rhs);
+  ZeroVelocityConstraint(const ZeroVelocityConstraint& rhs);
 
   const SwitchedModelReferenceManager* referenceManagerPtr_;
   std::unique_ptr<EndEffectorLinearConstraint> eeLinearConstraintPtr_;
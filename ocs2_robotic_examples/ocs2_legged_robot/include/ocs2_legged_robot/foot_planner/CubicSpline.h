@@ -54,6 +54,9 @@ class CubicSpline {
 
   scalar_t finalTimeDerivative(scalar_t t) const;
 
+  /** Gets the coefficients {a0, a1, a2, a3} of the spline written as a0 + a1 * s + a2 * s^2 + a3 * s^3, with s = time - origin. */
+  Eigen::Matrix<scalar_t, 4, 1> getCoefficients(scalar_t origin) const;
+
  private:
   scalar_t normalizedTime(scalar_t t) const;
 
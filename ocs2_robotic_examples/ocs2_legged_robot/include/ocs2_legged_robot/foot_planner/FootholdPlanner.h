@@ -0,0 +1,110 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_centroidal_model/CentroidalModelInfo.h>
+#include <ocs2_core/reference/ModeSchedule.h>
+#include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_perceptive/terrain/SegmentedTerrainMap.h>
+
+#include "ocs2_legged_robot/common/Types.h"
+#include "ocs2_legged_robot/constraint/EndEffectorLinearConstraint.h"
+
+namespace ocs2 {
+namespace legged_robot {
+
+/**
+ * Plans the footholds of the stance phases on a SegmentedTerrainMap.
+ *
+ * The nominal foothold of a stance phase is the nominal foot position under the reference base pose in the middle of the phase. It is
+ * moved to the closest foothold region of the map, which gives the terrain height of the phase and a box constraint on the position of
+ * the foot. The heights are used by the SwingTrajectoryPlanner and the constraints by FootPlacementConstraint.
+ *
+ * The map is only queried in update(), once per MPC iteration. The nodes look up the constraint of their phase.
+ */
+class FootholdPlanner {
+ public:
+  struct Config {
+    scalar_t regionMargin = 0.02;  // the foothold regions are shrunk by this margin [m]
+  };
+
+  /**
+   * Constructor
+   * @param [in] config : The planner configuration.
+   * @param [in] info : The centroidal model information.
+   * @param [in] nominalFootPositions : The nominal position of each foot relative to the base, in the base frame.
+   */
+  FootholdPlanner(Config config, CentroidalModelInfo info, feet_array_t<vector3_t> nominalFootPositions);
+
+  /**
+   * Plans the footholds of the mode schedule.
+   *
+   * @param [in] initTime : Start time of the optimization horizon. The stance phases which start before it are not constrained.
+   * @param [in] modeSchedule : The mode schedule.
+   * @param [in] targetTrajectories : The target trajectories, which contain the reference base pose.
+   * @param [in] terrainMap : The segmented terrain map.
+   */
+  void update(scalar_t initTime, const ModeSchedule& modeSchedule, const TargetTrajectories& targetTrajectories,
+              const SegmentedTerrainMap& terrainMap);
+
+  /** Removes the planned footholds. */
+  void reset();
+
+  /** Gets the terrain height at lift-off of each phase, see SwingTrajectoryPlanner::update(). */
+  const feet_array_t<scalar_array_t>& getLiftOffHeightSequence() const { return liftOffHeightSequence_; }
+
+  /** Gets the terrain height at touch-down of each phase, see SwingTrajectoryPlanner::update(). */
+  const feet_array_t<scalar_array_t>& getTouchDownHeightSequence() const { return touchDownHeightSequence_; }
+
+  /**
+   * Gets the constraint on the position of a foot, g(xee) = Ax * xee + b >= 0.
+   * @return nullptr if the foot is not constrained at the given time.
+   */
+  const EndEffectorLinearConstraint::Config* getFootPlacementConstraintConfig(size_t leg, scalar_t time) const;
+
+ private:
+  /** Gets the nominal foothold of a foot in the world frame. */
+  vector3_t getNominalFoothold(size_t leg, scalar_t time, const TargetTrajectories& targetTrajectories) const;
+
+  const Config config_;
+  const CentroidalModelInfo info_;
+  const feet_array_t<vector3_t> nominalFootPositions_;
+
+  scalar_array_t eventTimes_;
+  feet_array_t<std::vector<EndEffectorLinearConstraint::Config>> footPlacementConstraintConfigs_;  // empty config if not constrained
+  feet_array_t<scalar_array_t> liftOffHeightSequence_;
+  feet_array_t<scalar_array_t> touchDownHeightSequence_;
+};
+
+FootholdPlanner::Config loadFootholdPlannerSettings(const std::string& fileName, const std::string& fieldName = "foothold_planner",
+                                                    bool verbose = true);
+
+}  // namespace legged_robot
+}  // namespace ocs2
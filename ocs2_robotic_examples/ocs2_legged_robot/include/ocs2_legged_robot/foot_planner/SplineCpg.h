@@ -48,6 +48,14 @@ class SplineCpg {
 
   scalar_t finalTimeDerivative(scalar_t time) const;
 
+  /** Gets the time at which the two cubic splines meet. */
+  scalar_t midTime() const { return midTime_; }
+
+  /** Gets the coefficients of the cubic spline which is active at the given time, see CubicSpline::getCoefficients(). */
+  Eigen::Matrix<scalar_t, 4, 1> getCoefficients(scalar_t time, scalar_t origin) const {
+    return (time < midTime_) ? leftSpline_.getCoefficients(origin) : rightSpline_.getCoefficients(origin);
+  }
+
  private:
   scalar_t midTime_;
   CubicSpline leftSpline_;
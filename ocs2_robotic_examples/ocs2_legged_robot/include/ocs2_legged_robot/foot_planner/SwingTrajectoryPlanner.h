@@ -57,7 +57,21 @@ class SwingTrajectoryPlanner {
 
   scalar_t getZpositionConstraint(size_t leg, scalar_t time) const;
 
+  /**
+   * Evaluates the height references of all feet at once. The splines are tabulated once per update as piecewise cubic polynomials
+   * between the event times and the swing apexes, such that this call is a single lookup followed by a polynomial evaluation for all
+   * feet. The result is the same as calling getZpositionConstraint() and getZvelocityConstraint() for each foot.
+   *
+   * @param [in] time : The query time.
+   * @param [out] positions : The height reference of each foot.
+   * @param [out] velocities : The vertical velocity reference of each foot.
+   */
+  void getZReferences(scalar_t time, feet_vector_t& positions, feet_vector_t& velocities) const;
+
  private:
+  /** Tabulates the coefficients of feetHeightTrajectories_ between the breakpoints of all feet. */
+  void updateZReferenceTable(const scalar_array_t& eventTimes);
+
   /**
    * Extracts for each leg the contact sequence over the motion phase sequence.
    * @param phaseIDsStock
@@ -105,6 +119,12 @@ class SwingTrajectoryPlanner {
 
   feet_array_t<std::vector<SplineCpg>> feetHeightTrajectories_;
   feet_array_t<std::vector<scalar_t>> feetHeightTrajectoriesEvents_;
+
+  // Interval k covers (breakpoints[k-1], breakpoints[k]]. Its height references are coefficients[k] * [1, s, s^2, s^3]^T with
+  // s = time - origins[k], where the rows of coefficients[k] are the feet.
+  scalar_array_t zReferenceBreakpoints_;
+  scalar_array_t zReferenceOrigins_;
+  std::vector<Eigen::Matrix<scalar_t, 4, 4>, Eigen::aligned_allocator<Eigen::Matrix<scalar_t, 4, 4>>> zReferenceCoefficients_;
 };
 
 SwingTrajectoryPlanner::Config loadSwingTrajectorySettings(const std::string& fileName,
@@ -29,9 +29,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <ocs2_core/thread_support/BufferedValue.h>
 #include <ocs2_core/thread_support/Synchronized.h>
 #include <ocs2_oc/synchronized_module/ReferenceManager.h>
+#include <ocs2_perceptive/terrain/SegmentedTerrainMap.h>
 
+#include "ocs2_legged_robot/foot_planner/FootholdPlanner.h"
 #include "ocs2_legged_robot/foot_planner/SwingTrajectoryPlanner.h"
 #include "ocs2_legged_robot/gait/GaitSchedule.h"
 #include "ocs2_legged_robot/gait/MotionPhaseDefinition.h"
@@ -41,27 +44,65 @@ namespace legged_robot {
 
 /**
  * Manages the ModeSchedule and the TargetTrajectories for switched model.
+ *
+ * Without a terrain map, the swing trajectories are planned for flat ground. Once a map is set with setTerrainMap(), the footholds
+ * are planned on it by the FootholdPlanner at the start of each MPC iteration.
+ *
+ * The mode schedule is taken from the GaitSchedule, which is also changed without setModeSchedule(), e.g., by a gait command that
+ * inserts a ModeSequenceTemplate. The input mode schedule (see getInputModeSchedule()) is therefore the mode schedule that the
+ * GaitSchedule provided for the last solver run, and it counts as updated whenever that schedule changes. Setting it again with
+ * setModeSchedule() reproduces the same mode schedule, such that a ClosedLoopRecorder recording replays the gait changes.
  */
 class SwitchedModelReferenceManager : public ReferenceManager {
  public:
-  SwitchedModelReferenceManager(std::shared_ptr<GaitSchedule> gaitSchedulePtr, std::shared_ptr<SwingTrajectoryPlanner> swingTrajectoryPtr);
+  /**
+   * Constructor
+   * @param [in] gaitSchedulePtr : The gait schedule.
+   * @param [in] swingTrajectoryPtr : The swing trajectory planner.
+   * @param [in] footholdPlannerPtr : The foothold planner. Pass nullptr to ignore the terrain map.
+   */
+  SwitchedModelReferenceManager(std::shared_ptr<GaitSchedule> gaitSchedulePtr, std::shared_ptr<SwingTrajectoryPlanner> swingTrajectoryPtr,
+                                std::shared_ptr<FootholdPlanner> footholdPlannerPtr = nullptr);
 
   ~SwitchedModelReferenceManager() override = default;
 
   void setModeSchedule(const ModeSchedule& modeSchedule) override;
 
+  const ModeSchedule& getInputModeSchedule() const override { return gaitModeSchedule_; }
+  size_t getNumModeScheduleUpdates() const override { return numGaitModeScheduleUpdates_; }
+
   contact_flag_t getContactFlags(scalar_t time) const;
 
   const std::shared_ptr<GaitSchedule>& getGaitSchedule() { return gaitSchedulePtr_; }
 
   const std::shared_ptr<SwingTrajectoryPlanner>& getSwingTrajectoryPlanner() { return swingTrajectoryPtr_; }
 
+  /**
+   * Sets the terrain map which is used from the next MPC iteration on. Pass nullptr to go back to flat ground. This method is
+   * thread-safe.
+   */
+  void setTerrainMap(std::shared_ptr<const SegmentedTerrainMap> terrainMapPtr) { terrainMapPtr_.setBuffer(std::move(terrainMapPtr)); }
+
+  /**
+   * Gets the planned foothold constraint of a foot.
+   * @return nullptr if the foot is not constrained at the given time.
+   */
+  const EndEffectorLinearConstraint::Config* getFootPlacementConstraintConfig(size_t leg, scalar_t time) const {
+    return footholdPlannerPtr_ != nullptr ? footholdPlannerPtr_->getFootPlacementConstraintConfig(leg, time) : nullptr;
+  }
+
  private:
   void modifyReferences(scalar_t initTime, scalar_t finalTime, const vector_t& initState, TargetTrajectories& targetTrajectories,
                         ModeSchedule& modeSchedule) override;
 
   std::shared_ptr<GaitSchedule> gaitSchedulePtr_;
   std::shared_ptr<SwingTrajectoryPlanner> swingTrajectoryPtr_;
+  std::shared_ptr<FootholdPlanner> footholdPlannerPtr_;
+  BufferedValue<std::shared_ptr<const SegmentedTerrainMap>> terrainMapPtr_;
+
+  // The mode schedule of the GaitSchedule in the last solver run
+  ModeSchedule gaitModeSchedule_;
+  size_t numGaitModeScheduleUpdates_ = 0;
 };
 
 }  // namespace legged_robot
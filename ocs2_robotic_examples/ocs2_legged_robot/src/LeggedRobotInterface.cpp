@@ -44,14 +44,18 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/misc/Display.h>
 #include <ocs2_core/soft_constraint/StateInputSoftConstraint.h>
 #include <ocs2_oc/synchronized_module/SolverSynchronizedModule.h>
+#include <ocs2_pinocchio_interface/PinocchioEndEffectorKinematics.h>
 #include <ocs2_pinocchio_interface/PinocchioEndEffectorKinematicsCppAd.h>
+#include <ocs2_robotic_tools/common/RotationTransforms.h>
 
 #include "ocs2_legged_robot/LeggedRobotPreComputation.h"
+#include "ocs2_legged_robot/constraint/FootPlacementConstraint.h"
 #include "ocs2_legged_robot/constraint/FrictionConeConstraint.h"
-#include "ocs2_legged_robot/constraint/NormalVelocityConstraintCppAd.h"
+#include "ocs2_legged_robot/constraint/NormalVelocityConstraint.h"
 #include "ocs2_legged_robot/constraint/ZeroForceConstraint.h"
-#include "ocs2_legged_robot/constraint/ZeroVelocityConstraintCppAd.h"
+#include "ocs2_legged_robot/constraint/ZeroVelocityConstraint.h"
 #include "ocs2_legged_robot/cost/LeggedRobotQuadraticTrackingCost.h"
+#include "ocs2_legged_robot/dynamics/LeggedRobotDynamics.h"
 #include "ocs2_legged_robot/dynamics/LeggedRobotDynamicsAD.h"
 
 // Boost
@@ -61,6 +65,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 namespace legged_robot {
 
+namespace {
+EndEffectorLinearConstraint::Config getZeroVelocityConstraintConfig(scalar_t positionErrorGain) {
+  EndEffectorLinearConstraint::Config config;
+  config.b.setZero(3);
+  config.Av.setIdentity(3, 3);
+  if (!numerics::almost_eq(positionErrorGain, 0.0)) {
+    config.Ax.setZero(3, 3);
+    config.Ax(2, 2) = positionErrorGain;
+  }
+  return config;
+}
+}  // namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -126,9 +143,13 @@ void LeggedRobotInterface::setupOptimalConrolProblem(const std::string& taskFile
   auto swingTrajectoryPlanner =
       std::make_unique<SwingTrajectoryPlanner>(loadSwingTrajectorySettings(taskFile, "swing_trajectory_config", verbose), 4);
 
+  // Foothold planner, used once a terrain map is set
+  auto footholdPlanner = std::make_unique<FootholdPlanner>(loadFootholdPlannerSettings(taskFile, "foothold_planner", verbose),
+                                                           centroidalModelInfo_, getNominalFootPositions());
+
   // Mode schedule manager
-  referenceManagerPtr_ =
-      std::make_shared<SwitchedModelReferenceManager>(loadGaitSchedule(referenceFile, verbose), std::move(swingTrajectoryPlanner));
+  referenceManagerPtr_ = std::make_shared<SwitchedModelReferenceManager>(
+      loadGaitSchedule(referenceFile, verbose), std::move(swingTrajectoryPlanner), std::move(footholdPlanner));
 
   // Optimal control problem
   problemPtr_.reset(new OptimalControlProblem);
@@ -138,7 +159,7 @@ void LeggedRobotInterface::setupOptimalConrolProblem(const std::string& taskFile
   loadData::loadCppDataType(taskFile, "legged_robot_interface.useAnalyticalGradientsDynamics", useAnalyticalGradientsDynamics);
   std::unique_ptr<SystemDynamicsBase> dynamicsPtr;
   if (useAnalyticalGradientsDynamics) {
-    throw std::runtime_error("[LeggedRobotInterface::setupOptimalConrolProblem] The analytical dynamics class is not yet implemented!");
+    dynamicsPtr.reset(new LeggedRobotDynamics(*pinocchioInterfacePtr_, centroidalModelInfo_));
   } else {
     const std::string modelName = "dynamics";
     dynamicsPtr.reset(new LeggedRobotDynamicsAD(*pinocchioInterfacePtr_, centroidalModelInfo_, modelName, modelSettings_));
@@ -154,16 +175,29 @@ void LeggedRobotInterface::setupOptimalConrolProblem(const std::string& taskFile
   scalar_t frictionCoefficient = 0.7;
   RelaxedBarrierPenalty::Config barrierPenaltyConfig;
   std::tie(frictionCoefficient, barrierPenaltyConfig) = loadFrictionConeSettings(taskFile, verbose);
+  const auto footPlacementBarrierPenaltyConfig = loadFootPlacementSettings(taskFile, verbose);
 
   bool useAnalyticalGradientsConstraints = false;
   loadData::loadCppDataType(taskFile, "legged_robot_interface.useAnalyticalGradientsConstraints", useAnalyticalGradientsConstraints);
   for (size_t i = 0; i < centroidalModelInfo_.numThreeDofContacts; i++) {
     const std::string& footName = modelSettings_.contactNames3DoF[i];
 
-    std::unique_ptr<EndEffectorKinematics<scalar_t>> eeKinematicsPtr;
+    if (useHardFrictionConeConstraint_) {
+      problemPtr_->inequalityConstraintPtr->add(footName + "_frictionCone", getFrictionConeConstraint(i, frictionCoefficient));
+    } else {
+      problemPtr_->softConstraintPtr->add(footName + "_frictionCone",
+                                          getFrictionConeSoftConstraint(i, frictionCoefficient, barrierPenaltyConfig));
+    }
+    problemPtr_->equalityConstraintPtr->add(footName + "_zeroForce", getZeroForceConstraint(i));
+
     if (useAnalyticalGradientsConstraints) {
-      throw std::runtime_error(
-          "[LeggedRobotInterface::setupOptimalConrolProblem] The analytical end-effector linear constraint is not implemented!");
+      // the kinematics of all feet is computed in one pass by LeggedRobotPreComputation
+      const CentroidalModelPinocchioMapping pinocchioMapping(centroidalModelInfo_);
+      const PinocchioEndEffectorKinematics eeKinematics(*pinocchioInterfacePtr_, pinocchioMapping, {footName});
+      problemPtr_->equalityConstraintPtr->add(footName + "_zeroVelocity", getZeroVelocityConstraint(eeKinematics, i));
+      problemPtr_->equalityConstraintPtr->add(footName + "_normalVelocity", getNormalVelocityConstraint(eeKinematics, i));
+      problemPtr_->softConstraintPtr->add(footName + "_footPlacement",
+                                          getFootPlacementSoftConstraint(eeKinematics, i, footPlacementBarrierPenaltyConfig));
     } else {
       const auto infoCppAd = centroidalModelInfo_.toCppAd();
       const CentroidalModelPinocchioMappingCppAd pinocchioMappingCppAd(infoCppAd);
@@ -171,28 +205,21 @@ void LeggedRobotInterface::setupOptimalConrolProblem(const std::string& taskFile
         const ad_vector_t q = centroidal_model::getGeneralizedCoordinates(state, infoCppAd);
         updateCentroidalDynamics(pinocchioInterfaceAd, infoCppAd, q);
       };
-      eeKinematicsPtr.reset(new PinocchioEndEffectorKinematicsCppAd(*pinocchioInterfacePtr_, pinocchioMappingCppAd, {footName},
-                                                                    centroidalModelInfo_.stateDim, centroidalModelInfo_.inputDim,
-                                                                    velocityUpdateCallback, footName, modelSettings_.modelFolderCppAd,
-                                                                    modelSettings_.recompileLibrariesCppAd, modelSettings_.verboseCppAd));
-    }
-
-    if (useHardFrictionConeConstraint_) {
-      problemPtr_->inequalityConstraintPtr->add(footName + "_frictionCone", getFrictionConeConstraint(i, frictionCoefficient));
-    } else {
-      problemPtr_->softConstraintPtr->add(footName + "_frictionCone",
-                                          getFrictionConeSoftConstraint(i, frictionCoefficient, barrierPenaltyConfig));
+      const PinocchioEndEffectorKinematicsCppAd eeKinematics(*pinocchioInterfacePtr_, pinocchioMappingCppAd, {footName},
+                                                             centroidalModelInfo_.stateDim, centroidalModelInfo_.inputDim,
+                                                             velocityUpdateCallback, footName, modelSettings_.modelFolderCppAd,
+                                                             modelSettings_.recompileLibrariesCppAd, modelSettings_.verboseCppAd);
+      problemPtr_->equalityConstraintPtr->add(footName + "_zeroVelocity", getZeroVelocityConstraint(eeKinematics, i));
+      problemPtr_->equalityConstraintPtr->add(footName + "_normalVelocity", getNormalVelocityConstraint(eeKinematics, i));
+      problemPtr_->softConstraintPtr->add(footName + "_footPlacement",
+                                          getFootPlacementSoftConstraint(eeKinematics, i, footPlacementBarrierPenaltyConfig));
     }
-    problemPtr_->equalityConstraintPtr->add(footName + "_zeroForce", getZeroForceConstraint(i));
-    problemPtr_->equalityConstraintPtr->add(footName + "_zeroVelocity",
-                                            getZeroVelocityConstraint(*eeKinematicsPtr, i, useAnalyticalGradientsConstraints));
-    problemPtr_->equalityConstraintPtr->add(footName + "_normalVelocity",
-                                            getNormalVelocityConstraint(*eeKinematicsPtr, i, useAnalyticalGradientsConstraints));
   }
 
   // Pre-computation
   problemPtr_->preComputationPtr.reset(new LeggedRobotPreComputation(*pinocchioInterfacePtr_, centroidalModelInfo_,
-                                                                     *referenceManagerPtr_->getSwingTrajectoryPlanner(), modelSettings_));
+                                                                     *referenceManagerPtr_->getSwingTrajectoryPlanner(), modelSettings_,
+                                                                     useAnalyticalGradientsConstraints));
 
   // Rollout
   rolloutPtr_.reset(new TimeTriggeredRollout(*problemPtr_->dynamicsPtr, rolloutSettings_));
@@ -344,40 +371,99 @@ std::unique_ptr<StateInputConstraint> LeggedRobotInterface::getZeroForceConstrai
 /******************************************************************************************************/
 /******************************************************************************************************/
 std::unique_ptr<StateInputConstraint> LeggedRobotInterface::getZeroVelocityConstraint(const EndEffectorKinematics<scalar_t>& eeKinematics,
-                                                                                      size_t contactPointIndex,
-                                                                                      bool useAnalyticalGradients) {
-  auto eeZeroVelConConfig = [](scalar_t positionErrorGain) {
-    EndEffectorLinearConstraint::Config config;
-    config.b.setZero(3);
-    config.Av.setIdentity(3, 3);
-    if (!numerics::almost_eq(positionErrorGain, 0.0)) {
-      config.Ax.setZero(3, 3);
-      config.Ax(2, 2) = positionErrorGain;
-    }
-    return config;
-  };
+                                                                                      size_t contactPointIndex) {
+  return std::make_unique<ZeroVelocityConstraint>(*referenceManagerPtr_, eeKinematics, contactPointIndex,
+                                                  getZeroVelocityConstraintConfig(modelSettings_.positionErrorGain));
+}
 
-  if (useAnalyticalGradients) {
-    throw std::runtime_error(
-        "[LeggedRobotInterface::getZeroVelocityConstraint] The analytical end-effector zero velocity constraint is not implemented!");
-  } else {
-    return std::make_unique<ZeroVelocityConstraintCppAd>(*referenceManagerPtr_, eeKinematics, contactPointIndex,
-                                                         eeZeroVelConConfig(modelSettings_.positionErrorGain));
-  }
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<StateInputConstraint> LeggedRobotInterface::getZeroVelocityConstraint(const PinocchioEndEffectorKinematics& eeKinematics,
+                                                                                      size_t contactPointIndex) {
+  return std::make_unique<ZeroVelocityConstraint>(*referenceManagerPtr_, eeKinematics, contactPointIndex,
+                                                  getZeroVelocityConstraintConfig(modelSettings_.positionErrorGain));
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 std::unique_ptr<StateInputConstraint> LeggedRobotInterface::getNormalVelocityConstraint(const EndEffectorKinematics<scalar_t>& eeKinematics,
-                                                                                        size_t contactPointIndex,
-                                                                                        bool useAnalyticalGradients) {
-  if (useAnalyticalGradients) {
-    throw std::runtime_error(
-        "[LeggedRobotInterface::getNormalVelocityConstraint] The analytical end-effector normal velocity constraint is not implemented!");
-  } else {
-    return std::make_unique<NormalVelocityConstraintCppAd>(*referenceManagerPtr_, eeKinematics, contactPointIndex);
+                                                                                        size_t contactPointIndex) {
+  return std::make_unique<NormalVelocityConstraint>(*referenceManagerPtr_, eeKinematics, contactPointIndex);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<StateInputConstraint> LeggedRobotInterface::getNormalVelocityConstraint(const PinocchioEndEffectorKinematics& eeKinematics,
+                                                                                        size_t contactPointIndex) {
+  return std::make_unique<NormalVelocityConstraint>(*referenceManagerPtr_, eeKinematics, contactPointIndex);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+feet_array_t<vector3_t> LeggedRobotInterface::getNominalFootPositions() {
+  const auto& model = pinocchioInterfacePtr_->getModel();
+  auto& data = pinocchioInterfacePtr_->getData();
+  const vector_t& qNominal = centroidalModelInfo_.qPinocchioNominal;
+  pinocchio::forwardKinematics(model, data, qNominal);
+  pinocchio::updateFramePlacements(model, data);
+
+  // the base of the nominal configuration is not at the origin, e.g., it stands at its nominal height
+  const vector3_t basePosition = qNominal.head<3>();
+  const matrix3_t baseRotation = getRotationMatrixFromZyxEulerAngles<scalar_t>(qNominal.segment<3>(3));
+  feet_array_t<vector3_t> nominalFootPositions;
+  for (size_t i = 0; i < centroidalModelInfo_.numThreeDofContacts; i++) {
+    const vector3_t footPosition = data.oMf[centroidalModelInfo_.endEffectorFrameIndices[i]].translation();
+    nominalFootPositions[i] = baseRotation.transpose() * (footPosition - basePosition);
   }
+  return nominalFootPositions;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+RelaxedBarrierPenalty::Config LeggedRobotInterface::loadFootPlacementSettings(const std::string& taskFile, bool verbose) const {
+  boost::property_tree::ptree pt;
+  boost::property_tree::read_info(taskFile, pt);
+  const std::string prefix = "footPlacementSoftConstraint.";
+
+  RelaxedBarrierPenalty::Config barrierPenaltyConfig;
+  if (verbose) {
+    std::cerr << "\n #### Foot Placement Settings: ";
+    std::cerr << "\n #### =============================================================================\n";
+  }
+  loadData::loadPtreeValue(pt, barrierPenaltyConfig.mu, prefix + "mu", verbose);
+  loadData::loadPtreeValue(pt, barrierPenaltyConfig.delta, prefix + "delta", verbose);
+  if (verbose) {
+    std::cerr << " #### =============================================================================\n";
+  }
+
+  return barrierPenaltyConfig;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<StateInputCost> LeggedRobotInterface::getFootPlacementSoftConstraint(
+    const EndEffectorKinematics<scalar_t>& eeKinematics, size_t contactPointIndex,
+    const RelaxedBarrierPenalty::Config& barrierPenaltyConfig) {
+  return std::make_unique<StateInputSoftConstraint>(
+      std::make_unique<FootPlacementConstraint>(*referenceManagerPtr_, eeKinematics, contactPointIndex),
+      std::make_unique<RelaxedBarrierPenalty>(barrierPenaltyConfig));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<StateInputCost> LeggedRobotInterface::getFootPlacementSoftConstraint(
+    const PinocchioEndEffectorKinematics& eeKinematics, size_t contactPointIndex,
+    const RelaxedBarrierPenalty::Config& barrierPenaltyConfig) {
+  return std::make_unique<StateInputSoftConstraint>(
+      std::make_unique<FootPlacementConstraint>(*referenceManagerPtr_, eeKinematics, contactPointIndex),
+      std::make_unique<RelaxedBarrierPenalty>(barrierPenaltyConfig));
 }
 
 }  // namespace legged_robot
@@ -31,8 +31,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <pinocchio/algorithm/frames.hpp>
 #include <pinocchio/algorithm/jacobian.hpp>
+#include <pinocchio/algorithm/kinematics-derivatives.hpp>
 #include <pinocchio/algorithm/kinematics.hpp>
 
+#include <ocs2_centroidal_model/ModelHelperFunctions.h>
 #include <ocs2_core/misc/Numerics.h>
 
 #include <ocs2_legged_robot/LeggedRobotPreComputation.h>
@@ -44,12 +46,41 @@ namespace legged_robot {
 /******************************************************************************************************/
 /******************************************************************************************************/
 LeggedRobotPreComputation::LeggedRobotPreComputation(PinocchioInterface pinocchioInterface, CentroidalModelInfo info,
-                                                     const SwingTrajectoryPlanner& swingTrajectoryPlanner, ModelSettings settings)
+                                                     const SwingTrajectoryPlanner& swingTrajectoryPlanner, ModelSettings settings,
+                                                     bool computeEndEffectorKinematics)
     : pinocchioInterface_(std::move(pinocchioInterface)),
       info_(std::move(info)),
+      pinocchioMapping_(info_),
       swingTrajectoryPlannerPtr_(&swingTrajectoryPlanner),
       settings_(std::move(settings)) {
-  eeNormalVelConConfigs_.resize(info_.numThreeDofContacts);
+  // only the offsets of the normal velocity constraints depend on time
+  EndEffectorLinearConstraint::Config config;
+  config.b = vector_t::Zero(1);
+  config.Av = (matrix_t(1, 3) << 0.0, 0.0, 1.0).finished();
+  if (!numerics::almost_eq(settings_.positionErrorGain, 0.0)) {
+    config.Ax = (matrix_t(1, 3) << 0.0, 0.0, settings_.positionErrorGain).finished();
+  }
+  eeNormalVelConConfigs_.assign(info_.numThreeDofContacts, config);
+
+  pinocchioMapping_.setPinocchioInterface(pinocchioInterface_);
+  if (computeEndEffectorKinematics) {
+    eeKinematicsPtr_.reset(new PinocchioEndEffectorKinematics(pinocchioInterface_, pinocchioMapping_, settings_.contactNames3DoF));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LeggedRobotPreComputation::LeggedRobotPreComputation(const LeggedRobotPreComputation& other)
+    : PreComputation(other),
+      pinocchioInterface_(other.pinocchioInterface_),
+      info_(other.info_),
+      pinocchioMapping_(other.pinocchioMapping_),
+      eeKinematicsPtr_(other.eeKinematicsPtr_ != nullptr ? other.eeKinematicsPtr_->clone() : nullptr),
+      swingTrajectoryPlannerPtr_(other.swingTrajectoryPlannerPtr_),
+      settings_(other.settings_),
+      eeNormalVelConConfigs_(other.eeNormalVelConConfigs_) {
+  pinocchioMapping_.setPinocchioInterface(pinocchioInterface_);
 }
 
 /******************************************************************************************************/
@@ -67,23 +98,48 @@ void LeggedRobotPreComputation::request(RequestSet request, scalar_t t, const ve
     return;
   }
 
-  // lambda to set config for normal velocity constraints
-  auto eeNormalVelConConfig = [&](size_t footIndex) {
-    EndEffectorLinearConstraint::Config config;
-    config.b = (vector_t(1) << -swingTrajectoryPlannerPtr_->getZvelocityConstraint(footIndex, t)).finished();
-    config.Av = (matrix_t(1, 3) << 0.0, 0.0, 1.0).finished();
-    if (!numerics::almost_eq(settings_.positionErrorGain, 0.0)) {
-      config.b(0) -= settings_.positionErrorGain * swingTrajectoryPlannerPtr_->getZpositionConstraint(footIndex, t);
-      config.Ax = (matrix_t(1, 3) << 0.0, 0.0, settings_.positionErrorGain).finished();
-    }
-    return config;
-  };
-
+  // height references of all feet from the swing trajectory table
   if (request.contains(Request::Constraint)) {
+    feet_vector_t zPositions, zVelocities;
+    swingTrajectoryPlannerPtr_->getZReferences(t, zPositions, zVelocities);
+    const bool hasPositionError = !numerics::almost_eq(settings_.positionErrorGain, 0.0);
     for (size_t i = 0; i < info_.numThreeDofContacts; i++) {
-      eeNormalVelConConfigs_[i] = eeNormalVelConConfig(i);
+      eeNormalVelConConfigs_[i].b(0) = -zVelocities(i);
+      if (hasPositionError) {
+        eeNormalVelConConfigs_[i].b(0) -= settings_.positionErrorGain * zPositions(i);
+      }
     }
   }
+
+  // kinematics of all contact points in one pass
+  if (eeKinematicsPtr_ != nullptr && request.containsAny(Request::Constraint + Request::SoftConstraint)) {
+    const auto& model = pinocchioInterface_.getModel();
+    auto& data = pinocchioInterface_.getData();
+    const vector_t q = pinocchioMapping_.getPinocchioJointPosition(x);
+    // the generalized velocities depend on the centroidal momentum matrix
+    updateCentroidalDynamics(pinocchioInterface_, info_, q);
+    const vector_t v = pinocchioMapping_.getPinocchioJointVelocity(x, u);
+
+    if (request.contains(Request::Approximation)) {
+      updateCentroidalDynamicsDerivatives(pinocchioInterface_, info_, q, v);
+      pinocchio::computeForwardKinematicsDerivatives(model, data, q, v, vector_t::Zero(info_.generalizedCoordinatesNum));
+    } else {
+      pinocchio::forwardKinematics(model, data, q, v);
+    }
+    pinocchio::updateFramePlacements(model, data);
+
+    eeKinematicsPtr_->computeKinematics(pinocchioInterface_, x, &u, request.contains(Request::Approximation), eeKinematics_);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LeggedRobotPreComputation::setEndEffectorKinematics(PinocchioEndEffectorKinematics& eeKinematics) const {
+  if (eeKinematicsPtr_ == nullptr) {
+    throw std::runtime_error("[LeggedRobotPreComputation::setEndEffectorKinematics] The end-effector kinematics is not computed!");
+  }
+  eeKinematics.setPinocchioInterface(pinocchioInterface_, eeKinematics_);
 }
 
 }  // namespace legged_robot
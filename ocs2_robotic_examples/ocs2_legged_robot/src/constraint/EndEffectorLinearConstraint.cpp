@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_legged_robot/constraint/EndEffectorLinearConstraint.h"
 
+#include "ocs2_legged_robot/LeggedRobotPreComputation.h"
+
 namespace ocs2 {
 namespace legged_robot {
 
@@ -51,9 +53,15 @@ EndEffectorLinearConstraint::EndEffectorLinearConstraint(const EndEffectorKinema
 /******************************************************************************************************/
 EndEffectorLinearConstraint::EndEffectorLinearConstraint(const EndEffectorLinearConstraint& rhs)
     : StateInputConstraint(rhs),
-      endEffectorKinematicsPtr_(rhs.endEffectorKinematicsPtr_->clone()),
       numConstraints_(rhs.numConstraints_),
-      config_(rhs.config_) {}
+      config_(rhs.config_) {
+  if (rhs.preComputedKinematicsPtr_ != nullptr) {
+    preComputedKinematicsPtr_ = rhs.preComputedKinematicsPtr_->clone();
+    endEffectorKinematicsPtr_.reset(preComputedKinematicsPtr_);
+  } else {
+    endEffectorKinematicsPtr_.reset(rhs.endEffectorKinematicsPtr_->clone());
+  }
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -68,11 +76,26 @@ void EndEffectorLinearConstraint::configure(Config&& config) {
   config_ = std::move(config);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void EndEffectorLinearConstraint::setPreComputedKinematics(const PinocchioEndEffectorKinematics& endEffectorKinematics) {
+  if (endEffectorKinematics.getIds().size() != 1) {
+    throw std::runtime_error("[EndEffectorLinearConstraint] this class only accepts a single end-effector!");
+  }
+  preComputedKinematicsPtr_ = endEffectorKinematics.clone();
+  endEffectorKinematicsPtr_.reset(preComputedKinematicsPtr_);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t EndEffectorLinearConstraint::getValue(scalar_t time, const vector_t& state, const vector_t& input,
                                                const PreComputation& preComp) const {
+  if (preComputedKinematicsPtr_ != nullptr) {
+    cast<LeggedRobotPreComputation>(preComp).setEndEffectorKinematics(*preComputedKinematicsPtr_);
+  }
+
   vector_t f = config_.b;
   if (config_.Ax.size() > 0) {
     f.noalias() += config_.Ax * endEffectorKinematicsPtr_->getPosition(state).front();
@@ -89,6 +112,10 @@ vector_t EndEffectorLinearConstraint::getValue(scalar_t time, const vector_t& st
 VectorFunctionLinearApproximation EndEffectorLinearConstraint::getLinearApproximation(scalar_t time, const vector_t& state,
                                                                                       const vector_t& input,
                                                                                       const PreComputation& preComp) const {
+  if (preComputedKinematicsPtr_ != nullptr) {
+    cast<LeggedRobotPreComputation>(preComp).setEndEffectorKinematics(*preComputedKinematicsPtr_);
+  }
+
   VectorFunctionLinearApproximation linearApproximation =
       VectorFunctionLinearApproximation::Zero(getNumConstraints(time), state.size(), input.size());
 
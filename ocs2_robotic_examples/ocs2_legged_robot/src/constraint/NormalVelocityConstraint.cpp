@@ -27,7 +27,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
-#include "ocs2_legged_robot/constraint/NormalVelocityConstraintCppAd.h"
+#include "ocs2_legged_robot/constraint/NormalVelocityConstraint.h"
 #include "ocs2_legged_robot/LeggedRobotPreComputation.h"
 
 namespace ocs2 {
@@ -36,9 +36,8 @@ namespace legged_robot {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-NormalVelocityConstraintCppAd::NormalVelocityConstraintCppAd(const SwitchedModelReferenceManager& referenceManager,
-                                                             const EndEffectorKinematics<scalar_t>& endEffectorKinematics,
-                                                             size_t contactPointIndex)
+NormalVelocityConstraint::NormalVelocityConstraint(const SwitchedModelReferenceManager& referenceManager,
+                                                   const EndEffectorKinematics<scalar_t>& endEffectorKinematics, size_t contactPointIndex)
     : StateInputConstraint(ConstraintOrder::Linear),
       referenceManagerPtr_(&referenceManager),
       eeLinearConstraintPtr_(new EndEffectorLinearConstraint(endEffectorKinematics, 1)),
@@ -47,7 +46,19 @@ NormalVelocityConstraintCppAd::NormalVelocityConstraintCppAd(const SwitchedModel
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-NormalVelocityConstraintCppAd::NormalVelocityConstraintCppAd(const NormalVelocityConstraintCppAd& rhs)
+NormalVelocityConstraint::NormalVelocityConstraint(const SwitchedModelReferenceManager& referenceManager,
+                                                   const PinocchioEndEffectorKinematics& endEffectorKinematics, size_t contactPointIndex)
+    : StateInputConstraint(ConstraintOrder::Linear),
+      referenceManagerPtr_(&referenceManager),
+      eeLinearConstraintPtr_(new EndEffectorLinearConstraint(endEffectorKinematics, 1)),
+      contactPointIndex_(contactPointIndex) {
+  eeLinearConstraintPtr_->setPreComputedKinematics(endEffectorKinematics);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+NormalVelocityConstraint::NormalVelocityConstraint(const NormalVelocityConstraint& rhs)
     : StateInputConstraint(rhs),
       referenceManagerPtr_(rhs.referenceManagerPtr_),
       eeLinearConstraintPtr_(rhs.eeLinearConstraintPtr_->clone()),
@@ -56,15 +67,15 @@ NormalVelocityConstraintCppAd::NormalVelocityConstraintCppAd(const NormalVelocit
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-bool NormalVelocityConstraintCppAd::isActive(scalar_t time) const {
+bool NormalVelocityConstraint::isActive(scalar_t time) const {
   return !referenceManagerPtr_->getContactFlags(time)[contactPointIndex_];
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-vector_t NormalVelocityConstraintCppAd::getValue(scalar_t time, const vector_t& state, const vector_t& input,
-                                                 const PreComputation& preComp) const {
+vector_t NormalVelocityConstraint::getValue(scalar_t time, const vector_t& state, const vector_t& input,
+                                            const PreComputation& preComp) const {
   const auto& preCompLegged = cast<LeggedRobotPreComputation>(preComp);
   eeLinearConstraintPtr_->configure(preCompLegged.getEeNormalVelocityConstraintConfigs()[contactPointIndex_]);
 
@@ -74,9 +85,9 @@ vector_t NormalVelocityConstraintCppAd::getValue(scalar_t time, const vector_t&
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-VectorFunctionLinearApproximation NormalVelocityConstraintCppAd::getLinearApproximation(scalar_t time, const vector_t& state,
-                                                                                        const vector_t& input,
-                                                                                        const PreComputation& preComp) const {
+VectorFunctionLinearApproximation NormalVelocityConstraint::getLinearApproximation(scalar_t time, const vector_t& state,
+                                                                                   const vector_t& input,
+                                                                                   const PreComputation& preComp) const {
   const auto& preCompLegged = cast<LeggedRobotPreComputation>(preComp);
   eeLinearConstraintPtr_->configure(preCompLegged.getEeNormalVelocityConstraintConfigs()[contactPointIndex_]);
 
@@ -27,7 +27,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
-#include "ocs2_legged_robot/constraint/ZeroVelocityConstraintCppAd.h"
+#include "ocs2_legged_robot/constraint/ZeroVelocityConstraint.h"
 
 namespace ocs2 {
 namespace legged_robot {
@@ -35,9 +35,9 @@ namespace legged_robot {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-ZeroVelocityConstraintCppAd::ZeroVelocityConstraintCppAd(const SwitchedModelReferenceManager& referenceManager,
-                                                         const EndEffectorKinematics<scalar_t>& endEffectorKinematics,
-                                                         size_t contactPointIndex, EndEffectorLinearConstraint::Config config)
+ZeroVelocityConstraint::ZeroVelocityConstraint(const SwitchedModelReferenceManager& referenceManager,
+                                               const EndEffectorKinematics<scalar_t>& endEffectorKinematics, size_t contactPointIndex,
+                                               EndEffectorLinearConstraint::Config config)
     : StateInputConstraint(ConstraintOrder::Linear),
       referenceManagerPtr_(&referenceManager),
       eeLinearConstraintPtr_(new EndEffectorLinearConstraint(endEffectorKinematics, 3, std::move(config))),
@@ -46,7 +46,20 @@ ZeroVelocityConstraintCppAd::ZeroVelocityConstraintCppAd(const SwitchedModelRefe
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-ZeroVelocityConstraintCppAd::ZeroVelocityConstraintCppAd(const ZeroVelocityConstraintCppAd& rhs)
+ZeroVelocityConstraint::ZeroVelocityConstraint(const SwitchedModelReferenceManager& referenceManager,
+                                               const PinocchioEndEffectorKinematics& endEffectorKinematics, size_t contactPointIndex,
+                                               EndEffectorLinearConstraint::Config config)
+    : StateInputConstraint(ConstraintOrder::Linear),
+      referenceManagerPtr_(&referenceManager),
+      eeLinearConstraintPtr_(new EndEffectorLinearConstraint(endEffectorKinematics, 3, std::move(config))),
+      contactPointIndex_(contactPointIndex) {
+  eeLinearConstraintPtr_->setPreComputedKinematics(endEffectorKinematics);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ZeroVelocityConstraint::ZeroVelocityConstraint(const ZeroVelocityConstraint& rhs)
     : StateInputConstraint(rhs),
       referenceManagerPtr_(rhs.referenceManagerPtr_),
       eeLinearConstraintPtr_(rhs.eeLinearConstraintPtr_->clone()),
@@ -55,24 +68,24 @@ ZeroVelocityConstraintCppAd::ZeroVelocityConstraintCppAd(const ZeroVelocityConst
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-bool ZeroVelocityConstraintCppAd::isActive(scalar_t time) const {
+bool ZeroVelocityConstraint::isActive(scalar_t time) const {
   return referenceManagerPtr_->getContactFlags(time)[contactPointIndex_];
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-vector_t ZeroVelocityConstraintCppAd::getValue(scalar_t time, const vector_t& state, const vector_t& input,
-                                               const PreComputation& preComp) const {
+vector_t ZeroVelocityConstraint::getValue(scalar_t time, const vector_t& state, const vector_t& input,
+                                          const PreComputation& preComp) const {
   return eeLinearConstraintPtr_->getValue(time, state, input, preComp);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-VectorFunctionLinearApproximation ZeroVelocityConstraintCppAd::getLinearApproximation(scalar_t time, const vector_t& state,
-                                                                                      const vector_t& input,
-                                                                                      const PreComputation& preComp) const {
+VectorFunctionLinearApproximation ZeroVelocityConstraint::getLinearApproximation(scalar_t time, const vector_t& state,
+                                                                                 const vector_t& input,
+                                                                                 const PreComputation& preComp) const {
   return eeLinearConstraintPtr_->getLinearApproximation(time, state, input, preComp);
 }
 
@@ -99,6 +99,21 @@ scalar_t CubicSpline::finalTimeDerivative(scalar_t t) const {
   return velocity(t) * dt_ * dTn + dCoff;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Eigen::Matrix<scalar_t, 4, 1> CubicSpline::getCoefficients(scalar_t origin) const {
+  // Taylor expansion of the polynomial in the normalized time around the origin
+  const scalar_t tn = normalizedTime(origin);
+  const scalar_t scale = 1.0 / dt_;
+  Eigen::Matrix<scalar_t, 4, 1> coefficients;
+  coefficients(0) = ((c3_ * tn + c2_) * tn + c1_) * tn + c0_;
+  coefficients(1) = ((3.0 * c3_ * tn + 2.0 * c2_) * tn + c1_) * scale;
+  coefficients(2) = (3.0 * c3_ * tn + c2_) * scale * scale;
+  coefficients(3) = c3_ * scale * scale * scale;
+  return coefficients;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
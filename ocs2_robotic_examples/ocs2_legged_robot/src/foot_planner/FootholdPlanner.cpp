@@ -0,0 +1,198 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <cmath>
+#include <limits>
+
+#include <boost/property_tree/info_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include "ocs2_legged_robot/foot_planner/FootholdPlanner.h"
+
+#include <ocs2_centroidal_model/AccessHelperFunctions.h>
+#include <ocs2_core/misc/LoadData.h>
+#include <ocs2_core/misc/Lookup.h>
+
+#include "ocs2_legged_robot/gait/MotionPhaseDefinition.h"
+
+namespace ocs2 {
+namespace legged_robot {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+FootholdPlanner::FootholdPlanner(Config config, CentroidalModelInfo info, feet_array_t<vector3_t> nominalFootPositions)
+    : config_(std::move(config)), info_(std::move(info)), nominalFootPositions_(std::move(nominalFootPositions)) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FootholdPlanner::update(scalar_t initTime, const ModeSchedule& modeSchedule, const TargetTrajectories& targetTrajectories,
+                             const SegmentedTerrainMap& terrainMap) {
+  using vector2_t = SegmentedTerrainMap::vector2_t;
+  const auto& modeSequence = modeSchedule.modeSequence;
+  const auto& eventTimes = modeSchedule.eventTimes;
+  const size_t numPhases = modeSequence.size();
+  constexpr scalar_t nan = std::numeric_limits<scalar_t>::quiet_NaN();
+
+  eventTimes_ = eventTimes;
+  for (size_t leg = 0; leg < info_.numThreeDofContacts; leg++) {
+    auto& constraintConfigs = footPlacementConstraintConfigs_[leg];
+    constraintConfigs.assign(numPhases, EndEffectorLinearConstraint::Config());
+    scalar_array_t stanceHeights(numPhases, nan);
+
+    // a stance of the foot can span several phases
+    size_t stanceBegin = 0;
+    while (stanceBegin < numPhases) {
+      if (!modeNumber2StanceLeg(modeSequence[stanceBegin])[leg]) {
+        stanceBegin++;
+        continue;
+      }
+      size_t stanceEnd = stanceBegin + 1;
+      while (stanceEnd < numPhases && modeNumber2StanceLeg(modeSequence[stanceEnd])[leg]) {
+        stanceEnd++;
+      }
+
+      // phase p spans [eventTimes[p - 1], eventTimes[p]]
+      const bool isPlanned = stanceBegin > 0 && eventTimes[stanceBegin - 1] > initTime;
+      const scalar_t touchDownTime = isPlanned ? eventTimes[stanceBegin - 1] : initTime;
+      const scalar_t liftOffTime = stanceEnd < numPhases ? eventTimes[stanceEnd - 1] : touchDownTime;
+      // the foot of a stance which has started is already on the ground, close to its nominal position at the initial time
+      const scalar_t footholdTime = isPlanned ? 0.5 * (touchDownTime + liftOffTime) : initTime;
+      const vector3_t nominalFoothold = getNominalFoothold(leg, footholdTime, targetTrajectories);
+
+      scalar_t height = 0.0;  // flat ground if the map has no foothold region
+      SegmentedTerrainMap::Region region;
+      if (terrainMap.getFootholdRegion(nominalFoothold.head<2>(), region)) {
+        const scalar_t halfWidth = std::max(region.halfWidth - config_.regionMargin, 0.0);
+        const vector2_t lower = region.center.head<2>().array() - halfWidth;
+        const vector2_t upper = region.center.head<2>().array() + halfWidth;
+        height = region.getHeight(nominalFoothold.head<2>().cwiseMax(lower).cwiseMin(upper));
+
+        if (isPlanned) {
+          EndEffectorLinearConstraint::Config config;
+          config.Ax.setZero(4, 3);
+          config.Ax.topLeftCorner<2, 2>().setIdentity();
+          config.Ax.bottomLeftCorner<2, 2>() = -matrix_t::Identity(2, 2);
+          config.b.resize(4);
+          config.b << -lower, upper;
+          std::fill(constraintConfigs.begin() + stanceBegin, constraintConfigs.begin() + stanceEnd, config);
+        }
+      }
+      std::fill(stanceHeights.begin() + stanceBegin, stanceHeights.begin() + stanceEnd, height);
+      stanceBegin = stanceEnd;
+    }
+
+    // a swing starts at the height of the previous stance and ends at the height of the next one
+    auto& liftOffHeights = liftOffHeightSequence_[leg];
+    auto& touchDownHeights = touchDownHeightSequence_[leg];
+    liftOffHeights = stanceHeights;
+    touchDownHeights = stanceHeights;
+    for (size_t p = 1; p < numPhases; p++) {
+      if (std::isnan(liftOffHeights[p])) {
+        liftOffHeights[p] = liftOffHeights[p - 1];
+      }
+    }
+    for (size_t p = numPhases - 1; p > 0; p--) {
+      if (std::isnan(touchDownHeights[p - 1])) {
+        touchDownHeights[p - 1] = touchDownHeights[p];
+      }
+    }
+    for (size_t p = 0; p < numPhases; p++) {
+      if (std::isnan(liftOffHeights[p])) {
+        liftOffHeights[p] = std::isnan(touchDownHeights[p]) ? 0.0 : touchDownHeights[p];
+      }
+      if (std::isnan(touchDownHeights[p])) {
+        touchDownHeights[p] = liftOffHeights[p];
+      }
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FootholdPlanner::reset() {
+  eventTimes_.clear();
+  for (size_t leg = 0; leg < info_.numThreeDofContacts; leg++) {
+    footPlacementConstraintConfigs_[leg].clear();
+    liftOffHeightSequence_[leg].clear();
+    touchDownHeightSequence_[leg].clear();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const EndEffectorLinearConstraint::Config* FootholdPlanner::getFootPlacementConstraintConfig(size_t leg, scalar_t time) const {
+  const auto& constraintConfigs = footPlacementConstraintConfigs_[leg];
+  if (constraintConfigs.empty()) {
+    return nullptr;
+  }
+  const auto& config = constraintConfigs[lookup::findIndexInTimeArray(eventTimes_, time)];
+  return config.b.size() > 0 ? &config : nullptr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector3_t FootholdPlanner::getNominalFoothold(size_t leg, scalar_t time, const TargetTrajectories& targetTrajectories) const {
+  const vector_t state = targetTrajectories.getDesiredState(time);
+  const auto basePose = centroidal_model::getBasePose(state, info_);
+  // only the heading of the base is considered
+  const Eigen::AngleAxis<scalar_t> yawRotation(basePose(3), vector3_t::UnitZ());
+  return basePose.head<3>() + yawRotation * nominalFootPositions_[leg];
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+FootholdPlanner::Config loadFootholdPlannerSettings(const std::string& fileName, const std::string& fieldName, bool verbose) {
+  boost::property_tree::ptree pt;
+  boost::property_tree::read_info(fileName, pt);
+
+  if (verbose) {
+    std::cerr << "\n #### Foothold Planner Config:";
+    std::cerr << "\n #### =============================================================================\n";
+  }
+
+  FootholdPlanner::Config config;
+  const std::string prefix = fieldName + ".";
+
+  loadData::loadPtreeValue(pt, config.regionMargin, prefix + "regionMargin", verbose);
+
+  if (verbose) {
+    std::cerr << " #### =============================================================================" << std::endl;
+  }
+
+  return config;
+}
+
+}  // namespace legged_robot
+}  // namespace ocs2
@@ -27,6 +27,8 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
+
 #include <boost/property_tree/info_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
 
@@ -60,6 +62,21 @@ scalar_t SwingTrajectoryPlanner::getZpositionConstraint(size_t leg, scalar_t tim
   return feetHeightTrajectories_[leg][index].position(time);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SwingTrajectoryPlanner::getZReferences(scalar_t time, feet_vector_t& positions, feet_vector_t& velocities) const {
+  if (zReferenceCoefficients_.empty()) {
+    throw std::runtime_error("[SwingTrajectoryPlanner::getZReferences] The planner is not updated.");
+  }
+  const auto index = lookup::findIndexInTimeArray(zReferenceBreakpoints_, time);
+  const scalar_t s = time - zReferenceOrigins_[index];
+  const Eigen::Matrix<scalar_t, 4, 1> powers(1.0, s, s * s, s * s * s);
+  const Eigen::Matrix<scalar_t, 4, 1> powersDerivative(0.0, 1.0, 2.0 * s, 3.0 * s * s);
+  positions.noalias() = zReferenceCoefficients_[index] * powers;
+  velocities.noalias() = zReferenceCoefficients_[index] * powersDerivative;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -115,6 +132,52 @@ void SwingTrajectoryPlanner::update(const ModeSchedule& modeSchedule, const feet
     }
     feetHeightTrajectoriesEvents_[j] = eventTimes;
   }
+
+  updateZReferenceTable(eventTimes);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SwingTrajectoryPlanner::updateZReferenceTable(const scalar_array_t& eventTimes) {
+  // the splines are smooth in between the events and the apexes of the swing phases
+  zReferenceBreakpoints_ = eventTimes;
+  for (size_t j = 0; j < numFeet_; j++) {
+    for (size_t p = 1; p + 1 < feetHeightTrajectories_[j].size(); p++) {
+      const scalar_t midTime = feetHeightTrajectories_[j][p].midTime();
+      if (eventTimes[p - 1] < midTime && midTime < eventTimes[p]) {
+        zReferenceBreakpoints_.push_back(midTime);
+      }
+    }
+  }
+  std::sort(zReferenceBreakpoints_.begin(), zReferenceBreakpoints_.end());
+  zReferenceBreakpoints_.erase(std::unique(zReferenceBreakpoints_.begin(), zReferenceBreakpoints_.end()), zReferenceBreakpoints_.end());
+
+  const size_t numBreakpoints = zReferenceBreakpoints_.size();
+  zReferenceOrigins_.resize(numBreakpoints + 1);
+  zReferenceCoefficients_.resize(numBreakpoints + 1);
+  for (size_t k = 0; k <= numBreakpoints; k++) {
+    // a time strictly inside the interval selects the phase and the half of the spline for the whole interval
+    scalar_t innerTime = 0.0;
+    if (numBreakpoints == 0) {
+      zReferenceOrigins_[k] = 0.0;
+    } else if (k == 0) {
+      zReferenceOrigins_[k] = zReferenceBreakpoints_.front();
+      innerTime = zReferenceBreakpoints_.front() - 1.0;
+    } else if (k == numBreakpoints) {
+      zReferenceOrigins_[k] = zReferenceBreakpoints_.back();
+      innerTime = zReferenceBreakpoints_.back() + 1.0;
+    } else {
+      zReferenceOrigins_[k] = zReferenceBreakpoints_[k];
+      innerTime = 0.5 * (zReferenceBreakpoints_[k - 1] + zReferenceBreakpoints_[k]);
+    }
+
+    zReferenceCoefficients_[k].setZero();
+    for (size_t j = 0; j < numFeet_; j++) {
+      const auto index = lookup::findIndexInTimeArray(feetHeightTrajectoriesEvents_[j], innerTime);
+      zReferenceCoefficients_[k].row(j) = feetHeightTrajectories_[j][index].getCoefficients(innerTime, zReferenceOrigins_[k]).transpose();
+    }
+  }
 }
 
 /******************************************************************************************************/
@@ -36,10 +36,13 @@ namespace legged_robot {
 /******************************************************************************************************/
 /******************************************************************************************************/
 SwitchedModelReferenceManager::SwitchedModelReferenceManager(std::shared_ptr<GaitSchedule> gaitSchedulePtr,
-                                                             std::shared_ptr<SwingTrajectoryPlanner> swingTrajectoryPtr)
+                                                             std::shared_ptr<SwingTrajectoryPlanner> swingTrajectoryPtr,
+                                                             std::shared_ptr<FootholdPlanner> footholdPlannerPtr)
     : ReferenceManager(TargetTrajectories(), ModeSchedule()),
       gaitSchedulePtr_(std::move(gaitSchedulePtr)),
-      swingTrajectoryPtr_(std::move(swingTrajectoryPtr)) {}
+      swingTrajectoryPtr_(std::move(swingTrajectoryPtr)),
+      footholdPlannerPtr_(std::move(footholdPlannerPtr)),
+      terrainMapPtr_(nullptr) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -63,9 +66,24 @@ void SwitchedModelReferenceManager::modifyReferences(scalar_t initTime, scalar_t
                                                      TargetTrajectories& targetTrajectories, ModeSchedule& modeSchedule) {
   const auto timeHorizon = finalTime - initTime;
   modeSchedule = gaitSchedulePtr_->getModeSchedule(initTime - timeHorizon, finalTime + timeHorizon);
+  if (modeSchedule.eventTimes != gaitModeSchedule_.eventTimes || modeSchedule.modeSequence != gaitModeSchedule_.modeSequence) {
+    gaitModeSchedule_ = modeSchedule;
+    ++numGaitModeScheduleUpdates_;
+  }
 
-  const scalar_t terrainHeight = 0.0;
-  swingTrajectoryPtr_->update(modeSchedule, terrainHeight);
+  terrainMapPtr_.updateFromBuffer();
+  const auto& terrainMapPtr = terrainMapPtr_.get();
+  if (footholdPlannerPtr_ != nullptr && terrainMapPtr != nullptr && !targetTrajectories.empty()) {
+    footholdPlannerPtr_->update(initTime, modeSchedule, targetTrajectories, *terrainMapPtr);
+    swingTrajectoryPtr_->update(modeSchedule, footholdPlannerPtr_->getLiftOffHeightSequence(),
+                                footholdPlannerPtr_->getTouchDownHeightSequence());
+  } else {
+    if (footholdPlannerPtr_ != nullptr) {
+      footholdPlannerPtr_->reset();
+    }
+    const scalar_t terrainHeight = 0.0;
+    swingTrajectoryPtr_->update(modeSchedule, terrainHeight);
+  }
 }
 
 }  // namespace legged_robot
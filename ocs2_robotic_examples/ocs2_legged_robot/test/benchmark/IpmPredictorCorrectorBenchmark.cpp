@@ -0,0 +1,117 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_ipm/IpmSolver.h>
+#include <ocs2_robotic_assets/package_path.h>
+
+#include "ocs2_legged_robot/LeggedRobotInterface.h"
+#include "ocs2_legged_robot/package_path.h"
+
+namespace {
+
+struct BenchmarkResult {
+  size_t numIterations = 0;
+  ocs2::benchmark::RepeatedTimer solveTimer;
+};
+
+/**
+ * Runs the IPM solver as in a receding horizon loop: every call starts one MPC period after the previous one from the state that the
+ * previous solution predicts at that time, such that both modes see the same warm-started sequence of problems.
+ */
+BenchmarkResult runMpcLoop(ocs2::legged_robot::LeggedRobotInterface& interface, ocs2::ipm::Settings settings, size_t numMpcCalls) {
+  using namespace ocs2;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+
+  const scalar_t timeHorizon = interface.mpcSettings().timeHorizon_;
+  const scalar_t mpcFrequency = interface.mpcSettings().mpcDesiredFrequency_;
+  const scalar_t mpcPeriod = (mpcFrequency > 0.0) ? 1.0 / mpcFrequency : 0.01;
+  vector_t initState = interface.getInitialState();
+
+  interface.getReferenceManagerPtr()->setTargetTrajectories(
+      TargetTrajectories({0.0}, {initState}, {vector_t::Zero(interface.getCentroidalModelInfo().inputDim)}));
+
+  IpmSolver solver(std::move(settings), interface.getOptimalControlProblem(), interface.getInitializer());
+  solver.setReferenceManager(interface.getReferenceManagerPtr());
+
+  BenchmarkResult result;
+  scalar_t initTime = 0.0;
+  for (size_t i = 0; i < numMpcCalls; ++i) {
+    result.solveTimer.startTimer();
+    solver.run(initTime, initState, initTime + timeHorizon);
+    result.solveTimer.endTimer();
+    result.numIterations += solver.getIterationsLog().size();
+
+    const auto primalSolution = solver.primalSolution(initTime + timeHorizon);
+    initTime += mpcPeriod;
+    initState = LinearInterpolation::interpolate(initTime, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_);
+  }
+  return result;
+}
+
+}  // unnamed namespace
+
+/**
+ * Compares the monotone barrier update of the IPM solver with the predictor-corrector mode on the legged robot IPM configuration.
+ *
+ * Usage: ocs2_legged_robot_ipm_benchmark [number of MPC calls] [task file]
+ */
+int main(int argc, char* argv[]) {
+  using namespace ocs2;
+  using namespace ocs2::legged_robot;
+
+  const size_t numMpcCalls = (argc > 1) ? std::stoul(argv[1]) : 100;
+  const std::string taskFile = (argc > 2) ? argv[2] : legged_robot::getPath() + "/config/mpc/task.info";
+  const std::string urdfFile = robotic_assets::getPath() + "/resources/anymal_c/urdf/anymal.urdf";
+  const std::string referenceFile = legged_robot::getPath() + "/config/command/reference.info";
+
+  std::cout << std::setw(20) << "mode" << std::setw(14) << "iterations" << std::setw(16) << "iter / call" << std::setw(16)
+            << "total [ms]" << std::setw(16) << "call [ms]" << std::setw(16) << "max call [ms]" << "\n";
+  for (const bool usePredictorCorrector : {false, true}) {
+    // a fresh interface per mode such that the reference manager and the gait schedule start from the same state
+    LeggedRobotInterface interface(taskFile, urdfFile, referenceFile, /*useHardFrictionConeConstraint=*/true);
+    ipm::Settings settings = interface.ipmSettings();
+    settings.usePredictorCorrector = usePredictorCorrector;
+
+    const auto result = runMpcLoop(interface, settings, numMpcCalls);
+    std::cout << std::setw(20) << (usePredictorCorrector ? "predictor-corrector" : "monotone") << std::setw(14) << result.numIterations
+              << std::setw(16) << static_cast<scalar_t>(result.numIterations) / numMpcCalls << std::setw(16)
+              << result.solveTimer.getTotalInMilliseconds() << std::setw(16) << result.solveTimer.getAverageInMilliseconds()
+              << std::setw(16) << result.solveTimer.getMaxIntervalInMilliseconds() << "\n";
+  }
+  return 0;
+}
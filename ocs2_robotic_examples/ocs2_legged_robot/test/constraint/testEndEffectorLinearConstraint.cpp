@@ -41,8 +41,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_pinocchio_interface/PinocchioEndEffectorKinematics.h>
 #include <ocs2_pinocchio_interface/PinocchioEndEffectorKinematicsCppAd.h>
 
+#include "ocs2_legged_robot/LeggedRobotPreComputation.h"
 #include "ocs2_legged_robot/common/ModelSettings.h"
 #include "ocs2_legged_robot/constraint/EndEffectorLinearConstraint.h"
+#include "ocs2_legged_robot/gait/MotionPhaseDefinition.h"
 #include "ocs2_legged_robot/test/AnymalFactoryFunctions.h"
 
 using namespace ocs2;
@@ -177,3 +179,39 @@ TEST_F(testEndEffectorLinearConstraint, testLinearApproximation) {
   EXPECT_TRUE(linApprox.dfdx.isApprox(linApproxAd.dfdx, 1e-14));
   EXPECT_TRUE(linApprox.dfdu.isApprox(linApproxAd.dfdu));
 }
+
+TEST_F(testEndEffectorLinearConstraint, testPreComputedKinematics) {
+  auto eeVelConstraintPtr = std::make_unique<EndEffectorLinearConstraint>(*eeKinematicsPtr, 3);
+  eeVelConstraintPtr->setPreComputedKinematics(*eeKinematicsPtr);
+  eeVelConstraintPtr->configure(config);
+  auto eeVelConstraintAdPtr = std::make_unique<EndEffectorLinearConstraint>(*eeKinematicsAdPtr, 3);
+  eeVelConstraintAdPtr->configure(config);
+
+  // the swing trajectory planner is only used for the normal velocity constraint configs of the pre-computation
+  SwingTrajectoryPlanner swingTrajectoryPlanner(SwingTrajectoryPlanner::Config(), centroidalModelInfo.numThreeDofContacts);
+  swingTrajectoryPlanner.update(ModeSchedule({}, {ModeNumber::STANCE}), 0.0);
+  const ModelSettings modelSettings;
+  LeggedRobotPreComputation leggedPreComputation(*pinocchioInterfacePtr, centroidalModelInfo, swingTrajectoryPlanner, modelSettings, true);
+  std::unique_ptr<PreComputation> leggedPreComputationClonePtr(leggedPreComputation.clone());
+
+  // a clone of the constraint reads the kinematics of the pre-computation it is evaluated with
+  std::unique_ptr<EndEffectorLinearConstraint> eeVelConstraintClonePtr(eeVelConstraintPtr->clone());
+
+  leggedPreComputation.request(Request::Constraint, 0.0, x, u);
+  const auto value = eeVelConstraintPtr->getValue(0.0, x, u, leggedPreComputation);
+  const auto valueAd = eeVelConstraintAdPtr->getValue(0.0, x, u, preComputation);
+  EXPECT_TRUE(value.isApprox(valueAd));
+
+  leggedPreComputationClonePtr->request(Request::Constraint + Request::Approximation, 0.0, x, u);
+  const auto linApprox = eeVelConstraintClonePtr->getLinearApproximation(0.0, x, u, *leggedPreComputationClonePtr);
+  const auto linApproxAd = eeVelConstraintAdPtr->getLinearApproximation(0.0, x, u, preComputation);
+  EXPECT_TRUE(linApprox.f.isApprox(linApproxAd.f));
+  EXPECT_TRUE(linApprox.dfdx.isApprox(linApproxAd.dfdx, 1e-14));
+  EXPECT_TRUE(linApprox.dfdu.isApprox(linApproxAd.dfdu));
+
+  // without the end-effector kinematics of the pre-computation
+  LeggedRobotPreComputation preComputationWithoutKinematics(*pinocchioInterfacePtr, centroidalModelInfo, swingTrajectoryPlanner,
+                                                            modelSettings);
+  preComputationWithoutKinematics.request(Request::Constraint, 0.0, x, u);
+  EXPECT_THROW(eeVelConstraintPtr->getValue(0.0, x, u, preComputationWithoutKinematics), std::runtime_error);
+}
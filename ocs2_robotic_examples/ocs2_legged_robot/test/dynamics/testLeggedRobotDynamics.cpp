@@ -0,0 +1,92 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_legged_robot/common/ModelSettings.h"
+#include "ocs2_legged_robot/dynamics/LeggedRobotDynamics.h"
+#include "ocs2_legged_robot/dynamics/LeggedRobotDynamicsAD.h"
+#include "ocs2_legged_robot/test/AnymalFactoryFunctions.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+class TestLeggedRobotDynamics : public ::testing::TestWithParam<CentroidalModelType> {
+ public:
+  TestLeggedRobotDynamics() { srand(0); }
+
+  ModelSettings createModelSettings() const {
+    ModelSettings modelSettings;
+    modelSettings.verboseCppAd = false;
+    return modelSettings;
+  }
+
+  static constexpr scalar_t tol = 1e-9;
+  static constexpr size_t numTests = 20;
+  std::unique_ptr<PinocchioInterface> pinocchioInterfacePtr = createAnymalPinocchioInterface();
+  PreComputation preComputation;
+};
+
+constexpr scalar_t TestLeggedRobotDynamics::tol;
+constexpr size_t TestLeggedRobotDynamics::numTests;
+
+TEST_P(TestLeggedRobotDynamics, compareWithCppAd) {
+  const CentroidalModelType type = GetParam();
+  const CentroidalModelInfo info = createAnymalCentroidalModelInfo(*pinocchioInterfacePtr, type);
+
+  LeggedRobotDynamics dynamics(*pinocchioInterfacePtr, info);
+  const std::string modelName = "TestLeggedRobotDynamics" + toString(type) + "Ad";
+  LeggedRobotDynamicsAD dynamicsAd(*pinocchioInterfacePtr, info, modelName, createModelSettings());
+  std::unique_ptr<LeggedRobotDynamics> clonedDynamicsPtr(dynamics.clone());
+
+  for (size_t i = 0; i < numTests; i++) {
+    const scalar_t t = 0.0;
+    const vector_t x = vector_t::Random(info.stateDim);
+    const vector_t u = 100.0 * vector_t::Random(info.inputDim);
+
+    const vector_t flowMap = dynamics.computeFlowMap(t, x, u, preComputation);
+    const vector_t flowMapAd = dynamicsAd.computeFlowMap(t, x, u, preComputation);
+    EXPECT_TRUE(flowMap.isApprox(flowMapAd, tol));
+
+    const auto linearApproximation = dynamics.linearApproximation(t, x, u, preComputation);
+    const auto linearApproximationAd = dynamicsAd.linearApproximation(t, x, u, preComputation);
+    EXPECT_TRUE(linearApproximation.f.isApprox(linearApproximationAd.f, tol));
+    EXPECT_TRUE(linearApproximation.dfdx.isApprox(linearApproximationAd.dfdx, tol));
+    EXPECT_TRUE(linearApproximation.dfdu.isApprox(linearApproximationAd.dfdu, tol));
+
+    // A clone evaluates on its own copy of the pinocchio interface
+    const auto clonedLinearApproximation = clonedDynamicsPtr->linearApproximation(t, x, u, preComputation);
+    EXPECT_TRUE(clonedLinearApproximation.dfdx.isApprox(linearApproximation.dfdx, tol));
+    EXPECT_TRUE(clonedLinearApproximation.dfdu.isApprox(linearApproximation.dfdu, tol));
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(TestLeggedRobotDynamicsWithParam, TestLeggedRobotDynamics,
+                        testing::ValuesIn({CentroidalModelType::FullCentroidalDynamics, CentroidalModelType::SingleRigidBodyDynamics}),
+                        [](const testing::TestParamInfo<TestLeggedRobotDynamics::ParamType>& info) { return toString(info.param); });
@@ -0,0 +1,174 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_centroidal_model/AccessHelperFunctions.h>
+
+#include "ocs2_legged_robot/common/Types.h"
+#include "ocs2_legged_robot/foot_planner/FootholdPlanner.h"
+#include "ocs2_legged_robot/gait/MotionPhaseDefinition.h"
+#include "ocs2_legged_robot/test/AnymalFactoryFunctions.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+class TestFootholdPlanner : public ::testing::Test {
+ public:
+  using vector2_t = SegmentedTerrainMap::vector2_t;
+
+  TestFootholdPlanner() {
+    // a step of stepHeight at x = 0.5
+    std::vector<float> heights(mapSize[0] * mapSize[1]);
+    for (size_t y = 0; y < mapSize[1]; y++) {
+      for (size_t x = 0; x < mapSize[0]; x++) {
+        heights[x + mapSize[0] * y] = (mapOrigin.x() + mapResolution * x > 0.49) ? stepHeight : 0.0;
+      }
+    }
+    terrainMapPtr.reset(new SegmentedTerrainMap(heights, mapSize, mapResolution, mapOrigin, SegmentedTerrainMap::Settings()));
+
+    // the base walks forward by 0.6 [m] in 1 [s]
+    vector_t initState = vector_t::Zero(info.stateDim);
+    centroidal_model::getBasePose(initState, info)(2) = 0.5;
+    vector_t finalState = initState;
+    centroidal_model::getBasePose(finalState, info)(0) = 0.6;
+    const vector_t zeroInput = vector_t::Zero(info.inputDim);
+    targetTrajectories = TargetTrajectories({0.0, 1.0}, {initState, finalState}, {zeroInput, zeroInput});
+
+    // trot, all feet are in stance at the initial time
+    modeSchedule.eventTimes = {0.2, 0.5, 0.6, 0.9};
+    modeSchedule.modeSequence = {ModeNumber::STANCE, ModeNumber::LF_RH, ModeNumber::STANCE, ModeNumber::RF_LH, ModeNumber::STANCE};
+
+    nominalFootPositions[0] << 0.3, 0.2, -0.5;    // LF
+    nominalFootPositions[1] << 0.3, -0.2, -0.5;   // RF
+    nominalFootPositions[2] << -0.3, 0.2, -0.5;   // LH
+    nominalFootPositions[3] << -0.3, -0.2, -0.5;  // RH
+  }
+
+  /** Checks whether the xy-position of the foot satisfies the box constraint. */
+  static bool isFeasible(const EndEffectorLinearConstraint::Config& config, const vector2_t& position) {
+    const vector3_t footPosition(position.x(), position.y(), 0.0);
+    return ((config.Ax * footPosition + config.b).array() >= 0.0).all();
+  }
+
+  const std::array<size_t, 2> mapSize{{100, 60}};
+  const scalar_t mapResolution = 0.02;
+  const vector2_t mapOrigin{-0.5, -0.6};
+  const scalar_t stepHeight = 0.2;
+  const scalar_t initTime = 0.1;
+
+  std::unique_ptr<PinocchioInterface> pinocchioInterfacePtr = createAnymalPinocchioInterface();
+  const CentroidalModelInfo info = createAnymalCentroidalModelInfo(*pinocchioInterfacePtr, CentroidalModelType::SingleRigidBodyDynamics);
+  std::unique_ptr<SegmentedTerrainMap> terrainMapPtr;
+  TargetTrajectories targetTrajectories;
+  ModeSchedule modeSchedule;
+  feet_array_t<vector3_t> nominalFootPositions;
+};
+
+TEST_F(TestFootholdPlanner, heightSequence) {
+  FootholdPlanner planner(FootholdPlanner::Config(), info, nominalFootPositions);
+  planner.update(initTime, modeSchedule, targetTrajectories, *terrainMapPtr);
+  const auto& liftOffHeights = planner.getLiftOffHeightSequence();
+  const auto& touchDownHeights = planner.getTouchDownHeightSequence();
+
+  // LF stands on the low ground until it swings in phase 3 and touches down on the step at x = 0.54 + 0.3
+  const scalar_array_t lfLiftOff{0.0, 0.0, 0.0, 0.0, stepHeight};
+  const scalar_array_t lfTouchDown{0.0, 0.0, 0.0, stepHeight, stepHeight};
+  // RF swings in phase 1 and touches down on the step at x = 0.3 + 0.3, where it stays until the end of the horizon
+  const scalar_array_t rfLiftOff{0.0, 0.0, stepHeight, stepHeight, stepHeight};
+  const scalar_array_t rfTouchDown{0.0, stepHeight, stepHeight, stepHeight, stepHeight};
+  // The hind feet stay on the low ground
+  const scalar_array_t flat(modeSchedule.modeSequence.size(), 0.0);
+
+  const feet_array_t<scalar_array_t> expectedLiftOff{lfLiftOff, rfLiftOff, flat, flat};
+  const feet_array_t<scalar_array_t> expectedTouchDown{lfTouchDown, rfTouchDown, flat, flat};
+  for (size_t leg = 0; leg < info.numThreeDofContacts; leg++) {
+    ASSERT_EQ(liftOffHeights[leg].size(), modeSchedule.modeSequence.size());
+    ASSERT_EQ(touchDownHeights[leg].size(), modeSchedule.modeSequence.size());
+    for (size_t p = 0; p < modeSchedule.modeSequence.size(); p++) {
+      EXPECT_NEAR(liftOffHeights[leg][p], expectedLiftOff[leg][p], 1e-6) << "leg " << leg << ", phase " << p;
+      EXPECT_NEAR(touchDownHeights[leg][p], expectedTouchDown[leg][p], 1e-6) << "leg " << leg << ", phase " << p;
+    }
+  }
+}
+
+TEST_F(TestFootholdPlanner, stanceSpans) {
+  FootholdPlanner planner(FootholdPlanner::Config(), info, nominalFootPositions);
+  planner.update(initTime, modeSchedule, targetTrajectories, *terrainMapPtr);
+
+  // The stances which started before the initial time are not constrained
+  for (size_t leg = 0; leg < info.numThreeDofContacts; leg++) {
+    EXPECT_EQ(planner.getFootPlacementConstraintConfig(leg, 0.15), nullptr);
+  }
+  EXPECT_EQ(planner.getFootPlacementConstraintConfig(0, 0.55), nullptr);
+
+  // The stance of RF spans the phases 2 to 4, which share one constraint
+  const auto* rfConfig = planner.getFootPlacementConstraintConfig(1, 0.55);
+  ASSERT_NE(rfConfig, nullptr);
+  EXPECT_EQ(planner.getFootPlacementConstraintConfig(1, 0.3), nullptr);
+  for (const scalar_t time : {0.65, 0.95}) {
+    const auto* config = planner.getFootPlacementConstraintConfig(1, time);
+    ASSERT_NE(config, nullptr);
+    EXPECT_TRUE(config->Ax.isApprox(rfConfig->Ax));
+    EXPECT_TRUE(config->b.isApprox(rfConfig->b));
+  }
+
+  // The swing of LF in phase 3 ends in a constrained stance
+  EXPECT_EQ(planner.getFootPlacementConstraintConfig(0, 0.75), nullptr);
+  EXPECT_NE(planner.getFootPlacementConstraintConfig(0, 0.95), nullptr);
+
+  planner.reset();
+  EXPECT_EQ(planner.getFootPlacementConstraintConfig(1, 0.55), nullptr);
+  EXPECT_TRUE(planner.getLiftOffHeightSequence()[1].empty());
+}
+
+TEST_F(TestFootholdPlanner, boxConstraint) {
+  FootholdPlanner::Config config;
+  config.regionMargin = 0.02;
+  FootholdPlanner planner(config, info, nominalFootPositions);
+  planner.update(initTime, modeSchedule, targetTrajectories, *terrainMapPtr);
+
+  // RF touches down at t = 0.5 with the base at x = 0.3, the nominal foothold is on the step
+  const vector2_t rfNominalFoothold(0.3 + nominalFootPositions[1].x(), nominalFootPositions[1].y());
+  const auto* rfConfig = planner.getFootPlacementConstraintConfig(1, 0.55);
+  ASSERT_NE(rfConfig, nullptr);
+  ASSERT_EQ(rfConfig->Ax.rows(), 4);
+  EXPECT_TRUE(isFeasible(*rfConfig, rfNominalFoothold));
+  // the box excludes the edge of the step and the low ground
+  EXPECT_FALSE(isFeasible(*rfConfig, vector2_t(0.48, rfNominalFoothold.y())));
+  EXPECT_FALSE(isFeasible(*rfConfig, vector2_t(0.3, rfNominalFoothold.y())));
+
+  // the box is the foothold region shrunk by the margin
+  SegmentedTerrainMap::Region region;
+  ASSERT_TRUE(terrainMapPtr->getFootholdRegion(rfNominalFoothold, region));
+  const scalar_t halfWidth = region.halfWidth - config.regionMargin;
+  EXPECT_TRUE(isFeasible(*rfConfig, region.center.head<2>() + vector2_t(halfWidth, halfWidth) * 0.999));
+  EXPECT_FALSE(isFeasible(*rfConfig, region.center.head<2>() + vector2_t(halfWidth, 0.0) * 1.001));
+  EXPECT_FALSE(isFeasible(*rfConfig, region.center.head<2>() - vector2_t(0.0, halfWidth) * 1.001));
+}
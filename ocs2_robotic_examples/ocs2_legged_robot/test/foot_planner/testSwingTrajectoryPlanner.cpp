@@ -0,0 +1,115 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_legged_robot/common/Types.h"
+#include "ocs2_legged_robot/foot_planner/SwingTrajectoryPlanner.h"
+#include "ocs2_legged_robot/gait/MotionPhaseDefinition.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+class TestSwingTrajectoryPlanner : public ::testing::Test {
+ public:
+  TestSwingTrajectoryPlanner() {
+    config.liftOffVelocity = 0.2;
+    config.touchDownVelocity = -0.4;
+    config.swingHeight = 0.1;
+    config.swingTimeScale = 0.15;
+
+    // trot with a swing of LH over two phases
+    modeSchedule.eventTimes = {0.1, 0.45, 0.5, 0.7, 0.95};
+    modeSchedule.modeSequence = {ModeNumber::STANCE, ModeNumber::RF_LH, ModeNumber::STANCE, ModeNumber::LF_RH, ModeNumber::LF_RF_RH,
+                                 ModeNumber::STANCE};
+
+    for (size_t leg = 0; leg < numFeet; leg++) {
+      for (size_t p = 0; p < modeSchedule.modeSequence.size(); p++) {
+        liftOffHeightSequence[leg].push_back(0.01 * leg + 0.02 * p);
+        touchDownHeightSequence[leg].push_back(0.01 * leg - 0.03 * p);
+      }
+    }
+  }
+
+  /** Checks getZReferences against the per foot spline evaluation. */
+  void checkReferences(const SwingTrajectoryPlanner& planner, scalar_t time) const {
+    feet_vector_t positions, velocities;
+    planner.getZReferences(time, positions, velocities);
+    for (size_t leg = 0; leg < numFeet; leg++) {
+      EXPECT_NEAR(positions(leg), planner.getZpositionConstraint(leg, time), tolerance) << "leg: " << leg << ", time: " << time;
+      EXPECT_NEAR(velocities(leg), planner.getZvelocityConstraint(leg, time), tolerance) << "leg: " << leg << ", time: " << time;
+    }
+  }
+
+  static constexpr size_t numFeet = 4;
+  static constexpr scalar_t tolerance = 1e-9;
+  SwingTrajectoryPlanner::Config config;
+  ModeSchedule modeSchedule;
+  feet_array_t<scalar_array_t> liftOffHeightSequence;
+  feet_array_t<scalar_array_t> touchDownHeightSequence;
+};
+
+constexpr size_t TestSwingTrajectoryPlanner::numFeet;
+constexpr scalar_t TestSwingTrajectoryPlanner::tolerance;
+
+TEST_F(TestSwingTrajectoryPlanner, referencesOnGrid) {
+  SwingTrajectoryPlanner planner(config, numFeet);
+  planner.update(modeSchedule, liftOffHeightSequence, touchDownHeightSequence);
+
+  const scalar_t dt = 0.0037;
+  for (scalar_t time = -0.1; time < 1.2; time += dt) {
+    checkReferences(planner, time);
+  }
+}
+
+TEST_F(TestSwingTrajectoryPlanner, referencesAtEvents) {
+  SwingTrajectoryPlanner planner(config, numFeet);
+  planner.update(modeSchedule, liftOffHeightSequence, touchDownHeightSequence);
+
+  for (const auto eventTime : modeSchedule.eventTimes) {
+    checkReferences(planner, eventTime - 1e-6);
+    checkReferences(planner, eventTime);
+    checkReferences(planner, eventTime + 1e-6);
+  }
+}
+
+TEST_F(TestSwingTrajectoryPlanner, flatTerrain) {
+  SwingTrajectoryPlanner planner(config, numFeet);
+  planner.update(ModeSchedule({}, {ModeNumber::STANCE}), 0.3);
+
+  feet_vector_t positions, velocities;
+  planner.getZReferences(0.5, positions, velocities);
+  EXPECT_TRUE(positions.isApproxToConstant(0.3));
+  EXPECT_TRUE(velocities.isZero());
+
+  planner.update(modeSchedule, 0.0);
+  for (scalar_t time = 0.0; time < 1.0; time += 0.01) {
+    checkReferences(planner, time);
+  }
+}
@@ -0,0 +1,85 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "ocs2_legged_robot/gait/GaitSchedule.h"
+#include "ocs2_legged_robot/gait/MotionPhaseDefinition.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+namespace {
+GaitSchedule createStanceGaitSchedule() {
+  const ModeSchedule initModeSchedule({0.5}, {ModeNumber::STANCE, ModeNumber::STANCE});
+  const ModeSequenceTemplate stanceTemplate({0.0, 1.0}, {ModeNumber::STANCE});
+  const scalar_t phaseTransitionStanceTime = 0.2;
+  return GaitSchedule(initModeSchedule, stanceTemplate, phaseTransitionStanceTime);
+}
+}  // unnamed namespace
+
+/**
+ * SwitchedModelReferenceManager reports the mode schedule of the GaitSchedule as its input whenever it changes. Replaying these mode
+ * schedules with setModeSchedule() on a GaitSchedule that never received the gait command must give the same mode schedules.
+ */
+TEST(TestGaitSchedule, replayModeSchedules) {
+  const ModeSequenceTemplate trot({0.0, 0.3, 0.6}, {ModeNumber::LF_RH, ModeNumber::RF_LH});
+  const scalar_t timeHorizon = 1.0;
+  const scalar_t mpcPeriod = 0.02;
+
+  auto recordedGaitSchedule = createStanceGaitSchedule();
+  auto replayedGaitSchedule = createStanceGaitSchedule();
+  ModeSchedule lastModeSchedule;
+  for (size_t k = 0; k < 300; ++k) {
+    const scalar_t initTime = k * mpcPeriod;
+    const scalar_t finalTime = initTime + timeHorizon;
+    if (k == 10) {  // gait command as sent by the GaitReceiver
+      recordedGaitSchedule.insertModeSequenceTemplate(trot, finalTime, timeHorizon);
+    }
+
+    // same time window as SwitchedModelReferenceManager::modifyReferences()
+    const auto modeSchedule = recordedGaitSchedule.getModeSchedule(initTime - timeHorizon, finalTime + timeHorizon);
+    const bool isUpdated =
+        k == 0 || modeSchedule.eventTimes != lastModeSchedule.eventTimes || modeSchedule.modeSequence != lastModeSchedule.modeSequence;
+    if (isUpdated) {
+      lastModeSchedule = modeSchedule;
+      replayedGaitSchedule.setModeSchedule(modeSchedule);
+    }
+
+    const auto replayedModeSchedule = replayedGaitSchedule.getModeSchedule(initTime - timeHorizon, finalTime + timeHorizon);
+    ASSERT_EQ(replayedModeSchedule.eventTimes, modeSchedule.eventTimes) << "MPC call " << k;
+    ASSERT_EQ(replayedModeSchedule.modeSequence, modeSchedule.modeSequence) << "MPC call " << k;
+  }
+
+  // the gait command has changed the mode schedule
+  EXPECT_NE(std::count(lastModeSchedule.modeSequence.begin(), lastModeSchedule.modeSequence.end(), ModeNumber::LF_RH), 0);
+}
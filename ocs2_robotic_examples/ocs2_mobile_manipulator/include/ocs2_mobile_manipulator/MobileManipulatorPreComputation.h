@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string>
 
 #include <ocs2_core/PreComputation.h>
+#include <ocs2_pinocchio_interface/PinocchioEndEffectorKinematics.h>
 #include <ocs2_pinocchio_interface/PinocchioInterface.h>
 
 #include <ocs2_mobile_manipulator/ManipulatorModelInfo.h>
@@ -57,9 +58,14 @@ class MobileManipulatorPreComputation : public PreComputation {
   PinocchioInterface& getPinocchioInterface() { return pinocchioInterface_; }
   const PinocchioInterface& getPinocchioInterface() const { return pinocchioInterface_; }
 
+  /** Kinematics of the end-effector frame, computed in the same pass as the pinocchio data. */
+  const PinocchioEndEffectorKinematics::Kinematics& getEndEffectorKinematics() const { return eeKinematics_; }
+
  private:
   PinocchioInterface pinocchioInterface_;
   MobileManipulatorPinocchioMapping pinocchioMapping_;
+  std::unique_ptr<PinocchioEndEffectorKinematics> eeKinematicsPtr_;
+  PinocchioEndEffectorKinematics::Kinematics eeKinematics_;
 };
 
 }  // namespace mobile_manipulator
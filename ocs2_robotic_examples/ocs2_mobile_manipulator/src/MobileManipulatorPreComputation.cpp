@@ -42,7 +42,9 @@ namespace mobile_manipulator {
 /******************************************************************************************************/
 /******************************************************************************************************/
 MobileManipulatorPreComputation::MobileManipulatorPreComputation(PinocchioInterface pinocchioInterface, const ManipulatorModelInfo& info)
-    : pinocchioInterface_(std::move(pinocchioInterface)), pinocchioMapping_(info) {}
+    : pinocchioInterface_(std::move(pinocchioInterface)),
+      pinocchioMapping_(info),
+      eeKinematicsPtr_(new PinocchioEndEffectorKinematics(pinocchioInterface_, pinocchioMapping_, {info.eeFrame})) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -72,6 +74,8 @@ void MobileManipulatorPreComputation::request(RequestSet request, scalar_t t, co
     pinocchio::forwardKinematics(model, data, q);
     pinocchio::updateFramePlacements(model, data);
   }
+
+  eeKinematicsPtr_->computeKinematics(pinocchioInterface_, x, nullptr, request.contains(Request::Approximation), eeKinematics_);
 }
 
 /******************************************************************************************************/
@@ -94,6 +98,8 @@ void MobileManipulatorPreComputation::requestFinal(RequestSet request, scalar_t
     pinocchio::forwardKinematics(model, data, q);
     pinocchio::updateFramePlacements(model, data);
   }
+
+  eeKinematicsPtr_->computeKinematics(pinocchioInterface_, x, nullptr, request.contains(Request::Approximation), eeKinematics_);
 }
 
 }  // namespace mobile_manipulator
@@ -63,7 +63,7 @@ vector_t EndEffectorConstraint::getValue(scalar_t time, const vector_t& state, c
   // PinocchioEndEffectorKinematics requires pre-computation with shared PinocchioInterface.
   if (pinocchioEEKinPtr_ != nullptr) {
     const auto& preCompMM = cast<MobileManipulatorPreComputation>(preComputation);
-    pinocchioEEKinPtr_->setPinocchioInterface(preCompMM.getPinocchioInterface());
+    pinocchioEEKinPtr_->setPinocchioInterface(preCompMM.getPinocchioInterface(), preCompMM.getEndEffectorKinematics());
   }
 
   const auto desiredPositionOrientation = interpolateEndEffectorPose(time);
@@ -82,7 +82,7 @@ VectorFunctionLinearApproximation EndEffectorConstraint::getLinearApproximation(
   // PinocchioEndEffectorKinematics requires pre-computation with shared PinocchioInterface.
   if (pinocchioEEKinPtr_ != nullptr) {
     const auto& preCompMM = cast<MobileManipulatorPreComputation>(preComputation);
-    pinocchioEEKinPtr_->setPinocchioInterface(preCompMM.getPinocchioInterface());
+    pinocchioEEKinPtr_->setPinocchioInterface(preCompMM.getPinocchioInterface(), preCompMM.getEndEffectorKinematics());
   }
 
   const auto desiredPositionOrientation = interpolateEndEffectorPose(time);
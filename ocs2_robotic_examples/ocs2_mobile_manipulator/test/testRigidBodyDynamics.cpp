@@ -0,0 +1,146 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>
+
+#include <pinocchio/algorithm/aba.hpp>
+#include <pinocchio/multibody/joint/joint-free-flyer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/dynamics/SystemDynamicsBaseAD.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/LoadData.h>
+#include <ocs2_pinocchio_interface/PinocchioRigidBodyDynamics.h>
+#include <ocs2_pinocchio_interface/urdf.h>
+#include <ocs2_robotic_assets/package_path.h>
+
+#include "ocs2_mobile_manipulator/FactoryFunctions.h"
+#include "ocs2_mobile_manipulator/package_path.h"
+
+using namespace ocs2;
+using namespace mobile_manipulator;
+
+namespace {
+
+/** The CppAD-generated equivalent of PinocchioRigidBodyDynamics */
+class RigidBodyDynamicsCppAd final : public SystemDynamicsBaseAD {
+ public:
+  RigidBodyDynamicsCppAd(const PinocchioInterface& pinocchioInterface, const std::string& modelName, const std::string& modelFolder)
+      : pinocchioInterfaceCppAd_(pinocchioInterface.toCppAd()) {
+    const size_t nv = pinocchioInterface.getModel().nv;
+    initialize(2 * nv, nv, modelName, modelFolder, true, false);
+  }
+  ~RigidBodyDynamicsCppAd() override = default;
+  RigidBodyDynamicsCppAd* clone() const override { return new RigidBodyDynamicsCppAd(*this); }
+
+ private:
+  RigidBodyDynamicsCppAd(const RigidBodyDynamicsCppAd& rhs) = default;
+
+  ad_vector_t systemFlowMap(ad_scalar_t time, const ad_vector_t& state, const ad_vector_t& input,
+                            const ad_vector_t& parameters) const override {
+    auto pinocchioInterfaceCppAd = pinocchioInterfaceCppAd_;
+    const auto& model = pinocchioInterfaceCppAd.getModel();
+    auto& data = pinocchioInterfaceCppAd.getData();
+    const auto nv = model.nv;
+
+    ad_vector_t dxdt(2 * nv);
+    dxdt.head(nv) = state.tail(nv);
+    dxdt.tail(nv) = pinocchio::aba(model, data, state.head(nv), state.tail(nv), input);
+    return dxdt;
+  }
+
+  PinocchioInterfaceCppAd pinocchioInterfaceCppAd_;
+};
+
+const std::string URDF_FILE = ocs2::robotic_assets::getPath() + "/resources/mobile_manipulator/mabi_mobile/urdf/mabi_mobile.urdf";
+
+PinocchioInterface createMobileManipulatorPinocchioInterface() {
+  const std::string taskFile = ocs2::mobile_manipulator::getPath() + "/config/mabi_mobile/task.info";
+
+  // read manipulator type
+  ManipulatorModelType modelType = mobile_manipulator::loadManipulatorType(taskFile, "model_information.manipulatorModelType");
+  // read the joints to make fixed
+  std::vector<std::string> removeJointNames;
+  loadData::loadStdVector<std::string>(taskFile, "model_information.removeJoints", removeJointNames, false);
+  // initialize pinocchio interface
+  return createPinocchioInterface(URDF_FILE, modelType, removeJointNames);
+}
+
+}  // unnamed namespace
+
+TEST(testRigidBodyDynamics, AnalyticalVsAutoDiff) {
+  constexpr size_t numTests = 100;
+  constexpr scalar_t tol = 1e-6;
+  const std::string libraryFolder = ocs2::mobile_manipulator::getPath() + "/auto_generated";
+
+  const PinocchioInterface pinocchioInterface = createMobileManipulatorPinocchioInterface();
+
+  // startup
+  benchmark::RepeatedTimer startupTimer, startupTimerAd;
+  startupTimer.startTimer();
+  PinocchioRigidBodyDynamics dynamics(pinocchioInterface);
+  startupTimer.endTimer();
+
+  startupTimerAd.startTimer();
+  RigidBodyDynamicsCppAd dynamicsAd(pinocchioInterface, "testRigidBodyDynamics", libraryFolder);
+  startupTimerAd.endTimer();
+
+  // runtime
+  benchmark::RepeatedTimer timer, timerAd;
+  for (size_t i = 0; i < numTests; i++) {
+    const vector_t state = vector_t::Random(dynamics.getStateDim());
+    const vector_t input = 10.0 * vector_t::Random(dynamics.getInputDim());
+
+    timer.startTimer();
+    const auto linearApproximation = dynamics.linearApproximation(0.0, state, input, PreComputation());
+    timer.endTimer();
+
+    timerAd.startTimer();
+    const auto linearApproximationAd = dynamicsAd.linearApproximation(0.0, state, input, PreComputation());
+    timerAd.endTimer();
+
+    EXPECT_TRUE(linearApproximation.f.isApprox(dynamics.computeFlowMap(0.0, state, input, PreComputation()), tol));
+    EXPECT_TRUE(linearApproximation.f.isApprox(linearApproximationAd.f, tol));
+    EXPECT_TRUE(linearApproximation.dfdx.isApprox(linearApproximationAd.dfdx, tol));
+    EXPECT_TRUE(linearApproximation.dfdu.isApprox(linearApproximationAd.dfdu, tol));
+  }
+
+  std::cerr << "\nRigid body dynamics of mabi_mobile (nv = " << dynamics.getInputDim() << ")\n";
+  std::cerr << "startup: analytical " << startupTimer.getTotalInMilliseconds() << " [ms], CppAD " << startupTimerAd.getTotalInMilliseconds()
+            << " [ms]\n";
+  std::cerr << "linear approximation: analytical " << timer.getAverageInMilliseconds() << " [ms], CppAD "
+            << timerAd.getAverageInMilliseconds() << " [ms]\n";
+}
+
+TEST(testRigidBodyDynamics, throwsForQuaternionFloatingBase) {
+  const PinocchioInterface pinocchioInterface = getPinocchioInterfaceFromUrdfFile(URDF_FILE, pinocchio::JointModelFreeFlyer());
+  ASSERT_NE(pinocchioInterface.getModel().nq, pinocchioInterface.getModel().nv);
+  EXPECT_THROW(PinocchioRigidBodyDynamics{pinocchioInterface}, std::runtime_error);
+}
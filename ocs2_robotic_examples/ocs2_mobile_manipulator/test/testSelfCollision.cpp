@@ -156,3 +156,33 @@ TEST_F(TestSelfCollision, testRandomJointPositions) {
     ASSERT_TRUE(Jd1.isApprox(Jd2));
   }
 }
+
+TEST_F(TestSelfCollision, BroadPhaseAndWarmStart) {
+  const scalar_t activationDistance = minDistance + 0.1;
+  SelfCollision selfCollision(geometryInterface, minDistance);
+  SelfCollision selfCollisionCulled(geometryInterface, minDistance, activationDistance, true);
+
+  computeLinearApproximation(pinocchioInterface, jointPositon);
+
+  vector_t d1, d2;
+  matrix_t Jd1, Jd2;
+  std::tie(d1, Jd1) = selfCollision.getLinearApproximation(pinocchioInterface);
+  // the second evaluation at the same time is warm started
+  for (int i = 0; i < 2; ++i) {
+    std::tie(d2, Jd2) = selfCollisionCulled.getLinearApproximation(0.0, pinocchioInterface);
+  }
+  const vector_t d3 = selfCollisionCulled.getValue(0.0, pinocchioInterface);
+  EXPECT_TRUE(d2.isApprox(d3));
+
+  ASSERT_EQ(d1.size(), d2.size());
+  for (int i = 0; i < d1.size(); ++i) {
+    if (d1[i] + minDistance < activationDistance) {
+      EXPECT_NEAR(d1[i], d2[i], 1e-6);
+      EXPECT_TRUE(Jd1.row(i).isApprox(Jd2.row(i), 1e-6));
+    } else {
+      // the distances beyond the activation distance are saturated, including the pairs culled by the broad phase
+      EXPECT_DOUBLE_EQ(d2[i], activationDistance - minDistance);
+      EXPECT_TRUE(Jd2.row(i).isZero());
+    }
+  }
+}
@@ -0,0 +1,149 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>
+
+#include <pinocchio/algorithm/frames.hpp>
+#include <pinocchio/algorithm/kinematics.hpp>
+#include <pinocchio/multibody/geometry.hpp>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/LoadData.h>
+#include <ocs2_robotic_assets/package_path.h>
+#include <ocs2_self_collision/SelfCollision.h>
+#include <ocs2_self_collision/SelfCollisionCppAd.h>
+#include <ocs2_sphere_approximation/SphereSelfCollision.h>
+
+#include "ocs2_mobile_manipulator/FactoryFunctions.h"
+#include "ocs2_mobile_manipulator/package_path.h"
+
+using namespace ocs2;
+using namespace mobile_manipulator;
+
+class TestSphereSelfCollision : public ::testing::Test {
+ public:
+  TestSphereSelfCollision()
+      : pinocchioInterface(createMobileManipulatorPinocchioInterface()),
+        geometryInterface(pinocchioInterface, collisionLinkPairs),
+        sphereInterface(pinocchioInterface, {"ARM", "SHOULDER", "FOREARM", "WRIST_1"}, {0.20, 0.10, 0.05, 0.05}, 0.7) {}
+
+  void computeLinearApproximation(PinocchioInterface& pinocchioInterface, const vector_t& q) {
+    const auto& model = pinocchioInterface.getModel();
+    auto& data = pinocchioInterface.getData();
+    pinocchio::computeJointJacobians(model, data, q);  // also computes forwardKinematics
+    pinocchio::updateGlobalPlacements(model, data);
+  }
+
+  // initial joint configuration
+  const vector_t jointPositon = (vector_t(9) << 1.0, 1.0, 0.5, 2.5, -1.0, 1.5, 0.0, 1.0, 0.0).finished();
+  const std::vector<std::pair<std::string, std::string>> collisionLinkPairs = {{"ARM", "WRIST_1"}, {"SHOULDER", "WRIST_1"}};
+
+  const std::string libraryFolder = ocs2::mobile_manipulator::getPath() + "/auto_generated";
+  const scalar_t minDistance = 0.1;
+
+  PinocchioInterface pinocchioInterface;
+  PinocchioGeometryInterface geometryInterface;
+  PinocchioSphereInterface sphereInterface;
+
+ protected:
+  PinocchioInterface createMobileManipulatorPinocchioInterface() {
+    const std::string urdfPath = ocs2::robotic_assets::getPath() + "/resources/mobile_manipulator/mabi_mobile/urdf/mabi_mobile.urdf";
+    const std::string taskFile = ocs2::mobile_manipulator::getPath() + "/config/mabi_mobile/task.info";
+
+    // read manipulator type
+    ManipulatorModelType modelType = mobile_manipulator::loadManipulatorType(taskFile, "model_information.manipulatorModelType");
+    // read the joints to make fixed
+    std::vector<std::string> removeJointNames;
+    loadData::loadStdVector<std::string>(taskFile, "model_information.removeJoints", removeJointNames, false);
+    // initialize pinocchio interface
+    return createPinocchioInterface(urdfPath, modelType, removeJointNames);
+  }
+};
+
+TEST_F(TestSphereSelfCollision, FiniteDifferenceApproximation) {
+  const SphereSelfCollision sphereSelfCollision(sphereInterface, collisionLinkPairs, minDistance);
+  ASSERT_EQ(sphereSelfCollision.getNumCollisionPairs(), collisionLinkPairs.size());
+
+  computeLinearApproximation(pinocchioInterface, jointPositon);
+  vector_t d;
+  matrix_t Jd;
+  std::tie(d, Jd) = sphereSelfCollision.getLinearApproximation(pinocchioInterface);
+
+  const scalar_t eps = 1e-6;
+  matrix_t JdFiniteDifference(d.size(), jointPositon.size());
+  for (int i = 0; i < jointPositon.size(); ++i) {
+    vector_t q = jointPositon;
+    q(i) += eps;
+    pinocchio::forwardKinematics(pinocchioInterface.getModel(), pinocchioInterface.getData(), q);
+    JdFiniteDifference.col(i) = (sphereSelfCollision.getValue(pinocchioInterface) - d) / eps;
+  }
+  EXPECT_TRUE(Jd.isApprox(JdFiniteDifference, 1e-4));
+}
+
+TEST_F(TestSphereSelfCollision, LowerBoundOfExactDistance) {
+  const SphereSelfCollision sphereSelfCollision(sphereInterface, collisionLinkPairs, minDistance);
+  const SelfCollision selfCollision(geometryInterface, minDistance);
+
+  computeLinearApproximation(pinocchioInterface, jointPositon);
+  const vector_t sphereDistances = sphereSelfCollision.getValue(pinocchioInterface);
+  const vector_t exactDistances = selfCollision.getValue(pinocchioInterface);
+  // the spheres cover the primitive shapes (a link can hold several collision objects, hence only the minima are compared)
+  EXPECT_LE(sphereDistances.minCoeff(), exactDistances.minCoeff() + 1e-9);
+}
+
+TEST_F(TestSphereSelfCollision, BenchmarkAgainstCppAd) {
+  constexpr int numRepetitions = 1000;
+
+  const SphereSelfCollision sphereSelfCollision(sphereInterface, collisionLinkPairs, minDistance);
+  const SelfCollisionCppAd selfCollisionCppAd(pinocchioInterface, geometryInterface, minDistance, "testSphereSelfCollision", libraryFolder,
+                                              true, false);
+
+  benchmark::RepeatedTimer sphereTimer, cppAdTimer;
+  for (int i = 0; i < numRepetitions; ++i) {
+    const vector_t q = jointPositon + 0.1 * vector_t::Random(jointPositon.size());
+    computeLinearApproximation(pinocchioInterface, q);
+
+    sphereTimer.startTimer();
+    const auto sphereApproximation = sphereSelfCollision.getLinearApproximation(pinocchioInterface);
+    sphereTimer.endTimer();
+
+    cppAdTimer.startTimer();
+    const auto cppAdApproximation = selfCollisionCppAd.getLinearApproximation(pinocchioInterface, q);
+    cppAdTimer.endTimer();
+  }
+
+  std::cerr << "\n########################################################################\n";
+  std::cerr << "Self-collision linear approximation over " << numRepetitions << " configurations:\n";
+  std::cerr << "SphereSelfCollision (" << sphereSelfCollision.getNumCollisionPairs() << " pairs): average "
+            << sphereTimer.getAverageInMilliseconds() << " [ms], max " << sphereTimer.getMaxIntervalInMilliseconds() << " [ms]\n";
+  std::cerr << "SelfCollisionCppAd (" << selfCollisionCppAd.getNumCollisionPairs() << " pairs): average "
+            << cppAdTimer.getAverageInMilliseconds() << " [ms], max " << cppAdTimer.getMaxIntervalInMilliseconds() << " [ms]\n";
+}
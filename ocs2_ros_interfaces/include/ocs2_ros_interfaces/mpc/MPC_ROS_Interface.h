@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_mpc/ClosedLoopRecorder.h>
 #include <ocs2_mpc/CommandData.h>
 #include <ocs2_mpc/MPC_BASE.h>
 #include <ocs2_mpc/SystemObservation.h>
@@ -102,6 +103,19 @@ class MPC_ROS_Interface {
    */
   void launchNodes(ros::NodeHandle& nodeHandle);
 
+  /**
+   * Starts recording the observations and references of the following MPC iterations, such that they can be replayed offline without
+   * ROS by replayClosedLoop(). A running recording is stopped.
+   *
+   * @param [in] filename: The file to which the recording is written.
+   */
+  void startRecording(const std::string& filename);
+
+  /**
+   * Stops the recording.
+   */
+  void stopRecording();
+
  protected:
   /**
    * Callback to reset MPC.
@@ -131,8 +145,9 @@ class MPC_ROS_Interface {
    * Updates the buffer variables from the MPC object. This method is automatically called by advanceMpc()
    *
    * @param [in] mpcInitObservation: The observation used to run the MPC.
+   * @param [out] policyInputPtr: If not nullptr, the input of the buffered policy at the observation.
    */
-  void copyToBuffer(const SystemObservation& mpcInitObservation);
+  void copyToBuffer(const SystemObservation& mpcInitObservation, vector_t* policyInputPtr = nullptr);
 
   /**
    * The callback method which receives the current observation, invokes the MPC algorithm,
@@ -142,6 +157,17 @@ class MPC_ROS_Interface {
    */
   void mpcObservationCallback(const ocs2_msgs::mpc_observation::ConstPtr& msg);
 
+  /**
+   * Records the MPC iteration if a recording is running. This method is automatically called by mpcObservationCallback() after the
+   * policy is published.
+   *
+   * @param [in] mpcInitObservation: The observation used to run the MPC.
+   * @param [in] controllerIsUpdated: Whether the MPC returned a new policy.
+   * @param [in] latency: The duration of the MPC call in milliseconds.
+   * @param [in] policyInput: The input of the buffered policy at the observation.
+   */
+  void recordMpcIteration(const SystemObservation& mpcInitObservation, bool controllerIsUpdated, scalar_t latency, vector_t policyInput);
+
  protected:
   /*
    * Variables
@@ -179,6 +205,9 @@ class MPC_ROS_Interface {
   // MPC reset
   std::mutex resetMutex_;
   std::atomic_bool resetRequestedEver_{false};
+
+  // closed-loop recording, guarded by resetMutex_
+  std::unique_ptr<ClosedLoopRecorder> recorderPtr_;
 };
 
 }  // namespace ocs2
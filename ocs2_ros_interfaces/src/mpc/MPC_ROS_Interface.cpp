@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_ros_interfaces/mpc/MPC_ROS_Interface.h"
 
+#include <chrono>
+
 #include "ocs2_ros_interfaces/common/RosMsgConversions.h"
 
 namespace ocs2 {
@@ -212,7 +214,7 @@ void MPC_ROS_Interface::publisherWorker() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void MPC_ROS_Interface::copyToBuffer(const SystemObservation& mpcInitObservation) {
+void MPC_ROS_Interface::copyToBuffer(const SystemObservation& mpcInitObservation, vector_t* policyInputPtr) {
   // buffer policy mutex
   std::lock_guard<std::mutex> policyBufferLock(bufferMutex_);
 
@@ -222,6 +224,9 @@ void MPC_ROS_Interface::copyToBuffer(const SystemObservation& mpcInitObservation
     finalTime = mpc_.getSolverPtr()->getFinalTime();
   }
   mpc_.getSolverPtr()->getPrimalSolution(finalTime, bufferPrimalSolutionPtr_.get());
+  if (policyInputPtr != nullptr) {
+    *policyInputPtr = bufferPrimalSolutionPtr_->controllerPtr_->computeInput(mpcInitObservation.time, mpcInitObservation.state);
+  }
 
   // command
   bufferCommandPtr_->mpcInitObservation_ = mpcInitObservation;
@@ -249,11 +254,15 @@ void MPC_ROS_Interface::mpcObservationCallback(const ocs2_msgs::mpc_observation:
   mpcTimer_.startTimer();
 
   // run MPC
+  const auto runStartTime = std::chrono::steady_clock::now();
   bool controllerIsUpdated = mpc_.run(currentObservation.time, currentObservation.state);
+  const scalar_t runLatency = std::chrono::duration<scalar_t, std::milli>(std::chrono::steady_clock::now() - runStartTime).count();
   if (!controllerIsUpdated) {
+    recordMpcIteration(currentObservation, controllerIsUpdated, runLatency, vector_t());
     return;
   }
-  copyToBuffer(currentObservation);
+  vector_t policyInput;
+  copyToBuffer(currentObservation, recorderPtr_ != nullptr ? &policyInput : nullptr);
 
   // measure the delay for sending ROS messages
   mpcTimer_.endTimer();
@@ -287,6 +296,36 @@ void MPC_ROS_Interface::mpcObservationCallback(const ocs2_msgs::mpc_observation:
       createMpcPolicyMsg(*bufferPrimalSolutionPtr_, *bufferCommandPtr_, *bufferPerformanceIndicesPtr_);
   mpcPolicyPublisher_.publish(mpcPolicyMsg);
 #endif
+
+  recordMpcIteration(currentObservation, controllerIsUpdated, runLatency, std::move(policyInput));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::recordMpcIteration(const SystemObservation& mpcInitObservation, bool controllerIsUpdated, scalar_t latency,
+                                           vector_t policyInput) {
+  if (recorderPtr_ != nullptr) {
+    recorderPtr_->record(mpcInitObservation, mpc_.getSolverPtr()->getReferenceManager(), controllerIsUpdated, latency,
+                         std::move(policyInput));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::startRecording(const std::string& filename) {
+  std::lock_guard<std::mutex> resetLock(resetMutex_);
+  recorderPtr_.reset();  // closes the previous recording before a new file is opened
+  recorderPtr_.reset(new ClosedLoopRecorder(filename));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::stopRecording() {
+  std::lock_guard<std::mutex> resetLock(resetMutex_);
+  recorderPtr_.reset();
 }
 
 /******************************************************************************************************/
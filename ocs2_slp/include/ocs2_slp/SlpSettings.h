@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <limits>
+#include <string>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
 
@@ -47,6 +50,7 @@ struct Settings {
   // Linesearch - step size rules
   scalar_t alpha_decay = 0.5;  // multiply the step size by this factor every time a linesearch step is rejected.
   scalar_t alpha_min = 1e-4;   // terminate linesearch if the attempted step size is below this threshold
+  bool speculativeLinesearch = false;  // evaluate the step sizes concurrently on the thread pool and take the largest accepted one
 
   // Linesearch - step acceptance criteria with c = costs, g = the norm of constraint violation, and w = [x; u]
   scalar_t g_max = 1e6;          // (1): IF g{i+1} > g_max REQUIRE g{i+1} < (1-gamma_c) * g{i}
@@ -55,7 +59,9 @@ struct Settings {
   scalar_t gamma_c = 1e-6;       // (3): ELSE REQUIRE c{i+1} < (c{i} - gamma_c * g{i}) OR g{i+1} < (1-gamma_c) * g{i}
 
   // Discretization method
-  scalar_t dt = 0.01;  // user-defined time discretization
+  scalar_t dt = 0.01;                                     // user-defined time discretization
+  scalar_t dtGrowthFactor = 1.0;                          // growth of the time step along the horizon, 1.0 gives a uniform grid
+  scalar_t dtMax = std::numeric_limits<scalar_t>::max();  // upper bound on the time step of a graded grid
   SensitivityIntegratorType integratorType = SensitivityIntegratorType::RK2;
 
   // Inequality penalty relaxed barrier parameters
@@ -65,11 +71,19 @@ struct Settings {
   // Extract the Lagrange multiplier of the projected state-input constraint Cx+Du+e
   bool extractProjectionMultiplier = false;
 
+  // Warm start of the LP subproblem solver
+  bool warmStart = false;                // Initialize the PIPG duals with the time-shifted duals of the previous subproblem
+  scalar_t scalingReuseTolerance = 0.1;  // Reuse pre-conditioning and eigenvalue bounds if the relative change of the data is below this
+
   // Printing
   bool printSolverStatus = false;      // Print HPIPM status after solving the QP subproblem
   bool printSolverStatistics = false;  // Print benchmarking of the multiple shooting method
   bool printLinesearch = false;        // Print linesearch information
 
+  // Recording of the QP subproblems, e.g., for benchmarking QP solvers offline on the problems of a real run
+  std::string lqRecordingFile = "";  // binary file the QP subproblems are appended to, empty disables the recording
+  size_t lqRecordingPeriod = 1;      // record every lqRecordingPeriod-th QP subproblem
+
   // Threading
   size_t nThreads = 4;
   int threadPriority = 50;
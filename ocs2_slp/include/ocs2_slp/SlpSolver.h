@@ -36,6 +36,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h>
 #include <ocs2_oc/oc_data/TimeDiscretization.h>
+#include <ocs2_oc/oc_problem/LqSubproblemRecorder.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/oc_solver/SolverBase.h>
 #include <ocs2_oc/search_strategy/FilterLinesearch.h>
@@ -69,6 +70,9 @@ class SlpSolver : public SolverBase {
 
   size_t getNumIterations() const override { return totalNumIterations_; }
 
+  /** Returns the total number of PIPG iterations since the last reset() */
+  size_t getNumPipgIterations() const { return totalNumPipgIterations_; }
+
   const OptimalControlProblem& getOptimalControlProblem() const override { return ocpDefinitions_.front(); }
 
   const PerformanceIndex& getPerformanceIndeces() const override { return getIterationsLog().back(); };
@@ -122,7 +126,7 @@ class SlpSolver : public SolverBase {
 
   /** Creates QP around t, x(t), u(t). Returns performance metrics at the current {t, x(t), u(t)} */
   PerformanceIndex setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                            const vector_array_t& u, std::vector<Metrics>& metrics);
+                                            const vector_array_t& u);
 
   /** Computes only the performance metrics at the current {t, x(t), u(t)} */
   PerformanceIndex computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
@@ -134,7 +138,19 @@ class SlpSolver : public SolverBase {
     vector_array_t deltaUSol;      // delta_u(t)
     scalar_t armijoDescentMetric;  // inner product of the cost gradient and decision variable step
   };
-  OcpSubproblemSolution getOCPSolution(const vector_t& delta_x0);
+  OcpSubproblemSolution getOCPSolution(const std::vector<AnnotatedTime>& time, const vector_t& delta_x0);
+
+  /**
+   * Pre-conditions the LP subproblem in place. In warm start mode, the scaling factors of the previous subproblem are reused if the
+   * problem data has not changed more than settings_.scalingReuseTolerance. Returns true if the previous scaling is reused.
+   */
+  bool preconditionSubproblem(const OcpSize& ocpSize, const vector_t& delta_x0, vector_array_t& scalingVectors);
+
+  /** Sets the PIPG dual warm start by interpolating the unscaled duals of the previous subproblem at the new time discretization */
+  void setPipgDualWarmStart(const std::vector<AnnotatedTime>& time);
+
+  /** Stores the unscaled duals of the last PIPG solve for warm starting the next subproblem */
+  void cachePipgDualSolution(const std::vector<AnnotatedTime>& time);
 
   /** Constructs the primal solution based on the optimized state and input trajectories */
   PrimalSolution toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u);
@@ -144,6 +160,11 @@ class SlpSolver : public SolverBase {
                          const OcpSubproblemSolution& subproblemSolution, vector_array_t& x, vector_array_t& u,
                          std::vector<Metrics>& metrics);
 
+  /** Same as takeStep(), but the backtracking step sizes are evaluated concurrently if the full step is rejected */
+  slp::StepInfo takeSpeculativeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
+                                    const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
+                                    vector_array_t& u, std::vector<Metrics>& metrics);
+
   /** Determine convergence after a step */
   slp::Convergence checkConvergence(int iteration, const PerformanceIndex& baseline, const slp::StepInfo& stepInfo) const;
 
@@ -158,6 +179,9 @@ class SlpSolver : public SolverBase {
   // Solver interface
   PipgSolver pipgSolver_;
 
+  // Records the QP subproblems before pre-conditioning, nullptr if the recording is disabled
+  std::unique_ptr<LqSubproblemRecorder> lqRecorderPtr_;
+
   // Threading
   ThreadPool threadPool_;
 
@@ -175,6 +199,19 @@ class SlpSolver : public SolverBase {
   // Lagrange multipliers
   std::vector<multiple_shooting::ProjectionMultiplierCoefficients> projectionMultiplierCoefficients_;
 
+  // Pre-conditioning and PIPG bounds of the last subproblem
+  vector_array_t scalingD_, scalingE_;
+  scalar_t scalingC_ = 1.0;
+  scalar_t lambdaScaled_ = 0.0;
+  scalar_t sigmaScaled_ = 0.0;
+  OcpSize scaledOcpSize_;
+  std::vector<VectorFunctionLinearApproximation> scaledDynamics_;  // Unscaled data at the last computed scaling
+  std::vector<ScalarFunctionQuadraticApproximation> scaledCost_;
+
+  // Unscaled PIPG duals of the last subproblem
+  scalar_array_t dualTimeTrajectory_;
+  vector_array_t dualTrajectory_;
+
   // Iteration performance log
   std::vector<PerformanceIndex> performanceIndeces_;
 
@@ -184,6 +221,8 @@ class SlpSolver : public SolverBase {
   // Benchmarking
   size_t numProblems_{0};
   size_t totalNumIterations_{0};
+  size_t numScalingReuses_{0};
+  size_t totalNumPipgIterations_{0};
   benchmark::RepeatedTimer initializationTimer_;
   benchmark::RepeatedTimer linearQuadraticApproximationTimer_;
   benchmark::RepeatedTimer solveQpTimer_;
@@ -0,0 +1,72 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+#pragma once
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+namespace pipg {
+
+/**
+ * Node-wise packed representation of the PIPG operators. At node t, the primal variables are stacked as z_t = [x_t; u_t], (z_N = x_N),
+ * such that the cost hessian, H, the dynamics jacobian, G, and its transpose act on a single contiguous vector:
+ *
+ * H_t = [Q_t  P_t'
+ *        P_t  R_t],   h_t = [q_t; r_t]
+ *
+ * G_t = [A_t  B_t],   C_t x_{t+1} - G_t z_t - b_t = 0
+ *
+ * where C_t is the (diagonal) scaling of the identity part of the dynamics. For node 0, the state blocks are set to zero since x_0 is
+ * fixed. The final node only has a cost hessian and gradient, G_N is empty.
+ */
+struct PackedNode {
+  int numStates = 0;
+  int numInputs = 0;
+
+  matrix_t H;  // cost hessian of z_t
+  vector_t h;  // cost gradient of z_t
+  matrix_t G;  // dynamics jacobian of z_t
+  vector_t b;  // dynamics bias
+  vector_t c;  // scaling vector of x_{t+1}
+};
+
+/**
+ * Packs the LQ approximation into the node-wise representation. The storage of the given packedNodes is reused if the problem size has
+ * not changed.
+ *
+ * @param [in] dynamics : Dynamics array of size N.
+ * @param [in] cost : Cost array of size N + 1.
+ * @param [in] scalingVectors : Vector representation for the identity parts of the dynamics, of size N.
+ * @param [out] packedNodes : The packed nodes of size N + 1.
+ */
+void packOcp(const std::vector<VectorFunctionLinearApproximation>& dynamics, const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+             const vector_array_t& scalingVectors, std::vector<PackedNode>& packedNodes);
+
+}  // namespace pipg
+}  // namespace ocs2
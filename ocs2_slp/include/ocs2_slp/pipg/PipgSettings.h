@@ -44,6 +44,23 @@ struct Settings {
   size_t checkTerminationInterval = 1;
   /** The static lower bound of the cost hessian H. **/
   scalar_t lowerBoundH = 5e-6;
+  /**
+   * Extrapolates the primal iterates with Nesterov's momentum and restarts it once the sum of the primal residual, |Gz - g|, and the dual
+   * residual, |z_k - z_{k-1}| / alpha, increases. On a restart, the solver continues from the last non-extrapolated iterate.
+   **/
+  bool adaptiveRestart = false;
+  /** Minimum number of iterations between two consecutive restarts. **/
+  size_t minRestartInterval = 10;
+  /**
+   * Adapts the dual step size at every iteration to balance the primal residual, |Gz - g|, and the dual residual, |z_{k+1} - z_k| / alpha.
+   * The primal step size follows alpha * (lambda + beta * sigma) = 1 as for the default schedule.
+   **/
+  bool adaptiveStepSize = false;
+  /** The dual step size is scaled by this factor once one of the residuals is residualBalancingRatio times larger than the other. **/
+  scalar_t stepSizeAdaptationFactor = 2.0;
+  scalar_t residualBalancingRatio = 10.0;
+  /** The scaling of the dual step size is kept within [1 / maxStepSizeScaling, maxStepSizeScaling]. **/
+  scalar_t maxStepSizeScaling = 100.0;
   /** This value determines to display the a summary log. */
   bool displayShortSummary = false;
 };
@@ -38,6 +38,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/thread_support/ThreadPool.h>
 #include <ocs2_oc/oc_problem/OcpSize.h>
 
+#include "ocs2_slp/pipg/PackedOcp.h"
 #include "ocs2_slp/pipg/PipgBounds.h"
 #include "ocs2_slp/pipg/PipgSettings.h"
 #include "ocs2_slp/pipg/PipgSolverStatus.h"
@@ -84,6 +85,19 @@ class PipgSolver {
   int getNumDecisionVariables() const { return numDecisionVariables_; }
   int getNumDynamicsConstraints() const { return numDynamicsConstraints_; }
 
+  /**
+   * Sets the initial dual iterate of the dynamics constraints for the next call to solve(). The warm start is used only once and it is
+   * ignored if its size does not match the problem.
+   */
+  void setDualWarmStart(vector_array_t dualWarmStart) { dualWarmStart_ = std::move(dualWarmStart); }
+
+  /** Returns the dual iterate of the dynamics constraints of the last call to solve(). */
+  const vector_array_t& getDualSolution() const { return W_; }
+
+  /** Number of iterations and restarts of the last call to solve(). */
+  size_t getNumIterations() const { return numIterations_; }
+  size_t getNumRestarts() const { return numRestarts_; }
+
   const OcpSize& size() const { return ocpSize_; }
   const pipg::Settings& settings() const { return settings_; }
 
@@ -102,9 +116,19 @@ class PipgSolver {
   int numDecisionVariables_;
   int numDynamicsConstraints_;
 
-  // Data buffer for parallelized PIPG
-  vector_array_t X_, W_, V_, U_;
-  vector_array_t XNew_, UNew_, WNew_;
+  // Packed operators of the current problem
+  std::vector<pipg::PackedNode> packedNodes_;
+
+  // Data buffer for parallelized PIPG. Z_[t] = [x_t; u_t]
+  vector_array_t Z_, W_, V_;
+  vector_array_t ZNew_, WNew_;
+  // The dual of stage t - 1 recomputed by node t
+  vector_array_t VPrev_;
+  // Initial dual iterate of the next solve
+  vector_array_t dualWarmStart_;
+
+  size_t numIterations_ = 0;
+  size_t numRestarts_ = 0;
 };
 
 }  // namespace ocs2
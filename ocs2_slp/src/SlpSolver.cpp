@@ -33,12 +33,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <iostream>
 #include <numeric>
 
+#include <ocs2_core/NumericTraits.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_oc/multiple_shooting/Helpers.h>
 #include <ocs2_oc/multiple_shooting/Initialization.h>
 #include <ocs2_oc/multiple_shooting/MetricsComputation.h>
 #include <ocs2_oc/multiple_shooting/PerformanceIndexComputation.h>
 #include <ocs2_oc/multiple_shooting/Transcription.h>
 #include <ocs2_oc/precondition/Ruzi.h>
+#include <ocs2_oc/search_strategy/SpeculativeLinesearch.h>
 #include <ocs2_oc/trajectory_adjustment/TrajectorySpreadingHelperFunctions.h>
 
 #include "ocs2_slp/Helpers.h"
@@ -64,6 +67,11 @@ SlpSolver::SlpSolver(slp::Settings settings, const OptimalControlProblem& optima
   // Operating points
   initializerPtr_.reset(initializer.clone());
 
+  // QP subproblem recording
+  if (!settings_.lqRecordingFile.empty()) {
+    lqRecorderPtr_.reset(new LqSubproblemRecorder(settings_.lqRecordingFile, settings_.lqRecordingPeriod));
+  }
+
   // Linesearch
   filterLinesearch_.g_max = settings_.g_max;
   filterLinesearch_.g_min = settings_.g_min;
@@ -94,6 +102,15 @@ void SlpSolver::reset() {
   sigmaEstimation_.reset();
   preConditioning_.reset();
   pipgSolverTimer_.reset();
+
+  // Clear warm start
+  numScalingReuses_ = 0;
+  totalNumPipgIterations_ = 0;
+  scaledOcpSize_ = OcpSize();
+  scaledDynamics_.clear();
+  scaledCost_.clear();
+  dualTimeTrajectory_.clear();
+  dualTrajectory_.clear();
 }
 
 std::string SlpSolver::getBenchmarkingInformationPIPG() const {
@@ -118,6 +135,10 @@ std::string SlpSolver::getBenchmarkingInformationPIPG() const {
                << sigmaEstimation / benchmarkTotal * inPercent << "%)\n";
     infoStream << "\tPIPG runTime           :\t" << std::setw(10) << pipgSolverTimer_.getAverageInMilliseconds() << " [ms] \t("
                << pipgRuntime / benchmarkTotal * inPercent << "%)\n";
+    if (settings_.warmStart) {
+      infoStream << "\tThe pre-conditioning is reused in " << numScalingReuses_ << " out of " << preConditioning_.getNumTimedIntervals()
+                 << " iterations.\n";
+    }
   }
   return infoStream.str();
 }
@@ -165,7 +186,8 @@ void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
 
   // Determine time discretization, taking into account event times.
   const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
-  const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
+  const auto timeDiscretization =
+      gradedTimeDiscretizationWithEvents(initTime, finalTime, settings_.dt, settings_.dtGrowthFactor, settings_.dtMax, eventTimes);
 
   // Initialize references
   for (auto& ocpDefinition : ocpDefinitions_) {
@@ -182,7 +204,7 @@ void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   vector_array_t x, u;
   multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
 
-  // Bookkeeping
+  // Bookkeeping. The metrics are those of the last accepted step, i.e., of the current x and u.
   performanceIndeces_.clear();
   std::vector<Metrics> metrics;
 
@@ -194,13 +216,13 @@ void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     }
     // Make QP approximation
     linearQuadraticApproximationTimer_.startTimer();
-    const auto baselinePerformance = setupQuadraticSubproblem(timeDiscretization, initState, x, u, metrics);
+    const auto baselinePerformance = setupQuadraticSubproblem(timeDiscretization, initState, x, u);
     linearQuadraticApproximationTimer_.endTimer();
 
     // Solve LP
     solveQpTimer_.startTimer();
     const vector_t delta_x0 = initState - x[0];
-    const auto deltaSolution = getOCPSolution(delta_x0);
+    const auto deltaSolution = getOCPSolution(timeDiscretization, delta_x0);
     solveQpTimer_.endTimer();
 
     // Apply step
@@ -218,8 +240,14 @@ void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   }
 
   computeControllerTimer_.startTimer();
+  problemMetrics_ = ProblemMetrics();
+  if (isSolutionMetricsRequired()) {
+    if (metrics.empty()) {  // No step was accepted
+      computePerformance(timeDiscretization, initState, x, u, metrics);
+    }
+    problemMetrics_ = multiple_shooting::toProblemMetrics(timeDiscretization, std::move(metrics));
+  }
   primalSolution_ = toPrimalSolution(timeDiscretization, std::move(x), std::move(u));
-  problemMetrics_ = multiple_shooting::toProblemMetrics(timeDiscretization, std::move(metrics));
   computeControllerTimer_.endTimer();
 
   ++numProblems_;
@@ -236,56 +264,69 @@ void SlpSolver::runParallel(std::function<void(int)> taskFunction) {
   threadPool_.runParallel(std::move(taskFunction), settings_.nThreads);
 }
 
-SlpSolver::OcpSubproblemSolution SlpSolver::getOCPSolution(const vector_t& delta_x0) {
+SlpSolver::OcpSubproblemSolution SlpSolver::getOCPSolution(const std::vector<AnnotatedTime>& time, const vector_t& delta_x0) {
   // Solve the QP
   OcpSubproblemSolution solution;
   auto& deltaXSol = solution.deltaXSol;
   auto& deltaUSol = solution.deltaUSol;
 
   // without constraints, or when using projection, we have an unconstrained QP.
-  pipgSolver_.resize(extractSizesFromProblem(dynamics_, cost_, nullptr));
+  const auto ocpSize = extractSizesFromProblem(dynamics_, cost_, nullptr);
+  pipgSolver_.resize(ocpSize);
+  if (lqRecorderPtr_ != nullptr) {
+    lqRecorderPtr_->record(delta_x0, dynamics_, cost_, nullptr);
+  }
 
   // pre-condition the OCP
   preConditioning_.startTimer();
-  scalar_t c;
-  vector_array_t D, E;
   vector_array_t scalingVectors;
-  precondition::ocpDataInPlaceInParallel(threadPool_, delta_x0, pipgSolver_.size(), settings_.scalingIteration, dynamics_, cost_, D, E,
-                                         scalingVectors, c);
+  const bool isScalingReused = preconditionSubproblem(ocpSize, delta_x0, scalingVectors);
   preConditioning_.endTimer();
 
   // estimate mu and lambda: mu I < H < lambda I
   const auto muEstimated = [&]() {
     scalar_t maxScalingFactor = -1;
-    for (auto& v : D) {
+    for (auto& v : scalingD_) {
       if (v.size() != 0) {
         maxScalingFactor = std::max(maxScalingFactor, v.maxCoeff());
       }
     }
-    return c * pipgSolver_.settings().lowerBoundH * maxScalingFactor * maxScalingFactor;
+    return scalingC_ * pipgSolver_.settings().lowerBoundH * maxScalingFactor * maxScalingFactor;
   }();
-  lambdaEstimation_.startTimer();
-  const auto lambdaScaled = slp::hessianEigenvaluesUpperBound(pipgSolver_.size(), cost_);
-  lambdaEstimation_.endTimer();
 
-  // estimate sigma: G' G < sigma I
-  // However, since the G'G and GG' have exactly the same set of eigenvalues value: G G' < sigma I
-  sigmaEstimation_.startTimer();
-  const auto sigmaScaled = slp::GGTEigenvaluesUpperBound(threadPool_, pipgSolver_.size(), dynamics_, nullptr, &scalingVectors);
-  sigmaEstimation_.endTimer();
+  if (!isScalingReused) {
+    lambdaEstimation_.startTimer();
+    lambdaScaled_ = slp::hessianEigenvaluesUpperBound(pipgSolver_.size(), cost_);
+    lambdaEstimation_.endTimer();
+
+    // estimate sigma: G' G < sigma I
+    // However, since the G'G and GG' have exactly the same set of eigenvalues value: G G' < sigma I
+    sigmaEstimation_.startTimer();
+    sigmaScaled_ = slp::GGTEigenvaluesUpperBound(threadPool_, pipgSolver_.size(), dynamics_, nullptr, &scalingVectors);
+    sigmaEstimation_.endTimer();
+  }
 
   pipgSolverTimer_.startTimer();
-  vector_array_t EInv(E.size());
-  std::transform(E.begin(), E.end(), EInv.begin(), [](const vector_t& v) { return v.cwiseInverse(); });
-  const pipg::PipgBounds pipgBounds{muEstimated, lambdaScaled, sigmaScaled};
+  if (settings_.warmStart) {
+    setPipgDualWarmStart(time);
+  }
+  vector_array_t EInv(scalingE_.size());
+  std::transform(scalingE_.begin(), scalingE_.end(), EInv.begin(), [](const vector_t& v) { return v.cwiseInverse(); });
+  // The bounds of a reused scaling are inflated by the tolerated change in data.
+  const scalar_t boundsScaling = isScalingReused ? std::pow(1.0 + settings_.scalingReuseTolerance, 2) : 1.0;
+  const pipg::PipgBounds pipgBounds{muEstimated, boundsScaling * lambdaScaled_, boundsScaling * sigmaScaled_};
   const auto pipgStatus =
       pipgSolver_.solve(threadPool_, delta_x0, dynamics_, cost_, nullptr, scalingVectors, &EInv, pipgBounds, deltaXSol, deltaUSol);
+  totalNumPipgIterations_ += pipgSolver_.getNumIterations();
+  if (settings_.warmStart) {
+    cachePipgDualSolution(time);
+  }
   pipgSolverTimer_.endTimer();
 
   // to determine if the solution is a descent direction for the cost: compute gradient(cost)' * [dx; du]
   solution.armijoDescentMetric = armijoDescentMetric(cost_, deltaXSol, deltaUSol);
 
-  precondition::descaleSolution(D, deltaXSol, deltaUSol);
+  precondition::descaleSolution(scalingD_, deltaXSol, deltaUSol);
 
   // remap the tilde delta u to real delta u
   multiple_shooting::remapProjectedInput(constraintsProjection_, deltaXSol, deltaUSol);
@@ -293,13 +334,108 @@ SlpSolver::OcpSubproblemSolution SlpSolver::getOCPSolution(const vector_t& delta
   return solution;
 }
 
+bool SlpSolver::preconditionSubproblem(const OcpSize& ocpSize, const vector_t& delta_x0, vector_array_t& scalingVectors) {
+  if (!settings_.warmStart) {
+    precondition::ocpDataInPlaceInParallel(threadPool_, delta_x0, ocpSize, settings_.scalingIteration, dynamics_, cost_, scalingD_,
+                                           scalingE_, scalingVectors, scalingC_);
+    return false;
+  }
+
+  // The relative change of each unscaled data matrix since the last computed scaling
+  const int N = ocpSize.numStages;
+  auto isWithinTolerance = [&](const matrix_t& data, const matrix_t& scaledData) {
+    const scalar_t scaledDataNorm = std::max(scaledData.norm(), numeric_traits::weakEpsilon<scalar_t>());
+    return (data - scaledData).norm() <= settings_.scalingReuseTolerance * scaledDataNorm;
+  };
+  const bool isScalingReusable = [&]() {
+    if (!(ocpSize == scaledOcpSize_)) {
+      return false;
+    }
+    for (int i = 0; i < N; i++) {
+      // The state blocks of the initial cost are not scaled by D
+      if (!isWithinTolerance(dynamics_[i].dfdx, scaledDynamics_[i].dfdx) ||
+          !isWithinTolerance(dynamics_[i].dfdu, scaledDynamics_[i].dfdu) || !isWithinTolerance(cost_[i].dfduu, scaledCost_[i].dfduu) ||
+          !isWithinTolerance(cost_[i].dfdux, scaledCost_[i].dfdux) || (i > 0 && !isWithinTolerance(cost_[i].dfdxx, scaledCost_[i].dfdxx))) {
+        return false;
+      }
+    }
+    return isWithinTolerance(cost_[N].dfdxx, scaledCost_[N].dfdxx);
+  }();
+
+  if (isScalingReusable) {
+    // Apply the scaling of the previous subproblem
+    vector_t D(std::accumulate(scalingD_.begin(), scalingD_.end(), 0, [](int n, const vector_t& v) { return n + v.size(); }));
+    vector_t E(std::accumulate(scalingE_.begin(), scalingE_.end(), 0, [](int n, const vector_t& v) { return n + v.size(); }));
+    int offset = 0;
+    for (const auto& v : scalingD_) {
+      D.segment(offset, v.size()) = v;
+      offset += v.size();
+    }
+    offset = 0;
+    for (const auto& v : scalingE_) {
+      E.segment(offset, v.size()) = v;
+      offset += v.size();
+    }
+    precondition::scaleOcpData(ocpSize, D, E, scalingC_, dynamics_, cost_, scalingVectors);
+    // The state blocks of the initial node are only scaled by c in ocpDataInPlaceInParallel
+    cost_[0].dfdxx *= scalingC_;
+    cost_[0].dfdx *= scalingC_;
+    ++numScalingReuses_;
+
+  } else {
+    // The reference data is only updated with a new scaling such that the change does not accumulate unnoticed.
+    scaledDynamics_ = dynamics_;
+    scaledCost_ = cost_;
+    scaledOcpSize_ = ocpSize;
+    precondition::ocpDataInPlaceInParallel(threadPool_, delta_x0, ocpSize, settings_.scalingIteration, dynamics_, cost_, scalingD_,
+                                           scalingE_, scalingVectors, scalingC_);
+  }
+
+  return isScalingReusable;
+}
+
+void SlpSolver::setPipgDualWarmStart(const std::vector<AnnotatedTime>& time) {
+  if (dualTrajectory_.empty()) {
+    return;
+  }
+
+  // The duals are stored unscaled: nu = E * w / c
+  const int N = static_cast<int>(time.size()) - 1;
+  vector_array_t dualWarmStart(N);
+  for (int i = 0; i < N; i++) {
+    // Only interpolate between neighbours of the expected size, e.g., the sizes change with the mode schedule. Otherwise start from zero.
+    const auto expectedSize = scalingE_[i].size();
+    const auto indexAlpha = LinearInterpolation::timeSegment(time[i].time, dualTimeTrajectory_);
+    const auto& lhs = dualTrajectory_[indexAlpha.first];
+    const auto& rhs = dualTrajectory_[std::min(indexAlpha.first + 1, static_cast<int>(dualTrajectory_.size()) - 1)];
+    if (lhs.size() == expectedSize && rhs.size() == expectedSize) {
+      dualWarmStart[i] = indexAlpha.second * lhs + (1.0 - indexAlpha.second) * rhs;
+      dualWarmStart[i].array() *= scalingC_ / scalingE_[i].array();
+    } else {
+      dualWarmStart[i].setZero(expectedSize);
+    }
+  }
+  pipgSolver_.setDualWarmStart(std::move(dualWarmStart));
+}
+
+void SlpSolver::cachePipgDualSolution(const std::vector<AnnotatedTime>& time) {
+  const auto& W = pipgSolver_.getDualSolution();
+  const int N = W.size();
+  dualTimeTrajectory_.resize(N);
+  dualTrajectory_.resize(N);
+  for (int i = 0; i < N; i++) {
+    dualTimeTrajectory_[i] = time[i].time;
+    dualTrajectory_[i] = W[i].cwiseProduct(scalingE_[i]) / scalingC_;
+  }
+}
+
 PrimalSolution SlpSolver::toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u) {
   ModeSchedule modeSchedule = this->getReferenceManager().getModeSchedule();
   return multiple_shooting::toPrimalSolution(time, std::move(modeSchedule), std::move(x), std::move(u));
 }
 
 PerformanceIndex SlpSolver::setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState,
-                                                     const vector_array_t& x, const vector_array_t& u, std::vector<Metrics>& metrics) {
+                                                     const vector_array_t& x, const vector_array_t& u) {
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
 
@@ -311,7 +447,6 @@ PerformanceIndex SlpSolver::setupQuadraticSubproblem(const std::vector<Annotated
   stateInputIneqConstraints_.resize(N);
   constraintsProjection_.resize(N);
   projectionMultiplierCoefficients_.resize(N);
-  metrics.resize(N + 1);
 
   std::atomic_int timeIndex{0};
   auto parallelTask = [&](int workerId) {
@@ -324,7 +459,6 @@ PerformanceIndex SlpSolver::setupQuadraticSubproblem(const std::vector<Annotated
       if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
         auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
         workerPerformance += multiple_shooting::computePerformanceIndex(result);
         cost_[i] = std::move(result.cost);
         dynamics_[i] = std::move(result.dynamics);
@@ -338,7 +472,6 @@ PerformanceIndex SlpSolver::setupQuadraticSubproblem(const std::vector<Annotated
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
         auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
         workerPerformance += multiple_shooting::computePerformanceIndex(result, dt);
         multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier);
         cost_[i] = std::move(result.cost);
@@ -356,7 +489,6 @@ PerformanceIndex SlpSolver::setupQuadraticSubproblem(const std::vector<Annotated
     if (i == N) {  // Only one worker will execute this
       const scalar_t tN = getIntervalStart(time[N]);
       auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
-      metrics[i] = multiple_shooting::computeMetrics(result);
       workerPerformance += multiple_shooting::computePerformanceIndex(result);
       cost_[i] = std::move(result.cost);
       stateIneqConstraints_[i] = std::move(result.ineqConstraints);
@@ -430,6 +562,10 @@ slp::StepInfo SlpSolver::takeStep(const PerformanceIndex& baseline, const std::v
                                   vector_array_t& u, std::vector<Metrics>& metrics) {
   using StepType = FilterLinesearch::StepType;
 
+  if (settings_.speculativeLinesearch) {
+    return takeSpeculativeStep(baseline, timeDiscretization, initState, subproblemSolution, x, u, metrics);
+  }
+
   /*
    * Filter linesearch based on:
    * "On the implementation of an interior-point filter line-search algorithm for large-scale nonlinear programming"
@@ -520,6 +656,92 @@ slp::StepInfo SlpSolver::takeStep(const PerformanceIndex& baseline, const std::v
   return stepInfo;
 }
 
+slp::StepInfo SlpSolver::takeSpeculativeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
+                                             const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
+                                             vector_array_t& u, std::vector<Metrics>& metrics) {
+  if (settings_.printLinesearch) {
+    std::cerr << std::setprecision(9) << std::fixed;
+    std::cerr << "\n=== Speculative Linesearch ===\n";
+    std::cerr << "Baseline:\n" << baseline << "\n";
+  }
+
+  // Update norm
+  const auto& dx = subproblemSolution.deltaXSol;
+  const auto& du = subproblemSolution.deltaUSol;
+  const auto deltaUnorm = multiple_shooting::trajectoryNorm(du);
+  const auto deltaXnorm = multiple_shooting::trajectoryNorm(dx);
+
+  // The same step sizes as the serial backtracking
+  const scalar_array_t stepSizes =
+      backtrackingStepSizes(1.0, settings_.alpha_decay, settings_.alpha_min, settings_.deltaTol, deltaXnorm, deltaUnorm);
+
+  // Same evaluation as computePerformance(), node by node. The candidate is {x, u}.
+  const int N = static_cast<int>(timeDiscretization.size()) - 1;
+  auto evaluateNode = [&](int workerId, int i, const std::vector<vector_array_t>& candidate, Metrics& nodeMetrics) {
+    OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
+    const auto& xNew = candidate[0];
+    const auto& uNew = candidate[1];
+    PerformanceIndex performance;
+    if (i == N) {
+      const scalar_t tN = getIntervalStart(timeDiscretization[N]);
+      nodeMetrics = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, xNew[N]);
+      performance = toPerformanceIndex(nodeMetrics);
+    } else if (timeDiscretization[i].event == AnnotatedTime::Event::PreEvent) {
+      nodeMetrics = multiple_shooting::computeEventMetrics(ocpDefinition, timeDiscretization[i].time, xNew[i], xNew[i + 1]);
+      performance = toPerformanceIndex(nodeMetrics);
+    } else {
+      const scalar_t ti = getIntervalStart(timeDiscretization[i]);
+      const scalar_t dt = getIntervalDuration(timeDiscretization[i], timeDiscretization[i + 1]);
+      nodeMetrics = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, xNew[i], xNew[i + 1], uNew[i]);
+      performance = toPerformanceIndex(nodeMetrics, dt);
+    }
+    if (i == 0) {  // Account for initial state in performance
+      const vector_t initDynamicsViolation = initState - xNew.front();
+      nodeMetrics.dynamicsViolation += initDynamicsViolation;
+      performance.dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+    }
+    return performance;
+  };
+
+  std::vector<vector_array_t> trajectories{std::move(x), std::move(u)};
+  const auto result = speculativeLinesearch(filterLinesearch_, threadPool_, settings_.nThreads, baseline,
+                                            subproblemSolution.armijoDescentMetric, stepSizes, N + 1, evaluateNode, {dx, du}, trajectories,
+                                            metrics);
+  x = std::move(trajectories[0]);
+  u = std::move(trajectories[1]);
+
+  slp::StepInfo stepInfo;
+  if (result.stepIndex >= 0) {
+    const scalar_t alpha = stepSizes[result.stepIndex];
+    stepInfo.stepSize = alpha;
+    stepInfo.stepType = result.stepType;
+    stepInfo.dx_norm = alpha * deltaXnorm;
+    stepInfo.du_norm = alpha * deltaUnorm;
+    stepInfo.performanceAfterStep = result.performance;
+    stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(result.performance);
+
+    if (settings_.printLinesearch) {
+      std::cerr << "Step size: " << alpha << ", Step Type: " << toString(stepInfo.stepType) << " (Accepted)\n";
+      std::cerr << "|dx| = " << stepInfo.dx_norm << "\t|du| = " << stepInfo.du_norm << "\n";
+      std::cerr << result.performance << "\n";
+    }
+
+  } else {  // All step sizes rejected -> Don't take a step
+    stepInfo.stepSize = 0.0;
+    stepInfo.stepType = FilterLinesearch::StepType::ZERO;
+    stepInfo.dx_norm = 0.0;
+    stepInfo.du_norm = 0.0;
+    stepInfo.performanceAfterStep = baseline;
+    stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(baseline);
+
+    if (settings_.printLinesearch) {
+      std::cerr << "[Linesearch terminated] Step size: " << stepInfo.stepSize << ", Step Type: " << toString(stepInfo.stepType) << "\n";
+    }
+  }
+
+  return stepInfo;
+}
+
 slp::Convergence SlpSolver::checkConvergence(int iteration, const PerformanceIndex& baseline, const slp::StepInfo& stepInfo) const {
   using Convergence = slp::Convergence;
   if ((iteration + 1) >= settings_.slpIteration) {
@@ -535,6 +757,9 @@ slp::Convergence SlpSolver::checkConvergence(int iteration, const PerformanceInd
   } else if (stepInfo.dx_norm < settings_.deltaTol && stepInfo.du_norm < settings_.deltaTol) {
     // Converged because the change in primal variables is below the specified tolerance
     return Convergence::PRIMAL;
+  } else if (isTerminationRequested()) {
+    // Stopped because the termination was requested from outside
+    return Convergence::TERMINATED;
   } else {
     // None of the above convergence criteria were met -> not converged.
     return Convergence::FALSE;
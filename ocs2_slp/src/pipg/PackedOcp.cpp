@@ -0,0 +1,81 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+#include "ocs2_slp/pipg/PackedOcp.h"
+
+namespace ocs2 {
+namespace pipg {
+
+void packOcp(const std::vector<VectorFunctionLinearApproximation>& dynamics, const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+             const vector_array_t& scalingVectors, std::vector<PackedNode>& packedNodes) {
+  const int N = dynamics.size();
+  packedNodes.resize(N + 1);
+
+  for (int t = 0; t < N; t++) {
+    auto& node = packedNodes[t];
+    node.numStates = dynamics[t].dfdx.cols();
+    node.numInputs = dynamics[t].dfdu.cols();
+    const int nx = node.numStates;
+    const int nu = node.numInputs;
+
+    // Cost. Since x_0 is fixed, its blocks are not required.
+    node.H.resize(nx + nu, nx + nu);
+    node.h.resize(nx + nu);
+    if (t == 0) {
+      node.H.topLeftCorner(nx, nx).setZero();
+      node.h.head(nx).setZero();
+    } else {
+      node.H.topLeftCorner(nx, nx) = cost[t].dfdxx;
+      node.h.head(nx) = cost[t].dfdx;
+    }
+    node.H.bottomLeftCorner(nu, nx) = cost[t].dfdux;
+    node.H.topRightCorner(nx, nu) = cost[t].dfdux.transpose();
+    node.H.bottomRightCorner(nu, nu) = cost[t].dfduu;
+    node.h.tail(nu) = cost[t].dfdu;
+
+    // Dynamics
+    node.G.resize(dynamics[t].dfdx.rows(), nx + nu);
+    node.G.leftCols(nx) = dynamics[t].dfdx;
+    node.G.rightCols(nu) = dynamics[t].dfdu;
+    node.b = dynamics[t].f;
+    node.c = scalingVectors[t];
+  }
+
+  // Final node
+  auto& node = packedNodes[N];
+  node.numStates = cost[N].dfdxx.rows();
+  node.numInputs = 0;
+  node.H = cost[N].dfdxx;
+  node.h = cost[N].dfdx;
+  node.G.resize(0, node.numStates);
+  node.b.resize(0);
+  node.c.resize(0);
+}
+
+}  // namespace pipg
+}  // namespace ocs2
@@ -55,6 +55,13 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
 
   loadData::loadPtreeValue(pt, settings.lowerBoundH, fieldName + ".lowerBoundH", verbose);
 
+  loadData::loadPtreeValue(pt, settings.adaptiveRestart, fieldName + ".adaptiveRestart", verbose);
+  loadData::loadPtreeValue(pt, settings.minRestartInterval, fieldName + ".minRestartInterval", verbose);
+  loadData::loadPtreeValue(pt, settings.adaptiveStepSize, fieldName + ".adaptiveStepSize", verbose);
+  loadData::loadPtreeValue(pt, settings.stepSizeAdaptationFactor, fieldName + ".stepSizeAdaptationFactor", verbose);
+  loadData::loadPtreeValue(pt, settings.residualBalancingRatio, fieldName + ".residualBalancingRatio", verbose);
+  loadData::loadPtreeValue(pt, settings.maxStepSizeScaling, fieldName + ".maxStepSizeScaling", verbose);
+
   loadData::loadPtreeValue(pt, settings.checkTerminationInterval, fieldName + ".checkTerminationInterval", verbose);
   loadData::loadPtreeValue(pt, settings.displayShortSummary, fieldName + ".displayShortSummary", verbose);
 
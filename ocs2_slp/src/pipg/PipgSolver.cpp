@@ -29,8 +29,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_slp/pipg/PipgSolver.h"
 
+#include <algorithm>
 #include <condition_variable>
 #include <iostream>
+#include <limits>
 #include <mutex>
 #include <numeric>
 
@@ -63,32 +65,55 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
   // Disable Eigen's internal multithreading
   Eigen::setNbThreads(1);
 
+  // Pack the operators once per call such that each node is updated with a few contiguous matrix-vector products.
+  pipg::packOcp(dynamics, cost, scalingVectors, packedNodes_);
+
   vector_array_t primalResidualArray(N);
   scalar_array_t constraintsViolationInfNormArray(N);
   scalar_t constraintsViolationInfNorm;
 
   scalar_t solutionSSE, solutionSquaredNorm;
-  scalar_array_t solutionSEArray(N);
-  scalar_array_t solutionSquaredNormArray(N);
-
-  // initial state
-  X_[0] = x0;
-  XNew_[0] = x0;
-  // cold start
+  scalar_array_t solutionSEArray(N + 1);
+  scalar_array_t solutionSquaredNormArray(N + 1);
+
+  // Adaptive restart and step size
+  const bool computeResidualNorms = settings().adaptiveRestart || settings().adaptiveStepSize;
+  scalar_array_t primalResidualSquaredNormArray(N);
+  scalar_t lastResidualNorm = std::numeric_limits<scalar_t>::infinity();
+  size_t lastRestartIteration = 0;
+  scalar_t momentum = 0.0;
+  scalar_t dualStepSizeScaling = 1.0;
+  numRestarts_ = 0;
+
+  // cold start with the initial state
+  for (int t = 0; t <= N; t++) {
+    Z_[t].setZero(packedNodes_[t].h.size());
+    // ZNew_ will be swapped to Z_ in iteration 0. Thus, initialize ZNew_ here.
+    ZNew_[t].setZero(packedNodes_[t].h.size());
+  }
+  Z_[0].head(x0.size()) = x0;
+  ZNew_[0].head(x0.size()) = x0;
+  const bool useDualWarmStart = dualWarmStart_.size() == N && std::equal(dualWarmStart_.cbegin(), dualWarmStart_.cend(), packedNodes_.cbegin(),
+                                                                            [](const vector_t& w, const pipg::PackedNode& node) {
+                                                                              return w.size() == node.G.rows();
+                                                                            });
   for (int t = 0; t < N; t++) {
-    X_[t + 1].setZero(dynamics[t].dfdx.rows());
-    U_[t].setZero(dynamics[t].dfdu.cols());
-    W_[t].setZero(dynamics[t].dfdx.rows());
+    if (useDualWarmStart) {
+      W_[t] = dualWarmStart_[t];
+    } else {
+      W_[t].setZero(packedNodes_[t].G.rows());
+    }
     // WNew_ will NOT be filled, but will be swapped to W_ in iteration 0. Thus, initialize WNew_ here.
-    WNew_[t].setZero(dynamics[t].dfdx.rows());
+    WNew_[t] = W_[t];
   }
+  dualWarmStart_.clear();
 
   scalar_t alpha = pipgBounds.primalStepSize(0);
   scalar_t beta = pipgBounds.primalStepSize(0);
   scalar_t betaLast = 0;
 
   size_t k = 0;
-  std::atomic_int timeIndex{1}, finishedTaskCounter{0};
+  std::atomic_int timeIndex{0}, finishedTaskCounter{0};
   std::atomic_bool keepRunning{true}, shouldWait{true};
   bool isConverged = false;
 
@@ -112,92 +137,120 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
         // Multi-thread performance analysis
         ++threadsWorkloadCounter[workerId];
 
-        // PIPG algorithm
-        const auto& A = dynamics[t - 1].dfdx;
-        const auto& B = dynamics[t - 1].dfdu;
-        const auto& C = scalingVectors[t - 1];
-        const auto& b = dynamics[t - 1].f;
-
-        const auto& R = cost[t - 1].dfduu;
-        const auto& Q = cost[t].dfdxx;
-        const auto& P = cost[t - 1].dfdux;
-        const auto& q = cost[t].dfdx;
-        const auto& r = cost[t - 1].dfdu;
+        // PIPG algorithm on z_t = [x_t; u_t]
+        const auto& node = packedNodes_[t];
+        const scalar_t dualStep = beta + betaLast;
 
         if (k != 0) {
-          // Update W of the iteration k - 1. Move the update of W to the front of the calculation of V to prevent data race.
-          // vector_t primalResidual = C * X_[t] - A * X_[t - 1] - B * U_[t - 1] - b;
-          primalResidualArray[t - 1] = -b;
-          primalResidualArray[t - 1].array() += C.array() * X_[t].array();
-          primalResidualArray[t - 1].noalias() -= A * X_[t - 1];
-          primalResidualArray[t - 1].noalias() -= B * U_[t - 1];
-          if (EInv != nullptr) {
-            constraintsViolationInfNormArray[t - 1] = (*EInv)[t - 1].cwiseProduct(primalResidualArray[t - 1]).lpNorm<Eigen::Infinity>();
-          } else {
-            constraintsViolationInfNormArray[t - 1] = primalResidualArray[t - 1].lpNorm<Eigen::Infinity>();
-          }
-
-          WNew_[t - 1] = W_[t - 1] + betaLast * primalResidualArray[t - 1];
+          // What stored in ZNew is the solution of iteration k - 2 and what stored in Z is the solution of iteration k - 1. By convention,
+          // iteration starts from 0 and the solution of iteration -1 is the initial value. Reuse ZNew memory to store the difference
+          // between the last solution and the one before last solution.
+          ZNew_[t] -= Z_[t];
+          solutionSEArray[t] = ZNew_[t].squaredNorm();
+          solutionSquaredNormArray[t] = (t == 0) ? Z_[t].tail(node.numInputs).squaredNorm() : Z_[t].squaredNorm();
+        }
 
-          // What stored in UNew and XNew is the solution of iteration k - 2 and what stored in U and X is the solution of iteration k
-          // - 1. By convention, iteration starts from 0 and the solution of iteration -1 is the initial value. Reuse UNew and XNew
-          // memory to store the difference between the last solution and the one before last solution.
-          UNew_[t - 1] -= U_[t - 1];
-          XNew_[t] -= X_[t];
+        if (t != N) {
+          // primalResidual = C * x_{t+1} - G * z_t - b
+          auto& primalResidual = primalResidualArray[t];
+          primalResidual = -node.b;
+          primalResidual.array() += node.c.array() * Z_[t + 1].head(node.c.size()).array();
+          primalResidual.noalias() -= node.G * Z_[t];
+
+          if (k != 0) {
+            // Update W of the iteration k - 1. Move the update of W to the front of the calculation of V to prevent data race.
+            if (EInv != nullptr) {
+              constraintsViolationInfNormArray[t] = (*EInv)[t].cwiseProduct(primalResidual).lpNorm<Eigen::Infinity>();
+            } else {
+              constraintsViolationInfNormArray[t] = primalResidual.lpNorm<Eigen::Infinity>();
+            }
+            WNew_[t] = W_[t] + betaLast * primalResidual;
+
+            if (computeResidualNorms) {
+              primalResidualSquaredNormArray[t] = primalResidual.squaredNorm();
+            }
+          }
 
-          solutionSEArray[t - 1] = UNew_[t - 1].squaredNorm() + XNew_[t].squaredNorm();
-          solutionSquaredNormArray[t - 1] = U_[t - 1].squaredNorm() + X_[t].squaredNorm();
+          // V_[t] = W_[t] + (beta + betaLast) * (C * x_{t+1} - G * z_t - b);
+          V_[t] = W_[t] + dualStep * primalResidual;
         }
 
-        // V_[t - 1] = W_[t - 1] + (beta + betaLast) * (C * X_[t] - A * X_[t - 1] - B * U_[t - 1] - b);
-        V_[t - 1] = W_[t - 1] - (beta + betaLast) * b;
-        V_[t - 1].array() += (beta + betaLast) * C.array() * X_[t].array();
-        V_[t - 1].noalias() -= (beta + betaLast) * (A * X_[t - 1]);
-        V_[t - 1].noalias() -= (beta + betaLast) * (B * U_[t - 1]);
-
-        // UNew_[t - 1] = U_[t - 1] - alpha * (R * U_[t - 1] + P * X_[t - 1] + r - B.transpose() * V_[t - 1]);
-        UNew_[t - 1] = U_[t - 1] - alpha * r;
-        UNew_[t - 1].noalias() -= alpha * (R * U_[t - 1]);
-        UNew_[t - 1].noalias() -= alpha * (P * X_[t - 1]);
-        UNew_[t - 1].noalias() += alpha * (B.transpose() * V_[t - 1]);
+        // ZNew_[t] = Z_[t] - alpha * (H * Z_[t] + h - G' * V_[t] + [C_{t-1} * V_{t-1}; 0]);
+        ZNew_[t] = Z_[t] - alpha * node.h;
+        ZNew_[t].noalias() -= alpha * (node.H * Z_[t]);
+        if (t != N) {
+          ZNew_[t].noalias() += alpha * (node.G.transpose() * V_[t]);
+        }
 
-        // XNew_[t] = X_[t] - alpha * (Q * X_[t] + q + C * V_[t - 1]);
-        XNew_[t] = X_[t] - alpha * q;
-        XNew_[t].array() -= alpha * C.array() * V_[t - 1].array();
-        XNew_[t].noalias() -= alpha * (Q * X_[t]);
+        if (t != 0) {
+          // The dual of the previous stage is owned by the previous node. Recompute it here instead of waiting for it.
+          const auto& prevNode = packedNodes_[t - 1];
+          auto& VPrev = VPrev_[t];
+          VPrev = W_[t - 1] - dualStep * prevNode.b;
+          VPrev.array() += dualStep * prevNode.c.array() * Z_[t].head(node.numStates).array();
+          VPrev.noalias() -= dualStep * (prevNode.G * Z_[t - 1]);
+
+          ZNew_[t].head(node.numStates).array() -= alpha * prevNode.c.array() * VPrev.array();
+        } else {
+          ZNew_[t].head(node.numStates) = x0;
+        }
 
-        if (t != N) {
-          const auto& ANext = dynamics[t].dfdx;
-          const auto& BNext = dynamics[t].dfdu;
-          const auto& CNext = scalingVectors[t];
-          const auto& bNext = dynamics[t].f;
-
-          // dfdux
-          const auto& PNext = cost[t].dfdux;
-
-          // vector_t VNext = W_[t] + (beta + betaLast) * (CNext * X_[t + 1] - ANext * X_[t] - BNext * U_[t] - bNext);
-          vector_t VNext = W_[t] - (beta + betaLast) * bNext;
-          VNext.array() += (beta + betaLast) * CNext.array() * X_[t + 1].array();
-          VNext.noalias() -= (beta + betaLast) * (ANext * X_[t]);
-          VNext.noalias() -= (beta + betaLast) * (BNext * U_[t]);
-
-          XNew_[t].noalias() += alpha * (ANext.transpose() * VNext);
-          // Add dfdxu * du if it is not the final state.
-          XNew_[t].noalias() -= alpha * (PNext.transpose() * U_[t]);
+        if (momentum > 0.0) {
+          // Extrapolate along the last step: ZNew_[t] = z_k + momentum * (z_k - Z_[t])
+          ZNew_[t] += momentum * (ZNew_[t] - Z_[t]);
         }
 
         workerOrder = ++finishedTaskCounter;
       }
 
-      if (workerOrder != N) {
+      if (workerOrder != N + 1) {
         std::unique_lock<std::mutex> lk(mux);
         iterationFinished.wait(lk, [&shouldWait] { return !shouldWait; });
         lk.unlock();
       } else {
         betaLast = beta;
-        // Adaptive step size
-        beta = pipgBounds.dualStepSize(k);
-        alpha = pipgBounds.primalStepSize(k);
+
+        // Residuals of the solution of iteration k - 1
+        scalar_t primalResidualNorm = 0.0;
+        scalar_t dualResidualNorm = 0.0;
+        if (k != 0 && computeResidualNorms) {
+          primalResidualNorm =
+              std::sqrt(std::accumulate(primalResidualSquaredNormArray.begin(), primalResidualSquaredNormArray.end(), 0.0));
+          dualResidualNorm = std::sqrt(std::accumulate(solutionSEArray.begin(), solutionSEArray.end(), 0.0)) / alpha;
+        }
+
+        // Adaptive restart: once the residual increases, the extrapolation is reset, i.e., the solver continues from the plain PIPG
+        // iterate and the momentum starts over from zero.
+        bool isRestarted = false;
+        if (k != 0 && settings().adaptiveRestart) {
+          const scalar_t residualNorm = primalResidualNorm + dualResidualNorm;
+          if (residualNorm > lastResidualNorm && k >= lastRestartIteration + settings().minRestartInterval) {
+            isRestarted = true;
+            lastRestartIteration = k;
+            ++numRestarts_;
+          }
+          lastResidualNorm = residualNorm;
+        }
+
+        if (k != 0 && settings().adaptiveStepSize) {
+          // Residual balancing: increase the dual step size if the primal residual dominates and vice versa.
+          if (primalResidualNorm > settings().residualBalancingRatio * dualResidualNorm) {
+            dualStepSizeScaling *= settings().stepSizeAdaptationFactor;
+          } else if (dualResidualNorm > settings().residualBalancingRatio * primalResidualNorm) {
+            dualStepSizeScaling /= settings().stepSizeAdaptationFactor;
+          }
+          // Bound the scaling such that persistently unbalanced residuals cannot drive beta or alpha to zero
+          dualStepSizeScaling =
+              std::min(std::max(dualStepSizeScaling, 1.0 / settings().maxStepSizeScaling), settings().maxStepSizeScaling);
+        }
+
+        if (settings().adaptiveStepSize) {
+          beta = dualStepSizeScaling * pipgBounds.dualStepSize(k);
+          alpha = 1.0 / (pipgBounds.lambda + beta * pipgBounds.sigma);
+        } else {
+          beta = pipgBounds.dualStepSize(k);
+          alpha = pipgBounds.primalStepSize(k);
+        }
 
         if (k != 0 && k % settings().checkTerminationInterval == 0) {
           constraintsViolationInfNorm =
@@ -213,13 +266,23 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
           keepRunning = k < settings().maxNumIterations && !isConverged;
         }
 
-        XNew_.swap(X_);
-        UNew_.swap(U_);
+        if (settings().adaptiveRestart) {
+          if (isRestarted) {
+            // Undo the extrapolation of this iteration: z_k = (ZNew_ + momentum * Z_) / (1 + momentum)
+            for (int t = 0; t <= N; t++) {
+              ZNew_[t] = (ZNew_[t] + momentum * Z_[t]) / (1.0 + momentum);
+            }
+          }
+          // Nesterov's momentum of the next iteration
+          const scalar_t numItersSinceRestart = static_cast<scalar_t>(k + 1 - lastRestartIteration);
+          momentum = (numItersSinceRestart - 1.0) / (numItersSinceRestart + 2.0);
+        }
+        ZNew_.swap(Z_);
         WNew_.swap(W_);
 
         ++k;
         finishedTaskCounter = 0;
-        timeIndex = 1;
+        timeIndex = 0;
         {
           std::lock_guard<std::mutex> lk(mux);
           shouldWait = false;
@@ -230,8 +293,15 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
   };
   threadPool.runParallel(std::move(updateVariablesTask), threadPool.numThreads() + 1U);
 
-  xTrajectory = X_;
-  uTrajectory = U_;
+  numIterations_ = k;
+
+  xTrajectory.resize(N + 1);
+  uTrajectory.resize(N);
+  for (int t = 0; t < N; t++) {
+    xTrajectory[t] = Z_[t].head(packedNodes_[t].numStates);
+    uTrajectory[t] = Z_[t].tail(packedNodes_[t].numInputs);
+  }
+  xTrajectory[N] = Z_[N];
   const auto status = isConverged ? pipg::SolverStatus::SUCCESS : pipg::SolverStatus::MAX_ITER;
 
   if (settings().displayShortSummary) {
@@ -241,6 +311,9 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
     std::cerr << "\n+++++++++++++++++++++++++++++++++++++++++++++\n";
     std::cerr << "Solver status: " << pipg::toString(status) << "\n";
     std::cerr << "Number of Iterations: " << k << " out of " << settings().maxNumIterations << "\n";
+    if (settings().adaptiveRestart) {
+      std::cerr << "Number of Restarts: " << numRestarts_ << "\n";
+    }
     std::cerr << "Norm of delta primal solution: " << std::sqrt(solutionSSE) << "\n";
     std::cerr << "Constraints violation : " << constraintsViolationInfNorm << "\n";
     std::cerr << "Thread workload(ID: # of finished tasks): ";
@@ -271,13 +344,12 @@ void PipgSolver::resize(const OcpSize& ocpSize) {
   numDecisionVariables_ += std::accumulate(ocpSize_.numInputs.begin(), ocpSize_.numInputs.end(), 0);
   numDynamicsConstraints_ = std::accumulate(std::next(ocpSize_.numStates.begin()), ocpSize_.numStates.end(), 0);
 
-  X_.resize(N + 1);
+  Z_.resize(N + 1);
+  ZNew_.resize(N + 1);
   W_.resize(N);
-  V_.resize(N);
-  U_.resize(N);
-  XNew_.resize(N + 1);
-  UNew_.resize(N);
   WNew_.resize(N);
+  V_.resize(N);
+  VPrev_.resize(N + 1);
 }
 
 /******************************************************************************************************/
@@ -183,4 +183,139 @@ TEST_F(PIPGSolverTest, correctness) {
   ASSERT_TRUE(std::abs(PIPGConstraintViolation) < solver.settings().absoluteTolerance);
   EXPECT_TRUE(std::abs(QPConstraintViolation - PIPGConstraintViolation) < solver.settings().absoluteTolerance * 10.0);
   EXPECT_TRUE(std::abs(PIPGParallelCConstraintViolation - PIPGConstraintViolation) < solver.settings().absoluteTolerance * 10.0);
-}
\ No newline at end of file
+}
+
+TEST_F(PIPGSolverTest, adaptiveStepSize) {
+  auto QPconstraints = constraintsApproximation;
+  QPconstraints.f = -QPconstraints.f;
+  ocs2::vector_t primalSolutionQP;
+  std::tie(primalSolutionQP, std::ignore) = ocs2::qp_solver::solveDenseQp(costApproximation, QPconstraints);
+
+  Eigen::JacobiSVD<ocs2::matrix_t> svd(costApproximation.dfdxx);
+  ocs2::vector_t s = svd.singularValues();
+  const ocs2::scalar_t lambda = s(0);
+  const ocs2::scalar_t mu = s(svd.rank() - 1);
+  Eigen::JacobiSVD<ocs2::matrix_t> svdGTG(constraintsApproximation.dfdx.transpose() * constraintsApproximation.dfdx);
+  const ocs2::scalar_t sigma = svdGTG.singularValues()(0);
+  const ocs2::pipg::PipgBounds pipgBounds{mu, lambda, sigma};
+
+  ocs2::vector_array_t scalingVectors(N_, ocs2::vector_t::Ones(nx_));
+  ocs2::vector_array_t X, U;
+  std::ignore = solver.solve(threadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, X, U);
+  const auto numIterationsFixedSchedule = solver.getNumIterations();
+
+  auto adaptiveSettings = solver.settings();
+  adaptiveSettings.adaptiveRestart = true;
+  adaptiveSettings.adaptiveStepSize = true;
+  ocs2::PipgSolver adaptiveSolver(adaptiveSettings);
+  adaptiveSolver.resize(solver.size());
+  const auto status = adaptiveSolver.solve(threadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, X, U);
+
+  ocs2::vector_t primalSolutionAdaptive;
+  ocs2::toKktSolution(X, U, primalSolutionAdaptive);
+
+  if (verbose_) {
+    std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
+    std::cerr << "\n++++++++++++ [TestPIPG] Adaptive step size +++++++++++";
+    std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
+    std::cerr << "Iterations with fixed schedule: " << numIterationsFixedSchedule << "\n";
+    std::cerr << "Iterations with adaptive step size: " << adaptiveSolver.getNumIterations() << "\n";
+    std::cerr << "Number of restarts: " << adaptiveSolver.getNumRestarts() << "\n";
+  }
+
+  EXPECT_EQ(status, ocs2::pipg::SolverStatus::SUCCESS);
+  EXPECT_LT(adaptiveSolver.getNumIterations(), numIterationsFixedSchedule);
+  EXPECT_TRUE(primalSolutionQP.isApprox(primalSolutionAdaptive, solver.settings().absoluteTolerance * 10.0))
+      << "Inf-norm of (QP - PIPG): " << (primalSolutionQP - primalSolutionAdaptive).cwiseAbs().maxCoeff();
+  EXPECT_TRUE((constraintsApproximation.dfdx * primalSolutionAdaptive - constraintsApproximation.f).cwiseAbs().maxCoeff() <
+              solver.settings().absoluteTolerance * 10.0);
+}
+
+TEST_F(PIPGSolverTest, adaptiveRestart) {
+  auto QPconstraints = constraintsApproximation;
+  QPconstraints.f = -QPconstraints.f;
+  ocs2::vector_t primalSolutionQP;
+  std::tie(primalSolutionQP, std::ignore) = ocs2::qp_solver::solveDenseQp(costApproximation, QPconstraints);
+
+  Eigen::JacobiSVD<ocs2::matrix_t> svd(costApproximation.dfdxx);
+  ocs2::vector_t s = svd.singularValues();
+  const ocs2::scalar_t lambda = s(0);
+  const ocs2::scalar_t mu = s(svd.rank() - 1);
+  Eigen::JacobiSVD<ocs2::matrix_t> svdGTG(constraintsApproximation.dfdx.transpose() * constraintsApproximation.dfdx);
+  const ocs2::scalar_t sigma = svdGTG.singularValues()(0);
+  const ocs2::pipg::PipgBounds pipgBounds{mu, lambda, sigma};
+  ocs2::vector_array_t scalingVectors(N_, ocs2::vector_t::Ones(nx_));
+
+  // Both solvers adapt the step size, only one of them restarts
+  auto baseSettings = solver.settings();
+  baseSettings.adaptiveStepSize = true;
+  ocs2::PipgSolver baseSolver(baseSettings);
+  baseSolver.resize(solver.size());
+
+  auto restartSettings = baseSettings;
+  restartSettings.adaptiveRestart = true;
+  ocs2::PipgSolver restartSolver(restartSettings);
+  restartSolver.resize(solver.size());
+
+  ocs2::vector_array_t X, U;
+  const auto baseStatus = baseSolver.solve(threadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, X, U);
+  ocs2::vector_t primalSolutionBase;
+  ocs2::toKktSolution(X, U, primalSolutionBase);
+
+  const auto restartStatus =
+      restartSolver.solve(threadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, X, U);
+  ocs2::vector_t primalSolutionRestart;
+  ocs2::toKktSolution(X, U, primalSolutionRestart);
+
+  if (verbose_) {
+    std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
+    std::cerr << "\n++++++++++++++ [TestPIPG] Adaptive restart +++++++++++";
+    std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
+    std::cerr << "Iterations without restart: " << baseSolver.getNumIterations() << "\n";
+    std::cerr << "Iterations with restart: " << restartSolver.getNumIterations() << "\n";
+    std::cerr << "Number of restarts: " << restartSolver.getNumRestarts() << "\n";
+  }
+
+  EXPECT_EQ(baseStatus, ocs2::pipg::SolverStatus::SUCCESS);
+  EXPECT_EQ(restartStatus, ocs2::pipg::SolverStatus::SUCCESS);
+  EXPECT_EQ(baseSolver.getNumRestarts(), 0);
+  EXPECT_GT(restartSolver.getNumRestarts(), 0);
+  EXPECT_LT(restartSolver.getNumIterations(), baseSolver.getNumIterations());
+
+  EXPECT_TRUE(primalSolutionQP.isApprox(primalSolutionRestart, solver.settings().absoluteTolerance * 10.0))
+      << "Inf-norm of (QP - PIPG): " << (primalSolutionQP - primalSolutionRestart).cwiseAbs().maxCoeff();
+  EXPECT_TRUE(primalSolutionBase.isApprox(primalSolutionRestart, solver.settings().absoluteTolerance * 10.0));
+}
+
+TEST_F(PIPGSolverTest, boundedStepSizeScaling) {
+  auto QPconstraints = constraintsApproximation;
+  QPconstraints.f = -QPconstraints.f;
+  ocs2::vector_t primalSolutionQP;
+  std::tie(primalSolutionQP, std::ignore) = ocs2::qp_solver::solveDenseQp(costApproximation, QPconstraints);
+
+  Eigen::JacobiSVD<ocs2::matrix_t> svd(costApproximation.dfdxx);
+  ocs2::vector_t s = svd.singularValues();
+  const ocs2::scalar_t lambda = s(0);
+  const ocs2::scalar_t mu = s(svd.rank() - 1);
+  Eigen::JacobiSVD<ocs2::matrix_t> svdGTG(constraintsApproximation.dfdx.transpose() * constraintsApproximation.dfdx);
+  const ocs2::scalar_t sigma = svdGTG.singularValues()(0);
+  const ocs2::pipg::PipgBounds pipgBounds{mu, lambda, sigma};
+  ocs2::vector_array_t scalingVectors(N_, ocs2::vector_t::Ones(nx_));
+
+  // With a zero balancing ratio the primal residual always dominates, thus the dual step size is scaled up at every iteration. Without
+  // the bound, the primal step size vanishes and the solver stalls far from the solution.
+  auto settings = solver.settings();
+  settings.adaptiveStepSize = true;
+  settings.residualBalancingRatio = 0.0;
+  ocs2::PipgSolver pipgSolver(settings);
+  pipgSolver.resize(solver.size());
+
+  ocs2::vector_array_t X, U;
+  const auto status = pipgSolver.solve(threadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, X, U);
+  ocs2::vector_t primalSolution;
+  ocs2::toKktSolution(X, U, primalSolution);
+
+  EXPECT_EQ(status, ocs2::pipg::SolverStatus::SUCCESS);
+  // the unbounded scaling stalls with an error of order one
+  EXPECT_LT((primalSolutionQP - primalSolution).cwiseAbs().maxCoeff(), 1e-5);
+}
@@ -40,7 +40,8 @@ namespace {
 
 std::pair<PrimalSolution, std::vector<PerformanceIndex>> solve(const VectorFunctionLinearApproximation& dynamicsMatrices,
                                                                const ScalarFunctionQuadraticApproximation& costMatrices,
-                                                               const ocs2::scalar_t tol) {
+                                                               const ocs2::scalar_t tol, bool warmStart = false,
+                                                               bool shiftHorizon = false, size_t* numPipgIterationsPtr = nullptr) {
   int n = dynamicsMatrices.dfdu.rows();
   int m = dynamicsMatrices.dfdu.cols();
 
@@ -84,6 +85,7 @@ std::pair<PrimalSolution, std::vector<PerformanceIndex>> solve(const VectorFunct
     settings.printSolverStatus = true;
     settings.printLinesearch = true;
     settings.nThreads = 100;
+    settings.warmStart = warmStart;
     settings.pipgSettings = getPipgSettings();
     return settings;
   }();
@@ -99,6 +101,20 @@ std::pair<PrimalSolution, std::vector<PerformanceIndex>> solve(const VectorFunct
 
   // Solve
   solver.run(startTime, initState, finalTime);
+  if (shiftHorizon) {
+    // Second MPC call on a shifted horizon, which starts from the data of the previous call
+    const scalar_t timeShift = 0.05;
+    const vector_t shiftedState = solver.primalSolution(finalTime).stateTrajectory_[1];
+    const size_t numPipgIterationsBefore = solver.getNumPipgIterations();
+    solver.run(startTime + timeShift, shiftedState, finalTime + timeShift);
+    if (numPipgIterationsPtr != nullptr) {
+      *numPipgIterationsPtr = solver.getNumPipgIterations() - numPipgIterationsBefore;
+    }
+    return {solver.primalSolution(finalTime + timeShift), solver.getIterationsLog()};
+  }
+  if (numPipgIterationsPtr != nullptr) {
+    *numPipgIterationsPtr = solver.getNumPipgIterations();
+  }
   return {solver.primalSolution(finalTime), solver.getIterationsLog()};
 }
 
@@ -121,3 +137,20 @@ TEST(testSlpSolver, test_unconstrained) {
   ASSERT_LE(result.second.size(), 2);
   ASSERT_LT(result.second.back().dynamicsViolationSSE, tol);
 }
+
+TEST(testSlpSolver, test_unconstrained_warm_start) {
+  int n = 3;
+  int m = 2;
+  const double tol = 1e-9;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+  size_t numPipgIterationsWarm, numPipgIterationsCold;
+  const auto result = ocs2::solve(dynamics, costs, tol, true, true, &numPipgIterationsWarm);
+  const auto resultCold = ocs2::solve(dynamics, costs, tol, false, true, &numPipgIterationsCold);
+
+  ASSERT_LT(result.second.back().dynamicsViolationSSE, tol);
+  ASSERT_LT(resultCold.second.back().dynamicsViolationSSE, tol);
+
+  // The warm started duals of the shifted horizon reduce the PIPG iterations of the second MPC call
+  EXPECT_LT(numPipgIterationsWarm, numPipgIterationsCold);
+}
@@ -86,6 +86,27 @@ class HpipmInterface {
                      std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
                      vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose = false);
 
+  /**
+   * Solves the previously solved problem again for new linear terms, i.e., the initial state, dynamics offsets (f) and cost
+   * gradients (dfdx, dfdu) may change, while all matrices must be identical to the ones of the last call to solve(). The Riccati
+   * factorization of the last solve() is reused such that only a backward and forward pass over vectors is performed.
+   *
+   * Only available if the last call to solve() was unconstrained (constraints == nullptr), since otherwise the factorization
+   * contains the inequality multipliers of HPIPM.
+   *
+   * After this call, getRiccatiCostToGo() and getRiccatiFeedforward() return the quantities of the re-solved problem.
+   *
+   * @param x0 : Initial state (deviation).
+   * @param dynamics : Linearized approximation of the discrete dynamics.
+   * @param cost : Quadratic approximation of the cost.
+   * @param [out] stateTrajectory : Solution state (deviation) trajectory.
+   * @param [out] inputTrajectory : Solution input (deviation) trajectory.
+   * @return hpipm_status::SUCCESS or hpipm_status::NAN_SOL.
+   */
+  hpipm_status resolve(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                       const std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& stateTrajectory,
+                       vector_array_t& inputTrajectory);
+
   /**
    * Return the Riccati cost-to-go for the previously solved problem.
    * Extra information about the initial stage is needed to complete calculation.
@@ -121,6 +142,9 @@ class HpipmInterface {
   vector_array_t getRiccatiFeedforward(const VectorFunctionLinearApproximation& dynamics0,
                                        const ScalarFunctionQuadraticApproximation& cost0);
 
+  /** Returns the number of interior point iterations of the last call to solve(). */
+  int getNumIterations() const;
+
  private:
   class Impl;
   std::unique_ptr<Impl> pImpl_;
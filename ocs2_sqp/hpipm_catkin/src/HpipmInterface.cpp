@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "hpipm_catkin/HpipmInterface.h"
 
+#include <algorithm>
+
 #include <ocs2_core/misc/LinearAlgebra.h>
 
 extern "C" {
@@ -143,9 +145,9 @@ class HpipmInterface::Impl {
     d_ocp_qp_ipm_arg_set_ric_alg(&settings.ric_alg, &arg_);
   }
 
-  void verifySizes(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
-                   std::vector<ScalarFunctionQuadraticApproximation>& cost,
-                   std::vector<VectorFunctionLinearApproximation>* constraints) const {
+  void verifySizes(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                   const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                   const std::vector<VectorFunctionLinearApproximation>* constraints) const {
     if (dynamics.size() != ocpSize_.numStages) {
       throw std::runtime_error("[HpipmInterface] Inconsistent size of dynamics: " + std::to_string(dynamics.size()) + " with " +
                                std::to_string(ocpSize_.numStages) + " number of stages.");
@@ -282,6 +284,9 @@ class HpipmInterface::Impl {
     d_ocp_qp_set_all(AA.data(), BB.data(), bb.data(), QQ.data(), SS.data(), RR.data(), qq.data(), rr.data(), hidxbx, hlbx, hubx, hidxbu,
                      hlbu, hubu, CC.data(), DD.data(), llg.data(), uug.data(), hZl, hZu, hzl, hzu, hidxs, hlls, hlus, &qp_);
     d_ocp_qp_ipm_solve(&qp_, &qpSol_, &arg_, &workspace_);
+    isFactorizationReusable_ = (constraints == nullptr);
+    resolvedCostToGoGradient_.clear();
+    resolvedFeedforward_.clear();
 
     if (verbose) {
       printStatus();
@@ -300,6 +305,102 @@ class HpipmInterface::Impl {
     return hpipm_status(hpipmStatus);
   }
 
+  hpipm_status resolve(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                       const std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& stateTrajectory,
+                       vector_array_t& inputTrajectory) {
+    if (!isFactorizationReusable_) {
+      throw std::runtime_error("[HpipmInterface] resolve() requires a previous call to solve() without constraints.");
+    }
+    const int N = ocpSize_.numStages;
+    verifySizes(x0, dynamics, cost, nullptr);
+
+    // Factorization of the last solve: H[k] = Lr[k] * Lr[k]^T and S[k] + B[k]^T * P[k+1] * A[k] = Lr[k] * Ls[k]^T
+    std::vector<matrix_t> Lr(N);
+    std::vector<matrix_t> Ls(N);
+    matrix_t P;
+
+    // === Backward pass on the linear terms ===
+    // p[k] = q[k] + A[k]^T * v[k] - Ls[k] * inv(Lr[k]) * g[k],  with v[k] = p[k+1] + P[k+1] * b[k] and g[k] = r[k] + B[k]^T * v[k]
+    resolvedCostToGoGradient_.resize(N + 1);
+    resolvedFeedforward_.resize(N);
+    resolvedCostToGoGradient_[N] = cost[N].dfdx;
+    vector_t v, g;
+    for (int k = N - 1; k >= 0; --k) {
+      const auto numInput = ocpSize_.numInputs[k];
+      P.resize(ocpSize_.numStates[k + 1], ocpSize_.numStates[k + 1]);
+      d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, k + 1, P.data());
+
+      v = resolvedCostToGoGradient_[k + 1];
+      v.noalias() += P * dynamics[k].f;
+      g = cost[k].dfdu;
+      g.noalias() += dynamics[k].dfdu.transpose() * v;
+
+      if (numInput > 0) {
+        Lr[k].resize(numInput, numInput);
+        d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, k, Lr[k].data());  // Lr matrix is lower triangular
+        LinearAlgebra::setTriangularMinimumEigenvalues(Lr[k]);
+        Lr[k].triangularView<Eigen::Lower>().solveInPlace(g);  // g = inv(Lr) * g
+      }
+
+      // RiccatiFeedforward[k] = -(inv(Lr)^T * inv(Lr)) * g
+      resolvedFeedforward_[k] = -g;
+      if (numInput > 0) {
+        Lr[k].triangularView<Eigen::Lower>().transpose().solveInPlace(resolvedFeedforward_[k]);
+      }
+
+      // k = 0, state is not a decision variable. The cost-to-go is reconstructed in getRiccatiCostToGo
+      if (k > 0) {
+        resolvedCostToGoGradient_[k] = cost[k].dfdx;
+        resolvedCostToGoGradient_[k].noalias() += dynamics[k].dfdx.transpose() * v;
+        if (numInput > 0) {
+          Ls[k].resize(ocpSize_.numStates[k], numInput);
+          d_ocp_qp_ipm_get_ric_Ls(&qp_, &arg_, &workspace_, k, Ls[k].data());
+          resolvedCostToGoGradient_[k].noalias() -= Ls[k] * g;
+        }
+      }
+    }
+
+    // === Forward pass ===
+    stateTrajectory.resize(N + 1);
+    inputTrajectory.resize(N);
+    stateTrajectory[0] = x0;
+
+    // k = 0, the initial state enters as a linear term: u[0] = -inv(H[0]) * (g[0] + (S[0] + B[0]^T * P[1] * A[0]) * x0)
+    P.resize(ocpSize_.numStates[1], ocpSize_.numStates[1]);
+    d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, 1, P.data());
+    const vector_t A0_x0 = dynamics[0].dfdx * x0;
+    inputTrajectory[0] = -cost[0].dfdux * x0;
+    inputTrajectory[0].noalias() -= dynamics[0].dfdu.transpose() * (P * A0_x0);
+    if (ocpSize_.numInputs[0] > 0) {
+      Lr[0].triangularView<Eigen::Lower>().solveInPlace(inputTrajectory[0]);
+      Lr[0].triangularView<Eigen::Lower>().transpose().solveInPlace(inputTrajectory[0]);
+    }
+    inputTrajectory[0] += resolvedFeedforward_[0];
+    stateTrajectory[1] = dynamics[0].f + A0_x0;
+    stateTrajectory[1].noalias() += dynamics[0].dfdu * inputTrajectory[0];
+
+    // k > 0: u[k] = K[k] * x[k] + k[k], with K[k] = -inv(Lr[k])^T * Ls[k]^T
+    for (int k = 1; k < N; ++k) {
+      if (ocpSize_.numInputs[k] > 0) {
+        inputTrajectory[k].noalias() = -Ls[k].transpose() * stateTrajectory[k];
+        Lr[k].triangularView<Eigen::Lower>().transpose().solveInPlace(inputTrajectory[k]);
+        inputTrajectory[k] += resolvedFeedforward_[k];
+      } else {
+        inputTrajectory[k].resize(0);
+      }
+      stateTrajectory[k + 1] = dynamics[k].f;
+      stateTrajectory[k + 1].noalias() += dynamics[k].dfdx * stateTrajectory[k];
+      stateTrajectory[k + 1].noalias() += dynamics[k].dfdu * inputTrajectory[k];
+    }
+
+    const auto isFinite = [](const vector_t& v) { return v.allFinite(); };
+    if (!std::all_of(stateTrajectory.begin(), stateTrajectory.end(), isFinite) ||
+        !std::all_of(inputTrajectory.begin(), inputTrajectory.end(), isFinite)) {
+      return hpipm_status::NAN_SOL;
+    }
+    return hpipm_status::SUCCESS;
+  }
+
   bool getStateSolution(const vector_t& x0, vector_array_t& stateTrajectory) {
     stateTrajectory.resize(ocpSize_.numStages + 1);
     stateTrajectory.front() = x0;
@@ -367,6 +468,10 @@ class HpipmInterface::Impl {
 
   vector_array_t getRiccatiFeedforward(const VectorFunctionLinearApproximation& dynamics0,
                                        const ScalarFunctionQuadraticApproximation& cost0) {
+    if (!resolvedFeedforward_.empty()) {
+      return resolvedFeedforward_;
+    }
+
     const int N = ocpSize_.numStages;
     vector_array_t RiccatiFeedforward(N);
 
@@ -410,7 +515,11 @@ class HpipmInterface::Impl {
       RiccatiCostToGo[k].dfdxx.resize(ocpSize_.numStates[k], ocpSize_.numStates[k]);
       RiccatiCostToGo[k].dfdx.resize(ocpSize_.numStates[k]);
       d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, k, RiccatiCostToGo[k].dfdxx.data());
-      d_ocp_qp_ipm_get_ric_p(&qp_, &arg_, &workspace_, k, RiccatiCostToGo[k].dfdx.data());
+      if (resolvedCostToGoGradient_.empty()) {
+        d_ocp_qp_ipm_get_ric_p(&qp_, &arg_, &workspace_, k, RiccatiCostToGo[k].dfdx.data());
+      } else {
+        RiccatiCostToGo[k].dfdx = resolvedCostToGoGradient_[k];
+      }
     }
 
     // k = 0
@@ -454,6 +563,12 @@ class HpipmInterface::Impl {
     return RiccatiCostToGo;
   }
 
+  int getNumIterations() {
+    int iter = 0;
+    d_ocp_qp_ipm_get_iter(&workspace_, &iter);
+    return iter;
+  }
+
   void printStatus() {
     int hpipmStatus = -1;
     d_ocp_qp_ipm_get_status(&workspace_, &hpipmStatus);
@@ -506,6 +621,11 @@ class HpipmInterface::Impl {
   Settings settings_;
   OcpSize ocpSize_;
 
+  // Linear terms of the problem solved by resolve(). Empty if the last problem was solved by solve().
+  bool isFactorizationReusable_ = false;
+  vector_array_t resolvedCostToGoGradient_;
+  vector_array_t resolvedFeedforward_;
+
   MemoryBlock dimMem_;
   d_ocp_qp_dim dim_;
 
@@ -538,6 +658,12 @@ hpipm_status HpipmInterface::solve(const vector_t& x0, std::vector<VectorFunctio
   return pImpl_->solve(x0, dynamics, cost, constraints, stateTrajectory, inputTrajectory, verbose);
 }
 
+hpipm_status HpipmInterface::resolve(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                     const std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& stateTrajectory,
+                                     vector_array_t& inputTrajectory) {
+  return pImpl_->resolve(x0, dynamics, cost, stateTrajectory, inputTrajectory);
+}
+
 std::vector<ScalarFunctionQuadraticApproximation> HpipmInterface::getRiccatiCostToGo(const VectorFunctionLinearApproximation& dynamics0,
                                                                                      const ScalarFunctionQuadraticApproximation& cost0) {
   return pImpl_->getRiccatiCostToGo(dynamics0, cost0);
@@ -551,4 +677,8 @@ vector_array_t HpipmInterface::getRiccatiFeedforward(const VectorFunctionLinearA
   return pImpl_->getRiccatiFeedforward(dynamics0, cost0);
 }
 
+int HpipmInterface::getNumIterations() const {
+  return pImpl_->getNumIterations();
+}
+
 }  // namespace ocs2
@@ -338,3 +338,59 @@ TEST(test_hpiphm_interface, retrieveRiccati) {
     ASSERT_TRUE(uSol[k].isApprox(KSol[k] * xSol[k] + kSol[k]));
   }
 }
+
+TEST(test_hpiphm_interface, resolveWithNewLinearTerms) {
+  int nx = 3;
+  int nu = 2;
+  int N = 5;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+
+  // Interface
+  ocs2::OcpSize ocpSize(N, nx, nu);
+  ocs2::HpipmInterface hpipmInterface(ocpSize);
+
+  // Solve once to factorize
+  std::vector<ocs2::vector_t> xSol;
+  std::vector<ocs2::vector_t> uSol;
+  auto status = hpipmInterface.solve(x0, system, cost, nullptr, xSol, uSol, true);
+  ASSERT_EQ(status, hpipm_status::SUCCESS);
+
+  // Change the linear terms only
+  x0.setRandom();
+  for (int k = 0; k < N; k++) {
+    system[k].f.setRandom();
+    cost[k].dfdx.setRandom();
+    cost[k].dfdu.setRandom();
+  }
+  cost[N].dfdx.setRandom();
+
+  // Resolve with the previous factorization
+  std::vector<ocs2::vector_t> xResolved;
+  std::vector<ocs2::vector_t> uResolved;
+  status = hpipmInterface.resolve(x0, system, cost, xResolved, uResolved);
+  ASSERT_EQ(status, hpipm_status::SUCCESS);
+  const auto kResolved = hpipmInterface.getRiccatiFeedforward(system[0], cost[0]);
+  const auto costToGoResolved = hpipmInterface.getRiccatiCostToGo(system[0], cost[0]);
+
+  // Solve from scratch
+  status = hpipmInterface.solve(x0, system, cost, nullptr, xSol, uSol, true);
+  ASSERT_EQ(status, hpipm_status::SUCCESS);
+  const auto kSol = hpipmInterface.getRiccatiFeedforward(system[0], cost[0]);
+  const auto costToGo = hpipmInterface.getRiccatiCostToGo(system[0], cost[0]);
+
+  ASSERT_TRUE(ocs2::isEqual(xSol, xResolved, 1e-9));
+  ASSERT_TRUE(ocs2::isEqual(uSol, uResolved, 1e-9));
+  ASSERT_TRUE(ocs2::isEqual(kSol, kResolved, 1e-9));
+  for (int k = 0; k < (N + 1); k++) {
+    ASSERT_TRUE(costToGo[k].dfdx.isApprox(costToGoResolved[k].dfdx, 1e-9));
+  }
+}
@@ -29,7 +29,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <limits>
+#include <string>
+
 #include <ocs2_core/Types.h>
+#include <ocs2_core/cost/HessianApproximation.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
 
 #include <hpipm_catkin/HpipmInterfaceSettings.h>
@@ -46,6 +50,7 @@ struct Settings {
   // Linesearch - step size rules
   scalar_t alpha_decay = 0.5;  // multiply the step size by this factor every time a linesearch step is rejected.
   scalar_t alpha_min = 1e-4;   // terminate linesearch if the attempted step size is below this threshold
+  bool speculativeLinesearch = false;  // evaluate the step sizes concurrently on the thread pool and take the largest accepted one
 
   // Linesearch - step acceptance criteria with c = costs, g = the norm of constraint violation, and w = [x; u]
   scalar_t g_max = 1e6;          // (1): IF g{i+1} > g_max REQUIRE g{i+1} < (1-gamma_c) * g{i}
@@ -61,9 +66,24 @@ struct Settings {
   hpipm_interface::Settings hpipmSettings = hpipm_interface::Settings();
 
   // Discretization method
-  scalar_t dt = 0.01;  // user-defined time discretization
+  scalar_t dt = 0.01;                                     // user-defined time discretization
+  scalar_t dtGrowthFactor = 1.0;                          // growth of the time step along the horizon, 1.0 gives a uniform grid
+  scalar_t dtMax = std::numeric_limits<scalar_t>::max();  // upper bound on the time step of a graded grid
   SensitivityIntegratorType integratorType = SensitivityIntegratorType::RK2;
 
+  // Move blocking: the inputs of moveBlockingSize consecutive intervals starting after moveBlockingStartTime are tied together
+  size_t moveBlockingSize = 1;           // number of intervals that share one input, 1 disables move blocking
+  scalar_t moveBlockingStartTime = 0.0;  // [s] time into the horizon from which on the inputs are blocked
+
+  // Incremental linearization: nodes whose state, input, reference and mode changed less than incrementalLinearizationTol since their
+  // last linearization reuse its Jacobians and Hessians. Cost, dynamics defect and constraint values are always evaluated.
+  scalar_t incrementalLinearizationTol = 1e-6;       // infinity norm of the change of a node
+  size_t incrementalLinearizationRefreshPeriod = 1;  // all nodes are linearized at least every this many iterations, 1 disables it
+
+  // Hessian approximation of the state-input cost and soft constraint terms that support it, see StateInputCost::setHessianApproximation().
+  // It is applied to the terms unless the strategy is EXACT, in which case the terms keep their own setting.
+  hessian_approximation::Settings hessianApproximation;
+
   // Inequality penalty relaxed barrier parameters
   scalar_t inequalityConstraintMu = 0.0;
   scalar_t inequalityConstraintDelta = 1e-6;
@@ -76,6 +96,10 @@ struct Settings {
   bool printSolverStatistics = false;  // Print benchmarking of the multiple shooting method
   bool printLinesearch = false;        // Print linesearch information
 
+  // Recording of the QP subproblems, e.g., for benchmarking QP solvers offline on the problems of a real run
+  std::string lqRecordingFile = "";  // binary file the QP subproblems are appended to, empty disables the recording
+  size_t lqRecordingPeriod = 1;      // record every lqRecordingPeriod-th QP subproblem
+
   // Threading
   size_t nThreads = 4;
   int threadPriority = 50;
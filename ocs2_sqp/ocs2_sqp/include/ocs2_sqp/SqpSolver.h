@@ -34,8 +34,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
+#include <ocs2_oc/multiple_shooting/IncrementalLinearization.h>
+#include <ocs2_oc/multiple_shooting/MoveBlocking.h>
 #include <ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h>
 #include <ocs2_oc/oc_data/TimeDiscretization.h>
+#include <ocs2_oc/oc_problem/LqSubproblemRecorder.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/oc_solver/SolverBase.h>
 #include <ocs2_oc/search_strategy/FilterLinesearch.h>
@@ -70,6 +73,9 @@ class SqpSolver : public SolverBase {
 
   size_t getNumIterations() const override { return totalNumIterations_; }
 
+  /** Returns the number of nodes that kept the LQ approximation of an earlier iteration, see incrementalLinearizationRefreshPeriod. */
+  size_t getNumSkippedLinearizations() const { return totalNumSkippedLinearizations_; }
+
   const OptimalControlProblem& getOptimalControlProblem() const override { return ocpDefinitions_.front(); }
 
   const PerformanceIndex& getPerformanceIndeces() const override { return getIterationsLog().back(); };
@@ -119,7 +125,7 @@ class SqpSolver : public SolverBase {
 
   /** Creates QP around t, x(t), u(t). Returns performance metrics at the current {t, x(t), u(t)} */
   PerformanceIndex setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                            const vector_array_t& u, std::vector<Metrics>& metrics);
+                                            const vector_array_t& u);
 
   /** Computes only the performance metrics at the current {t, x(t), u(t)} */
   PerformanceIndex computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
@@ -144,6 +150,11 @@ class SqpSolver : public SolverBase {
                          const OcpSubproblemSolution& subproblemSolution, vector_array_t& x, vector_array_t& u,
                          std::vector<Metrics>& metrics);
 
+  /** Same as takeStep(), but the backtracking step sizes are evaluated concurrently if the full step is rejected */
+  sqp::StepInfo takeSpeculativeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
+                                    const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
+                                    vector_array_t& u, std::vector<Metrics>& metrics);
+
   /** Determine convergence after a step */
   sqp::Convergence checkConvergence(int iteration, const PerformanceIndex& baseline, const sqp::StepInfo& stepInfo) const;
 
@@ -158,6 +169,9 @@ class SqpSolver : public SolverBase {
   // Solver interface
   HpipmInterface hpipmInterface_;
 
+  // Records the QP subproblems passed to HPIPM, nullptr if the recording is disabled
+  std::unique_ptr<LqSubproblemRecorder> lqRecorderPtr_;
+
   // Threading
   ThreadPool threadPool_;
 
@@ -175,6 +189,13 @@ class SqpSolver : public SolverBase {
   std::vector<VectorFunctionLinearApproximation> stateInputIneqConstraints_;
   std::vector<VectorFunctionLinearApproximation> constraintsProjection_;
 
+  // Linearization points of the nodes for the incremental linearization
+  multiple_shooting::IncrementalLinearization incrementalLinearization_;
+
+  // Input move blocking and the LQ approximation condensed to one stage per block
+  std::vector<int> moveBlocks_;
+  multiple_shooting::BlockedLqProblem blockedLqProblem_;
+
   // Lagrange multipliers
   std::vector<multiple_shooting::ProjectionMultiplierCoefficients> projectionMultiplierCoefficients_;
 
@@ -186,6 +207,8 @@ class SqpSolver : public SolverBase {
 
   // Benchmarking
   size_t totalNumIterations_{0};
+  size_t totalNumLinearizations_{0};
+  size_t totalNumSkippedLinearizations_{0};
   benchmark::RepeatedTimer initializationTimer_;
   benchmark::RepeatedTimer linearQuadraticApproximationTimer_;
   benchmark::RepeatedTimer solveQpTimer_;
@@ -34,6 +34,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/misc/LoadData.h>
 
+#include <stdexcept>
+
 namespace ocs2 {
 namespace sqp {
 
@@ -52,17 +54,25 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.deltaTol, fieldName + ".deltaTol", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_decay, fieldName + ".alpha_decay", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_min, fieldName + ".alpha_min", verbose);
+  loadData::loadPtreeValue(pt, settings.speculativeLinesearch, fieldName + ".speculativeLinesearch", verbose);
   loadData::loadPtreeValue(pt, settings.gamma_c, fieldName + ".gamma_c", verbose);
   loadData::loadPtreeValue(pt, settings.g_max, fieldName + ".g_max", verbose);
   loadData::loadPtreeValue(pt, settings.g_min, fieldName + ".g_min", verbose);
   loadData::loadPtreeValue(pt, settings.armijoFactor, fieldName + ".armijoFactor", verbose);
   loadData::loadPtreeValue(pt, settings.costTol, fieldName + ".costTol", verbose);
   loadData::loadPtreeValue(pt, settings.dt, fieldName + ".dt", verbose);
+  loadData::loadPtreeValue(pt, settings.dtGrowthFactor, fieldName + ".dtGrowthFactor", verbose);
+  loadData::loadPtreeValue(pt, settings.dtMax, fieldName + ".dtMax", verbose);
   loadData::loadPtreeValue(pt, settings.useFeedbackPolicy, fieldName + ".useFeedbackPolicy", verbose);
   loadData::loadPtreeValue(pt, settings.createValueFunction, fieldName + ".createValueFunction", verbose);
   auto integratorName = sensitivity_integrator::toString(settings.integratorType);
   loadData::loadPtreeValue(pt, integratorName, fieldName + ".integratorType", verbose);
   settings.integratorType = sensitivity_integrator::fromString(integratorName);
+  loadData::loadPtreeValue(pt, settings.moveBlockingSize, fieldName + ".moveBlockingSize", verbose);
+  loadData::loadPtreeValue(pt, settings.moveBlockingStartTime, fieldName + ".moveBlockingStartTime", verbose);
+  loadData::loadPtreeValue(pt, settings.incrementalLinearizationTol, fieldName + ".incrementalLinearizationTol", verbose);
+  loadData::loadPtreeValue(pt, settings.incrementalLinearizationRefreshPeriod, fieldName + ".incrementalLinearizationRefreshPeriod",
+                           verbose);
   loadData::loadPtreeValue(pt, settings.inequalityConstraintMu, fieldName + ".inequalityConstraintMu", verbose);
   loadData::loadPtreeValue(pt, settings.inequalityConstraintDelta, fieldName + ".inequalityConstraintDelta", verbose);
   loadData::loadPtreeValue(pt, settings.projectStateInputEqualityConstraints, fieldName + ".projectStateInputEqualityConstraints", verbose);
@@ -70,14 +80,22 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.printSolverStatus, fieldName + ".printSolverStatus", verbose);
   loadData::loadPtreeValue(pt, settings.printSolverStatistics, fieldName + ".printSolverStatistics", verbose);
   loadData::loadPtreeValue(pt, settings.printLinesearch, fieldName + ".printLinesearch", verbose);
+  loadData::loadPtreeValue(pt, settings.lqRecordingFile, fieldName + ".lqRecordingFile", verbose);
+  loadData::loadPtreeValue(pt, settings.lqRecordingPeriod, fieldName + ".lqRecordingPeriod", verbose);
   loadData::loadPtreeValue(pt, settings.nThreads, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority, fieldName + ".threadPriority", verbose);
 
+  if (settings.dtGrowthFactor < 1.0) {
+    throw std::invalid_argument("[MultipleShootingSqpSettings] dtGrowthFactor must be at least 1.0!");
+  }
+
   if (verbose) {
     std::cerr << settings.hpipmSettings;
     std::cerr << " #### =============================================================================" << std::endl;
   }
 
+  settings.hessianApproximation = hessian_approximation::loadSettings(filename, fieldName + ".hessianApproximation", verbose);
+
   return settings;
 }
 }  // namespace sqp
@@ -39,6 +39,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_oc/multiple_shooting/PerformanceIndexComputation.h>
 #include <ocs2_oc/multiple_shooting/Transcription.h>
 #include <ocs2_oc/oc_problem/OcpSize.h>
+#include <ocs2_oc/search_strategy/SpeculativeLinesearch.h>
 #include <ocs2_oc/trajectory_adjustment/TrajectorySpreadingHelperFunctions.h>
 
 namespace ocs2 {
@@ -56,7 +57,8 @@ sqp::Settings rectifySettings(const OptimalControlProblem& ocp, sqp::Settings&&
 SqpSolver::SqpSolver(sqp::Settings settings, const OptimalControlProblem& optimalControlProblem, const Initializer& initializer)
     : settings_(rectifySettings(optimalControlProblem, std::move(settings))),
       hpipmInterface_(OcpSize(), settings_.hpipmSettings),
-      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority) {
+      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority),
+      incrementalLinearization_(settings_.incrementalLinearizationTol, settings_.incrementalLinearizationRefreshPeriod) {
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
 
@@ -65,13 +67,24 @@ SqpSolver::SqpSolver(sqp::Settings settings, const OptimalControlProblem& optima
   sensitivityDiscretizer_ = selectDynamicsSensitivityDiscretization(settings_.integratorType);
 
   // Clone objects to have one for each worker
-  for (int w = 0; w < settings_.nThreads; w++) {
-    ocpDefinitions_.push_back(optimalControlProblem);
+  ocpDefinitions_.push_back(optimalControlProblem);
+  if (settings_.hessianApproximation.strategy != hessian_approximation::Strategy::EXACT) {
+    // Set before cloning, such that all clones share the approximation of the nodes
+    ocpDefinitions_.front().costPtr->setHessianApproximation(settings_.hessianApproximation);
+    ocpDefinitions_.front().softConstraintPtr->setHessianApproximation(settings_.hessianApproximation);
+  }
+  for (int w = 1; w < settings_.nThreads; w++) {
+    ocpDefinitions_.push_back(ocpDefinitions_.front());
   }
 
   // Operating points
   initializerPtr_.reset(initializer.clone());
 
+  // QP subproblem recording
+  if (!settings_.lqRecordingFile.empty()) {
+    lqRecorderPtr_.reset(new LqSubproblemRecorder(settings_.lqRecordingFile, settings_.lqRecordingPeriod));
+  }
+
   // Linesearch
   filterLinesearch_.g_max = settings_.g_max;
   filterLinesearch_.g_min = settings_.g_min;
@@ -90,9 +103,12 @@ void SqpSolver::reset() {
   primalSolution_ = PrimalSolution();
   valueFunction_.clear();
   performanceIndeces_.clear();
+  incrementalLinearization_.reset();
 
   // reset timers
   totalNumIterations_ = 0;
+  totalNumLinearizations_ = 0;
+  totalNumSkippedLinearizations_ = 0;
   linearQuadraticApproximationTimer_.reset();
   solveQpTimer_.reset();
   linesearchTimer_.reset();
@@ -115,6 +131,11 @@ std::string SqpSolver::getBenchmarkingInformation() const {
     infoStream << "SQP Benchmarking\t   :\tAverage time [ms]   (% of total runtime)\n";
     infoStream << "\tLQ Approximation   :\t" << linearQuadraticApproximationTimer_.getAverageInMilliseconds() << " [ms] \t\t("
                << linearQuadraticApproximationTotal / benchmarkTotal * inPercent << "%)\n";
+    if (settings_.incrementalLinearizationRefreshPeriod > 1) {
+      infoStream << "\tSkipped nodes      :\t" << totalNumSkippedLinearizations_ << " of " << totalNumLinearizations_ << " \t\t("
+                 << static_cast<scalar_t>(totalNumSkippedLinearizations_) / std::max(totalNumLinearizations_, size_t(1)) * inPercent
+                 << "%)\n";
+    }
     infoStream << "\tSolve QP           :\t" << solveQpTimer_.getAverageInMilliseconds() << " [ms] \t\t("
                << solveQpTotal / benchmarkTotal * inPercent << "%)\n";
     infoStream << "\tLinesearch         :\t" << linesearchTimer_.getAverageInMilliseconds() << " [ms] \t\t("
@@ -163,7 +184,8 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
 
   // Determine time discretization, taking into account event times.
   const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
-  const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
+  const auto timeDiscretization =
+      gradedTimeDiscretizationWithEvents(initTime, finalTime, settings_.dt, settings_.dtGrowthFactor, settings_.dtMax, eventTimes);
 
   // Initialize references
   for (auto& ocpDefinition : ocpDefinitions_) {
@@ -180,7 +202,16 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   vector_array_t x, u;
   multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
 
-  // Bookkeeping
+  // Input move blocking. Without projection, the inputs of a block are tied here and the QP steps keep them tied. With projection,
+  // the projected inputs of the QP steps are tied.
+  moveBlocks_ = multiple_shooting::computeMoveBlocks(timeDiscretization, initTime + settings_.moveBlockingStartTime,
+                                                     settings_.moveBlockingSize);
+  const bool hasStateInputConstraints = !ocpDefinitions_.front().equalityConstraintPtr->empty();
+  if (!hasStateInputConstraints || !settings_.projectStateInputEqualityConstraints) {
+    multiple_shooting::applyMoveBlocks(moveBlocks_, u);
+  }
+
+  // Bookkeeping. The metrics are those of the last accepted step, i.e., of the current x and u.
   performanceIndeces_.clear();
   std::vector<Metrics> metrics;
 
@@ -192,7 +223,7 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     }
     // Make QP approximation
     linearQuadraticApproximationTimer_.startTimer();
-    const auto baselinePerformance = setupQuadraticSubproblem(timeDiscretization, initState, x, u, metrics);
+    const auto baselinePerformance = setupQuadraticSubproblem(timeDiscretization, initState, x, u);
     linearQuadraticApproximationTimer_.endTimer();
 
     // Solve QP
@@ -217,8 +248,14 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   }
 
   computeControllerTimer_.startTimer();
+  problemMetrics_ = ProblemMetrics();
+  if (isSolutionMetricsRequired()) {
+    if (metrics.empty()) {  // No step was accepted
+      computePerformance(timeDiscretization, initState, x, u, metrics);
+    }
+    problemMetrics_ = multiple_shooting::toProblemMetrics(timeDiscretization, std::move(metrics));
+  }
   primalSolution_ = toPrimalSolution(timeDiscretization, std::move(x), std::move(u));
-  problemMetrics_ = multiple_shooting::toProblemMetrics(timeDiscretization, std::move(metrics));
   computeControllerTimer_.endTimer();
 
   if (settings_.printSolverStatus || settings_.printLinesearch) {
@@ -240,12 +277,34 @@ SqpSolver::OcpSubproblemSolution SqpSolver::getOCPSolution(const vector_t& delta
   auto& deltaUSol = solution.deltaUSol;
   hpipm_status status;
   const bool hasStateInputConstraints = !ocpDefinitions_.front().equalityConstraintPtr->empty();
-  if (hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints) {
+  const bool hasConstraintsInQp = hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints;
+  multiple_shooting::splitMoveBlocks(dynamics_, moveBlocks_);
+  if (multiple_shooting::hasBlockedInputs(moveBlocks_)) {
+    // Solve the QP condensed to one stage per input block
+    multiple_shooting::blockLinearQuadraticProblem(moveBlocks_, dynamics_, cost_, hasConstraintsInQp ? &stateInputEqConstraints_ : nullptr,
+                                                   blockedLqProblem_);
+    auto* blockedConstraintsPtr = hasConstraintsInQp ? &blockedLqProblem_.constraints : nullptr;
+    hpipmInterface_.resize(extractSizesFromProblem(blockedLqProblem_.dynamics, blockedLqProblem_.cost, blockedConstraintsPtr));
+    if (lqRecorderPtr_ != nullptr) {
+      lqRecorderPtr_->record(delta_x0, blockedLqProblem_.dynamics, blockedLqProblem_.cost, blockedConstraintsPtr);
+    }
+    status = hpipmInterface_.solve(delta_x0, blockedLqProblem_.dynamics, blockedLqProblem_.cost, blockedConstraintsPtr, deltaXSol,
+                                   deltaUSol, settings_.printSolverStatus);
+    if (status == hpipm_status::SUCCESS) {
+      multiple_shooting::unblockSolution(moveBlocks_, dynamics_, deltaXSol, deltaUSol);
+    }
+  } else if (hasConstraintsInQp) {
     hpipmInterface_.resize(extractSizesFromProblem(dynamics_, cost_, &stateInputEqConstraints_));
+    if (lqRecorderPtr_ != nullptr) {
+      lqRecorderPtr_->record(delta_x0, dynamics_, cost_, &stateInputEqConstraints_);
+    }
     status =
         hpipmInterface_.solve(delta_x0, dynamics_, cost_, &stateInputEqConstraints_, deltaXSol, deltaUSol, settings_.printSolverStatus);
   } else {  // without constraints, or when using projection, we have an unconstrained QP.
     hpipmInterface_.resize(extractSizesFromProblem(dynamics_, cost_, nullptr));
+    if (lqRecorderPtr_ != nullptr) {
+      lqRecorderPtr_->record(delta_x0, dynamics_, cost_, nullptr);
+    }
     status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
   }
 
@@ -266,7 +325,12 @@ SqpSolver::OcpSubproblemSolution SqpSolver::getOCPSolution(const vector_t& delta
 
 void SqpSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x) {
   if (settings_.createValueFunction) {
-    valueFunction_ = hpipmInterface_.getRiccatiCostToGo(dynamics_[0], cost_[0]);
+    if (multiple_shooting::hasBlockedInputs(moveBlocks_)) {
+      valueFunction_ = hpipmInterface_.getRiccatiCostToGo(blockedLqProblem_.dynamics[0], blockedLqProblem_.cost[0]);
+      multiple_shooting::unblockCostToGo(moveBlocks_, dynamics_, cost_, valueFunction_);
+    } else {
+      valueFunction_ = hpipmInterface_.getRiccatiCostToGo(dynamics_[0], cost_[0]);
+    }
     // Correct for linearization state
     for (int i = 0; i < time.size(); ++i) {
       valueFunction_[i].dfdx.noalias() -= valueFunction_[i].dfdxx * x[i];
@@ -277,7 +341,16 @@ void SqpSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, con
 PrimalSolution SqpSolver::toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u) {
   if (settings_.useFeedbackPolicy) {
     ModeSchedule modeSchedule = this->getReferenceManager().getModeSchedule();
-    matrix_array_t KMatrices = hpipmInterface_.getRiccatiFeedback(dynamics_[0], cost_[0]);
+    matrix_array_t KMatrices;
+    if (multiple_shooting::hasBlockedInputs(moveBlocks_)) {
+      const auto& blockedDynamics0 = blockedLqProblem_.dynamics[0];
+      const auto& blockedCost0 = blockedLqProblem_.cost[0];
+      KMatrices = hpipmInterface_.getRiccatiFeedback(blockedDynamics0, blockedCost0);
+      const auto costToGo = hpipmInterface_.getRiccatiCostToGo(blockedDynamics0, blockedCost0);
+      multiple_shooting::unblockFeedback(moveBlocks_, dynamics_, cost_, costToGo, KMatrices);
+    } else {
+      KMatrices = hpipmInterface_.getRiccatiFeedback(dynamics_[0], cost_[0]);
+    }
     if (settings_.projectStateInputEqualityConstraints) {
       multiple_shooting::remapProjectedGain(constraintsProjection_, KMatrices);
     }
@@ -290,7 +363,7 @@ PrimalSolution SqpSolver::toPrimalSolution(const std::vector<AnnotatedTime>& tim
 }
 
 PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState,
-                                                     const vector_array_t& x, const vector_array_t& u, std::vector<Metrics>& metrics) {
+                                                     const vector_array_t& x, const vector_array_t& u) {
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
 
@@ -302,8 +375,17 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
   stateInputIneqConstraints_.resize(N);
   constraintsProjection_.resize(N);
   projectionMultiplierCoefficients_.resize(N);
-  metrics.resize(N + 1);
 
+  // Nodes that did not move since their last linearization keep their derivatives, the values are evaluated at the current point
+  const bool isIncremental = settings_.incrementalLinearizationRefreshPeriod > 1;
+  if (isIncremental) {
+    totalNumSkippedLinearizations_ += incrementalLinearization_.update(time, x, u, this->getReferenceManager().getModeSchedule(),
+                                                                       *ocpDefinitions_.front().targetTrajectoriesPtr);
+  }
+  totalNumLinearizations_ += N + 1;
+  auto needsLinearization = [&](int i) { return !isIncremental || incrementalLinearization_.needsLinearization(i); };
+
+  const bool hasHessianApproximation = settings_.hessianApproximation.strategy != hessian_approximation::Strategy::EXACT;
   std::atomic_int timeIndex{0};
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
@@ -314,8 +396,16 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
     while (i < N) {
       if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
-        auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
+        multiple_shooting::EventTranscription result;
+        if (needsLinearization(i)) {
+          result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
+          if (isIncremental) {
+            incrementalLinearization_.setEventNode(i, result);
+          }
+        } else {
+          const auto metrics = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
+          result = incrementalLinearization_.getEventNode(i, x[i], metrics);
+        }
         workerPerformance += multiple_shooting::computePerformanceIndex(result);
         cost_[i] = std::move(result.cost);
         dynamics_[i] = std::move(result.dynamics);
@@ -328,8 +418,20 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
+        multiple_shooting::Transcription result;
+        if (needsLinearization(i)) {
+          if (hasHessianApproximation) {
+            ocpDefinition.costPtr->setHessianApproximationNode(i);
+            ocpDefinition.softConstraintPtr->setHessianApproximationNode(i);
+          }
+          result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
+          if (isIncremental) {
+            incrementalLinearization_.setIntermediateNode(i, result);
+          }
+        } else {
+          const auto metrics = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
+          result = incrementalLinearization_.getIntermediateNode(i, x[i], u[i], metrics);
+        }
         workerPerformance += multiple_shooting::computePerformanceIndex(result, dt);
         if (settings_.projectStateInputEqualityConstraints) {
           multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier);
@@ -348,8 +450,16 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
 
     if (i == N) {  // Only one worker will execute this
       const scalar_t tN = getIntervalStart(time[N]);
-      auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
-      metrics[i] = multiple_shooting::computeMetrics(result);
+      multiple_shooting::TerminalTranscription result;
+      if (needsLinearization(N)) {
+        result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
+        if (isIncremental) {
+          incrementalLinearization_.setTerminalNode(result);
+        }
+      } else {
+        const auto metrics = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
+        result = incrementalLinearization_.getTerminalNode(x[N], metrics);
+      }
       workerPerformance += multiple_shooting::computePerformanceIndex(result);
       cost_[i] = std::move(result.cost);
       stateInputEqConstraints_[i].resize(0, x[i].size());
@@ -362,9 +472,7 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
   runParallel(std::move(parallelTask));
 
   // Account for initial state in performance
-  const vector_t initDynamicsViolation = initState - x.front();
-  metrics.front().dynamicsViolation += initDynamicsViolation;
-  performance.front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+  performance.front().dynamicsViolationSSE += (initState - x.front()).squaredNorm();
 
   // Sum performance of the threads
   PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
@@ -426,6 +534,10 @@ sqp::StepInfo SqpSolver::takeStep(const PerformanceIndex& baseline, const std::v
                                   vector_array_t& u, std::vector<Metrics>& metrics) {
   using StepType = FilterLinesearch::StepType;
 
+  if (settings_.speculativeLinesearch) {
+    return takeSpeculativeStep(baseline, timeDiscretization, initState, subproblemSolution, x, u, metrics);
+  }
+
   /*
    * Filter linesearch based on:
    * "On the implementation of an interior-point filter line-search algorithm for large-scale nonlinear programming"
@@ -516,6 +628,92 @@ sqp::StepInfo SqpSolver::takeStep(const PerformanceIndex& baseline, const std::v
   return stepInfo;
 }
 
+sqp::StepInfo SqpSolver::takeSpeculativeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
+                                             const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
+                                             vector_array_t& u, std::vector<Metrics>& metrics) {
+  if (settings_.printLinesearch) {
+    std::cerr << std::setprecision(9) << std::fixed;
+    std::cerr << "\n=== Speculative Linesearch ===\n";
+    std::cerr << "Baseline:\n" << baseline << "\n";
+  }
+
+  // Update norm
+  const auto& dx = subproblemSolution.deltaXSol;
+  const auto& du = subproblemSolution.deltaUSol;
+  const auto deltaUnorm = multiple_shooting::trajectoryNorm(du);
+  const auto deltaXnorm = multiple_shooting::trajectoryNorm(dx);
+
+  // The same step sizes as the serial backtracking
+  const scalar_array_t stepSizes =
+      backtrackingStepSizes(1.0, settings_.alpha_decay, settings_.alpha_min, settings_.deltaTol, deltaXnorm, deltaUnorm);
+
+  // Same evaluation as computePerformance(), node by node. The candidate is {x, u}.
+  const int N = static_cast<int>(timeDiscretization.size()) - 1;
+  auto evaluateNode = [&](int workerId, int i, const std::vector<vector_array_t>& candidate, Metrics& nodeMetrics) {
+    OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
+    const auto& xNew = candidate[0];
+    const auto& uNew = candidate[1];
+    PerformanceIndex performance;
+    if (i == N) {
+      const scalar_t tN = getIntervalStart(timeDiscretization[N]);
+      nodeMetrics = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, xNew[N]);
+      performance = toPerformanceIndex(nodeMetrics);
+    } else if (timeDiscretization[i].event == AnnotatedTime::Event::PreEvent) {
+      nodeMetrics = multiple_shooting::computeEventMetrics(ocpDefinition, timeDiscretization[i].time, xNew[i], xNew[i + 1]);
+      performance = toPerformanceIndex(nodeMetrics);
+    } else {
+      const scalar_t ti = getIntervalStart(timeDiscretization[i]);
+      const scalar_t dt = getIntervalDuration(timeDiscretization[i], timeDiscretization[i + 1]);
+      nodeMetrics = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, xNew[i], xNew[i + 1], uNew[i]);
+      performance = toPerformanceIndex(nodeMetrics, dt);
+    }
+    if (i == 0) {  // Account for initial state in performance
+      const vector_t initDynamicsViolation = initState - xNew.front();
+      nodeMetrics.dynamicsViolation += initDynamicsViolation;
+      performance.dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+    }
+    return performance;
+  };
+
+  std::vector<vector_array_t> trajectories{std::move(x), std::move(u)};
+  const auto result = speculativeLinesearch(filterLinesearch_, threadPool_, settings_.nThreads, baseline,
+                                            subproblemSolution.armijoDescentMetric, stepSizes, N + 1, evaluateNode, {dx, du}, trajectories,
+                                            metrics);
+  x = std::move(trajectories[0]);
+  u = std::move(trajectories[1]);
+
+  sqp::StepInfo stepInfo;
+  if (result.stepIndex >= 0) {
+    const scalar_t alpha = stepSizes[result.stepIndex];
+    stepInfo.stepSize = alpha;
+    stepInfo.stepType = result.stepType;
+    stepInfo.dx_norm = alpha * deltaXnorm;
+    stepInfo.du_norm = alpha * deltaUnorm;
+    stepInfo.performanceAfterStep = result.performance;
+    stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(result.performance);
+
+    if (settings_.printLinesearch) {
+      std::cerr << "Step size: " << alpha << ", Step Type: " << toString(stepInfo.stepType) << " (Accepted)\n";
+      std::cerr << "|dx| = " << stepInfo.dx_norm << "\t|du| = " << stepInfo.du_norm << "\n";
+      std::cerr << result.performance << "\n";
+    }
+
+  } else {  // All step sizes rejected -> Don't take a step
+    stepInfo.stepSize = 0.0;
+    stepInfo.stepType = FilterLinesearch::StepType::ZERO;
+    stepInfo.dx_norm = 0.0;
+    stepInfo.du_norm = 0.0;
+    stepInfo.performanceAfterStep = baseline;
+    stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(baseline);
+
+    if (settings_.printLinesearch) {
+      std::cerr << "[Linesearch terminated] Step size: " << stepInfo.stepSize << ", Step Type: " << toString(stepInfo.stepType) << "\n";
+    }
+  }
+
+  return stepInfo;
+}
+
 sqp::Convergence SqpSolver::checkConvergence(int iteration, const PerformanceIndex& baseline, const sqp::StepInfo& stepInfo) const {
   using Convergence = sqp::Convergence;
   if ((iteration + 1) >= settings_.sqpIteration) {
@@ -531,6 +729,9 @@ sqp::Convergence SqpSolver::checkConvergence(int iteration, const PerformanceInd
   } else if (stepInfo.dx_norm < settings_.deltaTol && stepInfo.du_norm < settings_.deltaTol) {
     // Converged because the change in primal variables is below the specified tolerance
     return Convergence::PRIMAL;
+  } else if (isTerminationRequested()) {
+    // Stopped because the termination was requested from outside
+    return Convergence::TERMINATED;
   } else {
     // None of the above convergence criteria were met -> not converged.
     return Convergence::FALSE;
@@ -89,6 +89,197 @@ TEST(test_circular_kinematics, solve_projected_EqConstraints) {
   }
 }
 
+TEST(test_circular_kinematics, solve_projected_EqConstraints_speculativeLinesearch) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  auto getSettings = [](bool speculativeLinesearch) {
+    ocs2::sqp::Settings settings;
+    settings.dt = 0.01;
+    settings.sqpIteration = 20;
+    settings.projectStateInputEqualityConstraints = true;
+    settings.useFeedbackPolicy = true;
+    settings.printLinesearch = true;
+    settings.nThreads = 4;
+    settings.speculativeLinesearch = speculativeLinesearch;
+    return settings;
+  };
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Solve
+  ocs2::SqpSolver solverSerial(getSettings(false), problem, zeroInitializer);
+  solverSerial.run(startTime, initState, finalTime);
+  ocs2::SqpSolver solverSpeculative(getSettings(true), problem, zeroInitializer);
+  solverSpeculative.run(startTime, initState, finalTime);
+
+  // The speculative linesearch takes the same steps as the serial one
+  const auto& iterationsSerial = solverSerial.getIterationsLog();
+  const auto& iterationsSpeculative = solverSpeculative.getIterationsLog();
+  ASSERT_EQ(iterationsSerial.size(), iterationsSpeculative.size());
+  for (int i = 0; i < iterationsSerial.size(); i++) {
+    EXPECT_NEAR(iterationsSerial[i].merit, iterationsSpeculative[i].merit, 1e-9);
+  }
+
+  const auto primalSolutionSerial = solverSerial.primalSolution(finalTime);
+  const auto primalSolutionSpeculative = solverSpeculative.primalSolution(finalTime);
+  ASSERT_EQ(primalSolutionSerial.timeTrajectory_.size(), primalSolutionSpeculative.timeTrajectory_.size());
+  for (int i = 0; i < primalSolutionSerial.timeTrajectory_.size(); i++) {
+    ASSERT_TRUE(primalSolutionSerial.stateTrajectory_[i].isApprox(primalSolutionSpeculative.stateTrajectory_[i], 1e-9));
+    ASSERT_TRUE(primalSolutionSerial.inputTrajectory_[i].isApprox(primalSolutionSpeculative.inputTrajectory_[i], 1e-9));
+  }
+}
+
+TEST(test_circular_kinematics, solve_projected_EqConstraints_moveBlocking) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  auto getSettings = [](size_t moveBlockingSize) {
+    ocs2::sqp::Settings settings;
+    settings.dt = 0.01;
+    settings.sqpIteration = 20;
+    settings.projectStateInputEqualityConstraints = true;
+    settings.useFeedbackPolicy = true;
+    settings.printLinesearch = true;
+    settings.nThreads = 1;
+    settings.moveBlockingSize = moveBlockingSize;
+    settings.moveBlockingStartTime = 0.2;
+    return settings;
+  };
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Solve
+  ocs2::SqpSolver solver(getSettings(1), problem, zeroInitializer);
+  solver.run(startTime, initState, finalTime);
+  ocs2::SqpSolver solverBlocked(getSettings(5), problem, zeroInitializer);
+  solverBlocked.run(startTime, initState, finalTime);
+
+  // Check constraint satisfaction, the blocked inputs cannot improve the cost.
+  const auto performance = solver.getPerformanceIndeces();
+  const auto performanceBlocked = solverBlocked.getPerformanceIndeces();
+  ASSERT_LT(performanceBlocked.dynamicsViolationSSE, 1e-6);
+  ASSERT_LT(performanceBlocked.equalityConstraintsSSE, 1e-6);
+  ASSERT_GE(performanceBlocked.cost, performance.cost - 1e-6);
+
+  // Check initial condition
+  const auto primalSolution = solverBlocked.primalSolution(finalTime);
+  ASSERT_TRUE(primalSolution.stateTrajectory_.front().isApprox(initState));
+  ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.front(), startTime);
+  ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.back(), finalTime);
+
+  // Check feedback controller
+  for (int i = 0; i < primalSolution.timeTrajectory_.size() - 1; i++) {
+    const auto t = primalSolution.timeTrajectory_[i];
+    const auto& x = primalSolution.stateTrajectory_[i];
+    const auto& u = primalSolution.inputTrajectory_[i];
+    ASSERT_TRUE(u.isApprox(primalSolution.controllerPtr_->computeInput(t, x)));
+  }
+}
+
+TEST(test_circular_kinematics, solve_projected_EqConstraints_incrementalLinearization) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  auto getSettings = [](size_t refreshPeriod) {
+    ocs2::sqp::Settings settings;
+    settings.dt = 0.01;
+    settings.sqpIteration = 20;
+    settings.projectStateInputEqualityConstraints = true;
+    settings.useFeedbackPolicy = true;
+    settings.printLinesearch = true;
+    settings.nThreads = 4;
+    settings.incrementalLinearizationTol = 1e-4;
+    settings.incrementalLinearizationRefreshPeriod = refreshPeriod;
+    return settings;
+  };
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Solve, the second run starts from the converged solution of the first one
+  ocs2::SqpSolver solver(getSettings(1), problem, zeroInitializer);
+  solver.run(startTime, initState, finalTime);
+  solver.run(startTime, initState, finalTime);
+  ocs2::SqpSolver solverIncremental(getSettings(10), problem, zeroInitializer);
+  solverIncremental.run(startTime, initState, finalTime);
+  solverIncremental.run(startTime, initState, finalTime);
+
+  // Nodes that moved less than the tolerance keep their linearization, the periodic refresh recovers the converged solution
+  ASSERT_EQ(solver.getNumSkippedLinearizations(), 0);
+  ASSERT_GT(solverIncremental.getNumSkippedLinearizations(), 0);
+
+  const auto performance = solver.getPerformanceIndeces();
+  const auto performanceIncremental = solverIncremental.getPerformanceIndeces();
+  ASSERT_LT(performanceIncremental.dynamicsViolationSSE, 1e-6);
+  ASSERT_LT(performanceIncremental.equalityConstraintsSSE, 1e-6);
+  ASSERT_NEAR(performanceIncremental.merit, performance.merit, 1e-6);
+
+  const auto primalSolution = solver.primalSolution(finalTime);
+  const auto primalSolutionIncremental = solverIncremental.primalSolution(finalTime);
+  ASSERT_EQ(primalSolution.timeTrajectory_.size(), primalSolutionIncremental.timeTrajectory_.size());
+  for (int i = 0; i < primalSolution.timeTrajectory_.size(); i++) {
+    ASSERT_TRUE(primalSolution.stateTrajectory_[i].isApprox(primalSolutionIncremental.stateTrajectory_[i], 1e-4));
+    ASSERT_TRUE(primalSolution.inputTrajectory_[i].isApprox(primalSolutionIncremental.inputTrajectory_[i], 1e-4));
+  }
+}
+
+TEST(test_circular_kinematics, solve_projected_EqConstraints_solutionMetrics) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.nThreads = 1;
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Without observers, the solution metrics are only collected on request
+  ocs2::SqpSolver solver(settings, problem, zeroInitializer);
+  solver.run(startTime, initState, finalTime);
+  ASSERT_TRUE(solver.getSolutionMetrics().intermediates.empty());
+
+  // The second run starts from the converged solution, the metrics are also available if no step is accepted
+  solver.requestSolutionMetrics(true);
+  solver.run(startTime, initState, finalTime);
+  const auto& solutionMetrics = solver.getSolutionMetrics();
+  const auto primalSolution = solver.primalSolution(finalTime);
+  ASSERT_EQ(solutionMetrics.intermediates.size(), primalSolution.timeTrajectory_.size() - 1);
+  for (const auto& metrics : solutionMetrics.intermediates) {
+    ASSERT_EQ(metrics.stateInputEqConstraint.size(), 1);
+    ASSERT_LT(metrics.stateInputEqConstraint.front().norm(), 1e-3);
+  }
+}
+
 TEST(test_circular_kinematics, solve_EqConstraints_inQPSubproblem) {
   // optimal control problem
   ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
@@ -0,0 +1,193 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_sqp/SqpMpc.h"
+
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_mpc/ClosedLoopReplay.h>
+#include <ocs2_mpc/MPC_MRT_Interface.h>
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+
+#include <ocs2_oc/test/circular_kinematics.h>
+
+namespace {
+std::unique_ptr<ocs2::SqpMpc> getMpc(const ocs2::OptimalControlProblem& problem, const ocs2::Initializer& initializer) {
+  ocs2::mpc::Settings mpcSettings;
+  mpcSettings.timeHorizon_ = 1.0;
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 5;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.printSolverStatus = false;
+  settings.nThreads = 1;
+  return std::make_unique<ocs2::SqpMpc>(mpcSettings, settings, problem, initializer);
+}
+
+/** Moves the target state by a constant offset in every solver run, based on the modified target of the previous run. */
+class DriftingReferenceManager final : public ocs2::ReferenceManager {
+ public:
+  using ocs2::ReferenceManager::ReferenceManager;
+
+ private:
+  void modifyReferences(ocs2::scalar_t initTime, ocs2::scalar_t finalTime, const ocs2::vector_t& initState,
+                        ocs2::TargetTrajectories& targetTrajectories, ocs2::ModeSchedule& modeSchedule) override {
+    targetTrajectories.stateTrajectory.front().array() += 0.1;
+  }
+};
+}  // namespace
+
+TEST(test_closed_loop_replay, recordAndReplay) {
+  const std::string filename = "/tmp/ocs2_closed_loop_recording.bin";
+  const ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+  const ocs2::DefaultInitializer zeroInitializer(2);
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // record a closed loop in which the target changes once
+  constexpr size_t numIterations = 5;
+  {
+    auto mpcPtr = getMpc(problem, zeroInitializer);
+    ocs2::MPC_MRT_Interface mpcMrtInterface(*mpcPtr);
+    mpcMrtInterface.resetMpcNode(ocs2::TargetTrajectories({0.0}, {initState}, {ocs2::vector_t::Zero(2)}));
+    mpcMrtInterface.startRecording(filename);
+    for (size_t i = 0; i < numIterations; ++i) {
+      if (i == 2) {
+        mpcMrtInterface.getReferenceManager().setTargetTrajectories(
+            ocs2::TargetTrajectories({0.0}, {ocs2::vector_t::Zero(2)}, {ocs2::vector_t::Zero(2)}));
+      }
+      ocs2::SystemObservation observation;
+      observation.time = 0.01 * i;
+      observation.state = initState;
+      observation.input = ocs2::vector_t::Zero(2);
+      mpcMrtInterface.setCurrentObservation(observation);
+      mpcMrtInterface.advanceMpc();
+    }
+    mpcMrtInterface.stopRecording();
+  }
+
+  const auto frames = ocs2::loadClosedLoopRecording(filename);
+  ASSERT_EQ(frames.size(), numIterations);
+  for (size_t i = 0; i < numIterations; ++i) {
+    EXPECT_DOUBLE_EQ(frames[i].observation.time, 0.01 * i);
+    EXPECT_TRUE(frames[i].observation.state.isApprox(initState));
+    EXPECT_TRUE(frames[i].isPolicyUpdated);
+    EXPECT_EQ(frames[i].policyInput.size(), 2);
+    // the references are stored in the first frame and when they changed
+    EXPECT_EQ(frames[i].isTargetTrajectoriesUpdated, i == 0 || i == 2);
+    EXPECT_EQ(frames[i].isModeScheduleUpdated, i == 0);
+  }
+  EXPECT_TRUE(frames[2].targetTrajectories.stateTrajectory.front().isZero());
+
+  // the replay through an identical MPC reproduces the recorded policies
+  auto mpcPtr = getMpc(problem, zeroInitializer);
+  const auto replayResult = ocs2::replayClosedLoop(*mpcPtr, frames);
+  const auto recordedResult = ocs2::getRecordedResult(frames);
+  const auto comparison = ocs2::comparePolicies(replayResult, recordedResult);
+  EXPECT_EQ(comparison.numCompared, numIterations);
+  EXPECT_EQ(comparison.numUpdateMismatches, 0);
+  EXPECT_LT(comparison.maxInputDeviation, 1e-9);
+  EXPECT_TRUE(mpcPtr->getSolverPtr()->getReferenceManager().getTargetTrajectories().stateTrajectory.front().isZero());
+
+  const auto statistics = ocs2::getLatencyStatistics(replayResult);
+  EXPECT_EQ(statistics.numSamples, numIterations);
+  EXPECT_LE(statistics.min, statistics.median);
+  EXPECT_LE(statistics.median, statistics.percentile90);
+  EXPECT_LE(statistics.percentile99, statistics.max);
+  std::cerr << "Replay latency: " << statistics << "\n";
+  std::cerr << "Replay vs. recording: " << comparison << "\n";
+}
+
+TEST(test_closed_loop_replay, latencyStatistics) {
+  ocs2::ClosedLoopResult result;
+  for (size_t i = 1; i <= 100; ++i) {
+    result.isPolicyUpdated.push_back(true);
+    result.latencies.push_back(static_cast<ocs2::scalar_t>(i));
+    result.policyInputs.emplace_back();
+  }
+  // calls without a new policy are not part of the distribution
+  result.isPolicyUpdated.push_back(false);
+  result.latencies.push_back(1000.0);
+  result.policyInputs.emplace_back();
+
+  const auto statistics = ocs2::getLatencyStatistics(result);
+  EXPECT_EQ(statistics.numSamples, 100);
+  EXPECT_DOUBLE_EQ(statistics.mean, 50.5);
+  EXPECT_DOUBLE_EQ(statistics.min, 1.0);
+  EXPECT_DOUBLE_EQ(statistics.median, 50.0);
+  EXPECT_DOUBLE_EQ(statistics.percentile90, 90.0);
+  EXPECT_DOUBLE_EQ(statistics.percentile99, 99.0);
+  EXPECT_DOUBLE_EQ(statistics.max, 100.0);
+}
+
+TEST(test_closed_loop_replay, replayModifiedReferences) {
+  const std::string filename = "/tmp/ocs2_closed_loop_recording_modified.bin";
+  const ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+  const ocs2::DefaultInitializer zeroInitializer(2);
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+  const ocs2::TargetTrajectories targetTrajectories({0.0}, {initState}, {ocs2::vector_t::Zero(2)});
+
+  // record a closed loop in which the same target is set again
+  constexpr size_t numIterations = 6;
+  {
+    auto mpcPtr = getMpc(problem, zeroInitializer);
+    mpcPtr->getSolverPtr()->setReferenceManager(std::make_shared<DriftingReferenceManager>());
+    ocs2::MPC_MRT_Interface mpcMrtInterface(*mpcPtr);
+    mpcMrtInterface.resetMpcNode(targetTrajectories);
+    mpcMrtInterface.startRecording(filename);
+    for (size_t i = 0; i < numIterations; ++i) {
+      if (i == 3) {
+        mpcMrtInterface.getReferenceManager().setTargetTrajectories(targetTrajectories);
+      }
+      ocs2::SystemObservation observation;
+      observation.time = 0.01 * i;
+      observation.state = initState;
+      observation.input = ocs2::vector_t::Zero(2);
+      mpcMrtInterface.setCurrentObservation(observation);
+      mpcMrtInterface.advanceMpc();
+    }
+    mpcMrtInterface.stopRecording();
+  }
+
+  // the unmodified target is stored whenever it was set, even if it did not change
+  const auto frames = ocs2::loadClosedLoopRecording(filename);
+  ASSERT_EQ(frames.size(), numIterations);
+  for (size_t i = 0; i < numIterations; ++i) {
+    EXPECT_EQ(frames[i].isTargetTrajectoriesUpdated, i == 0 || i == 3);
+  }
+  EXPECT_TRUE(frames[3].targetTrajectories.stateTrajectory.front().isApprox(initState));
+
+  // the replay applies the modifications of the reference manager in the same way as the recording
+  auto mpcPtr = getMpc(problem, zeroInitializer);
+  mpcPtr->getSolverPtr()->setReferenceManager(std::make_shared<DriftingReferenceManager>());
+  const auto comparison = ocs2::comparePolicies(ocs2::replayClosedLoop(*mpcPtr, frames), ocs2::getRecordedResult(frames));
+  EXPECT_EQ(comparison.numCompared, numIterations);
+  EXPECT_EQ(comparison.numUpdateMismatches, 0);
+  EXPECT_LT(comparison.maxInputDeviation, 1e-9);
+}
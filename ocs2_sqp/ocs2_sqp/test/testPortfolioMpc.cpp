@@ -0,0 +1,162 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include "ocs2_sqp/SqpSolver.h"
+
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_mpc/PortfolioMpc.h>
+
+#include <ocs2_oc/test/circular_kinematics.h>
+
+namespace {
+ocs2::sqp::Settings getSettings(size_t sqpIteration) {
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = sqpIteration;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useFeedbackPolicy = true;
+  settings.printSolverStatus = false;
+  settings.nThreads = 1;
+  return settings;
+}
+
+ocs2::scalar_t constraintViolation(const ocs2::PerformanceIndex& performance) {
+  return std::sqrt(performance.dynamicsViolationSSE + performance.equalityConstraintsSSE + performance.inequalityConstraintsSSE);
+}
+}  // namespace
+
+TEST(test_portfolio_mpc, requestTermination) {
+  const ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+  const ocs2::DefaultInitializer zeroInitializer(2);
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  ocs2::SqpSolver solver(getSettings(20), problem, zeroInitializer);
+  solver.requestTermination();
+  solver.run(0.0, initState, 1.0);
+  EXPECT_EQ(solver.getNumIterations(), 1);
+
+  // the request holds until it is withdrawn
+  solver.run(0.0, initState, 1.0);
+  EXPECT_EQ(solver.getNumIterations(), 2);
+  solver.requestTermination(false);
+  solver.run(0.0, initState, 1.0);
+  EXPECT_GT(solver.getNumIterations(), 3);
+}
+
+TEST(test_portfolio_mpc, publishAcceptedPolicy) {
+  const ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+  const ocs2::DefaultInitializer zeroInitializer(2);
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // a single iteration from the zero initialization does not meet the tolerance
+  ocs2::SqpSolver singleIterationSolver(getSettings(1), problem, zeroInitializer);
+  singleIterationSolver.run(0.0, initState, 1.0);
+  ocs2::portfolio_mpc::Settings portfolioSettings;
+  portfolioSettings.constraintTolerance = 1e-3;
+  ASSERT_GT(constraintViolation(singleIterationSolver.getPerformanceIndeces()), portfolioSettings.constraintTolerance);
+
+  ocs2::mpc::Settings mpcSettings;
+  mpcSettings.timeHorizon_ = 1.0;
+  mpcSettings.debugPrint_ = true;
+  std::vector<std::unique_ptr<ocs2::SolverBase>> solvers;
+  solvers.emplace_back(new ocs2::SqpSolver(getSettings(1), problem, zeroInitializer));
+  solvers.emplace_back(new ocs2::SqpSolver(getSettings(20), problem, zeroInitializer));
+  ocs2::PortfolioMpc mpc(mpcSettings, portfolioSettings, {"SQP-1", "SQP-20"}, std::move(solvers));
+
+  // the references set through the published solver reach the portfolio
+  const ocs2::TargetTrajectories targetTrajectories({0.0}, {initState}, {ocs2::vector_t::Zero(2)});
+  mpc.getSolverPtr()->getReferenceManager().setTargetTrajectories(targetTrajectories);
+
+  ASSERT_TRUE(mpc.run(0.0, initState));
+  EXPECT_EQ(mpc.getWinnerIndex(), 1);
+  EXPECT_EQ(mpc.getSolverName(mpc.getWinnerIndex()), "SQP-20");
+  EXPECT_LT(constraintViolation(mpc.getSolverPtr()->getPerformanceIndeces()), portfolioSettings.constraintTolerance);
+  EXPECT_TRUE(mpc.getReferenceManager().getTargetTrajectories().stateTrajectory.front().isApprox(initState));
+  EXPECT_TRUE(mpc.getSolverPtr()->getReferenceManager().getTargetTrajectories().stateTrajectory.front().isApprox(initState));
+
+  const auto primalSolution = mpc.getSolverPtr()->primalSolution(mpc.getSolverPtr()->getFinalTime());
+  EXPECT_TRUE(primalSolution.stateTrajectory_.front().isApprox(initState));
+}
+
+TEST(test_portfolio_mpc, publishSmallestConstraintViolation) {
+  const ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+  const ocs2::DefaultInitializer zeroInitializer(2);
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  ocs2::mpc::Settings mpcSettings;
+  mpcSettings.timeHorizon_ = 1.0;
+  ocs2::portfolio_mpc::Settings portfolioSettings;
+  portfolioSettings.constraintTolerance = 0.0;  // no policy is accepted
+  std::vector<std::unique_ptr<ocs2::SolverBase>> solvers;
+  solvers.emplace_back(new ocs2::SqpSolver(getSettings(20), problem, zeroInitializer));
+  solvers.emplace_back(new ocs2::SqpSolver(getSettings(1), problem, zeroInitializer));
+  ocs2::PortfolioMpc mpc(mpcSettings, portfolioSettings, {"SQP-20", "SQP-1"}, std::move(solvers));
+
+  // consecutive calls wait for the solvers of the previous call
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(mpc.run(0.01 * i, initState));
+    EXPECT_EQ(mpc.getWinnerIndex(), 0);
+  }
+  EXPECT_EQ(mpc.getNumWins()[0], 3);
+  EXPECT_EQ(mpc.getNumWins()[1], 0);
+}
+
+TEST(test_portfolio_mpc, cancelledSolversSitOut) {
+  const ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+  const ocs2::DefaultInitializer zeroInitializer(2);
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  ocs2::mpc::Settings mpcSettings;
+  mpcSettings.timeHorizon_ = 1.0;
+  ocs2::portfolio_mpc::Settings portfolioSettings;
+  portfolioSettings.constraintTolerance = std::numeric_limits<ocs2::scalar_t>::infinity();  // the first policy is accepted
+  auto slowSettings = getSettings(20);
+  slowSettings.dt = 0.0005;
+  std::vector<std::unique_ptr<ocs2::SolverBase>> solvers;
+  solvers.emplace_back(new ocs2::SqpSolver(getSettings(1), problem, zeroInitializer));
+  solvers.emplace_back(new ocs2::SqpSolver(slowSettings, problem, zeroInitializer));
+  ocs2::PortfolioMpc mpc(mpcSettings, portfolioSettings, {"SQP-1", "SQP-slow"}, std::move(solvers));
+  mpc.getSolverPtr()->getReferenceManager().setTargetTrajectories(
+      ocs2::TargetTrajectories({0.0}, {initState}, {ocs2::vector_t::Zero(2)}));
+
+  // the fast solver wins and the slow one is cancelled
+  ASSERT_TRUE(mpc.run(0.0, initState));
+  EXPECT_EQ(mpc.getWinnerIndex(), 0);
+
+  // the following calls do not wait for the cancelled solver, it races again once it has returned
+  for (int i = 1; i < 4; ++i) {
+    ASSERT_TRUE(mpc.run(0.01 * i, initState));
+    EXPECT_TRUE(mpc.getSolverPtr()->getReferenceManager().getTargetTrajectories().stateTrajectory.front().isApprox(initState));
+  }
+  EXPECT_EQ(mpc.getNumWins()[0] + mpc.getNumWins()[1], 4);
+}
@@ -41,7 +41,7 @@ namespace {
 
 std::pair<PrimalSolution, std::vector<PerformanceIndex>> solveWithFeedbackSetting(
     bool feedback, bool emptyConstraint, const VectorFunctionLinearApproximation& dynamicsMatrices,
-    const ScalarFunctionQuadraticApproximation& costMatrices) {
+    const ScalarFunctionQuadraticApproximation& costMatrices, size_t moveBlockingSize = 1) {
   int n = dynamicsMatrices.dfdu.rows();
   int m = dynamicsMatrices.dfdu.cols();
 
@@ -76,6 +76,8 @@ std::pair<PrimalSolution, std::vector<PerformanceIndex>> solveWithFeedbackSettin
   settings.printSolverStatus = true;
   settings.printLinesearch = true;
   settings.nThreads = 100;
+  settings.moveBlockingSize = moveBlockingSize;
+  settings.moveBlockingStartTime = 0.3;
 
   // Additional problem definitions
   const ocs2::scalar_t startTime = 0.0;
@@ -160,3 +162,34 @@ TEST(test_unconstrained, noFeedback) {
         withEmptyConstraint.controllerPtr_->computeInput(t, x).isApprox(withNullConstraint.controllerPtr_->computeInput(t, x), tol));
   }
 }
+
+TEST(test_unconstrained, moveBlocking) {
+  int n = 3;
+  int m = 2;
+  const double tol = 1e-9;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+  const auto solution = ocs2::solveWithFeedbackSetting(true, false, dynamics, costs);
+  const auto solutionBlocked = ocs2::solveWithFeedbackSetting(true, false, dynamics, costs, 4);
+
+  // Linear dynamics should be satisfied after the step, the blocked inputs cannot improve the cost.
+  ASSERT_LE(solutionBlocked.second.size(), 2);
+  ASSERT_LT(solutionBlocked.second.back().dynamicsViolationSSE, tol);
+  ASSERT_GE(solutionBlocked.second.back().cost, solution.second.back().cost - tol);
+
+  // Nodes: 0.0, 0.05, ..., 1.0. The inputs of the intervals from 0.3 on are tied in blocks of 4.
+  const auto& primalSolution = solutionBlocked.first;
+  ASSERT_EQ(primalSolution.timeTrajectory_.size(), 21);
+  ASSERT_FALSE(primalSolution.inputTrajectory_[0].isApprox(primalSolution.inputTrajectory_[1], tol));
+  for (int i = 6; i < 20; i++) {
+    const int leader = 6 + 4 * ((i - 6) / 4);
+    ASSERT_TRUE(primalSolution.inputTrajectory_[i].isApprox(primalSolution.inputTrajectory_[leader], tol));
+  }
+
+  // The feedback controller reproduces the nominal inputs
+  for (int i = 0; i < primalSolution.timeTrajectory_.size() - 1; i++) {
+    const auto t = primalSolution.timeTrajectory_[i];
+    const auto& x = primalSolution.stateTrajectory_[i];
+    ASSERT_TRUE(primalSolution.inputTrajectory_[i].isApprox(primalSolution.controllerPtr_->computeInput(t, x), tol));
+  }
+}
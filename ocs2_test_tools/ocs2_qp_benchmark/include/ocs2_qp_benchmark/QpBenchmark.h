@@ -0,0 +1,105 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_oc/oc_problem/LqSubproblemRecorder.h>
+
+#include <hpipm_catkin/HpipmInterface.h>
+#include <ocs2_slp/pipg/PipgSolver.h>
+
+namespace ocs2 {
+namespace qp_benchmark {
+
+struct Settings {
+  size_t numRepetitions = 10;  // number of timed solves of each subproblem
+  size_t nThreads = 4;         // number of threads of the PIPG solver
+  hpipm_interface::Settings hpipmSettings = hpipm_interface::Settings();
+  pipg::Settings pipgSettings = pipg::Settings();
+  size_t scalingIteration = 3;  // number of pre-conditioning iterations of PIPG, as in the SLP solver
+};
+
+/** Outcome of one QP solver on one LQ subproblem. */
+struct SolverResult {
+  std::string solverName;
+  bool isSolved = false;             // false if the solver failed or does not support the subproblem
+  scalar_t averageSolveTime = 0.0;   // [ms]
+  size_t numIterations = 0;          // iterations of the last solve, 1 for the direct dense solver
+  scalar_t stateError = 0.0;         // maximum absolute deviation of the states from the dense reference solution
+  scalar_t inputError = 0.0;         // maximum absolute deviation of the inputs from the dense reference solution
+  scalar_t dynamicsViolation = 0.0;  // maximum absolute violation of the linear dynamics
+};
+
+/**
+ * Solves recorded LQ subproblems (see LqSubproblemRecorder) with the QP solvers of OCS2 and compares them against a dense reference
+ * solution, such that the QP solvers can be benchmarked offline on the subproblems of a real run.
+ *
+ * The following solvers are compared:
+ *   "dense" : Solution of the dense KKT system with ocs2_qp_solver. This is the reference solution.
+ *   "hpipm" : The HPIPM Riccati based interior point method, as used by the SQP solver.
+ *   "pipg"  : The PIPG solver with the pre-conditioning and eigenvalue bounds of the SLP solver. Only applicable to subproblems without
+ *             general constraints.
+ */
+class QpBenchmark {
+ public:
+  explicit QpBenchmark(Settings settings);
+
+  /** Solves the subproblem with all solvers. The first entry is the dense reference solution. */
+  std::vector<SolverResult> run(const LqSubproblem& subproblem);
+
+  /** Solves the subproblem with HPIPM. */
+  SolverResult runHpipm(const LqSubproblem& subproblem, const vector_array_t& xReference, const vector_array_t& uReference);
+
+  /** Solves the subproblem with PIPG. */
+  SolverResult runPipg(const LqSubproblem& subproblem, const vector_array_t& xReference, const vector_array_t& uReference);
+
+  /** Solves the subproblem by the dense KKT system and returns the reference solution. */
+  SolverResult runDense(const LqSubproblem& subproblem, vector_array_t& xReference, vector_array_t& uReference);
+
+ private:
+  Settings settings_;
+  HpipmInterface hpipmInterface_;
+  PipgSolver pipgSolver_;
+  ThreadPool threadPool_;
+};
+
+/** Maximum absolute violation of x[k+1] = A x[k] + B u[k] + b and of x[0] = x0. */
+scalar_t getDynamicsViolation(const LqSubproblem& subproblem, const vector_array_t& xTrajectory, const vector_array_t& uTrajectory);
+
+/** Prints a table of the results of several subproblems, one row per solver, averaged over the subproblems. */
+void printResults(const std::vector<std::vector<SolverResult>>& results, std::ostream& stream);
+
+}  // namespace qp_benchmark
+}  // namespace ocs2
@@ -0,0 +1,267 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_qp_benchmark/QpBenchmark.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_oc/oc_problem/OcpToKkt.h>
+#include <ocs2_oc/precondition/Ruzi.h>
+#include <ocs2_qp_solver/QpSolver.h>
+#include <ocs2_slp/Helpers.h>
+
+namespace ocs2 {
+namespace qp_benchmark {
+
+namespace {
+scalar_t maxAbsoluteDifference(const vector_array_t& lhs, const vector_array_t& rhs) {
+  if (lhs.size() != rhs.size()) {
+    return std::numeric_limits<scalar_t>::infinity();
+  }
+  scalar_t maxDifference = 0.0;
+  for (size_t i = 0; i < lhs.size(); ++i) {
+    if (lhs[i].size() != rhs[i].size()) {
+      return std::numeric_limits<scalar_t>::infinity();
+    }
+    if (lhs[i].size() > 0) {
+      maxDifference = std::max(maxDifference, (lhs[i] - rhs[i]).lpNorm<Eigen::Infinity>());
+    }
+  }
+  return maxDifference;
+}
+
+void evaluateSolution(const LqSubproblem& subproblem, const vector_array_t& xTrajectory, const vector_array_t& uTrajectory,
+                      const vector_array_t& xReference, const vector_array_t& uReference, SolverResult& result) {
+  result.stateError = maxAbsoluteDifference(xTrajectory, xReference);
+  result.inputError = maxAbsoluteDifference(uTrajectory, uReference);
+  result.dynamicsViolation = getDynamicsViolation(subproblem, xTrajectory, uTrajectory);
+}
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+QpBenchmark::QpBenchmark(Settings settings)
+    : settings_(std::move(settings)),
+      hpipmInterface_(OcpSize(), settings_.hpipmSettings),
+      pipgSolver_(settings_.pipgSettings),
+      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, 50) {
+  if (settings_.numRepetitions == 0) {
+    throw std::runtime_error("[QpBenchmark] numRepetitions should be at least 1.");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<SolverResult> QpBenchmark::run(const LqSubproblem& subproblem) {
+  std::vector<SolverResult> results;
+  vector_array_t xReference, uReference;
+  results.push_back(runDense(subproblem, xReference, uReference));
+  results.push_back(runHpipm(subproblem, xReference, uReference));
+  results.push_back(runPipg(subproblem, xReference, uReference));
+  return results;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SolverResult QpBenchmark::runDense(const LqSubproblem& subproblem, vector_array_t& xReference, vector_array_t& uReference) {
+  SolverResult result;
+  result.solverName = "dense";
+  result.numIterations = 1;
+
+  const auto* constraintsPtr = subproblem.constraints.empty() ? nullptr : &subproblem.constraints;
+  benchmark::RepeatedTimer timer;
+  vector_t stackedSolution;
+  for (size_t r = 0; r < settings_.numRepetitions; ++r) {
+    timer.startTimer();
+    ScalarFunctionQuadraticApproximation costApproximation;
+    VectorFunctionLinearApproximation constraintsApproximation;
+    getCostMatrix(subproblem.ocpSize, subproblem.x0, subproblem.cost, costApproximation);
+    getConstraintMatrix(subproblem.ocpSize, subproblem.x0, subproblem.dynamics, constraintsPtr, nullptr, constraintsApproximation);
+    // qp_solver::solveDenseQp uses A w + b = 0, while the KKT constraints are G w = g
+    constraintsApproximation.f = -constraintsApproximation.f;
+    stackedSolution = qp_solver::solveDenseQp(costApproximation, constraintsApproximation).first;
+    timer.endTimer();
+  }
+  result.averageSolveTime = timer.getAverageInMilliseconds();
+
+  toOcpSolution(subproblem.ocpSize, stackedSolution, subproblem.x0, xReference, uReference);
+  result.isSolved = stackedSolution.allFinite();
+  evaluateSolution(subproblem, xReference, uReference, xReference, uReference, result);
+  return result;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SolverResult QpBenchmark::runHpipm(const LqSubproblem& subproblem, const vector_array_t& xReference, const vector_array_t& uReference) {
+  SolverResult result;
+  result.solverName = "hpipm";
+
+  // HPIPM takes the problem by non-const reference
+  auto dynamics = subproblem.dynamics;
+  auto cost = subproblem.cost;
+  auto constraints = subproblem.constraints;
+  auto* constraintsPtr = constraints.empty() ? nullptr : &constraints;
+
+  benchmark::RepeatedTimer timer;
+  vector_array_t xTrajectory, uTrajectory;
+  hpipm_status status = hpipm_status::SUCCESS;
+  hpipmInterface_.resize(subproblem.ocpSize);
+  for (size_t r = 0; r < settings_.numRepetitions; ++r) {
+    timer.startTimer();
+    status = hpipmInterface_.solve(subproblem.x0, dynamics, cost, constraintsPtr, xTrajectory, uTrajectory);
+    timer.endTimer();
+  }
+  result.averageSolveTime = timer.getAverageInMilliseconds();
+  result.numIterations = hpipmInterface_.getNumIterations();
+  result.isSolved = (status == hpipm_status::SUCCESS);
+
+  evaluateSolution(subproblem, xTrajectory, uTrajectory, xReference, uReference, result);
+  return result;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SolverResult QpBenchmark::runPipg(const LqSubproblem& subproblem, const vector_array_t& xReference, const vector_array_t& uReference) {
+  SolverResult result;
+  result.solverName = "pipg";
+
+  // As in the SLP solver, PIPG only handles the dynamics constraints.
+  if (!subproblem.constraints.empty()) {
+    return result;
+  }
+
+  benchmark::RepeatedTimer timer;
+  vector_array_t xTrajectory, uTrajectory;
+  pipg::SolverStatus status = pipg::SolverStatus::UNDEFINED;
+  pipgSolver_.resize(subproblem.ocpSize);
+  for (size_t r = 0; r < settings_.numRepetitions; ++r) {
+    // The pre-conditioning scales the data in place
+    auto dynamics = subproblem.dynamics;
+    auto cost = subproblem.cost;
+
+    timer.startTimer();
+    vector_array_t scalingD, scalingE, scalingVectors;
+    scalar_t scalingC;
+    precondition::ocpDataInPlaceInParallel(threadPool_, subproblem.x0, subproblem.ocpSize, settings_.scalingIteration, dynamics, cost,
+                                           scalingD, scalingE, scalingVectors, scalingC);
+
+    // estimate mu and lambda: mu I < H < lambda I, and sigma: G G' < sigma I
+    scalar_t maxScalingFactor = -1;
+    for (const auto& v : scalingD) {
+      if (v.size() != 0) {
+        maxScalingFactor = std::max(maxScalingFactor, v.maxCoeff());
+      }
+    }
+    const scalar_t mu = scalingC * pipgSolver_.settings().lowerBoundH * maxScalingFactor * maxScalingFactor;
+    const scalar_t lambda = slp::hessianEigenvaluesUpperBound(subproblem.ocpSize, cost);
+    const scalar_t sigma = slp::GGTEigenvaluesUpperBound(threadPool_, subproblem.ocpSize, dynamics, nullptr, &scalingVectors);
+
+    vector_array_t EInv(scalingE.size());
+    std::transform(scalingE.begin(), scalingE.end(), EInv.begin(), [](const vector_t& v) { return v.cwiseInverse(); });
+    const pipg::PipgBounds pipgBounds{mu, lambda, sigma};
+    status = pipgSolver_.solve(threadPool_, subproblem.x0, dynamics, cost, nullptr, scalingVectors, &EInv, pipgBounds, xTrajectory,
+                               uTrajectory);
+    precondition::descaleSolution(scalingD, xTrajectory, uTrajectory);
+    timer.endTimer();
+  }
+  result.averageSolveTime = timer.getAverageInMilliseconds();
+  result.numIterations = pipgSolver_.getNumIterations();
+  result.isSolved = (status == pipg::SolverStatus::SUCCESS);
+
+  evaluateSolution(subproblem, xTrajectory, uTrajectory, xReference, uReference, result);
+  return result;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t getDynamicsViolation(const LqSubproblem& subproblem, const vector_array_t& xTrajectory, const vector_array_t& uTrajectory) {
+  const int N = subproblem.ocpSize.numStages;
+  if (xTrajectory.size() != N + 1 || uTrajectory.size() != N) {
+    return std::numeric_limits<scalar_t>::infinity();
+  }
+
+  scalar_t violation = (xTrajectory[0] - subproblem.x0).lpNorm<Eigen::Infinity>();
+  for (int i = 0; i < N; ++i) {
+    const auto& dynamics = subproblem.dynamics[i];
+    vector_t defect = dynamics.f - xTrajectory[i + 1];
+    defect.noalias() += dynamics.dfdx * xTrajectory[i];
+    if (uTrajectory[i].size() > 0) {
+      defect.noalias() += dynamics.dfdu * uTrajectory[i];
+    }
+    violation = std::max(violation, defect.lpNorm<Eigen::Infinity>());
+  }
+  return violation;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void printResults(const std::vector<std::vector<SolverResult>>& results, std::ostream& stream) {
+  if (results.empty()) {
+    return;
+  }
+
+  stream << std::left << std::setw(8) << "solver" << std::right << std::setw(10) << "solved" << std::setw(14) << "time [ms]"
+         << std::setw(12) << "iterations" << std::setw(14) << "state error" << std::setw(14) << "input error" << std::setw(14)
+         << "dyn. viol." << "\n";
+
+  const size_t numSolvers = results.front().size();
+  for (size_t s = 0; s < numSolvers; ++s) {
+    size_t numSolved = 0;
+    scalar_t solveTime = 0.0, numIterations = 0.0, stateError = 0.0, inputError = 0.0, dynamicsViolation = 0.0;
+    for (const auto& subproblemResults : results) {
+      const auto& result = subproblemResults[s];
+      if (result.isSolved) {
+        ++numSolved;
+        solveTime += result.averageSolveTime;
+        numIterations += result.numIterations;
+        stateError = std::max(stateError, result.stateError);
+        inputError = std::max(inputError, result.inputError);
+        dynamicsViolation = std::max(dynamicsViolation, result.dynamicsViolation);
+      }
+    }
+    const scalar_t normalization = std::max(numSolved, size_t(1));
+    stream << std::left << std::setw(8) << results.front()[s].solverName << std::right << std::setw(10)
+           << (std::to_string(numSolved) + "/" + std::to_string(results.size())) << std::setw(14) << solveTime / normalization
+           << std::setw(12) << numIterations / normalization << std::setw(14) << stateError << std::setw(14) << inputError
+           << std::setw(14) << dynamicsViolation << "\n";
+  }
+}
+
+}  // namespace qp_benchmark
+}  // namespace ocs2
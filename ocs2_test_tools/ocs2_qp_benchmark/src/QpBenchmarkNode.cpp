@@ -0,0 +1,62 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <iostream>
+
+#include "ocs2_qp_benchmark/QpBenchmark.h"
+
+/**
+ * Benchmarks the QP solvers on the LQ subproblems recorded by a solver with lqRecordingFile set.
+ *
+ * Usage: qp_benchmark <recording file> [number of repetitions]
+ */
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " <recording file> [number of repetitions]" << std::endl;
+    return 1;
+  }
+
+  ocs2::qp_benchmark::Settings settings;
+  if (argc > 2) {
+    settings.numRepetitions = std::stoul(argv[2]);
+  }
+
+  const auto subproblems = ocs2::loadLqSubproblems(argv[1]);
+  std::cerr << "Loaded " << subproblems.size() << " LQ subproblems from " << argv[1] << "\n";
+
+  ocs2::qp_benchmark::QpBenchmark qpBenchmark(settings);
+  std::vector<std::vector<ocs2::qp_benchmark::SolverResult>> results;
+  results.reserve(subproblems.size());
+  for (const auto& subproblem : subproblems) {
+    results.push_back(qpBenchmark.run(subproblem));
+  }
+
+  ocs2::qp_benchmark::printResults(results, std::cout);
+  return 0;
+}
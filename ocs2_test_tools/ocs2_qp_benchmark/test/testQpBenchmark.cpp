@@ -0,0 +1,109 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+#include "ocs2_qp_benchmark/QpBenchmark.h"
+
+namespace {
+ocs2::LqSubproblem getRandomLqSubproblem(int N, int nx, int nu, int nc) {
+  ocs2::LqSubproblem subproblem;
+  subproblem.x0 = ocs2::vector_t::Random(nx);
+  for (int i = 0; i < N; i++) {
+    subproblem.dynamics.push_back(ocs2::getRandomDynamics(nx, nu));
+    subproblem.cost.push_back(ocs2::getRandomCost(nx, nu));
+    if (nc > 0) {
+      subproblem.constraints.push_back(ocs2::getRandomConstraints(nx, nu, nc));
+    }
+  }
+  subproblem.cost.push_back(ocs2::getRandomCost(nx, 0));
+  if (nc > 0) {
+    subproblem.constraints.push_back(ocs2::getRandomConstraints(nx, 0, nc));
+  }
+  subproblem.ocpSize =
+      ocs2::extractSizesFromProblem(subproblem.dynamics, subproblem.cost, subproblem.constraints.empty() ? nullptr : &subproblem.constraints);
+  return subproblem;
+}
+
+ocs2::qp_benchmark::Settings getSettings() {
+  ocs2::qp_benchmark::Settings settings;
+  settings.numRepetitions = 2;
+  settings.pipgSettings.maxNumIterations = 30000;
+  settings.pipgSettings.absoluteTolerance = 1e-10;
+  settings.pipgSettings.relativeTolerance = 1e-6;
+  return settings;
+}
+}  // namespace
+
+TEST(testQpBenchmark, unconstrainedProblem) {
+  srand(0);
+  const auto subproblem = getRandomLqSubproblem(10, 4, 3, 0);
+
+  ocs2::qp_benchmark::QpBenchmark qpBenchmark(getSettings());
+  const auto results = qpBenchmark.run(subproblem);
+  ASSERT_EQ(results.size(), 3);
+
+  const auto& dense = results[0];
+  EXPECT_EQ(dense.solverName, "dense");
+  EXPECT_TRUE(dense.isSolved);
+  EXPECT_LT(dense.dynamicsViolation, 1e-9);
+
+  const auto& hpipm = results[1];
+  EXPECT_EQ(hpipm.solverName, "hpipm");
+  EXPECT_TRUE(hpipm.isSolved);
+  EXPECT_LT(hpipm.stateError, 1e-6);
+  EXPECT_LT(hpipm.inputError, 1e-6);
+  EXPECT_LT(hpipm.dynamicsViolation, 1e-9);
+
+  const auto& pipg = results[2];
+  EXPECT_EQ(pipg.solverName, "pipg");
+  EXPECT_GT(pipg.numIterations, 0);
+  EXPECT_LT(pipg.stateError, 1e-2);
+  EXPECT_LT(pipg.inputError, 1e-2);
+
+  std::ostringstream stream;
+  ocs2::qp_benchmark::printResults({results}, stream);
+  EXPECT_FALSE(stream.str().empty());
+}
+
+TEST(testQpBenchmark, pipgSkipsConstrainedProblem) {
+  srand(0);
+  const auto subproblem = getRandomLqSubproblem(10, 4, 3, 2);
+
+  ocs2::qp_benchmark::QpBenchmark qpBenchmark(getSettings());
+  ocs2::vector_array_t xReference, uReference;
+  const auto dense = qpBenchmark.runDense(subproblem, xReference, uReference);
+  EXPECT_TRUE(dense.isSolved);
+  EXPECT_LT(dense.dynamicsViolation, 1e-9);
+
+  const auto pipg = qpBenchmark.runPipg(subproblem, xReference, uReference);
+  EXPECT_FALSE(pipg.isSolved);
+}